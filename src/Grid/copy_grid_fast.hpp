@@ -9,6 +9,13 @@
 #define OPENFPM_DATA_SRC_GRID_COPY_GRID_FAST_HPP_
 
 #include "Grid/iterators/grid_key_dx_iterator.hpp"
+#include "util/thread_pool.hpp"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//! Copies bigger than this (in byte) use non-temporal stores, the destination is not expected to be in cache
+#define COPY_GRID_FAST_NT_THRESHOLD (32*1024*1024)
 
 template<unsigned int dim>
 struct striding
@@ -140,36 +147,33 @@ struct copy_grid_fast<true,3,grid,ginfo>
 				   grid & gd_dst,
 				   grid_key_dx<3> (& cnt)[1] )
 	{
-		size_t lin_src = 0;
-		size_t lin_dst = 0;
+		// nothing to copy
+		if (bx_src.isValid() == false)
+		{return;}
 
-		lin_src += bx_src.getLow(2) * gs_src.size_s(1);
-		lin_dst += bx_dst.getLow(2) * gs_dst.size_s(1);
-		for (size_t i = bx_src.getLow(2) ; i <= bx_src.getHigh(2) ; i++)
+		size_t tot_z = bx_src.getHigh(2) - bx_src.getLow(2) + 1;
+		size_t n_slice = (bx_src.getHigh(1) - bx_src.getLow(1) + 1)*(bx_src.getHigh(0) - bx_src.getLow(0) + 1);
+
+		// the planes along the slowest dimension are distributed across the threads
+		openfpm::parallel_for_blocks(0,tot_z,openfpm::parallel_n_blocks(0,tot_z,OFP_PARALLEL_GRAIN / n_slice + 1),[&](size_t b, size_t z_start, size_t z_stop)
 		{
-			lin_src += bx_src.getLow(1) * gs_src.size_s(0);
-			lin_dst += bx_dst.getLow(1) * gs_dst.size_s(0);
-			for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
+			for (size_t i = z_start ; i < z_stop ; i++)
 			{
-				lin_src += bx_src.getLow(0);
-				lin_dst += bx_dst.getLow(0);
-				for (size_t k = bx_src.getLow(0) ; k <= bx_src.getHigh(0) ; k++)
+				for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
 				{
-					gd_dst.set(lin_dst,gd_src,lin_src);
+					size_t lin_src = (bx_src.getLow(2) + i) * gs_src.size_s(1) + j * gs_src.size_s(0) + bx_src.getLow(0);
+					size_t lin_dst = (bx_dst.getLow(2) + i) * gs_dst.size_s(1) + (bx_dst.getLow(1) + j - bx_src.getLow(1)) * gs_dst.size_s(0) + bx_dst.getLow(0);
 
-					lin_src++;
-					lin_dst++;
+					for (size_t k = bx_src.getLow(0) ; k <= bx_src.getHigh(0) ; k++)
+					{
+						gd_dst.set(lin_dst,gd_src,lin_src);
+
+						lin_src++;
+						lin_dst++;
+					}
 				}
-				lin_src -= bx_src.getHigh(0) + 1;
-				lin_dst -= bx_dst.getHigh(0) + 1;
-				lin_src += gs_src.size_s(0);
-				lin_dst += gs_dst.size_s(0);
 			}
-			lin_src -= (bx_src.getHigh(1) + 1)*gs_src.size_s(0);
-			lin_dst -= (bx_dst.getHigh(1) + 1)*gs_dst.size_s(0);
-			lin_src += gs_src.size_s(1);
-			lin_dst += gs_dst.size_s(1);
-		}
+		});
 	}
 };
 
@@ -189,29 +193,30 @@ struct copy_grid_fast<true,2,grid,ginfo>
 				   grid & gd_dst,
 				   grid_key_dx<2> (& cnt)[1] )
 	{
-		size_t lin_src = 0;
-		size_t lin_dst = 0;
+		// nothing to copy
+		if (bx_src.isValid() == false)
+		{return;}
 
+		size_t tot_y = bx_src.getHigh(1) - bx_src.getLow(1) + 1;
+		size_t n_row = bx_src.getHigh(0) - bx_src.getLow(0) + 1;
 
-		lin_src += bx_src.getLow(1) * gs_src.size_s(0);
-		lin_dst += bx_dst.getLow(1) * gs_dst.size_s(0);
-		for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
+		// the rows along the slowest dimension are distributed across the threads
+		openfpm::parallel_for_blocks(0,tot_y,openfpm::parallel_n_blocks(0,tot_y,OFP_PARALLEL_GRAIN / n_row + 1),[&](size_t b, size_t y_start, size_t y_stop)
 		{
-			lin_src += bx_src.getLow(0);
-			lin_dst += bx_dst.getLow(0);
-			for (size_t k = bx_src.getLow(0) ; k <= bx_src.getHigh(0) ; k++)
+			for (size_t j = y_start ; j < y_stop ; j++)
 			{
-				gd_dst.set(lin_dst,gd_src,lin_src);
+				size_t lin_src = (bx_src.getLow(1) + j) * gs_src.size_s(0) + bx_src.getLow(0);
+				size_t lin_dst = (bx_dst.getLow(1) + j) * gs_dst.size_s(0) + bx_dst.getLow(0);
 
-				lin_src++;
-				lin_dst++;
-			}
-			lin_src -= bx_src.getHigh(0) + 1;
-			lin_dst -= bx_dst.getHigh(0) + 1;
-			lin_src += gs_src.size_s(0);
-			lin_dst += gs_dst.size_s(0);
-		}
+				for (size_t k = bx_src.getLow(0) ; k <= bx_src.getHigh(0) ; k++)
+				{
+					gd_dst.set(lin_dst,gd_src,lin_src);
 
+					lin_src++;
+					lin_dst++;
+				}
+			}
+		});
 	}
 };
 
@@ -249,19 +254,75 @@ struct copy_grid_fast<true,1,grid,ginfo>
 	}
 };
 
+/*! \brief Copy n bytes with non-temporal stores (the destination is written bypassing the cache)
+ *
+ * Without SSE2 it is a memcpy
+ *
+ * \param dst destination
+ * \param src source
+ * \param n number of bytes
+ *
+ */
+static inline void copy_grid_fast_nt(unsigned char * dst, const unsigned char * src, size_t n)
+{
+#ifdef __SSE2__
+
+	// head, up to the first 16 byte aligned destination
+	size_t head = (16 - ((size_t)dst & 15)) & 15;
+	if (head > n)	{head = n;}
+
+	memcpy(dst,src,head);
+	dst += head;
+	src += head;
+	n -= head;
+
+	for ( ; n >= 64 ; n -= 64, dst += 64, src += 64)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i *)src);
+		__m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+		__m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+		__m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+
+		_mm_stream_si128((__m128i *)dst,a);
+		_mm_stream_si128((__m128i *)(dst + 16),b);
+		_mm_stream_si128((__m128i *)(dst + 32),c);
+		_mm_stream_si128((__m128i *)(dst + 48),d);
+	}
+
+	memcpy(dst,src,n);
+
+#else
+
+	memcpy(dst,src,n);
+
+#endif
+}
+
+//! make the non-temporal stores of the calling thread visible
+static inline void copy_grid_fast_nt_fence()
+{
+#ifdef __SSE2__
+	_mm_sfence();
+#endif
+}
+
 ////// In case the property is not complex
 
 template<unsigned int object_size>
 void copy_grid_fast_longx_3(const Box<3,size_t> & bx_src,
 							unsigned char * ptr_dst,
 							unsigned char * ptr_src,
-							striding<3> & sr)
+							striding<3> & sr,
+							bool nt)
 {
 	for (size_t i = bx_src.getLow(2) ; i <= bx_src.getHigh(2) ; i++)
 	{
 		for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
 		{
-			memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);
+			if (nt == true)
+			{copy_grid_fast_nt(ptr_dst,ptr_src,sr.n_cpy*object_size);}
+			else
+			{memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);}
 
 			ptr_dst += sr.striding_dst[0];
 			ptr_src += sr.striding_src[0];
@@ -269,6 +330,9 @@ void copy_grid_fast_longx_3(const Box<3,size_t> & bx_src,
 		ptr_dst += sr.striding_dst[1] - sr.tot_y*sr.striding_dst[0];
 		ptr_src += sr.striding_src[1] - sr.tot_y*sr.striding_src[0];
 	}
+
+	if (nt == true)
+	{copy_grid_fast_nt_fence();}
 }
 
 template<unsigned int object_size, unsigned int n_cpy>
@@ -298,15 +362,22 @@ template<unsigned int object_size>
 void copy_grid_fast_longx_2(const Box<2,size_t> & bx_src,
 							unsigned char * ptr_dst,
 							unsigned char * ptr_src,
-							striding<2> & sr)
+							striding<2> & sr,
+							bool nt)
 {
 	for (size_t j = bx_src.getLow(1) ; j <= bx_src.getHigh(1) ; j++)
 	{
-		memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);
+		if (nt == true)
+		{copy_grid_fast_nt(ptr_dst,ptr_src,sr.n_cpy*object_size);}
+		else
+		{memcpy(ptr_dst,ptr_src,sr.n_cpy*object_size);}
 
 		ptr_dst += sr.striding_dst[0];
 		ptr_src += sr.striding_src[0];
 	}
+
+	if (nt == true)
+	{copy_grid_fast_nt_fence();}
 }
 
 template<unsigned int object_size, unsigned int n_cpy>
@@ -341,10 +412,11 @@ template<>
 struct copy_ndim_fast_selector<3>
 {
 	template<unsigned int object_size>
-	static void call(unsigned char * ptr_src,
+	static void call_seq(unsigned char * ptr_src,
 					 unsigned char * ptr_dst,
 					 striding<3> & sr,
-		   const Box<3,size_t> & bx_src)
+		   const Box<3,size_t> & bx_src,
+		   bool nt)
 	{
 		switch (sr.n_cpy)
 		{
@@ -378,19 +450,49 @@ struct copy_ndim_fast_selector<3>
 				break;
 
 		default:
-				copy_grid_fast_longx_3<object_size>(bx_src,ptr_dst,ptr_src,sr);
+				copy_grid_fast_longx_3<object_size>(bx_src,ptr_dst,ptr_src,sr,nt);
 		}
 	}
+
+	/*! \brief Copy the box, the planes along the slowest dimension are distributed across the threads
+	 *
+	 * Copies bigger than COPY_GRID_FAST_NT_THRESHOLD use non-temporal stores
+	 *
+	 */
+	template<unsigned int object_size>
+	static void call(unsigned char * ptr_src,
+					 unsigned char * ptr_dst,
+					 striding<3> & sr,
+		   const Box<3,size_t> & bx_src)
+	{
+		// nothing to copy
+		if (bx_src.isValid() == false)
+		{return;}
+
+		size_t tot_z = bx_src.getHigh(2) - bx_src.getLow(2) + 1;
+		size_t sz_plane = sr.n_cpy*sr.tot_y*object_size;
+		bool nt = sz_plane*tot_z >= COPY_GRID_FAST_NT_THRESHOLD;
+
+		openfpm::parallel_for_blocks(0,tot_z,openfpm::parallel_n_blocks(0,tot_z,OFP_PARALLEL_GRAIN_BYTES / sz_plane + 1),[&](size_t b, size_t z_start, size_t z_stop)
+		{
+			Box<3,size_t> bx = bx_src;
+			bx.setLow(2,bx_src.getLow(2) + z_start);
+			bx.setHigh(2,bx_src.getLow(2) + z_stop - 1);
+
+			call_seq<object_size>(ptr_src + z_start*sr.striding_src[1],ptr_dst + z_start*sr.striding_dst[1],sr,bx,nt);
+		});
+	}
 };
 
 template<>
 struct copy_ndim_fast_selector<2>
 {
 	template<unsigned int object_size>
-	static void call(unsigned char * ptr_src,
+	static void call_seq(unsigned char * ptr_src,
 			 unsigned char * ptr_dst,
 			 striding<2> & sr,
-  const Box<2,size_t> & bx_src)
+  const Box<2,size_t> & bx_src,
+  	  bool nt)
 	{
 		switch (sr.n_cpy)
 		{
@@ -424,9 +526,38 @@ struct copy_ndim_fast_selector<2>
 				break;
 
 		default:
-				copy_grid_fast_longx_2<object_size>(bx_src,ptr_dst,ptr_src,sr);
+				copy_grid_fast_longx_2<object_size>(bx_src,ptr_dst,ptr_src,sr,nt);
 		}
 	}
+
+	/*! \brief Copy the box, the rows along the slowest dimension are distributed across the threads
+	 *
+	 * Copies bigger than COPY_GRID_FAST_NT_THRESHOLD use non-temporal stores
+	 *
+	 */
+	template<unsigned int object_size>
+	static void call(unsigned char * ptr_src,
+			 unsigned char * ptr_dst,
+			 striding<2> & sr,
+  const Box<2,size_t> & bx_src)
+	{
+		// nothing to copy
+		if (bx_src.isValid() == false)
+		{return;}
+
+		size_t tot_y = bx_src.getHigh(1) - bx_src.getLow(1) + 1;
+		size_t sz_row = sr.n_cpy*object_size;
+		bool nt = sz_row*tot_y >= COPY_GRID_FAST_NT_THRESHOLD;
+
+		openfpm::parallel_for_blocks(0,tot_y,openfpm::parallel_n_blocks(0,tot_y,OFP_PARALLEL_GRAIN_BYTES / sz_row + 1),[&](size_t b, size_t y_start, size_t y_stop)
+		{
+			Box<2,size_t> bx = bx_src;
+			bx.setLow(1,bx_src.getLow(1) + y_start);
+			bx.setHigh(1,bx_src.getLow(1) + y_stop - 1);
+
+			call_seq<object_size>(ptr_src + y_start*sr.striding_src[0],ptr_dst + y_start*sr.striding_dst[0],sr,bx,nt);
+		});
+	}
 };
 
 
@@ -13,7 +13,9 @@
 #include "cuda/cuda_grid_gpu_funcs.cuh"
 #include "util/create_vmpl_sequence.hpp"
 #include "util/cuda_launch.hpp"
+#include "util/cuda/cudify_parallel.hpp"
 #include "util/object_si_di.hpp"
+#include "util/thread_pool.hpp"
 
 constexpr int DATA_ON_HOST = 32;
 constexpr int DATA_ON_DEVICE = 64;
@@ -1077,6 +1079,9 @@ public:
 	}
 
 	/*! \brief Fill the memory with the selected byte
+	 *
+	 * For memory_traits_lin the full buffer is filled (prp must be 0), for memory_traits_inte
+	 * the buffer of the property prp. The buffer is filled in parallel
 	 *
 	 * \warning It is a low level memory operation it ignore any type and semantic safety
 	 *
@@ -1086,12 +1091,20 @@ public:
 	template<int prp>
 	void fill(unsigned char fl)
 	{
+		if (is_layout_inte<layout_base<T>>::type::value == true)
+		{
+			typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<prp>>::type prp_type;
+
+			openfpm::parallel_memset(getPointer<prp>(),fl,size() * sizeof(prp_type));
+			return;
+		}
+
 		if (prp != 0 || is_layout_mlin<layout_base<T>>::type::value == false)
 		{
 			std::cout << "Error: " << __FILE__ << ":" << __LINE__ << " unsupported fill operation " << std::endl;
 		}
 
-		memset(getPointer(),fl,size() * sizeof(T));
+		openfpm::parallel_memset(getPointer(),fl,size() * sizeof(T));
 	}
 
 	/*! \brief Remove all the points in this region
@@ -1202,8 +1215,8 @@ public:
 			     const Box<dim,size_t> & box_src,
 				 const Box<dim,size_t> & box_dst)
 	{
-        typedef typename std::remove_reference<decltype(grid_src)>::type grid_cp;
-        typedef typename std::remove_reference<decltype(grid_src.getGrid())>::type grid_info_cp;
+        typedef typename std::remove_reference<decltype(*this)>::type grid_cp;
+        typedef typename std::remove_reference<decltype(this->getGrid())>::type grid_info_cp;
 
         grid_key_dx<dim> cnt[1];
         cnt[0].zero();
@@ -1241,17 +1254,41 @@ public:
 			     const Box<dim,size_t> & bx_src,
 				 const Box<dim,size_t> & bx_dst)
 	{
-		grid_key_dx_iterator_sub<dim> sub_src(gs.getGrid(),bx_src.getKP1(),bx_src.getKP2());
-		grid_key_dx_iterator_sub<dim> sub_dst(this->getGrid(),bx_dst.getKP1(),bx_dst.getKP2());
+		// nothing to copy
+		if (bx_src.isValid() == false)
+		{return;}
+
+		// The box is split along the slowest dimension across the threads
+		size_t n_slow = bx_src.getHigh(dim-1) - bx_src.getLow(dim-1) + 1;
+		size_t sz_slice = 1;
+
+		for (size_t i = 0 ; i < dim-1 ; i++)
+		{sz_slice *= bx_src.getHigh(i) - bx_src.getLow(i) + 1;}
 
-		while (sub_src.isNext())
+		openfpm::parallel_for_blocks(0,n_slow,openfpm::parallel_n_blocks(0,n_slow,OFP_PARALLEL_GRAIN / sz_slice + 1),[&](size_t b, size_t s_start, size_t s_stop)
 		{
-			// write the object in the last element
-			object_si_di_op<op,decltype(gs.get_o(sub_src.get())),decltype(this->get_o(sub_dst.get())),OBJ_ENCAP,prp...>(gs.get_o(sub_src.get()),this->get_o(sub_dst.get()));
+			grid_key_dx<dim> src_start = bx_src.getKP1();
+			grid_key_dx<dim> src_stop = bx_src.getKP2();
+			grid_key_dx<dim> dst_start = bx_dst.getKP1();
+			grid_key_dx<dim> dst_stop = bx_dst.getKP2();
 
-			++sub_src;
-			++sub_dst;
-		}
+			src_start.set_d(dim-1,bx_src.getLow(dim-1) + s_start);
+			src_stop.set_d(dim-1,bx_src.getLow(dim-1) + s_stop - 1);
+			dst_start.set_d(dim-1,bx_dst.getLow(dim-1) + s_start);
+			dst_stop.set_d(dim-1,bx_dst.getLow(dim-1) + s_stop - 1);
+
+			grid_key_dx_iterator_sub<dim> sub_src(gs.getGrid(),src_start,src_stop);
+			grid_key_dx_iterator_sub<dim> sub_dst(this->getGrid(),dst_start,dst_stop);
+
+			while (sub_src.isNext())
+			{
+				// write the object in the last element
+				object_si_di_op<op,decltype(gs.get_o(sub_src.get())),decltype(this->get_o(sub_dst.get())),OBJ_ENCAP,prp...>(gs.get_o(sub_src.get()),this->get_o(sub_dst.get()));
+
+				++sub_src;
+				++sub_dst;
+			}
+		});
 	}
 
 	/*! \brief Indicate that unpacking the header is supported
@@ -1701,6 +1738,47 @@ public:
 		return grid_key_dx_iterator_sub<dim>(gvoid,start,stop);
 	}
 
+	/*! \brief Return a tiled (cache blocked) iterator over all points included between start and stop point
+	 *
+	 * \param start point
+	 * \param stop point
+	 * \param tile size of the tile in each direction
+	 * \param order TILED_ORDER_LEX or TILED_ORDER_MORTON (order in which the tiles are visited)
+	 *
+	 * \return a tiled sub-grid iterator
+	 *
+	 */
+	inline grid_key_dx_iterator_sub_tiled<dim> getIteratorTiled(const grid_key_dx<dim> & start,
+																 const grid_key_dx<dim> & stop,
+																 const size_t (& tile)[dim],
+																 size_t order = TILED_ORDER_LEX) const
+	{
+		return grid_key_dx_iterator_sub_tiled<dim>(g1,start,stop,tile,order);
+	}
+
+	/*! \brief Return a tiled (cache blocked) iterator with stencil calculation over all points included
+	 *         between start and stop point
+	 *
+	 * \param start point
+	 * \param stop point
+	 * \param stencil_pnt stencil points
+	 * \param tile size of the tile in each direction
+	 * \param order TILED_ORDER_LEX or TILED_ORDER_MORTON (order in which the tiles are visited)
+	 *
+	 * \return a tiled sub-grid iterator with stencil calculation
+	 *
+	 */
+	template<unsigned int Np>
+	inline grid_key_dx_iterator_sub_tiled<dim,stencil_offset_compute<dim,Np>>
+	getIteratorStencilTiled(const grid_key_dx<dim> & start,
+							const grid_key_dx<dim> & stop,
+							const grid_key_dx<dim> (& stencil_pnt)[Np],
+							const size_t (& tile)[dim],
+							size_t order = TILED_ORDER_LEX) const
+	{
+		return grid_key_dx_iterator_sub_tiled<dim,stencil_offset_compute<dim,Np>>(g1,start,stop,stencil_pnt,tile,order);
+	}
+
 	/*! \brief return the internal data_
 	 *
 	 * return the internal data_
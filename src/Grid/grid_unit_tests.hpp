@@ -837,6 +837,108 @@ BOOST_AUTO_TEST_CASE(grid_test_copy_to)
 }
 
 
+/*! \brief Fill the source grid, copy a box with copy_to/copy_to_prp/copy_to_op and check the destination
+ *
+ * The boxes are big enough to be split across threads and to use non-temporal stores
+ *
+ */
+template<typename grid_type>
+void grid_copy_to_parallel_test(size_t sz)
+{
+	size_t sz_g[] = {sz,sz,sz};
+	grid_type g_src(sz_g);
+	grid_type g_dst(sz_g);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto & gs = g_src.getGrid();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto k = it.get();
+
+		g_src.template get<0>(k) = gs.LinId(k);
+		g_src.template get<1>(k)[0] = gs.LinId(k) + 1;
+		g_src.template get<1>(k)[1] = gs.LinId(k) + 2;
+		g_src.template get<1>(k)[2] = gs.LinId(k) + 3;
+
+		g_dst.template get<0>(k) = 0;
+		g_dst.template get<1>(k)[0] = 0;
+		g_dst.template get<1>(k)[1] = 0;
+		g_dst.template get<1>(k)[2] = 0;
+
+		++it;
+	}
+
+	Box<3,size_t> box_src({1,2,3},{sz-3,sz-2,sz-1});
+	Box<3,size_t> box_dst({0,0,0},{sz-4,sz-4,sz-4});
+
+	g_dst.copy_to(g_src,box_src,box_dst);
+
+	// copy_to_prp of property 0 and copy_to_op (add) of property 1, the destination
+	// get property 0 twice and property 1 once
+	g_dst.template copy_to_prp<0>(g_src,box_src,box_dst);
+	g_dst.template copy_to_op<add_,1>(g_src,box_src,box_dst);
+
+	// a box empty along the fastest dimension copy nothing
+	Box<3,size_t> box_empty({2,1,1},{1,sz-2,sz-2});
+
+	g_dst.copy_to(g_src,box_empty,box_empty);
+	g_dst.template copy_to_prp<0>(g_src,box_empty,box_empty);
+	g_dst.template copy_to_op<add_,1>(g_src,box_empty,box_empty);
+
+	bool match = true;
+
+	auto itd = g_dst.getIterator();
+	while (itd.isNext())
+	{
+		auto k = itd.get();
+		Point<3,size_t> p({(size_t)k.get(0),(size_t)k.get(1),(size_t)k.get(2)});
+
+		if (box_dst.isInside(p) == true)
+		{
+			grid_key_dx<3> ks = k + box_src.getKP1() - box_dst.getKP1();
+			size_t lin = gs.LinId(ks);
+
+			match &= g_dst.template get<0>(k) == lin;
+			match &= g_dst.template get<1>(k)[0] == 2*(lin + 1);
+			match &= g_dst.template get<1>(k)[1] == 2*(lin + 2);
+			match &= g_dst.template get<1>(k)[2] == 2*(lin + 3);
+		}
+		else
+		{
+			match &= g_dst.template get<0>(k) == 0;
+			match &= g_dst.template get<1>(k)[0] == 0;
+			match &= g_dst.template get<1>(k)[1] == 0;
+			match &= g_dst.template get<1>(k)[2] == 0;
+		}
+
+		++itd;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE(grid_test_copy_to_parallel)
+{
+	size_t old_thr = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	typedef aggregate<size_t,size_t[3]> T;
+
+	// small boxes (no split, no non-temporal stores) and big boxes
+	grid_copy_to_parallel_test<grid_cpu<3,T>>(16);
+	grid_copy_to_parallel_test<grid_base<3,T,HeapMemory,typename memory_traits_inte<T>::type>>(16);
+
+#ifndef TEST_COVERAGE_MODE
+	grid_copy_to_parallel_test<grid_cpu<3,T>>(168);
+	grid_copy_to_parallel_test<grid_base<3,T,HeapMemory,typename memory_traits_inte<T>::type>>(168);
+#endif
+
+	openfpm::set_num_threads(old_thr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
@@ -11,6 +11,7 @@
 #include "Grid/map_grid.hpp"
 #include "data_type/aggregate.hpp"
 #include "Grid/iterators/grid_key_dx_iterator_sub_bc.hpp"
+#include "Grid/iterators/grid_key_dx_iterator_sub_tiled.hpp"
 
 BOOST_AUTO_TEST_SUITE( grid_iterators_tests )
 
@@ -345,5 +346,311 @@ BOOST_AUTO_TEST_CASE( grid_iterator_sub_bc_hd )
 	BOOST_REQUIRE_EQUAL(cnt,8ul);
 }
 
+template<unsigned int dim>
+void test_tiled_iterator(const size_t (& sz)[dim],
+		                 const grid_key_dx<dim> & start,
+						 const grid_key_dx<dim> & stop,
+						 const size_t (& tile)[dim],
+						 size_t order)
+{
+	grid_sm<dim,void> g_sm(sz);
+	std::vector<size_t> visited(g_sm.size(),0);
+
+	grid_key_dx_iterator_sub_tiled<dim> it(g_sm,start,stop,tile,order);
+
+	bool in_tile = true;
+	size_t cnt = 0;
+	size_t tile_cnt = 0;
+	size_t act_tile = 0;
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		visited[g_sm.LinId(key)]++;
+
+		// All the points of a tile are visited before the next tile
+		if (tile_cnt == (size_t)Box<dim,long int>::getVolumeKey(it.getTile(act_tile).getKP1().get_k(),it.getTile(act_tile).getKP2().get_k()))
+		{
+			act_tile++;
+			tile_cnt = 0;
+		}
+
+		Point<dim,long int> p;
+		for (size_t i = 0 ; i < dim ; i++)
+		{p.get(i) = key.get(i);}
+
+		in_tile &= it.getTile(act_tile).isInside(p);
+
+		tile_cnt++;
+		cnt++;
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(in_tile,true);
+	BOOST_REQUIRE_EQUAL(act_tile + 1,it.getNTiles());
+
+	// every point inside start-stop is visited once
+	bool ret = true;
+	size_t vol = 1;
+	for (size_t i = 0 ; i < dim ; i++)
+	{vol *= stop.get(i) - start.get(i) + 1;}
+
+	grid_key_dx_iterator<dim> it_all(g_sm);
+	while (it_all.isNext())
+	{
+		auto key = it_all.get();
+
+		bool inside = true;
+		for (size_t i = 0 ; i < dim ; i++)
+		{inside &= key.get(i) >= start.get(i) && key.get(i) <= stop.get(i);}
+
+		ret &= visited[g_sm.LinId(key)] == ((inside == true)?1:0);
+
+		++it_all;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(cnt,vol);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_sub_tiled )
+{
+	size_t sz3[] = {37,29,41};
+	size_t tile3[] = {8,8,8};
+	size_t tile3_nd[] = {5,7,3};
+
+	grid_key_dx<3> start3({1,2,3});
+	grid_key_dx<3> stop3({35,26,40});
+
+	test_tiled_iterator<3>(sz3,start3,stop3,tile3,TILED_ORDER_LEX);
+	test_tiled_iterator<3>(sz3,start3,stop3,tile3,TILED_ORDER_MORTON);
+	test_tiled_iterator<3>(sz3,start3,stop3,tile3_nd,TILED_ORDER_MORTON);
+
+	size_t sz2[] = {64,33};
+	size_t tile2[] = {16,4};
+
+	grid_key_dx<2> start2({0,0});
+	grid_key_dx<2> stop2({63,32});
+
+	test_tiled_iterator<2>(sz2,start2,stop2,tile2,TILED_ORDER_LEX);
+	test_tiled_iterator<2>(sz2,start2,stop2,tile2,TILED_ORDER_MORTON);
+
+	// Morton fall back to lexicographic in 4D
+	size_t sz4[] = {9,8,7,6};
+	size_t tile4[] = {4,4,4,4};
+
+	grid_key_dx<4> start4({0,1,0,1});
+	grid_key_dx<4> stop4({8,7,6,5});
+
+	test_tiled_iterator<4>(sz4,start4,stop4,tile4,TILED_ORDER_MORTON);
+
+	// The first tiles of a Morton traversal
+	grid_sm<2,void> g_sm(sz2);
+	grid_key_dx_iterator_sub_tiled<2> it(g_sm,start2,stop2,tile2,TILED_ORDER_MORTON);
+
+	BOOST_REQUIRE_EQUAL(it.getTile(0).getLow(0),0);
+	BOOST_REQUIRE_EQUAL(it.getTile(0).getLow(1),0);
+	BOOST_REQUIRE_EQUAL(it.getTile(1).getLow(0),16);
+	BOOST_REQUIRE_EQUAL(it.getTile(1).getLow(1),0);
+	BOOST_REQUIRE_EQUAL(it.getTile(2).getLow(0),0);
+	BOOST_REQUIRE_EQUAL(it.getTile(2).getLow(1),4);
+	BOOST_REQUIRE_EQUAL(it.getTile(3).getLow(0),16);
+	BOOST_REQUIRE_EQUAL(it.getTile(3).getLow(1),4);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_sub_tiled_stencil )
+{
+	size_t sz[] = {52,52,52};
+	grid_sm<3,void> g_sm(sz);
+
+	grid_cpu<3,aggregate<long int>> gtest(sz);
+	gtest.setMemory();
+	auto it = gtest.getSubIterator(0);
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		gtest.get<0>(key) = key.get(0) + key.get(1) + key.get(2);
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({50,50,50});
+
+	for (size_t order = TILED_ORDER_LEX ; order <= TILED_ORDER_MORTON ; order++)
+	{
+		bool ret = true;
+		size_t cnt = 0;
+
+		//! [tiled stencil iterator]
+
+		size_t tile[] = {16,8,8};
+		auto gsi = gtest.getIteratorStencilTiled(start,stop,star_stencil_3D,tile,order);
+
+		while (gsi.isNext() == true)
+		{
+			auto key = gsi.get();
+
+			size_t lin1 = gsi.getStencil<0>();
+			size_t lin2 = gsi.getStencil<1>();
+			size_t lin3 = gsi.getStencil<2>();
+			size_t lin4 = gsi.getStencil<3>();
+			size_t lin5 = gsi.getStencil<4>();
+			size_t lin6 = gsi.getStencil<5>();
+			size_t lin7 = gsi.getStencil<6>();
+
+			size_t sum = 6*gtest.get<0>(lin1) -
+						 gtest.get<0>(lin2) -
+						 gtest.get<0>(lin3) -
+						 gtest.get<0>(lin4) -
+						 gtest.get<0>(lin5) -
+						 gtest.get<0>(lin6) -
+						 gtest.get<0>(lin7);
+
+			ret &= (sum == 0);
+
+			ret &= g_sm.LinId(key) == lin1;
+			cnt++;
+
+			++gsi;
+		}
+
+		//! [tiled stencil iterator]
+
+		BOOST_REQUIRE_EQUAL(ret,true);
+		BOOST_REQUIRE_EQUAL(cnt,50ul*50ul*50ul);
+	}
+}
+
+template<typename it_type, unsigned int dim>
+void test_split_iterator(const it_type & it, grid_sm<dim,void> & g_sm, size_t vol, size_t n)
+{
+	std::vector<size_t> visited(g_sm.size(),0);
+	size_t cnt = 0;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		auto it_p = it.split(i,n);
+
+		while (it_p.isNext())
+		{
+			visited[g_sm.LinId(it_p.get())]++;
+			cnt++;
+
+			++it_p;
+		}
+	}
+
+	bool ret = true;
+	for (size_t i = 0 ; i < visited.size() ; i++)
+	{ret &= visited[i] <= 1;}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(cnt,vol);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_split )
+{
+	size_t sz[] = {13,11,9};
+	grid_sm<3,void> g_sm(sz);
+
+	grid_key_dx<3> start({1,2,3});
+	grid_key_dx<3> stop({12,8,7});
+	size_t tile[] = {4,4,4};
+
+	grid_key_dx_iterator<3> it(g_sm);
+	grid_key_dx_iterator_sub<3> it_sub(g_sm,start,stop);
+	grid_key_dx_iterator_sub_tiled<3> it_tiled(g_sm,start,stop,tile,TILED_ORDER_MORTON);
+
+	size_t n_parts[] = {1,2,3,4,7,100};
+
+	for (size_t j = 0 ; j < sizeof(n_parts)/sizeof(size_t) ; j++)
+	{
+		test_split_iterator(it,g_sm,13*11*9,n_parts[j]);
+		test_split_iterator(it_sub,g_sm,12*7*5,n_parts[j]);
+		test_split_iterator(it_tiled,g_sm,12*7*5,n_parts[j]);
+	}
+
+	// balanced parts
+	auto it_p0 = it.split(0,4);
+	auto it_p3 = it.split(3,4);
+
+	BOOST_REQUIRE_EQUAL(it_p0.getStop().get(2) - it_p0.getStart().get(2) + 1,3);
+	BOOST_REQUIRE_EQUAL(it_p3.getStop().get(2) - it_p3.getStart().get(2) + 1,2);
+
+	// with a stencil every part has the stencil offsets of its points
+	grid_key_dx<3> start_s({1,1,1});
+	grid_key_dx<3> stop_s({11,9,7});
+	grid_key_dx_iterator_sub<3,stencil_offset_compute<3,7>> it_st(g_sm,start_s,stop_s,star_stencil_3D);
+
+	bool ret = true;
+	for (size_t i = 0 ; i < 3 ; i++)
+	{
+		auto it_p = it_st.split(i,3);
+
+		while (it_p.isNext())
+		{
+			auto key = it_p.get();
+
+			ret &= it_p.getStencil<0>() == g_sm.LinId(key);
+			ret &= it_p.getStencil<1>() == g_sm.LinId(key) - g_sm.size_s(1);
+			ret &= it_p.getStencil<6>() == g_sm.LinId(key) + 1;
+
+			++it_p;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_parallel_for_each )
+{
+	size_t old_thr = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	size_t sz[] = {64,32,16};
+	grid_cpu<3,aggregate<size_t>> g(sz);
+	g.setMemory();
+
+	auto & gs = g.getGrid();
+
+	openfpm::parallel_for_each(g.getIterator(),[&](const grid_key_dx<3> & key)
+	{
+		g.template get<0>(key) = gs.LinId(key);
+	});
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({62,30,14});
+
+	openfpm::parallel_for_each(g.getSubIterator(start,stop),[&](const grid_key_dx<3> & key)
+	{
+		g.template get<0>(key) += 1;
+	});
+
+	bool ret = true;
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		bool inside = key.get(0) >= 1 && key.get(0) <= 62 &&
+				      key.get(1) >= 1 && key.get(1) <= 30 &&
+					  key.get(2) >= 1 && key.get(2) <= 14;
+
+		ret &= g.template get<0>(key) == gs.LinId(key) + ((inside == true)?1:0);
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	openfpm::set_num_threads(old_thr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -10,6 +10,63 @@
 
 #include "Grid/grid_sm.hpp"
 #include "stencil_type.hpp"
+#include "util/thread_pool.hpp"
+
+/*! \brief Restrict the box start-stop to the part i of n
+ *
+ * It is used to split an iterator in balanced parts (one for each thread). The box is cut
+ * along the slowest dimension that has at least n points, if no dimension has n points it is
+ * cut along the dimension with most points (and some parts are empty)
+ *
+ * \param start start point of the box (in) start point of the part i (out)
+ * \param stop stop point of the box (in) stop point of the part i (out)
+ * \param i part
+ * \param n number of parts
+ *
+ * \return false if the part i is empty
+ *
+ */
+template<unsigned int dim>
+inline bool grid_iterator_split_box(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, size_t i, size_t n)
+{
+	for (size_t d = 0 ; d < dim ; d++)
+	{
+		if (stop.get(d) < start.get(d))
+		{return false;}
+	}
+
+	long int sd = dim-1;
+	size_t ext_max = 0;
+
+	for (long int d = dim-1 ; d >= 0 ; d--)
+	{
+		size_t ext = stop.get(d) - start.get(d) + 1;
+
+		if (ext >= n)
+		{
+			sd = d;
+			break;
+		}
+
+		if (ext > ext_max)
+		{
+			sd = d;
+			ext_max = ext;
+		}
+	}
+
+	size_t b_start;
+	size_t b_stop;
+	openfpm::parallel_block_range(0,stop.get(sd) - start.get(sd) + 1,n,i,b_start,b_stop);
+
+	if (b_start == b_stop)
+	{return false;}
+
+	stop.set_d(sd,start.get(sd) + b_stop - 1);
+	start.set_d(sd,start.get(sd) + b_start);
+
+	return true;
+}
 
 /**
  *
@@ -359,6 +416,45 @@ public:
 		return Box<dim,long int>::getVolumeKey(getStart().k, getStop().k);
 	}
 
+	/*! \brief Split the iteration in n balanced parts and return the part i
+	 *
+	 * The parts cover the full grid (independently from the actual position of this
+	 * iterator) and do not overlap, so n threads can iterate one part each
+	 *
+	 * \param i part
+	 * \param n number of parts
+	 *
+	 * \return an iterator over the part i (with the same stencil)
+	 *
+	 */
+	grid_key_dx_iterator_sub<dim,stencil,linearizer> split(size_t i, size_t n) const
+	{
+		grid_key_dx<dim> start;
+		grid_key_dx<dim> stop;
+
+		for (size_t d = 0 ; d < dim ; d++)
+		{
+			start.set_d(d,0);
+			stop.set_d(d,(long int)grid_base.size(d) - 1);
+		}
+
+		bool not_empty = grid_iterator_split_box(start,stop,i,n);
+
+		if (not_empty == false)
+		{stop = start;}
+
+		grid_key_dx_iterator_sub<dim,stencil,linearizer> it(grid_base,start,stop);
+
+		if (not_empty == false)
+		{it.invalidate();}
+
+		// same stencil points
+		static_cast<grid_key_dx_iterator<dim,stencil,linearizer> &>(it).stl_code = stl_code;
+		it.calc_stencil_offset(it.get());
+
+		return it;
+	}
+
 
 };
 
@@ -646,6 +646,39 @@ public:
 		this->stl_code.private_adjust(tot_add);
 	}
 
+	/*! \brief Split the iteration in n balanced parts and return the part i
+	 *
+	 * The parts cover the full box start-stop (independently from the actual position of this
+	 * iterator) and do not overlap, so n threads can iterate one part each
+	 *
+	 * \param i part
+	 * \param n number of parts
+	 *
+	 * \return an iterator over the part i (with the same stencil)
+	 *
+	 */
+	grid_key_dx_iterator_sub<dim,stencil,linearizer,warn> split(size_t i, size_t n) const
+	{
+		grid_key_dx<dim> start = gk_start;
+		grid_key_dx<dim> stop = gk_stop;
+
+		bool not_empty = grid_iterator_split_box(start,stop,i,n);
+
+		if (not_empty == false)
+		{stop = start;}
+
+		grid_key_dx_iterator_sub<dim,stencil,linearizer,warn> it(grid_base,start,stop);
+
+		if (not_empty == false)
+		{it.invalidate();}
+
+		// same stencil points
+		it.stl_code = this->stl_code;
+		it.calc_stencil_offset(it.gk);
+
+		return it;
+	}
+
 	/* \brief Set the iterator in a way that isNext return false
 	 *
 	 */
@@ -0,0 +1,329 @@
+#ifndef OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_SUB_TILED_HPP_
+#define OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_SUB_TILED_HPP_
+
+#include <algorithm>
+#include <vector>
+#include "grid_key_dx_iterator_sub.hpp"
+#include "Grid/grid_zm.hpp"
+
+//! The tiles are visited in lexicographic order
+#define TILED_ORDER_LEX 0
+
+//! The tiles are visited along a Morton (Z) curve
+#define TILED_ORDER_MORTON 1
+
+/*! \brief Linearize the coordinate of a tile in the tile grid
+ *
+ * The Morton linearization (grid_zm) is available up to 3 dimensions, in higher
+ * dimension the tiles are always visited in lexicographic order
+ *
+ * \tparam dim dimensionality
+ * \tparam is_zm true if grid_zm can linearize dim dimensions
+ *
+ */
+template<unsigned int dim, bool is_zm = (dim <= 3)>
+struct tiled_order_lin
+{
+	/*! \brief Linearize the tile coordinate
+	 *
+	 * \param g_tiles grid of tiles
+	 * \param key tile coordinate
+	 * \param order TILED_ORDER_LEX or TILED_ORDER_MORTON
+	 *
+	 * \return the position of the tile in the visiting order
+	 *
+	 */
+	static size_t lin(const grid_sm<dim,void> & g_tiles, const grid_key_dx<dim> & key, size_t order)
+	{
+		if (order == TILED_ORDER_MORTON)
+		{
+			grid_zm<dim,void> g_zm(g_tiles.getSize());
+			return g_zm.LinId(key);
+		}
+
+		return g_tiles.LinId(key);
+	}
+};
+
+template<unsigned int dim>
+struct tiled_order_lin<dim,false>
+{
+	static size_t lin(const grid_sm<dim,void> & g_tiles, const grid_key_dx<dim> & key, size_t order)
+	{
+		return g_tiles.LinId(key);
+	}
+};
+
+/*! \brief Iterate a sub-grid tile by tile (cache blocking)
+ *
+ * The box between start and stop is divided in tiles, the points inside one tile
+ * are visited in lexicographic order (like grid_key_dx_iterator_sub) and all the
+ * points of a tile are visited before moving to the next tile. The tiles are visited in
+ * lexicographic or Morton order. With a stencil the neighborhood of the points of a tile
+ * stay in cache, while a plain lexicographic iteration on a big grid evicts the
+ * neighboring planes before they are reused.
+ *
+ * The interface is the same of grid_key_dx_iterator_sub (isNext() get() ++ getStencil<id>())
+ *
+ * ### Tiled stencil iteration
+ * \snippet grid_iterators_unit_tests.cpp tiled stencil iterator
+ *
+ * \tparam dim dimensionality
+ * \tparam stencil stencil type
+ * \tparam linearizer linearizer
+ * \tparam warn print warning on adjustment
+ *
+ */
+template<unsigned int dim, typename stencil=no_stencil, typename linearizer = grid_sm<dim,void>, typename warn=print_warning_on_adjustment<dim,linearizer>>
+class grid_key_dx_iterator_sub_tiled : public grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>
+{
+	//! actual tile
+	size_t act;
+
+	//! tiles in visiting order
+	std::vector<Box<dim,long int>> tiles;
+
+	//! size of the tiles
+	size_t tile_sz[dim];
+
+	//! order in which the tiles are visited
+	size_t order;
+
+	//! start point of the tiled box
+	grid_key_dx<dim> t_start;
+
+	//! stop point of the tiled box
+	grid_key_dx<dim> t_stop;
+
+	/*! \brief Divide the box in tiles
+	 *
+	 * \param start starting point
+	 * \param stop stop point
+	 * \param tile size of the tile in each direction
+	 * \param order TILED_ORDER_LEX or TILED_ORDER_MORTON
+	 *
+	 */
+	void create_tiles(const grid_key_dx<dim> & start,
+			          const grid_key_dx<dim> & stop,
+					  const size_t (& tile)[dim],
+					  size_t order)
+	{
+		tiles.clear();
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{tile_sz[i] = tile[i];}
+		this->order = order;
+		t_start = start;
+		t_stop = stop;
+
+		size_t n_tiles[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if (stop.get(i) < start.get(i))
+			{return;}
+
+			if (tile[i] == 0)
+			{
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " tile size must be bigger than zero" << std::endl;
+				return;
+			}
+
+			n_tiles[i] = (stop.get(i) - start.get(i) + tile[i]) / tile[i];
+		}
+
+		grid_sm<dim,void> g_tiles(n_tiles);
+		grid_key_dx_iterator<dim> it(g_tiles);
+
+		std::vector<std::pair<size_t,Box<dim,long int>>> tl;
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			Box<dim,long int> bt;
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				bt.setLow(i,start.get(i) + key.get(i)*tile[i]);
+				bt.setHigh(i,std::min((long int)(start.get(i) + (key.get(i)+1)*tile[i] - 1),stop.get(i)));
+			}
+
+			tl.push_back(std::pair<size_t,Box<dim,long int>>(tiled_order_lin<dim>::lin(g_tiles,key,order),bt));
+
+			++it;
+		}
+
+		if (order == TILED_ORDER_MORTON)
+		{
+			std::sort(tl.begin(),tl.end(),[](const std::pair<size_t,Box<dim,long int>> & a, const std::pair<size_t,Box<dim,long int>> & b)
+					                      {return a.first < b.first;});
+		}
+
+		tiles.resize(tl.size());
+		for (size_t i = 0 ; i < tl.size() ; i++)
+		{tiles[i] = tl[i].second;}
+	}
+
+	/*! \brief Start the iteration on the actual tile
+	 *
+	 * \param g grid information
+	 *
+	 */
+	void start_tile(const linearizer & g)
+	{
+		if (act < tiles.size())
+		{grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>::reinitialize(grid_key_dx_iterator_sub<dim>(g,tiles[act].getKP1(),tiles[act].getKP2()));}
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param g Grid information
+	 * \param start starting point
+	 * \param stop stop point
+	 * \param tile size of the tile in each direction
+	 * \param order TILED_ORDER_LEX (default) or TILED_ORDER_MORTON
+	 *
+	 */
+	grid_key_dx_iterator_sub_tiled(const linearizer & g,
+								   const grid_key_dx<dim> & start,
+								   const grid_key_dx<dim> & stop,
+								   const size_t (& tile)[dim],
+								   size_t order = TILED_ORDER_LEX)
+	:grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>(g,start,stop),act(0)
+	{
+		// start and stop cropped by the sub-iterator
+		create_tiles(this->getStart(),this->getStop(),tile,order);
+		start_tile(g);
+	}
+
+	/*! \brief Constructor with stencil
+	 *
+	 * \param g Grid information
+	 * \param start starting point
+	 * \param stop stop point
+	 * \param stencil_pnt stencil points
+	 * \param tile size of the tile in each direction
+	 * \param order TILED_ORDER_LEX (default) or TILED_ORDER_MORTON
+	 *
+	 */
+	grid_key_dx_iterator_sub_tiled(const linearizer & g,
+								   const grid_key_dx<dim> & start,
+								   const grid_key_dx<dim> & stop,
+								   const grid_key_dx<dim> (& stencil_pnt)[stencil::nsp],
+								   const size_t (& tile)[dim],
+								   size_t order = TILED_ORDER_LEX)
+	:grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>(g,start,stop,stencil_pnt),act(0)
+	{
+		// start and stop cropped by the sub-iterator
+		create_tiles(this->getStart(),this->getStop(),tile,order);
+		start_tile(g);
+	}
+
+	/*! \brief Get the next element
+	 *
+	 * \return the next grid_key
+	 *
+	 */
+	inline grid_key_dx_iterator_sub_tiled<dim,stencil,linearizer,warn> & operator++()
+	{
+		grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>::operator++();
+
+		// when the tile is finished we move to the next one, after the last tile
+		// the sub-iterator is left at the end so isNext() is the one of the sub-iterator
+		if (grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>::isNext() == false && act + 1 < tiles.size())
+		{
+			act++;
+			start_tile(this->getGridInfo());
+		}
+
+		return *this;
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next, false otherwise
+	 *
+	 */
+	inline bool isNext()
+	{
+		return tiles.size() != 0 && grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>::isNext();
+	}
+
+	/*! \brief Return the actual grid key iterator
+	 *
+	 * \return the actual key
+	 *
+	 */
+	inline grid_key_dx<dim> get() const
+	{
+		return grid_key_dx_iterator_sub<dim,stencil,linearizer,warn>::get();
+	}
+
+	/*! \brief Get the number of tiles
+	 *
+	 * \return the number of tiles
+	 *
+	 */
+	inline size_t getNTiles() const
+	{
+		return tiles.size();
+	}
+
+	/*! \brief Get the tile i (in visiting order)
+	 *
+	 * \param i tile
+	 *
+	 * \return the box of the tile
+	 *
+	 */
+	inline const Box<dim,long int> & getTile(size_t i) const
+	{
+		return tiles[i];
+	}
+
+	/*! \brief Split the iteration in n balanced parts and return the part i
+	 *
+	 * The part i is iterated tile by tile with the same tile size and order
+	 *
+	 * \param i part
+	 * \param n number of parts
+	 *
+	 * \return a tiled iterator over the part i (with the same stencil)
+	 *
+	 */
+	grid_key_dx_iterator_sub_tiled<dim,stencil,linearizer,warn> split(size_t i, size_t n) const
+	{
+		grid_key_dx_iterator_sub_tiled<dim,stencil,linearizer,warn> it(*this);
+
+		grid_key_dx<dim> start = t_start;
+		grid_key_dx<dim> stop = t_stop;
+
+		it.act = 0;
+
+		if (grid_iterator_split_box(start,stop,i,n) == false)
+		{
+			it.tiles.clear();
+			return it;
+		}
+
+		it.create_tiles(start,stop,tile_sz,order);
+		it.start_tile(this->getGridInfo());
+
+		return it;
+	}
+
+	/*! \brief Reset the iterator (it restart from the beginning)
+	 *
+	 */
+	inline void reset()
+	{
+		act = 0;
+		start_tile(this->getGridInfo());
+	}
+};
+
+
+#endif /* OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_SUB_TILED_HPP_ */
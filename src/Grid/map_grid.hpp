@@ -46,6 +46,7 @@
 #include "iterators/grid_key_dx_iterator.hpp"
 #include "iterators/grid_key_dx_iterator_sub.hpp"
 #include "iterators/grid_key_dx_iterator_sp.hpp"
+#include "iterators/grid_key_dx_iterator_sub_tiled.hpp"
 #include "iterators/grid_key_dx_iterator_sub_bc.hpp"
 #include "Packer_Unpacker/Packer_util.hpp"
 #include "Packer_Unpacker/has_pack_agg.hpp"
@@ -964,11 +965,296 @@ public:
 	}
 };
 
+/*! \brief This is an N-dimensional grid or an N-dimensional array with memory_traits_aosoa layout
+ *
+ * The elements (in linearized order) are grouped in tiles of W elements, inside a tile
+ * each property is stored as an array of W values
+ *
+ *	\tparam dim Dimensionality of the grid
+ *	\tparam T type of object the grid store
+ *	\tparam S type of memory HeapMemory CudaMemory
+ *	\tparam W number of elements in a tile
+ *
+ * ### Grid with AoSoA layout and access by tile
+ * \snippet memory_conf_unit_tests.cpp Grid with AoSoA layout
+ *
+ */
+template<unsigned int dim, typename T, typename S, unsigned int W, typename linearizer>
+class grid_base<dim,T,S,memory_aosoa<T,W>, linearizer> : public grid_base_impl<dim,T,S, memory_traits_aosoa_tile<W>::template layout,linearizer>
+{
+	//! base implementation
+	typedef grid_base_impl<dim,T,S, memory_traits_aosoa_tile<W>::template layout,linearizer> base_impl;
+
+	T background;
+
+public:
+
+	//! type of layout of the structure
+	typedef memory_aosoa<T,W> layout;
+
+	//! Object container for T, it is the return type of get_o it return a object type trough
+	// you can access all the properties of T
+	typedef typename base_impl::container container;
+
+	//! grid_base has no grow policy
+	typedef void grow_policy;
+
+	//! type that identify one point in the grid
+	typedef grid_key_dx<dim> base_key;
+
+	//! sub-grid iterator type
+	typedef grid_key_dx_iterator_sub<dim> sub_grid_iterator_type;
+
+	//! linearizer type Z-morton Hilbert curve , normal striding
+	typedef typename base_impl::linearizer_type linearizer_type;
+
+	//! Default constructor
+	inline grid_base() THROW
+	:base_impl()
+	{}
+
+	/*! \brief create a grid from another grid
+	 *
+	 * \param g the grid to copy
+	 *
+	 */
+	inline grid_base(const grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & g) THROW
+	:base_impl(g)
+	{
+	}
+
+	/*! \brief create a grid of size sz on each direction
+	 *
+	 * \param sz size if the grid on each directions
+	 *
+	 */
+	inline grid_base(const size_t & sz) THROW
+	:base_impl(sz)
+	{
+	}
+
+	/*! \brief Constructor allocate memory
+	 *
+	 * \param sz size of the grid in each dimension
+	 *
+	 */
+	inline grid_base(const size_t (& sz)[dim]) THROW
+	:base_impl(sz)
+	{
+	}
+
+	/*! \brief It copy a grid
+	 *
+	 * \param g grid to copy
+	 *
+	 */
+	grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & operator=(const grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & g)
+	{
+		(static_cast<base_impl *>(this))->swap(g.duplicate());
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
+	/*! \brief It copy a grid
+	 *
+	 * \param g grid to copy
+	 *
+	 */
+	grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & operator=(grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> && g)
+	{
+		(static_cast<base_impl *>(this))->swap(g);
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
+	/*! \brief This structure has pointers
+	 *
+	 * \return false
+	 *
+	 */
+	static bool noPointers()
+	{
+		return false;
+	}
+
+	/*! \brief Copy the memory from host to device
+	 *
+	 * \tparam (all properties are copied to prp is useless in this case)
+	 *
+	 */
+	template<unsigned int ... prp> void hostToDevice()
+	{
+		this->data_.mem->hostToDevice();
+	}
+
+	/*! \brief Synchronize the memory buffer in the device with the memory in the host
+	 *
+	 * \tparam ingored
+	 *
+	 */
+	template<unsigned int ... prp> void deviceToHost()
+	{
+		this->data_.mem->deviceToHost();
+	}
+
+	/*! \brief Number of elements in a tile
+	 *
+	 * \return the tile width
+	 *
+	 */
+	static constexpr unsigned int tileSize()
+	{
+		return W;
+	}
+
+	/*! \brief Number of tiles used to store the grid
+	 *
+	 * The last tile can be partially filled
+	 *
+	 * \return the number of tiles
+	 *
+	 */
+	size_t size_tiles() const
+	{
+		return this->data_.mem_r.size_tiles();
+	}
+
+	/*! \brief Return the property p of the tile t
+	 *
+	 * For a scalar property it is an array of W elements (T[W]), for an array property T[N1]
+	 * it is T[N1][W]. The W values are contiguous, so they can be loaded with
+	 * vector instructions (for example Vc::float_v(&getTile<p>(t)[0],Vc::Unaligned)
+	 * with W multiple of Vc::float_v::Size)
+	 *
+	 * \tparam p property
+	 *
+	 * \param t tile
+	 *
+	 * \return the property of the tile
+	 *
+	 */
+	template<unsigned int p>
+	inline auto getTile(size_t t) -> decltype(boost::fusion::at_c<p>(this->data_.mem_r.getTile(t)))
+	{
+		return boost::fusion::at_c<p>(this->data_.mem_r.getTile(t));
+	}
+
+	/*! \brief Return the property p of the tile t
+	 *
+	 * \tparam p property
+	 *
+	 * \param t tile
+	 *
+	 * \return the property of the tile
+	 *
+	 */
+	template<unsigned int p>
+	inline auto getTile(size_t t) const -> decltype(boost::fusion::at_c<p>(this->data_.mem_r.getTile(t)))
+	{
+		return boost::fusion::at_c<p>(this->data_.mem_r.getTile(t));
+	}
+
+	/*! \brief This is a meta-function return which type of sub iterator a grid produce
+	 *
+	 * \return the type of the sub-grid iterator
+	 *
+	 */
+	template <typename stencil = no_stencil>
+	static grid_key_dx_iterator_sub<dim, stencil> type_of_subiterator()
+	{
+		return grid_key_dx_iterator_sub<dim, stencil>();
+	}
+
+	/*! \brief Return if in this representation data are stored is a compressed way
+	 *
+	 * \return false this is a normal grid no compression
+	 *
+	 */
+	static constexpr bool isCompressed()
+	{
+		return false;
+	}
+
+	/*! \brief This is a meta-function return which type of iterator a grid produce
+	 *
+	 * \return the type of the sub-grid iterator
+	 *
+	 */
+	static grid_key_dx_iterator<dim> type_of_iterator()
+	{
+		return grid_key_dx_iterator<dim>();
+	}
+
+	/*! \brief In this case it just copy the key_in in key_out
+	 *
+	 * \param key_out output key
+	 * \param key_in input key
+	 *
+	 */
+	void convert_key(grid_key_dx<dim> & key_out, const grid_key_dx<dim> & key_in) const
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{key_out.set_d(i,key_in.get(i));}
+	}
+
+	/*! \brief Get the background value
+	 *
+	 * For dense grid this function is useless
+	 *
+	 * \return background value
+	 *
+	 */
+	T & getBackgroundValue()
+	{
+		return background;
+	}
+
+	/*! \brief Get the background value
+	 *
+	 * For dense grid this function is useless
+	 *
+	 * \return background value
+	 *
+	 */
+	T & getBackgroundValueAggr()
+	{
+		return background;
+	}
+
+	/*! \brief assign operator
+	 *
+	 * \return itself
+	 *
+	 */
+	grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & operator=(const base_impl & base)
+	{
+		base_impl::operator=(base);
+
+		return *this;
+	}
+
+	/*! \brief assign operator
+	 *
+	 * \return itself
+	 *
+	 */
+	grid_base<dim,T,S,memory_aosoa<T,W>,linearizer> & operator=(base_impl && base)
+	{
+		base_impl::operator=((base_impl &&)base);
+
+		return *this;
+	}
+};
+
 //! short formula for a grid on gpu
 template <unsigned int dim, typename T, typename linearizer = grid_sm<dim,void> > using grid_gpu = grid_base<dim,T,CudaMemory,typename memory_traits_inte<T>::type>;
 
-//! short formula for a grid on gpu
-template <unsigned int dim, typename T, typename linearizer = grid_sm<dim,void> > using grid_cpu = grid_base<dim,T,HeapMemory,typename memory_traits_lin<T>::type,linearizer>;
+//! short formula for a grid on cpu (S can be any host memory like HeapMemory or NumaHeapMemory)
+template <unsigned int dim, typename T, typename linearizer = grid_sm<dim,void>, typename S = HeapMemory > using grid_cpu = grid_base<dim,T,S,typename memory_traits_lin<T>::type,linearizer>;
 
 
 #endif
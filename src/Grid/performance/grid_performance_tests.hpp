@@ -195,6 +195,169 @@ BOOST_AUTO_TEST_CASE(grid_performance_duplicate)
 	report_grid_funcs.graphs.put("performance.grid.set(3).y.data.dev",dev);
 }
 
+/*! \brief Measure copy_to of a large box with a given number of threads
+ *
+ * \param n_thr number of threads
+ * \param id id of the set in the report
+ * \param name name of the measure in the report
+ *
+ */
+void grid_performance_copy_to_measure(size_t n_thr, size_t id, const std::string & name)
+{
+	size_t sz[] = {256,256,256};
+
+	std::string base = std::string("performance.grid.set(") + std::to_string(id) + ")";
+
+	report_grid_funcs.graphs.put(base + ".grid.x",sz[0]);
+	report_grid_funcs.graphs.put(base + ".grid.y",sz[1]);
+	report_grid_funcs.graphs.put(base + ".grid.z",sz[2]);
+
+	grid_cpu<3, Point_test<float> > c3(sz);
+	c3.setMemory();
+	grid_cpu<3, Point_test<float> > c1(sz);
+	c1.setMemory();
+
+	fill_grid<3>(c3);
+
+	Box<3,size_t> box_src({1,1,1},{254,254,254});
+	Box<3,size_t> box_dst({0,0,0},{253,253,253});
+
+	size_t old_thr = openfpm::get_num_threads();
+	openfpm::set_num_threads(n_thr);
+
+	std::vector<double> times(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		c1.copy_to(c3,box_src,box_dst);
+
+		t.stop();
+
+		times[i] = t.getwct();
+	}
+
+	openfpm::set_num_threads(old_thr);
+
+	double mean;
+	double dev;
+	standard_deviation(times,mean,dev);
+
+	report_grid_funcs.graphs.put(base + ".x.data.name",name);
+	report_grid_funcs.graphs.put(base + ".y.data.mean",mean);
+	report_grid_funcs.graphs.put(base + ".y.data.dev",dev);
+}
+
+BOOST_AUTO_TEST_CASE(grid_performance_copy_to)
+{
+	grid_performance_copy_to_measure(1,4,"Grid_copy_to_1");
+	grid_performance_copy_to_measure(openfpm::get_num_threads(),5,"Grid_copy_to_N");
+}
+
+/*! \brief Measure a 7-point stencil with the plain sub-iterator or the tiled iterator
+ *
+ * \param get_it function that return the iterator over the internal points of the grid
+ * \param g source grid
+ * \param g_out destination grid
+ * \param id id of the set in the report
+ * \param name name of the measure in the report
+ *
+ */
+template<typename get_it_type, typename grid_type>
+void grid_performance_stencil_measure(get_it_type get_it, grid_type & g, grid_type & g_out, size_t id, const std::string & name)
+{
+	std::string base = std::string("performance.grid.set(") + std::to_string(id) + ")";
+
+	report_grid_funcs.graphs.put(base + ".grid.x",g.getGrid().size(0));
+	report_grid_funcs.graphs.put(base + ".grid.y",g.getGrid().size(1));
+	report_grid_funcs.graphs.put(base + ".grid.z",g.getGrid().size(2));
+
+	std::vector<double> times(N_STAT_SMALL + 1);
+
+	for (size_t i = 0 ; i < N_STAT_SMALL+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		auto it = get_it();
+
+		while (it.isNext())
+		{
+			g_out.template get<0>(it.template getStencil<0>()) = g.template get<0>(it.template getStencil<1>()) +
+					                                             g.template get<0>(it.template getStencil<2>()) +
+																 g.template get<0>(it.template getStencil<3>()) +
+																 g.template get<0>(it.template getStencil<4>()) +
+																 g.template get<0>(it.template getStencil<5>()) +
+																 g.template get<0>(it.template getStencil<6>()) -
+																 6.0*g.template get<0>(it.template getStencil<0>());
+
+			++it;
+		}
+
+		t.stop();
+
+		times[i] = t.getwct();
+	}
+
+	double mean;
+	double dev;
+	standard_deviation(times,mean,dev);
+
+	report_grid_funcs.graphs.put(base + ".x.data.name",name);
+	report_grid_funcs.graphs.put(base + ".y.data.mean",mean);
+	report_grid_funcs.graphs.put(base + ".y.data.dev",dev);
+}
+
+BOOST_AUTO_TEST_CASE(grid_performance_stencil_tiled)
+{
+	size_t sz[] = {256,256,256};
+
+	grid_cpu<3, aggregate<double>> g(sz);
+	g.setMemory();
+	grid_cpu<3, aggregate<double>> g_out(sz);
+	g_out.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + key.get(1) + key.get(2);
+		g_out.template get<0>(key) = 0.0;
+
+		++it;
+	}
+
+	grid_key_dx<3> star_stencil_3D[7] = {{0,0,0},
+	                                     {0,0,-1},
+										 {0,0,1},
+										 {0,-1,0},
+										 {0,1,0},
+										 {-1,0,0},
+										 {1,0,0}};
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({254,254,254});
+
+	auto get_it_plain = [&]()
+	{return grid_key_dx_iterator_sub<3,stencil_offset_compute<3,7>>(g.getGrid(),start,stop,star_stencil_3D);};
+	grid_performance_stencil_measure(get_it_plain,g,g_out,6,"Grid_stencil");
+
+	size_t tile[] = {256,16,16};
+
+	auto get_it_lex = [&]()
+	{return g.getIteratorStencilTiled(start,stop,star_stencil_3D,tile,TILED_ORDER_LEX);};
+	grid_performance_stencil_measure(get_it_lex,g,g_out,7,"Grid_stencil_tiled");
+
+	size_t tile_m[] = {32,32,32};
+
+	auto get_it_mor = [&]()
+	{return g.getIteratorStencilTiled(start,stop,star_stencil_3D,tile_m,TILED_ORDER_MORTON);};
+	grid_performance_stencil_measure(get_it_mor,g,g_out,8,"Grid_stencil_tiled_morton");
+}
+
 /////// THIS IS NOT A TEST IT WRITE THE PERFORMANCE RESULT ///////
 
 BOOST_AUTO_TEST_CASE(grid_performance_write_report)
@@ -202,7 +365,7 @@ BOOST_AUTO_TEST_CASE(grid_performance_write_report)
 	// Create a graphs
 
 	report_grid_funcs.graphs.put("graphs.graph(0).type","line");
-	report_grid_funcs.graphs.add("graphs.graph(0).title","Grid set functions (so/sog/soge) and duplicate (dup) performance");
+	report_grid_funcs.graphs.add("graphs.graph(0).title","Grid set functions (so/sog/soge), duplicate (dup), copy_to and stencil iteration performance");
 	report_grid_funcs.graphs.add("graphs.graph(0).x.title","Tests");
 	report_grid_funcs.graphs.add("graphs.graph(0).y.title","Time seconds");
 	report_grid_funcs.graphs.add("graphs.graph(0).y.data(0).source","performance.grid.set(#).y.data.mean");
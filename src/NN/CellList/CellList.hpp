@@ -22,10 +22,12 @@
 #include "ParticleIt_Cells.hpp"
 #include "ParticleItCRS_Cells.hpp"
 #include "util/common.hpp"
+#include "util/thread_pool.hpp"
 
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 #include "NN/CellList/NNc_array.hpp"
 #include "cuda/CellList_cpu_ker.cuh"
 
@@ -822,6 +824,37 @@ public:
 		addCell(cell_id,ele);
 	}
 
+	/*! \brief Fill the cell-list with all the particles using all the threads of the thread pool
+	 *
+	 * The result is the same of clear() followed by add(pos.get(i),i) for each particle in sequence.
+	 * In the symmetric case the particles below g_m are added with addDom and the others with addPad
+	 *
+	 * \warning available only for Mem_type that implement fill_parallel (Mem_fast)
+	 *
+	 * \param pos vector of positions
+	 * \param g_m ghost marker (used only in the symmetric case)
+	 * \param sym true for the symmetric construction
+	 *
+	 */
+	template<typename vector_pos_type2>
+	void fill_parallel(const vector_pos_type2 & pos, size_t g_m, bool sym)
+	{
+		openfpm::vector<typename Mem_type::local_index_type> cell_ids;
+		cell_ids.resize(pos.size());
+
+		openfpm::parallel_for(0,pos.size(),[&](size_t i)
+		{
+			Point<dim,T> xp(pos.get(i));
+
+			if (sym == true && i < g_m)
+			{cell_ids.get(i) = this->getCellDom(xp);}
+			else
+			{cell_ids.get(i) = this->getCell(xp);}
+		});
+
+		Mem_type::fill_parallel(cell_ids);
+	}
+
 	/*! \brief remove an element from the cell
 	 *
 	 * \param cell cell id
@@ -968,6 +1001,29 @@ public:
 
 	}
 
+	/*! \brief Get the neighborhood cells up to the radius r_cut
+	 *
+	 * They are calculated at the first call and cached, the next calls with the same radius only
+	 * read the cache and can be done concurrently by several threads
+	 *
+	 * \param r_cut radius
+	 *
+	 * \return the offsets of the neighborhood cells
+	 *
+	 */
+	const openfpm::vector<long int> & getNNc_rad(T r_cut)
+	{
+		auto it = rcache.find(r_cut);
+
+		if (it == rcache.end())
+		{
+			it = rcache.emplace(r_cut,openfpm::vector<long int>()).first;
+			NNcalc_rad(r_cut,it->second,this->getCellBox(),this->getGrid());
+		}
+
+		return it->second;
+	}
+
 	/*! \brief Get the symmetric Neighborhood iterator
 	 *
 	 * It iterate across all the element of the selected cell and the near cells up to some selected radius
@@ -981,12 +1037,7 @@ public:
 	template<unsigned int impl=NO_CHECK>
 	__attribute__((always_inline)) inline CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,impl> getNNIteratorRadius(size_t cell, T r_cut)
 	{
-		openfpm::vector<long int> & NNc = rcache[r_cut];
-
-		if (NNc.size() == 0)
-		{NNcalc_rad(r_cut,NNc,this->getCellBox(),this->getGrid());}
-
-		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,impl> cln(cell,NNc,*this);
+		CellNNIteratorRadius<dim,CellList<dim,T,Mem_type,transform,vector_pos_type>,impl> cln(cell,getNNc_rad(r_cut),*this);
 
 		return cln;
 	}
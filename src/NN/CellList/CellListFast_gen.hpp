@@ -11,7 +11,9 @@
 //#define HILBERT 1
 
 #include "CellList.hpp"
+#include "CellList_util.hpp"
 #include "ProcKeys.hpp"
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
 
 /* \brief Cell list implementation with particle iterator over cells
  *
@@ -122,6 +124,77 @@ public:
 		}
 	}
 
+	/*! \brief Reorder the particles along the space filling curve and rebuild the Cell-list
+	 *
+	 * The particles below g_m are sorted (stable) by the position of their cell along the curve
+	 * selected by Prock (cells outside the curve, like the padding cells, follow in linear order),
+	 * the particles after g_m are not moved. The same permutation is applied to the positions and
+	 * to the properties, then the Cell-list is filled again with all the particles (non symmetric).
+	 * After this call the particles of a cell and of the cells close along the curve are contiguous
+	 * in memory
+	 *
+	 * \param pos vector of positions
+	 * \param prp vector of properties
+	 * \param perm the permutation applied, the particle i is the old particle perm.get(i) (output)
+	 * \param g_m ghost marker, by default all the particles are reordered
+	 *
+	 */
+	template<typename vector_pos_type2, typename vector_prp_type>
+	void reorder_sfc(vector_pos_type2 & pos, vector_prp_type & prp, openfpm::vector<size_t> & perm, size_t g_m = (size_t)-1)
+	{
+		if (g_m > pos.size())
+		{g_m = pos.size();}
+
+		init_SFC();
+
+		// rank of each cell along the curve
+
+		const openfpm::vector<size_t> & keys = SFC.getKeys();
+		std::vector<size_t> rank(this->getGrid().size());
+
+		openfpm::parallel_for(0,rank.size(),[&](size_t c)
+		{
+			rank[c] = keys.size() + c;
+		});
+
+		openfpm::parallel_for(0,keys.size(),[&](size_t i)
+		{
+			rank[keys.get(i)] = i;
+		});
+
+		// sort the particles by the rank of their cell
+
+		std::vector<size_t> cell_rank(g_m);
+		perm.resize(pos.size());
+		size_t * pr = (size_t *)perm.getPointer();
+
+		openfpm::parallel_for(0,pos.size(),[&](size_t i)
+		{
+			if (i < g_m)
+			{
+				Point<dim,T> xp(pos.get(i));
+				cell_rank[i] = rank[this->getCell(xp)];
+			}
+
+			pr[i] = i;
+		});
+
+		openfpm::sort_cpu(cell_rank.data(),pr,g_m,std::less<size_t>());
+
+		pos.reorder(perm);
+		prp.reorder(perm);
+
+		// rebuild the Cell-list
+
+		if (populate_cell_list_parallel<has_fill_parallel<CellList_gen<dim,T,Prock,Mem_type,transform,vector_pos_type>>::value>::populate(pos,*this,g_m,false) == true)
+		{return;}
+
+		this->clear();
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{this->add(pos.get(i),i);}
+	}
+
 	/*! \brief return the celllist iterator (across cells)
 	 *
 	 * \return an iterator
@@ -471,6 +471,122 @@ BOOST_AUTO_TEST_CASE( ParticleIt_Cells_iterator )
 	BOOST_REQUIRE_EQUAL(count,290ul);
 }
 
+/*! \brief Reorder the particles along the SFC of the Cell-list and check the result
+ *
+ * \tparam Prock space filling curve
+ *
+ */
+template<template <unsigned int, typename> class Prock>
+void celllist_gen_reorder_sfc_test()
+{
+	const size_t dim = 3;
+
+	size_t div[dim] = {7,5,6};
+
+	//Number of particles
+	size_t k = 10000;
+
+	Box<dim,float> box;
+
+	for (size_t i = 0; i < dim; i++)
+	{
+		box.setLow(i,0.0);
+		box.setHigh(i,1.0);
+	}
+
+	CellList_gen<dim,float,Prock> NN;
+
+	NN.Initialize(box,div,1);
+	NN.set_gm(k);
+
+	openfpm::vector<Point<dim,float>> pos;
+	openfpm::vector<aggregate<size_t,float>> prp;
+
+	for (size_t i = 0; i < k; i++)
+	{
+		Point<dim,float> p;
+
+		for (size_t j = 0; j < dim; j++)
+		{p.get(j) = rand()/double(RAND_MAX);}
+
+		pos.add(p);
+		prp.add();
+		prp.template get<0>(i) = i;
+		prp.template get<1>(i) = p.get(0);
+
+		NN.add(p,i);
+	}
+
+	openfpm::vector<Point<dim,float>> pos_old(pos);
+	openfpm::vector<size_t> perm;
+
+	NN.reorder_sfc(pos,prp,perm);
+
+	BOOST_REQUIRE_EQUAL(pos.size(),k);
+	BOOST_REQUIRE_EQUAL(perm.size(),k);
+
+	bool match = true;
+	for (size_t i = 0; i < k; i++)
+	{
+		size_t o = perm.get(i);
+
+		match &= prp.template get<0>(i) == o;
+		match &= prp.template get<1>(i) == pos_old.template get<0>(o)[0];
+
+		for (size_t j = 0; j < dim; j++)
+		{match &= pos.template get<0>(i)[j] == pos_old.template get<0>(o)[j];}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// The iterator across the cells must now visit the particles in memory order
+
+	auto it_cl = NN.getIterator();
+
+	size_t count = 0;
+
+	while (it_cl.isNext())
+	{
+		match &= it_cl.get() == count;
+
+		count++;
+		++it_cl;
+	}
+
+	BOOST_REQUIRE_EQUAL(count,k);
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( celllist_gen_reorder_sfc )
+{
+	celllist_gen_reorder_sfc_test<Process_keys_lin>();
+	celllist_gen_reorder_sfc_test<Process_keys_hilb>();
+	celllist_gen_reorder_sfc_test<Process_keys_morton>();
+
+	// with more threads the Cell-list is filled in parallel
+
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	celllist_gen_reorder_sfc_test<Process_keys_hilb>();
+	celllist_gen_reorder_sfc_test<Process_keys_morton>();
+
+	openfpm::set_num_threads(n_threads_old);
+
+	// Morton keys
+
+	size_t p[3] = {5,2,7};
+	size_t p2[3];
+
+	size_t key = Process_keys_morton<3,void>::encode(p,3);
+	Process_keys_morton<3,void>::decode(key,3,p2);
+
+	BOOST_REQUIRE_EQUAL(key,0x175ul);
+	BOOST_REQUIRE_EQUAL(p2[0],5ul);
+	BOOST_REQUIRE_EQUAL(p2[1],2ul);
+	BOOST_REQUIRE_EQUAL(p2[2],7ul);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTITERATOR_TEST_HPP_ */
@@ -7,6 +7,7 @@
 
 #include "CellList.hpp"
 #include "CellListM.hpp"
+#include "CellList_util.hpp"
 #include "Grid/grid_sm.hpp"
 
 #ifndef CELLLIST_TEST_HPP_
@@ -488,8 +489,76 @@ template<unsigned int dim, typename T, typename CellS> void Test_NN_iterator_rad
 	BOOST_REQUIRE(number_of_nn2 < number_of_nn);
 }
 
+/*! \brief Check that the parallel construction of the Cell-list produce the same
+ *         Cell-list of the sequential construction
+ *
+ * \param opt CL_NON_SYMMETRIC or CL_SYMMETRIC
+ * \param cluster fraction of particles concentrated in one cell
+ *
+ */
+template<unsigned int dim, typename T, typename CellS> void Test_cell_parallel_construct(size_t opt, float cluster)
+{
+	SpaceBox<dim,T> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	size_t div[dim] = {16,16,16};
+
+	openfpm::vector<Point<dim,T>> pos;
+
+	for (size_t j = 0 ; j < 100000 ; j++)
+	{
+		pos.add();
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if ((float)rand() / RAND_MAX < cluster)
+			{pos.template get<0>(j)[i] = 0.5;}
+			else
+			{pos.template get<0>(j)[i] = (T)rand() / RAND_MAX;}
+		}
+	}
+
+	size_t g_m = pos.size() / 2;
+
+	mgpu::ofp_context_t context(mgpu::gpu_context_opt::dummy);
+
+	CellS cl_seq(box,div);
+	CellS cl_par(box,div);
+
+	size_t n_threads = openfpm::get_num_threads();
+
+	openfpm::set_num_threads(1);
+	populate_cell_list(pos,cl_seq,context,g_m,opt,cl_construct_opt::Full);
+
+	openfpm::set_num_threads(4);
+	populate_cell_list(pos,cl_par,context,g_m,opt,cl_construct_opt::Full);
+
+	openfpm::set_num_threads(n_threads);
+
+	BOOST_REQUIRE_EQUAL(cl_seq.getNCells(),cl_par.getNCells());
+	BOOST_REQUIRE_EQUAL(cl_seq.private_get_cl_base().size(),cl_par.private_get_cl_base().size());
+
+	bool match = true;
+	for (size_t c = 0 ; c < cl_seq.getNCells() ; c++)
+	{
+		match &= cl_seq.getNelements(c) == cl_par.getNelements(c);
+
+		for (size_t j = 0 ; j < cl_seq.getNelements(c) && match == true ; j++)
+		{match &= cl_seq.get(c,j) == cl_par.get(c,j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
 BOOST_AUTO_TEST_SUITE( CellList_test )
 
+BOOST_AUTO_TEST_CASE( CellList_parallel_construct )
+{
+	Test_cell_parallel_construct<3,float,CellList<3,float,Mem_fast<>>>(CL_NON_SYMMETRIC,0.0);
+	Test_cell_parallel_construct<3,float,CellList<3,float,Mem_fast<>>>(CL_NON_SYMMETRIC,0.3);
+	Test_cell_parallel_construct<3,float,CellList<3,float,Mem_fast<HeapMemory,unsigned int>,shift<3,float>>>(CL_SYMMETRIC,0.0);
+	Test_cell_parallel_construct<3,float,CellList<3,float,Mem_fast<HeapMemory,unsigned int>,shift<3,float>>>(CL_SYMMETRIC,0.3);
+}
+
 BOOST_AUTO_TEST_CASE ( NN_radius_check )
 {
 	SpaceBox<2,float> box1({0.1,0.1},{0.3,0.5});
@@ -519,6 +588,7 @@ BOOST_AUTO_TEST_CASE( CellList_use)
 
 	Test_cell_s<3,double,CellList<3,double,Mem_bal<>>>(box);
 	Test_cell_s<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_csr<>>>(box);
 
 	std::cout << "End cell list" << "\n";
 
@@ -38,6 +38,72 @@ template<unsigned int dim, typename T, typename CellList> void populate_cell_lis
 }
 
 #include "Vector/map_vector.hpp"
+#include "util/thread_pool.hpp"
+
+//! Check if the memory type of the Cell-list can be filled in parallel (false)
+template<typename T, typename Sfinae = void>
+struct has_fill_parallel: std::false_type {};
+
+/*! \brief Check if the memory type of the Cell-list can be filled in parallel
+ *
+ * \tparam T Cell-list type
+ *
+ * return true if the Mem_type of the Cell-list define yes_has_fill_parallel
+ *
+ */
+template<typename T>
+struct has_fill_parallel<T, typename Void<typename T::Mem_type_type::yes_has_fill_parallel>::type> : std::true_type
+{};
+
+/*! \brief Fill a CPU Cell-list in parallel
+ *
+ * This is the case where the Cell-list does not support the parallel construction
+ *
+ */
+template<bool has_fill_parallel>
+struct populate_cell_list_parallel
+{
+	/*! \brief Fill the cell-list in parallel
+	 *
+	 * \return false, the Cell-list must be filled sequentially
+	 *
+	 */
+	template<typename vector_pos_type, typename CellList>
+	static bool populate(vector_pos_type & pos, CellList & cli, size_t g_m, bool sym)
+	{
+		return false;
+	}
+};
+
+/*! \brief Fill a CPU Cell-list in parallel
+ *
+ * This is the case where the Cell-list support the parallel construction
+ *
+ */
+template<>
+struct populate_cell_list_parallel<true>
+{
+	/*! \brief Fill the cell-list in parallel (if the thread pool has more than one thread)
+	 *
+	 * \param pos vector of positions
+	 * \param cli Cell-list
+	 * \param g_m ghost marker
+	 * \param sym symmetric construction
+	 *
+	 * \return true if the Cell-list has been filled
+	 *
+	 */
+	template<typename vector_pos_type, typename CellList>
+	static bool populate(vector_pos_type & pos, CellList & cli, size_t g_m, bool sym)
+	{
+		if (openfpm::get_num_threads() == 1 || pos.size() < OFP_PARALLEL_GRAIN)
+		{return false;}
+
+		cli.fill_parallel(pos,g_m,sym);
+
+		return true;
+	}
+};
 
 template<bool is_gpu>
 struct populate_cell_list_no_sym_impl
@@ -52,6 +118,9 @@ struct populate_cell_list_no_sym_impl
 			   	   	   	   size_t g_m,
 			   	   	   	   cl_construct_opt optc)
 	{
+		if (populate_cell_list_parallel<has_fill_parallel<CellList>::value>::populate(pos,cli,g_m,false) == true)
+		{return;}
+
 		cli.clear();
 
 		for (size_t i = 0; i < pos.size() ; i++)
@@ -89,6 +158,9 @@ struct populate_cell_list_sym_impl
 			   	   	   	   CellList & cli,
 			   	   	   	   size_t g_m)
 	{
+		if (populate_cell_list_parallel<has_fill_parallel<CellList>::value>::populate(pos,cli,g_m,true) == true)
+		{return;}
+
 		cli.clear();
 
 		for (size_t i = 0; i < g_m ; i++)
@@ -218,4 +218,117 @@ public:
 	}
 };
 
+/*! \brief Class for a Morton (Z-order) processing of cell keys for CellList_gen implementation
+ *
+ * \tparam dim Dimansionality of the space
+ */
+template<unsigned int dim, typename CellList>
+class Process_keys_morton
+{
+	//! vector for storing the cell keys
+	openfpm::vector<size_t> keys;
+
+public:
+
+	//! Particle Iterator produced by this key generator
+	typedef ParticleIt_CellP<CellList> Pit;
+
+	/*! \brief Interleave the bits of the coordinates
+	 *
+	 * \param point coordinates
+	 * \param m number of bits for each coordinate
+	 *
+	 * \return the Morton key
+	 *
+	 */
+	static inline size_t encode(const size_t (& point)[dim], size_t m)
+	{
+		size_t key = 0;
+
+		for (size_t b = 0 ; b < m ; b++)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{key |= ((point[i] >> b) & 1ul) << (b*dim + i);}
+		}
+
+		return key;
+	}
+
+	/*! \brief Get the coordinates from a Morton key
+	 *
+	 * \param key Morton key
+	 * \param m number of bits for each coordinate
+	 * \param point coordinates
+	 *
+	 */
+	static inline void decode(size_t key, size_t m, size_t (& point)[dim])
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{point[i] = 0;}
+
+		for (size_t b = 0 ; b < m ; b++)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{point[i] |= ((key >> (b*dim + i)) & 1ul) << b;}
+		}
+	}
+
+	/*! \brief Return cellkeys vector
+	 *
+	 * \return vector of cell keys
+	 *
+	 */
+	inline const openfpm::vector<size_t> & getKeys() const
+	{
+		return keys;
+	}
+
+	/*! \brief Get a Morton key from the coordinates and add to the getKeys vector
+	 *
+	 * \tparam S Cell list type
+	 *
+	 * \param obj Cell list object
+	 * \param gk grid key
+	 * \param m order of a curve
+	 */
+	template<typename S> inline void get_hkey(S & obj, grid_key_dx<dim> gk, size_t m)
+	{
+		size_t point[dim];
+
+		for (size_t i = 0; i < dim; i++)
+		{
+			point[i] = gk.get(i);
+		}
+
+		keys.add(encode(point,m));
+	}
+
+	/*! \brief Sort the Morton keys, get the coordinates, linearize and add to the getKeys vector
+	 *
+	 * \tparam S Cell list type
+	 *
+	 * \param obj Cell list object
+	 * \param m order of a curve
+	 */
+	template<typename S> inline void linearize_hkeys(S & obj, size_t m)
+	{
+		size_t coord[dim];
+
+		keys.sort();
+
+		openfpm::vector<size_t> keys_new;
+
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			decode(keys.get(i),m,coord);
+
+			for (size_t j = 0 ; j < dim ; j++)	{coord[j] += obj.getPadding(j);}
+
+			keys_new.add(obj.getGrid().LinIdPtr(static_cast<size_t *>(coord)));
+		}
+
+		keys.swap(keys_new);
+	}
+};
+
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_PROCKEYS_HPP_ */
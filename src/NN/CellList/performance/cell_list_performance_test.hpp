@@ -0,0 +1,236 @@
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELL_LIST_PERFORMANCE_TEST_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELL_LIST_PERFORMANCE_TEST_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "NN/CellList/CellList_util.hpp"
+#include "NN/CellList/CellListFast_gen.hpp"
+#include "util/thread_pool.hpp"
+
+#define NPART_CL 8*1024*1024
+#define NPART_CL_SFC 1024*1024
+
+// Property tree
+struct report_cell_list_func_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_cell_list_func_tests report_cell_list_funcs;
+
+BOOST_AUTO_TEST_SUITE( cell_list_performance )
+
+/*! \brief Measure the construction time of a Cell-list with n_threads threads
+ *
+ * \param pos particle positions
+ * \param n_threads number of threads
+ * \param mean average time
+ * \param dev standard deviation
+ *
+ */
+void cell_list_construct_time(openfpm::vector<Point<3,float>> & pos, size_t n_threads, double & mean, double & dev)
+{
+	SpaceBox<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {128,128,128};
+
+	CellList<3,float,Mem_fast<>> cl(box,div);
+	mgpu::ofp_context_t context(mgpu::gpu_context_opt::dummy);
+
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(n_threads);
+
+	std::vector<double> times(N_STAT + 1);
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		populate_cell_list(pos,cl,context,pos.size(),CL_NON_SYMMETRIC,cl_construct_opt::Full);
+
+		t.stop();
+		times[i] = t.getwct();
+	}
+
+	openfpm::set_num_threads(n_threads_old);
+
+	standard_deviation(times,mean,dev);
+}
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_construct)
+{
+	openfpm::vector<Point<3,float>> pos;
+	pos.resize(NPART_CL);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		pos.template get<0>(i)[0] = (float)rand() / RAND_MAX;
+		pos.template get<0>(i)[1] = (float)rand() / RAND_MAX;
+		pos.template get<0>(i)[2] = (float)rand() / RAND_MAX;
+	}
+
+	size_t n_threads = std::thread::hardware_concurrency();
+	if (n_threads == 0)	{n_threads = 1;}
+
+	double mean;
+	double dev;
+
+	cell_list_construct_time(pos,1,mean,dev);
+
+	report_cell_list_funcs.graphs.put("performance.cell_list(0).funcs.nele",NPART_CL);
+	report_cell_list_funcs.graphs.put("performance.cell_list(0).funcs.name","construct_1_thread");
+	report_cell_list_funcs.graphs.put("performance.cell_list(0).y.data.mean",mean);
+	report_cell_list_funcs.graphs.put("performance.cell_list(0).y.data.dev",dev);
+
+	cell_list_construct_time(pos,n_threads,mean,dev);
+
+	report_cell_list_funcs.graphs.put("performance.cell_list(1).funcs.nele",NPART_CL);
+	report_cell_list_funcs.graphs.put("performance.cell_list(1).funcs.name","construct_" + std::to_string(n_threads) + "_threads");
+	report_cell_list_funcs.graphs.put("performance.cell_list(1).y.data.mean",mean);
+	report_cell_list_funcs.graphs.put("performance.cell_list(1).y.data.dev",dev);
+}
+
+/*! \brief Measure a neighborhood loop (sum of the squared distances of the particles in the neighborhood cells)
+ *
+ * The particles are processed in memory order, the access pattern to the neighborhood particles
+ * depend on how the particles are ordered in memory
+ *
+ * \param pos particle positions
+ * \param prp particle properties (the result is stored in the property 0)
+ * \param cl Cell-list
+ * \param mean average time
+ * \param dev standard deviation
+ *
+ */
+template<typename CellList_type>
+void cell_list_nn_loop_time(openfpm::vector<Point<3,float>> & pos, openfpm::vector<aggregate<float>> & prp, CellList_type & cl, double & mean, double & dev)
+{
+	std::vector<double> times(N_STAT + 1);
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<3,float> xp = pos.get(p);
+			float sum = 0.0;
+
+			auto NN = cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
+
+			while (NN.isNext())
+			{
+				Point<3,float> xq = pos.get(NN.get());
+
+				sum += xp.distance2(xq);
+
+				++NN;
+			}
+
+			prp.template get<0>(p) = sum;
+		}
+
+		t.stop();
+		times[i] = t.getwct();
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+/*! \brief Reorder the particles along the space filling curve Prock and measure the neighborhood loop
+ *
+ * \tparam Prock space filling curve
+ *
+ * \param pos_in particle positions (not reordered)
+ * \param id measure id
+ * \param name name of the measure
+ * \param reorder if false the particles are not reordered
+ *
+ */
+template<template <unsigned int, typename> class Prock>
+void cell_list_sfc_measure(openfpm::vector<Point<3,float>> & pos_in, size_t id, const std::string & name, bool reorder)
+{
+	Box<3,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+
+	openfpm::vector<Point<3,float>> pos(pos_in);
+	openfpm::vector<aggregate<float>> prp;
+	prp.resize(pos.size());
+
+	CellList_gen<3,float,Prock> cl;
+	cl.Initialize(box,div,1);
+	cl.set_gm(pos.size());
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{cl.add(pos.get(i),i);}
+
+	if (reorder == true)
+	{
+		openfpm::vector<size_t> perm;
+		cl.reorder_sfc(pos,prp,perm);
+	}
+
+	double mean;
+	double dev;
+
+	cell_list_nn_loop_time(pos,prp,cl,mean,dev);
+
+	std::string base = "performance.cell_list(" + std::to_string(id) + ")";
+
+	report_cell_list_funcs.graphs.put(base + ".funcs.nele",NPART_CL_SFC);
+	report_cell_list_funcs.graphs.put(base + ".funcs.name",name);
+	report_cell_list_funcs.graphs.put(base + ".y.data.mean",mean);
+	report_cell_list_funcs.graphs.put(base + ".y.data.dev",dev);
+}
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_sfc_reorder)
+{
+	openfpm::vector<Point<3,float>> pos;
+	pos.resize(NPART_CL_SFC);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		pos.template get<0>(i)[0] = (float)rand() / RAND_MAX;
+		pos.template get<0>(i)[1] = (float)rand() / RAND_MAX;
+		pos.template get<0>(i)[2] = (float)rand() / RAND_MAX;
+	}
+
+	cell_list_sfc_measure<Process_keys_lin>(pos,2,"nn_loop_random",false);
+	cell_list_sfc_measure<Process_keys_lin>(pos,3,"nn_loop_sfc_lin",true);
+	cell_list_sfc_measure<Process_keys_hilb>(pos,4,"nn_loop_sfc_hilb",true);
+	cell_list_sfc_measure<Process_keys_morton>(pos,5,"nn_loop_sfc_morton",true);
+}
+
+/////// THIS IS NOT A TEST IT WRITE THE PERFORMANCE RESULT ///////
+
+BOOST_AUTO_TEST_CASE(cell_list_performance_write_report)
+{
+	// Create a graphs
+
+	report_cell_list_funcs.graphs.put("graphs.graph(0).type","line");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).title","Cell-list construction and neighborhood loop");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).x.title","Tests");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).y.title","Time seconds");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).y.data(0).source","performance.cell_list(#).y.data.mean");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).x.data(0).source","performance.cell_list(#).funcs.name");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).y.data(0).title","Actual");
+	report_cell_list_funcs.graphs.add("graphs.graph(0).interpolation","lines");
+
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("cell_list_performance_funcs.xml", report_cell_list_funcs.graphs,std::locale(),settings);
+
+	GoogleChart cg;
+
+	std::string file_xml_ref(test_dir);
+	file_xml_ref += std::string("/openfpm_data/cell_list_performance_funcs_ref.xml");
+
+	StandardXMLPerformanceGraph("cell_list_performance_funcs.xml",file_xml_ref,cg);
+
+	addUpdtateTime(cg,1);
+
+	cg.write("cell_list_performance_funcs.html");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_PERFORMANCE_CELL_LIST_PERFORMANCE_TEST_HPP_ */
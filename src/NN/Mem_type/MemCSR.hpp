@@ -0,0 +1,548 @@
+#ifndef OPENFPM_DATA_SRC_NN_MEM_TYPE_MEMCSR_HPP_
+#define OPENFPM_DATA_SRC_NN_MEM_TYPE_MEMCSR_HPP_
+
+#include "config.h"
+#include "util/common.hpp"
+#include "Vector/map_vector.hpp"
+#include "util/thread_pool.hpp"
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <memory>
+
+/*! \brief Class for CSR (compressed sparse row) cell list and Verlet list implementation
+ *
+ * \tparam Memory memory used to allocate the data-structures
+ * \tparam local_index type used for the local index
+ *
+ * It is a class that work like a vector(1) of vector(2). The elements of all the vector(2)
+ * are stored contiguously in a 1D array and each vector(2) is identified by an offset and
+ * a number of elements. Differently from Mem_fast the memory allocated is exact
+ * Size = (M+1)*sizeof(offset) + M*sizeof(count) + N*sizeof(ele) and it does not depend on the
+ * most populated cell
+ *
+ * Where
+ *
+ * N = total number of elements
+ * M = number of cells
+ *
+ * The structure is constructed in two passes. addCell only record the element in a staging
+ * buffer, the first access (get, getNelements, getStartId ...) count the elements for each cell
+ * and scatter them in the CSR layout. A structure that has been compacted can be accessed
+ * concurrently by several threads. fill_parallel and set_n_elements_parallel construct the
+ * layout directly without staging
+ *
+ * Adding elements after the layout has been constructed is supported. When the staged elements
+ * are merged into a non-empty layout, every cell that receive new elements get 50% of free
+ * space, the following addCell on a cell with free space write directly in the layout without
+ * staging. In this way interleaving addCell and get does not rebuild the full layout at every
+ * access. A layout constructed from empty (after init_to_zero, clear or with fill_parallel) is exact
+ *
+ * \note useful for clustered distributions where Mem_fast reserve for every cell the space of the most
+ *       populated cell
+ *
+ */
+template <typename Memory = HeapMemory, typename local_index = size_t>
+class Mem_csr
+{
+	//! base that store the data
+	typedef typename openfpm::vector<aggregate<local_index>,Memory> base;
+
+	//! offset of the first element of each cell (one more element to store the total)
+	base cl_off;
+
+	//! number of elements in each cell
+	base cl_n;
+
+	//! elements of all the cells, one padding element at the end
+	base cl_base;
+
+	//! staging buffer, cells of the elements added with addCell
+	openfpm::vector<local_index> st_cell;
+
+	//! staging buffer, elements added with addCell
+	openfpm::vector<local_index> st_ele;
+
+	//! true if the staging buffer contain elements not yet in the CSR layout
+	mutable std::atomic<bool> dirty;
+
+	//! mutex used to compact the structure
+	mutable std::mutex cmp_mtx;
+
+	/*! \brief Merge the staging buffer into the CSR layout
+	 *
+	 * The elements already in the layout come first, the staged elements follow in insertion order,
+	 * so the result is the same of adding the elements one by one into growing vectors.
+	 * If the layout already contain elements, the cells that receive staged elements are
+	 * allocated with free space, the other cells retain their capacity
+	 *
+	 */
+	void compact_impl()
+	{
+		size_t n_cell = cl_n.size();
+
+		base cl_off_;
+		cl_off_.resize(n_cell + 1);
+
+		// first pass, count the elements of each cell and calculate the offsets
+
+		openfpm::vector<local_index> cnt;
+		cnt.resize(n_cell);
+
+		size_t n_old = 0;
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			cnt.get(i) = 0;
+			n_old += cl_n.template get<0>(i);
+		}
+
+		for (size_t i = 0 ; i < st_cell.size() ; i++)
+		{cnt.get(st_cell.get(i))++;}
+
+		cl_off_.template get<0>(0) = 0;
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			local_index n = cl_n.template get<0>(i) + cnt.get(i);
+			local_index cap = cl_off.template get<0>(i+1) - cl_off.template get<0>(i);
+
+			if (n_old == 0)
+			{cap = n;}
+			else if (cnt.get(i) != 0)
+			{cap = std::max(cap,(local_index)(n + n/2));}
+
+			cl_off_.template get<0>(i+1) = cl_off_.template get<0>(i) + cap;
+		}
+
+		// second pass, scatter the elements
+
+		base cl_base_;
+		cl_base_.resize(cl_off_.template get<0>(n_cell) + 1);
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			local_index start = cl_off.template get<0>(i);
+			local_index start_ = cl_off_.template get<0>(i);
+
+			for (local_index j = 0 ; j < cl_n.template get<0>(i) ; j++)
+			{cl_base_.template get<0>(start_ + j) = cl_base.template get<0>(start + j);}
+
+			cnt.get(i) = start_ + cl_n.template get<0>(i);
+		}
+
+		for (size_t i = 0 ; i < st_cell.size() ; i++)
+		{
+			local_index c = st_cell.get(i);
+			local_index & cur = cnt.get(c);
+			cl_base_.template get<0>(cur) = st_ele.get(i);
+			cur++;
+			cl_n.template get<0>(c)++;
+		}
+
+		cl_off.swap(cl_off_);
+		cl_base.swap(cl_base_);
+
+		st_cell.clear();
+		st_ele.clear();
+	}
+
+	/*! \brief Construct the CSR layout if there are staged elements
+	 *
+	 * It is safe to call it concurrently
+	 *
+	 */
+	inline void compact() const
+	{
+		if (dirty.load(std::memory_order_acquire) == false)
+		{return;}
+
+		std::lock_guard<std::mutex> lk(cmp_mtx);
+
+		if (dirty.load(std::memory_order_relaxed) == true)
+		{
+			const_cast<Mem_csr<Memory,local_index> *>(this)->compact_impl();
+			dirty.store(false,std::memory_order_release);
+		}
+	}
+
+	/*! \brief Set the offsets from the number of elements of each cell and allocate the elements
+	 *
+	 * \warning the content of the cells is not preserved
+	 *
+	 */
+	inline void set_offsets()
+	{
+		size_t n_cell = cl_n.size();
+
+		cl_off.resize(n_cell + 1);
+		cl_off.template get<0>(0) = 0;
+
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cl_off.template get<0>(i+1) = cl_off.template get<0>(i) + cl_n.template get<0>(i);}
+
+		cl_base.resize(cl_off.template get<0>(n_cell) + 1);
+
+		st_cell.clear();
+		st_ele.clear();
+		dirty.store(false,std::memory_order_relaxed);
+	}
+
+public:
+
+	typedef void toKernel_type;
+
+	typedef local_index local_index_type;
+
+	//! It indicate that the structure can be filled in parallel with fill_parallel
+	typedef int yes_has_fill_parallel;
+
+	/*! \brief return the number of elements
+	 *
+	 * \return the number of elements
+	 *
+	 */
+	inline size_t size() const
+	{
+		return cl_n.size();
+	}
+
+	/*! \brief Destroy the internal memory including the retained one
+	 *
+	 */
+	inline void destroy()
+	{
+		cl_off.swap(base());
+		cl_n.swap(base());
+		cl_base.swap(base());
+		st_cell.swap(openfpm::vector<local_index>());
+		st_ele.swap(openfpm::vector<local_index>());
+		dirty.store(false,std::memory_order_relaxed);
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot unused
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	inline void init_to_zero(local_index slot, local_index tot_n_cell)
+	{
+		cl_n.resize(tot_n_cell);
+		cl_n.template fill<0>(0);
+
+		set_offsets();
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(const Mem_csr<Memory,local_index> & mem)
+	{
+		mem.compact();
+
+		cl_off = mem.cl_off;
+		cl_n = mem.cl_n;
+		cl_base = mem.cl_base;
+
+		st_cell.clear();
+		st_ele.clear();
+		dirty.store(false,std::memory_order_relaxed);
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(Mem_csr<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * If the cell has free space the element is written directly in the CSR layout, otherwise
+	 * it is stored in the CSR layout at the first access
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, local_index ele)
+	{
+		if (dirty.load(std::memory_order_relaxed) == false)
+		{
+			local_index start = cl_off.template get<0>(cell_id);
+			local_index & n = cl_n.template get<0>(cell_id);
+
+			if (start + n < cl_off.template get<0>(cell_id+1))
+			{
+				cl_base.template get<0>(start + n) = ele;
+				n++;
+				return;
+			}
+		}
+
+		st_cell.add(cell_id);
+		st_ele.add(ele);
+
+		dirty.store(true,std::memory_order_relaxed);
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void add(local_index cell_id, local_index ele)
+	{
+		this->addCell(cell_id,ele);
+	}
+
+	/*! \brief Set the number of elements of each cell using all the threads of the thread pool
+	 *
+	 * The memory is allocated for exactly cnt.get(c) elements in each cell c. The content of the cells
+	 * is undefined and must be set with get(c,j)
+	 *
+	 * \param cnt number of elements for each cell (it must have size() elements)
+	 *
+	 */
+	template<typename vector_cnt_type>
+	void set_n_elements_parallel(const vector_cnt_type & cnt)
+	{
+		openfpm::parallel_for(0,cl_n.size(),[&](size_t c){cl_n.template get<0>(c) = cnt.get(c);});
+
+		set_offsets();
+	}
+
+	/*! \brief Fill the structure using all the threads of the thread pool
+	 *
+	 * The element i is added to the cell cell_ids.get(i). The previous content is removed.
+	 * The result is identical to clear() followed by addCell(cell_ids.get(i),i)
+	 * for i = 0 ... cell_ids.size()-1 in sequence
+	 *
+	 * \param cell_ids cell id for each element
+	 *
+	 */
+	template<typename vector_ids_type>
+	void fill_parallel(const vector_ids_type & cell_ids)
+	{
+		size_t n_cell = cl_n.size();
+		size_t n_ele = cell_ids.size();
+
+		std::unique_ptr<std::atomic<local_index>[]> cnt(new std::atomic<local_index>[n_cell]);
+
+		openfpm::parallel_for(0,n_cell,[&](size_t c){cnt[c].store(0,std::memory_order_relaxed);});
+
+		// count the elements in each cell
+		openfpm::parallel_for(0,n_ele,[&](size_t i)
+		{cnt[cell_ids.get(i)].fetch_add(1,std::memory_order_relaxed);});
+
+		openfpm::parallel_for(0,n_cell,[&](size_t c){cl_n.template get<0>(c) = cnt[c].load(std::memory_order_relaxed);});
+
+		set_offsets();
+
+		// reset the counters to use them as cursor
+		openfpm::parallel_for(0,n_cell,[&](size_t c){cnt[c].store(0,std::memory_order_relaxed);});
+
+		// scatter
+		openfpm::parallel_for(0,n_ele,[&](size_t i)
+		{
+			local_index c = cell_ids.get(i);
+			local_index k = cnt[c].fetch_add(1,std::memory_order_relaxed);
+			cl_base.template get<0>(cl_off.template get<0>(c) + k) = i;
+		});
+
+		// restore the insertion order inside each cell
+		openfpm::parallel_for(0,n_cell,[&](size_t c)
+		{
+			local_index n = cl_n.template get<0>(c);
+
+			if (n <= 1)	{return;}
+
+			local_index * start = &cl_base.template get<0>(cl_off.template get<0>(c));
+			std::sort(start,start + n);
+		});
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) -> decltype(cl_base.template get<0>(0)) &
+	{
+		compact();
+
+		return cl_base.template get<0>(cl_off.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) const -> decltype(cl_base.template get<0>(0)) &
+	{
+		compact();
+
+		return cl_base.template get<0>(cl_off.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Remove the last element of the cell (like Mem_fast)
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id to remove (unused)
+	 *
+	 */
+	inline void remove(local_index cell, local_index ele)
+	{
+		compact();
+
+		cl_n.template get<0>(cell)--;
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		compact();
+
+		return cl_n.template get<0>(cell_id);
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> & mem)
+	{
+		cl_off.swap(mem.cl_off);
+		cl_n.swap(mem.cl_n);
+		cl_base.swap(mem.cl_base);
+		st_cell.swap(mem.st_cell);
+		st_ele.swap(mem.st_ele);
+
+		bool dirty_tmp = mem.dirty.load(std::memory_order_relaxed);
+		mem.dirty.store(dirty.load(std::memory_order_relaxed),std::memory_order_relaxed);
+		dirty.store(dirty_tmp,std::memory_order_relaxed);
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief Delete all the elements
+	 *
+	 * The memory is retained
+	 *
+	 */
+	inline void clear()
+	{
+		cl_n.template fill<0>(0);
+
+		set_offsets();
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		compact();
+
+		return cl_base.template get<0>(cl_off.template get<0>(cell_id));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		compact();
+
+		return cl_base.template get<0>(cl_off.template get<0>(cell_id) + cl_n.template get<0>(cell_id));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+public:
+
+	//! expose the type of the local index
+	typedef local_index loc_index;
+
+	/*! \brief Constructor
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline Mem_csr(local_index slot)
+	:dirty(false)
+	{
+		cl_off.resize(1);
+		cl_off.template get<0>(0) = 0;
+		cl_base.resize(1);
+	}
+
+	/*! \brief Set the number of slot for each cell (unused)
+	 *
+	 * \param slot number of slot
+	 *
+	 */
+	inline void set_slot(local_index slot)
+	{}
+
+	/*! \brief Return the private data-structure cl_base
+	 *
+	 * \return cl_base (the last element is padding)
+	 *
+	 */
+	const base & private_get_cl_base() const
+	{
+		compact();
+
+		return cl_base;
+	}
+};
+
+
+#endif /* OPENFPM_DATA_SRC_NN_MEM_TYPE_MEMCSR_HPP_ */
@@ -16,6 +16,10 @@
 #include <unordered_map>
 #include "util/common.hpp"
 #include "Vector/map_vector.hpp"
+#include "util/thread_pool.hpp"
+#include <atomic>
+#include <algorithm>
+#include <memory>
 
 template <typename Memory, template <typename> class layout_base,typename local_index>
 class Mem_fast_ker
@@ -125,12 +129,37 @@ class Mem_fast
 	}
 
 
+	/*! \brief Double the slots until a cell with mx elements fit (like addCell does)
+	 *
+	 * \warning the content of the cells is not preserved
+	 *
+	 * \param mx number of elements of the biggest cell
+	 *
+	 */
+	inline void grow_slot_no_copy(local_index mx)
+	{
+		local_index slot_new = slot;
+
+		while (mx >= slot_new)
+		{slot_new *= 2;}
+
+		if (slot_new != slot || cl_base.size() != cl_n.size() * slot)
+		{
+			base cl_base_(slot_new * cl_n.size());
+			cl_base.swap(cl_base_);
+			slot = slot_new;
+		}
+	}
+
 public:
 
 	typedef Mem_fast_ker<Memory,memory_traits_lin,local_index> toKernel_type;
 
 	typedef local_index local_index_type;
 
+	//! It indicate that the structure can be filled in parallel with fill_parallel
+	typedef int yes_has_fill_parallel;
+
 	/*! \brief return the number of elements
 	 *
 	 * \return the number of elements
@@ -230,6 +259,87 @@ public:
 		cl_n.template get<0>(cell_id)++;
 	}
 
+	/*! \brief Set the number of elements of each cell using all the threads of the thread pool
+	 *
+	 * The slots are grown like the sequential addCell would do to store cnt.get(c) elements
+	 * in each cell c. The content of the cells is undefined and must be set with get(c,j)
+	 *
+	 * \param cnt number of elements for each cell (it must have size() elements)
+	 *
+	 */
+	template<typename vector_cnt_type>
+	void set_n_elements_parallel(const vector_cnt_type & cnt)
+	{
+		local_index mx = openfpm::parallel_reduce(0,cl_n.size(),(local_index)0,
+												  [&](size_t c){return (local_index)cnt.get(c);},
+												  [](local_index a, local_index b){return (a > b)?a:b;});
+
+		grow_slot_no_copy(mx);
+
+		openfpm::parallel_for(0,cl_n.size(),[&](size_t c){cl_n.template get<0>(c) = cnt.get(c);});
+	}
+
+	/*! \brief Fill the structure using all the threads of the thread pool
+	 *
+	 * The element i is added to the cell cell_ids.get(i). The previous content is removed.
+	 * The result (slot included) is identical to clear() followed by addCell(cell_ids.get(i),i)
+	 * for i = 0 ... cell_ids.size()-1 in sequence
+	 *
+	 * The construction count the elements for each cell, grow the slot to fit the
+	 * most populated cell, scatter the elements and sort each cell to restore the
+	 * sequential order
+	 *
+	 * \param cell_ids cell id for each element
+	 *
+	 */
+	template<typename vector_ids_type>
+	void fill_parallel(const vector_ids_type & cell_ids)
+	{
+		size_t n_cell = cl_n.size();
+		size_t n_ele = cell_ids.size();
+
+		std::unique_ptr<std::atomic<local_index>[]> cnt(new std::atomic<local_index>[n_cell]);
+
+		openfpm::parallel_for(0,n_cell,[&](size_t c){cnt[c].store(0,std::memory_order_relaxed);});
+
+		// count the elements in each cell
+		openfpm::parallel_for(0,n_ele,[&](size_t i)
+		{cnt[cell_ids.get(i)].fetch_add(1,std::memory_order_relaxed);});
+
+		// maximum number of elements in a cell
+		local_index mx = openfpm::parallel_reduce(0,n_cell,(local_index)0,
+												  [&](size_t c){return cnt[c].load(std::memory_order_relaxed);},
+												  [](local_index a, local_index b){return (a > b)?a:b;});
+
+		grow_slot_no_copy(mx);
+
+		// set the number of elements and reset the counters to use them as cursor
+		openfpm::parallel_for(0,n_cell,[&](size_t c)
+		{
+			cl_n.template get<0>(c) = cnt[c].load(std::memory_order_relaxed);
+			cnt[c].store(0,std::memory_order_relaxed);
+		});
+
+		// scatter
+		openfpm::parallel_for(0,n_ele,[&](size_t i)
+		{
+			local_index c = cell_ids.get(i);
+			local_index k = cnt[c].fetch_add(1,std::memory_order_relaxed);
+			cl_base.template get<0>(c * slot + k) = i;
+		});
+
+		// restore the insertion order inside each cell
+		openfpm::parallel_for(0,n_cell,[&](size_t c)
+		{
+			local_index n = cl_n.template get<0>(c);
+
+			if (n <= 1)	{return;}
+
+			local_index * start = &cl_base.template get<0>(c * slot);
+			std::sort(start,start + n);
+		});
+	}
+
 	/*! \brief Add an element to the cell
 	 *
 	 * \param cell_id id of the cell
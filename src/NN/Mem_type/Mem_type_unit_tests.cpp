@@ -10,6 +10,7 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 
 BOOST_AUTO_TEST_SUITE( Mem_type_test )
 
@@ -38,6 +39,86 @@ BOOST_AUTO_TEST_CASE ( Mem_type_check )
 	test_mem_type<Mem_fast<>>();
 	test_mem_type<Mem_bal<>>();
 	test_mem_type<Mem_mw<>>();
+	test_mem_type<Mem_csr<>>();
+}
+
+BOOST_AUTO_TEST_CASE ( Mem_csr_check )
+{
+	const size_t n_cell = 64;
+
+	Mem_csr<> mem(16);
+	mem.init_to_zero(16,n_cell);
+
+	openfpm::vector<openfpm::vector<size_t>> ref;
+	ref.resize(n_cell);
+
+	// clustered distribution, most of the elements are in 3 cells
+
+	size_t n_ele = 0;
+	for (size_t i = 0 ; i < 3000 ; i++)
+	{
+		size_t c = (i % 10 == 0)?(i*7 % n_cell):(i % 3)*17;
+
+		mem.addCell(c,i);
+		ref.get(c).add(i);
+		n_ele++;
+	}
+
+	// the memory allocated is exact (one padding element)
+
+	BOOST_REQUIRE_EQUAL(mem.private_get_cl_base().size(),n_ele + 1);
+
+	bool match = true;
+	for (size_t c = 0 ; c < n_cell ; c++)
+	{
+		match &= mem.getNelements(c) == ref.get(c).size();
+
+		for (size_t j = 0 ; j < ref.get(c).size() && match == true ; j++)
+		{match &= mem.get(c,j) == ref.get(c).get(j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// interleave add and get
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		size_t c = (i % 5 == 0)?(i*13 % n_cell):17;
+
+		mem.addCell(c,n_ele);
+		ref.get(c).add(n_ele);
+		n_ele++;
+
+		match &= mem.getNelements(c) == ref.get(c).size();
+		match &= mem.get(c,mem.getNelements(c)-1) == ref.get(c).last();
+		match &= *(&mem.getStartId(c) + ref.get(c).size() - 1) == ref.get(c).last();
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	for (size_t c = 0 ; c < n_cell ; c++)
+	{
+		match &= mem.getNelements(c) == ref.get(c).size();
+
+		for (size_t j = 0 ; j < ref.get(c).size() && match == true ; j++)
+		{match &= mem.get(c,j) == ref.get(c).get(j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the free space is bounded
+
+	BOOST_REQUIRE(mem.private_get_cl_base().size() <= n_ele + n_ele/2 + n_cell + 1);
+
+	// a layout constructed from empty is exact again
+
+	mem.clear();
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{mem.addCell(i % 2,i);}
+
+	BOOST_REQUIRE_EQUAL(mem.getNelements(1),50ul);
+	BOOST_REQUIRE_EQUAL(mem.private_get_cl_base().size(),101ul);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
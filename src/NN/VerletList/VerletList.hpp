@@ -20,6 +20,7 @@ typedef unsigned int local_index_;
 #define VERLETLIST_FAST(dim,St) VerletList<dim,St,Mem_fast<>,shift<dim,St> >
 #define VERLETLIST_BAL(dim,St) VerletList<dim,St,Mem_bal<>,shift<dim,St> >
 #define VERLETLIST_MEM(dim,St) VerletList<dim,St,Mem_mem<>,shift<dim,St> >
+#define VERLETLIST_CSR(dim,St) VerletList<dim,St,Mem_csr<>,shift<dim,St> >
 
 #include "VerletListFast.hpp"
 
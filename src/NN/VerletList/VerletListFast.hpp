@@ -13,9 +13,13 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 
 #define VERLET_STARTING_NSLOT 128
 
+//! Minimum number of particles (or cells for CRS) each thread process in the parallel construction
+#define VERLET_PARALLEL_GRAIN 512
+
 
 #define WITH_RADIUS 3
 
@@ -53,6 +57,16 @@ struct NNType
 		return cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
 	}
 
+	/*! \brief Prepare the Cell-list to be used concurrently by several threads
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 */
+	static inline void init(CellListImpl & cl, T r_cut)
+	{
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -100,6 +114,20 @@ struct NNType<dim,T,CellListImpl,PartIt,WITH_RADIUS,local_index>
 		return cl.template getNNIteratorRadius<NO_CHECK>(cl.getCell(xp),r_cut);
 	}
 
+	/*! \brief Prepare the Cell-list to be used concurrently by several threads
+	 *
+	 * The radius neighborhood is cached in the Cell-list at the first call, we create
+	 * it here so the threads only read it
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 */
+	static inline void init(CellListImpl & cl, T r_cut)
+	{
+		cl.getNNc_rad(r_cut);
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -147,6 +175,16 @@ struct NNType<dim,T,CellListImpl,PartIt,VL_SYMMETRIC,local_index>
 		return cl.template getNNIteratorSym<NO_CHECK>(cl.getCell(xp),p,v);
 	}
 
+	/*! \brief Prepare the Cell-list to be used concurrently by several threads
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 */
+	static inline void init(CellListImpl & cl, T r_cut)
+	{
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -196,6 +234,16 @@ struct NNType<dim,T,CellListImpl,PartIt,VL_CRS_SYMMETRIC,local_index>
 	}
 
 
+	/*! \brief Prepare the Cell-list to be used concurrently by several threads
+	 *
+	 * \param cl Cell-list type implementation
+	 * \param r_cut Cutoff radius
+	 *
+	 */
+	static inline void init(CellListImpl & cl, T r_cut)
+	{
+	}
+
 	/*! \brief Add particle in the list of the domain particles
 	 *
 	 * \param p particle id
@@ -236,6 +284,48 @@ public:
 		end = g_m;
 		return pos.getIteratorTo(end);
 	}
+
+	/*! \brief Return the number of work units the iteration can be split into
+	 *
+	 * \param dom list of cells with normal neighborhood
+	 * \param anom list of cells with not-normal neighborhood
+	 * \param g_m ghost marker
+	 *
+	 * \return the number of particles
+	 *
+	 */
+	static inline size_t n_work(const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, size_t g_m)
+	{
+		return g_m;
+	}
+
+	/*! \brief It return the particle iterator over the work units [start,stop)
+	 *
+	 * Iterating the blocks in order visit the particles in the same order of the iterator returned by get
+	 *
+	 * \param pos vector with position of the particles
+	 * \param dom list of cells with normal neighborhood
+	 * \param anom list of cells with not-normal neighborhood
+	 * \param cli Cell-list used for Verlet-list construction
+	 * \param start first work unit
+	 * \param stop one past the last work unit
+	 * \param dom_b unused
+	 * \param anom_b unused
+	 *
+	 * \return the particle iterator
+	 *
+	 */
+	static inline auto get_block(const vector & pos,
+								 const openfpm::vector<size_t> & dom,
+								 const openfpm::vector<subsub_lin<dim>> & anom,
+								 CellList & cli,
+								 size_t start,
+								 size_t stop,
+								 openfpm::vector<size_t> & dom_b,
+								 openfpm::vector<subsub_lin<dim>> & anom_b) -> decltype(pos.getIteratorTo(0))
+	{
+		return decltype(pos.getIteratorTo(0))(stop,start);
+	}
 };
 
 /*! \brief In general different NN scheme like full symmetric or CRS require different
@@ -266,6 +356,55 @@ public:
 		end = pos.size();
 		return ParticleItCRS_Cells<dim,CellList,vector>(cli,dom,anom,cli.getNNc_sym());
 	}
+
+	/*! \brief Return the number of work units the iteration can be split into
+	 *
+	 * \param dom list of cells with normal neighborhood
+	 * \param anom list of cells with not-normal neighborhood
+	 * \param g_m ghost marker
+	 *
+	 * \return the number of cells (domain cells followed by anomalous cells)
+	 *
+	 */
+	static inline size_t n_work(const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, size_t g_m)
+	{
+		return dom.size() + anom.size();
+	}
+
+	/*! \brief It return the particle iterator over the cells [start,stop)
+	 *
+	 * The work units are the domain cells followed by the anomalous cells, iterating the blocks in order
+	 * visit the particles in the same order of the iterator returned by get
+	 *
+	 * \param pos vector with position of the particles
+	 * \param dom list of cells with normal neighborhood
+	 * \param anom list of cells with not-normal neighborhood
+	 * \param cli Cell-list used for Verlet-list construction
+	 * \param start first work unit
+	 * \param stop one past the last work unit
+	 * \param dom_b storage for the domain cells of the block (must live as long as the iterator)
+	 * \param anom_b storage for the anomalous cells of the block (must live as long as the iterator)
+	 *
+	 * \return the particle iterator
+	 *
+	 */
+	static inline ParticleItCRS_Cells<dim,CellList,vector> get_block(const vector & pos,
+																	const openfpm::vector<size_t> & dom,
+																	const openfpm::vector<subsub_lin<dim>> & anom,
+																	CellList & cli,
+																	size_t start,
+																	size_t stop,
+																	openfpm::vector<size_t> & dom_b,
+																	openfpm::vector<subsub_lin<dim>> & anom_b)
+	{
+		for (size_t i = start ; i < stop && i < dom.size() ; i++)
+		{dom_b.add(dom.get(i));}
+
+		for (size_t i = (start > dom.size())?start:dom.size() ; i < stop ; i++)
+		{anom_b.add(anom.get(i - dom.size()));}
+
+		return ParticleItCRS_Cells<dim,CellList,vector>(cli,dom_b,anom_b,cli.getNNc_sym());
+	}
 };
 
 /*! \brief Class for Verlet list implementation
@@ -311,6 +450,30 @@ private:
 	//! Interlal cell-list
 	CellListImpl cli;
 
+	//! skin, the Verlet-list is constructed with radius r_cut + skin
+	T skin;
+
+	//! position of the particles when the Verlet-list has been constructed (only with skin)
+	openfpm::vector<Point<dim,T>> pos_ref;
+
+	/*! \brief Save the position of the particles to track the displacement
+	 *
+	 * \param pos vector of positions
+	 *
+	 */
+	void savePositions(const vector_pos_type & pos)
+	{
+		if (skin == 0)
+		{return;}
+
+		pos_ref.resize(pos.size());
+
+		openfpm::parallel_for(0,pos.size(),[&](size_t i)
+		{
+			for (size_t k = 0 ; k < dim ; k++)
+			{pos_ref.template get<0>(i)[k] = pos.template get<0>(i)[k];}
+		});
+	}
 
 	/*! \brief Fill the cell-list with data
 	 *
@@ -373,6 +536,16 @@ private:
 	 */
 	template<typename NN_type, int type> inline void create_(const vector_pos_type & pos, const vector_pos_type & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt)
 	{
+		savePositions(pos);
+
+		if (openfpm::get_num_threads() > 1)
+		{
+			typedef VerletList<dim,T,Mem_type,transform,vector_pos_type,CellListImpl> self;
+
+			if (create_parallel_<NN_type,type>(pos,pos2,dom,anom,r_cut,g_m,cli,opt,std::integral_constant<bool,has_fill_parallel<self>::value>()) == true)
+			{return;}
+		}
+
 		size_t end;
 
 		auto it = PartItNN<type,dim,vector_pos_type,CellListImpl>::get(pos,dom,anom,cli,g_m,end);
@@ -411,6 +584,156 @@ private:
 		}
 	}
 
+	/*! \brief Create the Verlet list in parallel, case where Mem_type does not support it
+	 *
+	 * \return false, the Verlet list must be constructed sequentially
+	 *
+	 */
+	template<typename NN_type, int type> inline bool create_parallel_(const vector_pos_type & pos, const vector_pos_type & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt, std::false_type)
+	{
+		return false;
+	}
+
+	/*! \brief Create the Verlet list from a given cell-list using all the threads of the thread pool
+	 *
+	 * The particles (cells for CRS) are split in contiguous blocks, each thread store the neighborhood of
+	 * its particles in a local buffer. The buffers are merged at the end into Mem_type. The result is
+	 * identical to the sequential construction (create_)
+	 *
+	 * \param pos vector of positions
+	 * \param pos2 vector of position for the neighborhood
+	 * \param dom list of domain cells with normal neighborhood
+	 * \param anom list of domain cells with non-normal neighborhood
+	 * \param r_cut cut-off radius to get the neighborhood particles
+	 * \param g_m ghost marker
+	 * \param cli Cell-list elements to use to construct the verlet list
+	 * \param opt options
+	 *
+	 * \return true if the Verlet list has been constructed
+	 *
+	 */
+	template<typename NN_type, int type> inline bool create_parallel_(const vector_pos_type & pos, const vector_pos_type & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt, std::true_type)
+	{
+		typedef typename Mem_type::local_index_type lid;
+		typedef PartItNN<type,dim,vector_pos_type,CellListImpl> part_it_type;
+
+		size_t n_work = part_it_type::n_work(dom,anom,g_m);
+
+		if (n_work < VERLET_PARALLEL_GRAIN)
+		{return false;}
+
+		size_t end;
+		auto it_seq = part_it_type::get(pos,dom,anom,cli,g_m,end);
+
+		typedef NNType<dim,T,CellListImpl,decltype(it_seq),type,lid> NN_sel;
+
+		NN_sel::init(cli,r_cut);
+
+		// we use more blocks than threads to balance non uniform distributions
+		size_t nb = (n_work + VERLET_PARALLEL_GRAIN - 1) / VERLET_PARALLEL_GRAIN;
+		nb = (nb < 4*openfpm::get_num_threads())?nb:4*openfpm::get_num_threads();
+
+		// local buffers, particles processed, number of neighborhood, neighborhood and domain particles
+		openfpm::vector<openfpm::vector<lid>> part_b(nb);
+		openfpm::vector<openfpm::vector<lid>> n_nn_b(nb);
+		openfpm::vector<openfpm::vector<lid>> nn_b(nb);
+		openfpm::vector<openfpm::vector<lid>> dp_b(nb);
+
+		// square of the cutting radius
+		T r_cut2 = r_cut * r_cut;
+
+		openfpm::parallel_for_blocks(0,n_work,nb,[&](size_t b, size_t start, size_t stop)
+		{
+			openfpm::vector<size_t> dom_b;
+			openfpm::vector<subsub_lin<dim>> anom_b;
+
+			auto it = part_it_type::get_block(pos,dom,anom,cli,start,stop,dom_b,anom_b);
+
+			openfpm::vector<lid> & part = part_b.get(b);
+			openfpm::vector<lid> & n_nn = n_nn_b.get(b);
+			openfpm::vector<lid> & nn = nn_b.get(b);
+
+			while (it.isNext())
+			{
+				lid i = it.get();
+				Point<dim,T> xp = pos.template get<0>(i);
+
+				// Get the neighborhood of the particle
+				auto NN = NNType<dim,T,CellListImpl,decltype(it),type,lid>::get(it,pos,xp,i,cli,r_cut);
+				NNType<dim,T,CellListImpl,decltype(it),type,lid>::add(i,dp_b.get(b));
+
+				size_t n = 0;
+
+				while (NN.isNext())
+				{
+					auto nnp = NN.get();
+
+					Point<dim,T> xq = pos2.template get<0>(nnp);
+
+					if (xp.distance2(xq) < r_cut2)
+					{
+						nn.add(nnp);
+						n++;
+					}
+
+					// Next particle
+					++NN;
+				}
+
+				part.add(i);
+				n_nn.add(n);
+
+				++it;
+			}
+		});
+
+		// Merge the buffers
+
+		Mem_type::init_to_zero(slot,end);
+
+		openfpm::vector<lid> n_ele;
+		n_ele.resize(end);
+
+		openfpm::parallel_for(0,end,[&](size_t i){n_ele.get(i) = 0;});
+
+		openfpm::parallel_for_blocks(0,nb,nb,[&](size_t b, size_t start, size_t stop)
+		{
+			for (size_t k = 0 ; k < part_b.get(b).size() ; k++)
+			{n_ele.get(part_b.get(b).get(k)) = n_nn_b.get(b).get(k);}
+		});
+
+		Mem_type::set_n_elements_parallel(n_ele);
+
+		openfpm::vector<size_t> dp_off;
+		dp_off.resize(nb+1);
+		dp_off.get(0) = 0;
+
+		for (size_t b = 0 ; b < nb ; b++)
+		{dp_off.get(b+1) = dp_off.get(b) + dp_b.get(b).size();}
+
+		dp.resize(dp_off.get(nb));
+
+		openfpm::parallel_for_blocks(0,nb,nb,[&](size_t b, size_t start, size_t stop)
+		{
+			size_t off = 0;
+
+			for (size_t k = 0 ; k < part_b.get(b).size() ; k++)
+			{
+				lid i = part_b.get(b).get(k);
+
+				for (size_t j = 0 ; j < n_nn_b.get(b).get(k) ; j++)
+				{Mem_type::get(i,j) = nn_b.get(b).get(off + j);}
+
+				off += n_nn_b.get(b).get(k);
+			}
+
+			for (size_t k = 0 ; k < dp_b.get(b).size() ; k++)
+			{dp.get(dp_off.get(b) + k) = dp_b.get(b).get(k);}
+		});
+
+		return true;
+	}
+
 	/*! \brief Create the Verlet list from a given cell-list with a particular cut-off radius
 	 *
 	 * \param pos vector of positions of particles
@@ -494,6 +817,8 @@ public:
 	 * 			100 particles
 	 * \param opt option to generate Verlet list
 	 *
+	 * \note if a skin has been set the Verlet list is constructed with radius r_cut + skin
+	 *
 	 */
 	void Initialize(const Box<dim,T> & box, const Box<dim,T> & dom, T r_cut, vector_pos_type & pos, size_t g_m, size_t opt = VL_NON_SYMMETRIC)
 	{
@@ -502,6 +827,8 @@ public:
 
 		Box<dim,T> bt = box;
 
+		r_cut += skin;
+
 		// Calculate the divisions for the Cell-lists
 		cl_param_calculate(bt,div,r_cut,Ghost<dim,T>(0.0));
 
@@ -529,9 +856,13 @@ public:
 	 * 			if we have 120 particles and g_m = 100, the Verlet list will be constructed only for the first
 	 * 			100 particles
 	 *
+	 * \note with skin the ghost g must be bigger than r_cut + skin
+	 *
 	 */
 	void InitializeSym(const Box<dim,T> & box, const Box<dim,T> & dom, const Ghost<dim,T> & g, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m)
 	{
+		r_cut += skin;
+
 		// Padding
 		size_t pad = 0;
 
@@ -565,9 +896,13 @@ public:
 	 * 			if we have 120 particles and g_m = 100, the Verlet list will be constructed only for the first
 	 * 			100 particles
 	 *
+	 * \note with skin the ghost g must be bigger than r_cut + skin
+	 *
 	 */
 	void InitializeCrs(const Box<dim,T> & box, const Box<dim,T> & dom, const Ghost<dim,T> & g, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m)
 	{
+		r_cut += skin;
+
 		// Padding
 		size_t pad = 0;
 
@@ -595,10 +930,13 @@ public:
 	void createVerletCrs(T r_cut, size_t g_m, openfpm::vector<Point<dim,T>> & pos, openfpm::vector<size_t> & dom_c, openfpm::vector<subsub_lin<dim>> & anom_c)
 	{
 		// create verlet
-		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,VL_CRS_SYMMETRIC);
+		create(pos, pos,dom_c,anom_c,r_cut + skin,g_m,cli,VL_CRS_SYMMETRIC);
 	}
 
 	/*! \brief update the Verlet list
+	 *
+	 * \note if a skin has been set the Verlet list is reconstructed with radius r_cut + skin,
+	 *       use updateIfNeeded to reconstruct it only when a particle moved more than skin/2
 	 *
 	 * \param r_cut cutoff radius
 	 * \param dom Processor domain
@@ -615,10 +953,13 @@ public:
 		openfpm::vector<subsub_lin<dim>> anom_c;
 		openfpm::vector<size_t> dom_c;
 
-		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,opt);
+		create(pos, pos,dom_c,anom_c,r_cut + skin,g_m,cli,opt);
 	}
 
 	/*! \brief update the Verlet list
+	 *
+	 * \note if a skin has been set the Verlet list is reconstructed with radius r_cut + skin,
+	 *       use updateCrsIfNeeded to reconstruct it only when a particle moved more than skin/2
 	 *
 	 * \param r_cut cutoff radius
 	 * \param dom Processor domain
@@ -632,7 +973,116 @@ public:
 	{
 		initCl(cli,pos,g_m,VL_CRS_SYMMETRIC);
 
-		create(pos,pos,dom_c,anom_c,r_cut,g_m,cli,VL_CRS_SYMMETRIC);
+		create(pos,pos,dom_c,anom_c,r_cut + skin,g_m,cli,VL_CRS_SYMMETRIC);
+	}
+
+	/*! \brief update the Verlet list only if a particle moved more than skin/2
+	 *
+	 * from the position it had at the last construction (see needRebuild). Without skin the
+	 * Verlet list is always reconstructed
+	 *
+	 * \param r_cut cutoff radius
+	 * \param dom Processor domain
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 * \param opt option to create the Verlet list
+	 *
+	 * \return true if the Verlet list has been reconstructed
+	 *
+	 */
+	bool updateIfNeeded(const Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t & g_m, size_t opt)
+	{
+		if (needRebuild(pos) == false)
+		{return false;}
+
+		update(dom,r_cut,pos,g_m,opt);
+
+		return true;
+	}
+
+	/*! \brief update the Verlet list only if a particle moved more than skin/2
+	 *
+	 * from the position it had at the last construction (see needRebuild). Without skin the
+	 * Verlet list is always reconstructed
+	 *
+	 * \param r_cut cutoff radius
+	 * \param dom Processor domain
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 * \param dom_c list of cells with normal neighborhood
+	 * \param anom_c list of cells with anormal neighborhood
+	 *
+	 * \return true if the Verlet list has been reconstructed
+	 *
+	 */
+	bool updateCrsIfNeeded(const Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t & g_m, const openfpm::vector<size_t> & dom_c, const openfpm::vector<subsub_lin<dim>> & anom_c)
+	{
+		if (needRebuild(pos) == false)
+		{return false;}
+
+		updateCrs(dom,r_cut,pos,g_m,dom_c,anom_c);
+
+		return true;
+	}
+
+	/*! \brief Set the skin
+	 *
+	 * The Verlet list is constructed with radius r_cut + skin, the neighborhood contain all the
+	 * particles within r_cut until no particle moved more than skin/2. The interaction loops must
+	 * still filter the neighborhood particles by r_cut. It has effect from the next construction
+	 *
+	 * \param skin skin (0 disable the displacement tracking)
+	 *
+	 */
+	void setSkin(T skin)
+	{
+		this->skin = skin;
+
+		pos_ref.clear();
+	}
+
+	/*! \brief Get the skin
+	 *
+	 * \return the skin
+	 *
+	 */
+	T getSkin() const
+	{
+		return skin;
+	}
+
+	/*! \brief Check if the Verlet list must be reconstructed
+	 *
+	 * It is true if any particle moved more than skin/2 from the position it had at the
+	 * last construction, if the number of particles changed or if the skin is zero.
+	 *
+	 * \warning the particles are identified by their index, if the particles are reordered
+	 *          the Verlet list must be reconstructed
+	 *
+	 * \param pos vector of particle positions
+	 *
+	 * \return true if the Verlet list must be reconstructed
+	 *
+	 */
+	template<typename vector_pos_type2>
+	bool needRebuild(const vector_pos_type2 & pos) const
+	{
+		if (skin == 0 || pos.size() != pos_ref.size())
+		{return true;}
+
+		T lim2 = skin * skin / 4;
+
+		size_t n_moved = openfpm::parallel_reduce(0,pos.size(),(size_t)0,
+			[&](size_t i)
+			{
+				Point<dim,T> xp = pos.template get<0>(i);
+				Point<dim,T> xr = pos_ref.template get<0>(i);
+
+				return (xp.distance2(xr) > lim2)?(size_t)1:(size_t)0;
+			},
+			[](size_t a, size_t b){return a + b;});
+
+		return n_moved != 0;
 	}
 
 	/*! Initialize the verlet list from an already filled cell-list
@@ -646,6 +1096,8 @@ public:
 	 * 			100 particles
 	 * 	\param opt options for the Verlet-list creation
 	 *
+	 * \note if a skin has been set the Verlet list is constructed with radius r_cut + skin
+	 *
 	 */
 	void Initialize(CellListImpl & cli,
 					T r_cut,
@@ -655,6 +1107,8 @@ public:
 	{
 		Point<dim,T> spacing = cli.getCellBox().getP2();
 
+		r_cut += skin;
+
 		// Create with radius or not
 		bool wr = true;
 
@@ -679,19 +1133,19 @@ public:
 
 	//! Default Constructor
 	VerletList()
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0),skin(0)
 	{};
 
 	//! Copy constructor
 	VerletList(const VerletList<dim,T,Mem_type,transform,vector_pos_type,CellListImpl> & cell)
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),skin(0)
 	{
 		this->operator=(cell);
 	}
 
 	//! Copy constructor
 	VerletList(VerletList<dim,T,Mem_type,transform,vector_pos_type,CellListImpl> && cell)
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0),skin(0)
 	{
 		this->operator=(cell);
 	}
@@ -707,7 +1161,7 @@ public:
 	 *
 	 */
 	VerletList(Box<dim,T> & box, T r_cut, Matrix<dim,T> mat, const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:slot(VERLET_STARTING_NSLOT),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad)
+	:slot(VERLET_STARTING_NSLOT),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad),skin(0)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,r_cut,pad,slot);
@@ -727,7 +1181,7 @@ public:
 	 *
 	 */
 	VerletList(Box<dim,T> & box, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t slot=VERLET_STARTING_NSLOT)
-	:slot(slot)
+	:slot(slot),skin(0)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,r_cut,pos,g_m);
@@ -748,7 +1202,7 @@ public:
 	 *
 	 */
 	VerletList(SpaceBox<dim,T> & box, Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t slot=VERLET_STARTING_NSLOT)
-	:slot(slot)
+	:slot(slot),skin(0)
 	{
 		Initialize(box,r_cut,pos);
 	}
@@ -777,6 +1231,9 @@ public:
 
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		pos_ref.swap(vl.pos_ref);
+
 		return *this;
 	}
 
@@ -799,6 +1256,9 @@ public:
 		dp = vl.dp;
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		pos_ref = vl.pos_ref;
+
 		return *this;
 	}
 
@@ -846,6 +1306,12 @@ public:
 		size_t n_dec_tmp = vl.n_dec;
 		vl.n_dec = n_dec;
 		n_dec = n_dec_tmp;
+
+		T skin_tmp = vl.skin;
+		vl.skin = skin;
+		skin = skin_tmp;
+
+		pos_ref.swap(vl.pos_ref);
 	}
 
 	/*! \brief Get the Neighborhood iterator
@@ -472,9 +472,303 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_sM(SpaceB
 	}
 }
 
+/*! \brief Check that two Verlet-lists are identical
+ *
+ * \param vl1 first Verlet-list
+ * \param vl2 second Verlet-list
+ * \param n number of particles to check
+ *
+ */
+template<typename VerS> void Verlet_list_check_equal(VerS & vl1, VerS & vl2, size_t n)
+{
+	bool match = true;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		match &= vl1.getNNPart(i) == vl2.getNNPart(i);
+
+		for (size_t j = 0 ; j < vl1.getNNPart(i) && match == true ; j++)
+		{match &= vl1.get(i,j) == vl2.get(i,j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	BOOST_REQUIRE_EQUAL(vl1.getParticleSeq().size(),vl2.getParticleSeq().size());
+
+	for (size_t i = 0 ; i < vl1.getParticleSeq().size() ; i++)
+	{match &= vl1.getParticleSeq().get(i) == vl2.getParticleSeq().get(i);}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Check that the parallel construction of the Verlet-list produce the same
+ *         Verlet-list of the sequential construction
+ *
+ */
+template<unsigned int dim, typename T, typename VerS> void Verlet_list_parallel(SpaceBox<dim,T> & box)
+{
+	T r_cut = 0.05;
+
+	openfpm::vector<Point<dim,T>> pos;
+
+	for (size_t j = 0 ; j < 20000 ; j++)
+	{
+		pos.add();
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{pos.template get<0>(j)[i] = (T)rand() / RAND_MAX * (box.getHigh(i) - box.getLow(i)) + box.getLow(i);}
+	}
+
+	size_t n_threads = openfpm::get_num_threads();
+	Ghost<dim,T> g(r_cut);
+
+	// non symmetric
+
+	VerS vl_seq;
+	VerS vl_par;
+
+	openfpm::set_num_threads(1);
+	vl_seq.Initialize(box,box,r_cut,pos,pos.size());
+	openfpm::set_num_threads(4);
+	vl_par.Initialize(box,box,r_cut,pos,pos.size());
+
+	Verlet_list_check_equal(vl_seq,vl_par,pos.size());
+
+	// non symmetric from an external Cell-list with spacing smaller than r_cut (neighborhood with radius)
+
+	typename VerS::CellListImpl_ cl_ext;
+	size_t div[dim];
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{div[i] = (box.getHigh(i) - box.getLow(i)) / (r_cut / 2.0);}
+
+	cl_ext.Initialize(box,div,3);
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{cl_ext.add(pos.template get<0>(i),i);}
+
+	VerS vlr_seq;
+	VerS vlr_par;
+
+	openfpm::set_num_threads(1);
+	vlr_seq.Initialize(cl_ext,r_cut,pos,pos,pos.size());
+	openfpm::set_num_threads(4);
+	vlr_par.Initialize(cl_ext,r_cut,pos,pos,pos.size());
+
+	Verlet_list_check_equal(vlr_seq,vlr_par,pos.size());
+
+	// symmetric
+
+	VerS vls_seq;
+	VerS vls_par;
+
+	openfpm::set_num_threads(1);
+	vls_seq.InitializeSym(box,box,g,r_cut,pos,pos.size());
+	openfpm::set_num_threads(4);
+	vls_par.InitializeSym(box,box,g,r_cut,pos,pos.size());
+
+	Verlet_list_check_equal(vls_seq,vls_par,pos.size());
+
+	// CRS symmetric, all the domain cells have normal neighborhood
+
+	VerS vlc_seq;
+	VerS vlc_par;
+
+	openfpm::set_num_threads(1);
+	vlc_seq.InitializeCrs(box,box,g,r_cut,pos,pos.size());
+	openfpm::set_num_threads(4);
+	vlc_par.InitializeCrs(box,box,g,r_cut,pos,pos.size());
+
+	auto & cli = vlc_seq.getInternalCellList();
+
+	grid_key_dx<dim> start;
+	grid_key_dx<dim> stop;
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		start.set_d(i,cli.getPadding(i));
+		stop.set_d(i,cli.getGrid().size(i) - cli.getPadding(i) - 1);
+	}
+
+	openfpm::vector<size_t> dom_c;
+	openfpm::vector<subsub_lin<dim>> anom_c;
+
+	grid_key_dx_iterator_sub<dim> it(cli.getGrid(),start,stop);
+
+	while (it.isNext())
+	{
+		dom_c.add(cli.getGrid().LinId(it.get()));
+
+		++it;
+	}
+
+	openfpm::set_num_threads(1);
+	vlc_seq.createVerletCrs(r_cut,pos.size(),pos,dom_c,anom_c);
+	openfpm::set_num_threads(4);
+	vlc_par.createVerletCrs(r_cut,pos.size(),pos,dom_c,anom_c);
+
+	Verlet_list_check_equal(vlc_seq,vlc_par,pos.size());
+
+	openfpm::set_num_threads(n_threads);
+}
+
+/*! \brief Check that the neighborhood of a Verlet-list constructed with skin filtered by r_cut
+ *         contain exactly the particles within r_cut
+ *
+ */
+template<unsigned int dim, typename T, typename VerS> void Verlet_list_check_skin(VerS & vl, openfpm::vector<Point<dim,T>> & pos, T r_cut)
+{
+	bool match = true;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		Point<dim,T> xp = pos.template get<0>(i);
+
+		openfpm::vector<size_t> nn_vl;
+		openfpm::vector<size_t> nn_bf;
+
+		auto NN = vl.template getNNIterator<NO_CHECK>(i);
+
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+			Point<dim,T> xq = pos.template get<0>(q);
+
+			if (xp.distance2(xq) < r_cut*r_cut)
+			{nn_vl.add(q);}
+
+			++NN;
+		}
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<dim,T> xq = pos.template get<0>(q);
+
+			if (xp.distance2(xq) < r_cut*r_cut)
+			{nn_bf.add(q);}
+		}
+
+		nn_vl.sort();
+
+		match &= nn_vl.size() == nn_bf.size();
+
+		for (size_t j = 0 ; j < nn_vl.size() && match == true ; j++)
+		{match &= nn_vl.get(j) == nn_bf.get(j);}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
 
 BOOST_AUTO_TEST_SUITE( VerletList_test )
 
+BOOST_AUTO_TEST_CASE( VerletList_skin )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+
+	double r_cut = 0.1;
+	double skin = 0.04;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t j = 0 ; j < 2000 ; j++)
+	{
+		pos.add();
+
+		for (size_t i = 0 ; i < 3 ; i++)
+		{pos.template get<0>(j)[i] = 0.05 + 0.9 * (double)rand() / RAND_MAX;}
+	}
+
+	VerletList<3,double,Mem_fast<>> vl;
+	vl.setSkin(skin);
+
+	BOOST_REQUIRE_EQUAL(vl.getSkin(),skin);
+
+	vl.Initialize(box,box,r_cut,pos,pos.size());
+
+	Verlet_list_check_skin(vl,pos,r_cut);
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+
+	// Move all the particles less than skin/2
+
+	for (size_t j = 0 ; j < pos.size() ; j++)
+	{
+		for (size_t i = 0 ; i < 3 ; i++)
+		{pos.template get<0>(j)[i] += ((j+i) % 2 == 0)?0.011:-0.011;}
+	}
+
+	size_t g_m = pos.size();
+
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+	BOOST_REQUIRE_EQUAL(vl.updateIfNeeded(box,r_cut,pos,g_m,VL_NON_SYMMETRIC),false);
+
+	Verlet_list_check_skin(vl,pos,r_cut);
+
+	// Move one particle more than skin/2
+
+	pos.template get<0>(100)[0] += 0.015;
+
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),true);
+	BOOST_REQUIRE_EQUAL(vl.updateIfNeeded(box,r_cut,pos,g_m,VL_NON_SYMMETRIC),true);
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+
+	Verlet_list_check_skin(vl,pos,r_cut);
+
+	// update always reconstruct
+
+	vl.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),false);
+
+	Verlet_list_check_skin(vl,pos,r_cut);
+
+	// Loop with getNNPart, the list contain the skin, filtering by r_cut give the exact neighborhood
+
+	size_t n_skin = 0;
+	bool match = true;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		Point<3,double> xp = pos.template get<0>(i);
+
+		size_t n_vl = 0;
+		for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+		{
+			Point<3,double> xq = pos.template get<0>(vl.get(i,j));
+
+			if (xp.distance2(xq) < r_cut*r_cut)
+			{n_vl++;}
+			else
+			{n_skin++;}
+		}
+
+		size_t n_bf = 0;
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+
+			if (xp.distance2(xq) < r_cut*r_cut)
+			{n_bf++;}
+		}
+
+		match &= n_vl == n_bf;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(n_skin != 0);
+
+	// Without skin we always reconstruct
+
+	vl.setSkin(0.0);
+	BOOST_REQUIRE_EQUAL(vl.needRebuild(pos),true);
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_parallel_construct )
+{
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+
+	Verlet_list_parallel<3,double,VerletList<3,double,Mem_fast<>,shift<3,double>>>(box);
+	Verlet_list_parallel<3,double,VerletList<3,double,Mem_csr<>,shift<3,double>>>(box);
+}
+
 BOOST_AUTO_TEST_CASE( VerletList_use)
 {
 	std::cout << "Test verlet list" << "\n";
@@ -500,28 +500,58 @@ template <typename> struct Debug;
 template<bool is_not_zero, typename T, typename T_nc, int ... prp>
 struct selector_chunking_prp_has_zero_size
 {
-	template<typename Mem> static inline void select(ExtPreAlloc<Mem> & mem,  const T & eobj, size_t sub_id)
+	//! size of the packed element
+	static constexpr size_t size()
+	{
+		return sizeof(T_nc);
+	}
+
+	/*! \brief Pack the element sub_id of the chunk at the address ptr
+	 *
+	 * \param ptr where to pack (at least size() bytes)
+	 * \param eobj chunk
+	 * \param sub_id element in the chunk
+	 *
+	 */
+	static inline void select_ptr(void * ptr,  const T & eobj, size_t sub_id)
 	{
-		mem.allocate(sizeof(T_nc));
-		encapc<1,T_nc,typename memory_traits_lin< T_nc >::type> enc(*static_cast<typename T_nc::type *>(mem.getPointer()));
+		encapc<1,T_nc,typename memory_traits_lin< T_nc >::type> enc(*static_cast<typename T_nc::type *>(ptr));
 		copy_packer_chunk<decltype(eobj),
 		                  encapc<1,T_nc,typename memory_traits_lin< T_nc >::type>> cp(eobj,sub_id,enc);
 		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::T_type::max_prop>>(cp);
 		//enc = eobj[sub_id];
 	}
+
+	template<typename Mem> static inline void select(ExtPreAlloc<Mem> & mem,  const T & eobj, size_t sub_id)
+	{
+		mem.allocate(size());
+		select_ptr(mem.getPointer(),eobj,sub_id);
+	}
 };
 
 template<typename T,  typename T_nc, int ... prp>
 struct selector_chunking_prp_has_zero_size<true,T,T_nc,prp...>
 {
-	template<typename Mem> static inline void select(ExtPreAlloc<Mem> & mem,  const T & eobj, size_t sub_id)
+	// Here we create an encap without array extent
+	typedef object<typename object_creator_chunking<typename T::type,prp...>::type> prp_object;
+
+	//! size of the packed element
+	static constexpr size_t size()
 	{
-		// Here we create an encap without array extent
-		typedef object<typename object_creator_chunking<typename T::type,prp...>::type> prp_object;
-		mem.allocate(sizeof(prp_object));
-		encapc<1,prp_object,typename memory_traits_lin< prp_object>::type> enc(*static_cast<typename prp_object::type *>(mem.getPointer()));
+		return sizeof(prp_object);
+	}
+
+	static inline void select_ptr(void * ptr,  const T & eobj, size_t sub_id)
+	{
+		encapc<1,prp_object,typename memory_traits_lin< prp_object>::type> enc(*static_cast<typename prp_object::type *>(ptr));
 		object_si_d<T,decltype(enc),OBJ_ENCAP_CHUNKING,prp ... >(eobj,sub_id,enc);
 	}
+
+	template<typename Mem> static inline void select(ExtPreAlloc<Mem> & mem,  const T & eobj, size_t sub_id)
+	{
+		mem.allocate(size());
+		select_ptr(mem.getPointer(),eobj,sub_id);
+	}
 };
 
 template<typename T, typename Mem>
@@ -552,6 +582,39 @@ public:
 		sts.incReq();
 	}
 
+	/*! \brief Size of one packed element of the chunk
+	 *
+	 * \note valid only when the properties do not have a pack() member (has_pack_encap is false)
+	 *
+	 * \tparam T_nc object without chunking
+	 *
+	 * \return the number of bytes pack() allocate for one element
+	 *
+	 */
+	template<typename T_nc, int ... prp> static constexpr size_t packSize()
+	{
+		return selector_chunking_prp_has_zero_size<sizeof...(prp) != 0,T, T_nc, prp ...>::size();
+	}
+
+	/*! \brief Pack the element sub_id of the chunk at the address ptr (without allocating)
+	 *
+	 * It write the same bytes of pack(). It does not touch the memory object, so different
+	 * elements can be packed concurrently at different addresses
+	 *
+	 * \note valid only when the properties do not have a pack() member (has_pack_encap is false)
+	 *
+	 * \tparam T_nc object without chunking
+	 *
+	 * \param ptr where to pack (at least packSize() bytes)
+	 * \param eobj chunk
+	 * \param sub_id element in the chunk
+	 *
+	 */
+	template<typename T_nc, int ... prp> static inline void pack_ptr(void * ptr, const T & eobj, size_t sub_id)
+	{
+		selector_chunking_prp_has_zero_size<sizeof...(prp) != 0,T, T_nc, prp ...>::select_ptr(ptr,eobj,sub_id);
+	}
+
 	/*! \brief
 	 *
 	 *
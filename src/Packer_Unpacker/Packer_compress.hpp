@@ -0,0 +1,918 @@
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_COMPRESS_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_COMPRESS_HPP_
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "Packer.hpp"
+#include "Unpacker.hpp"
+
+//! No compression
+#define PACK_CODEC_NONE 0
+
+//! Byte shuffle + LZ (generic data)
+#define PACK_CODEC_SHUFFLE_LZ 1
+
+//! XOR with the previous element + byte shuffle + LZ (smooth floating point fields)
+#define PACK_CODEC_XOR_DELTA 2
+
+//! Run length (masks and mostly-background data)
+#define PACK_CODEC_RLE 3
+
+//! Minimum match of the LZ codec
+#define PACK_LZ_MIN_MATCH 4
+
+//! Bits of the hash table of the LZ codec
+#define PACK_LZ_HASH_BITS 14
+
+/*! \brief Header of a compressed block
+ *
+ * A compressed block is the header followed by the compressed stream
+ *
+ */
+struct pack_compress_header
+{
+	//! size of the uncompressed data
+	size_t raw;
+
+	//! size of the compressed data
+	size_t comp;
+
+	//! codec used (PACK_CODEC_NONE if compression did not reduce the size)
+	size_t codec;
+
+	//! size of the element used by shuffle and XOR-delta
+	size_t stride;
+};
+
+/*! \brief Bytes shuffle
+ *
+ * The byte k of every element are stored contiguously, for floating point data the exponents
+ * and the most significant bits of the mantissa are grouped together and compress better
+ *
+ * \param src source
+ * \param dst destination
+ * \param n number of byte
+ * \param stride size of the element
+ *
+ */
+static inline void pack_shuffle(const unsigned char * src, unsigned char * dst, size_t n, size_t stride)
+{
+	size_t nel = n / stride;
+
+	for (size_t i = 0 ; i < nel ; i++)
+	{
+		for (size_t k = 0 ; k < stride ; k++)
+		{dst[k*nel + i] = src[i*stride + k];}
+	}
+
+	memcpy(dst + nel*stride,src + nel*stride,n - nel*stride);
+}
+
+/*! \brief Inverse of pack_shuffle
+ *
+ * \param src source
+ * \param dst destination
+ * \param n number of byte
+ * \param stride size of the element
+ *
+ */
+static inline void pack_unshuffle(const unsigned char * src, unsigned char * dst, size_t n, size_t stride)
+{
+	size_t nel = n / stride;
+
+	for (size_t k = 0 ; k < stride ; k++)
+	{
+		for (size_t i = 0 ; i < nel ; i++)
+		{dst[i*stride + k] = src[k*nel + i];}
+	}
+
+	memcpy(dst + nel*stride,src + nel*stride,n - nel*stride);
+}
+
+/*! \brief XOR every byte with the byte of the previous element
+ *
+ * Smooth fields produce elements that differ only in the last bits of the mantissa
+ *
+ * \param src source
+ * \param dst destination
+ * \param n number of byte
+ * \param stride size of the element
+ *
+ */
+static inline void pack_xor_delta(const unsigned char * src, unsigned char * dst, size_t n, size_t stride)
+{
+	size_t s = std::min(stride,n);
+
+	memcpy(dst,src,s);
+
+	for (size_t i = s ; i < n ; i++)
+	{dst[i] = src[i] ^ src[i - stride];}
+}
+
+/*! \brief Inverse of pack_xor_delta (in place)
+ *
+ * \param buf buffer
+ * \param n number of byte
+ * \param stride size of the element
+ *
+ */
+static inline void pack_xor_undelta(unsigned char * buf, size_t n, size_t stride)
+{
+	for (size_t i = stride ; i < n ; i++)
+	{buf[i] ^= buf[i - stride];}
+}
+
+/*! \brief Write a length in the LZ stream (255 continuation bytes)
+ *
+ * \param dst stream
+ * \param op position in the stream
+ * \param cap capacity of the stream
+ * \param len length to write
+ *
+ * \return false if the stream is full
+ *
+ */
+static inline bool pack_lz_put_len(unsigned char * dst, size_t & op, size_t cap, size_t len)
+{
+	while (len >= 255)
+	{
+		if (op >= cap) {return false;}
+		dst[op++] = 255;
+		len -= 255;
+	}
+
+	if (op >= cap) {return false;}
+	dst[op++] = len;
+
+	return true;
+}
+
+/*! \brief Write an LZ sequence (literals followed by a match)
+ *
+ * \param dst stream
+ * \param op position in the stream
+ * \param cap capacity of the stream
+ * \param lit literals
+ * \param n_lit number of literals
+ * \param off offset of the match (ignored if match is 0)
+ * \param match length of the match (0 for the last sequence)
+ *
+ * \return false if the stream is full
+ *
+ */
+static inline bool pack_lz_put_seq(unsigned char * dst, size_t & op, size_t cap,
+		                           const unsigned char * lit, size_t n_lit,
+								   size_t off, size_t match)
+{
+	size_t ml = (match == 0)?0:match - PACK_LZ_MIN_MATCH;
+
+	if (op >= cap) {return false;}
+	dst[op++] = (std::min(n_lit,(size_t)15) << 4) | std::min(ml,(size_t)15);
+
+	if (n_lit >= 15 && pack_lz_put_len(dst,op,cap,n_lit - 15) == false)
+	{return false;}
+
+	if (op + n_lit > cap) {return false;}
+	memcpy(dst + op,lit,n_lit);
+	op += n_lit;
+
+	if (match == 0)
+	{return true;}
+
+	if (op + 2 > cap) {return false;}
+	dst[op++] = off & 0xFF;
+	dst[op++] = (off >> 8) & 0xFF;
+
+	if (ml >= 15 && pack_lz_put_len(dst,op,cap,ml - 15) == false)
+	{return false;}
+
+	return true;
+}
+
+/*! \brief LZ compression (LZ77 with hash table, 64KB window)
+ *
+ * The stream is a sequence of [token][literal length][literals][offset][match length], the
+ * last sequence contain only literals
+ *
+ * \param src source
+ * \param n number of byte
+ * \param dst destination
+ * \param cap capacity of the destination
+ *
+ * \return the size of the compressed stream, 0 if it does not fit in cap
+ *
+ */
+static inline size_t pack_lz_compress(const unsigned char * src, size_t n, unsigned char * dst, size_t cap)
+{
+	std::vector<size_t> table(1 << PACK_LZ_HASH_BITS,0);
+
+	size_t ip = 0;
+	size_t anchor = 0;
+	size_t op = 0;
+
+	// the last bytes are always literals
+	size_t limit = (n > 2*PACK_LZ_MIN_MATCH)?n - 2*PACK_LZ_MIN_MATCH:0;
+
+	while (ip < limit)
+	{
+		uint32_t seq;
+		memcpy(&seq,src + ip,sizeof(seq));
+
+		size_t h = (seq * 2654435761u) >> (32 - PACK_LZ_HASH_BITS);
+		size_t ref = table[h];
+		table[h] = ip + 1;
+
+		uint32_t seq_ref;
+		if (ref != 0 && ip - (ref - 1) <= 0xFFFF && (memcpy(&seq_ref,src + ref - 1,sizeof(seq_ref)),seq_ref == seq))
+		{
+			size_t m = ref - 1;
+			size_t len = PACK_LZ_MIN_MATCH;
+
+			while (ip + len < limit && src[m + len] == src[ip + len])
+			{len++;}
+
+			if (pack_lz_put_seq(dst,op,cap,src + anchor,ip - anchor,ip - m,len) == false)
+			{return 0;}
+
+			ip += len;
+			anchor = ip;
+		}
+		else
+		{ip++;}
+	}
+
+	if (pack_lz_put_seq(dst,op,cap,src + anchor,n - anchor,0,0) == false)
+	{return 0;}
+
+	return op;
+}
+
+/*! \brief Read a length from the LZ stream
+ *
+ * \param src stream
+ * \param ip position in the stream
+ * \param n size of the stream
+ * \param len length to increment
+ *
+ * \return false if the stream is corrupted
+ *
+ */
+static inline bool pack_lz_get_len(const unsigned char * src, size_t & ip, size_t n, size_t & len)
+{
+	unsigned char b;
+
+	do
+	{
+		if (ip >= n) {return false;}
+		b = src[ip++];
+		len += b;
+	} while (b == 255);
+
+	return true;
+}
+
+/*! \brief LZ decompression
+ *
+ * \param src compressed stream
+ * \param n size of the compressed stream
+ * \param dst destination
+ * \param cap capacity of the destination
+ *
+ * \return the size of the decompressed data, (size_t)-1 if the stream is corrupted
+ *
+ */
+static inline size_t pack_lz_decompress(const unsigned char * src, size_t n, unsigned char * dst, size_t cap)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < n)
+	{
+		unsigned char tok = src[ip++];
+
+		size_t n_lit = tok >> 4;
+		if (n_lit == 15 && pack_lz_get_len(src,ip,n,n_lit) == false)
+		{return (size_t)-1;}
+
+		if (ip + n_lit > n || op + n_lit > cap)
+		{return (size_t)-1;}
+
+		memcpy(dst + op,src + ip,n_lit);
+		ip += n_lit;
+		op += n_lit;
+
+		if (ip == n)
+		{break;}
+
+		if (ip + 2 > n)
+		{return (size_t)-1;}
+
+		size_t off = src[ip] | ((size_t)src[ip+1] << 8);
+		ip += 2;
+
+		size_t match = tok & 15;
+		if (match == 15 && pack_lz_get_len(src,ip,n,match) == false)
+		{return (size_t)-1;}
+		match += PACK_LZ_MIN_MATCH;
+
+		if (off == 0 || off > op || op + match > cap)
+		{return (size_t)-1;}
+
+		// the match can overlap the output, copy byte by byte
+		for (size_t i = 0 ; i < match ; i++)
+		{dst[op + i] = dst[op + i - off];}
+
+		op += match;
+	}
+
+	return op;
+}
+
+/*! \brief Run length compression
+ *
+ * A control byte c < 128 is followed by c+1 literals, c >= 128 is followed by one byte repeated c-125 times
+ *
+ * \param src source
+ * \param n number of byte
+ * \param dst destination
+ * \param cap capacity of the destination
+ *
+ * \return the size of the compressed stream, 0 if it does not fit in cap
+ *
+ */
+static inline size_t pack_rle_compress(const unsigned char * src, size_t n, unsigned char * dst, size_t cap)
+{
+	size_t ip = 0;
+	size_t op = 0;
+	size_t anchor = 0;
+
+	while (ip <= n)
+	{
+		size_t run = 1;
+
+		if (ip < n)
+		{
+			while (ip + run < n && run < 130 && src[ip + run] == src[ip])
+			{run++;}
+		}
+
+		// flush the literals when a run start, at the end or when they are 128
+		if (ip == n || run >= 3 || ip - anchor == 128)
+		{
+			while (anchor < ip)
+			{
+				size_t l = std::min(ip - anchor,(size_t)128);
+
+				if (op + l + 1 > cap) {return 0;}
+				dst[op++] = l - 1;
+				memcpy(dst + op,src + anchor,l);
+				op += l;
+				anchor += l;
+			}
+		}
+
+		if (ip == n)
+		{break;}
+
+		if (run >= 3)
+		{
+			if (op + 2 > cap) {return 0;}
+			dst[op++] = run + 125;
+			dst[op++] = src[ip];
+			ip += run;
+			anchor = ip;
+		}
+		else
+		{ip++;}
+	}
+
+	return op;
+}
+
+/*! \brief Run length decompression
+ *
+ * \param src compressed stream
+ * \param n size of the compressed stream
+ * \param dst destination
+ * \param cap capacity of the destination
+ *
+ * \return the size of the decompressed data, (size_t)-1 if the stream is corrupted
+ *
+ */
+static inline size_t pack_rle_decompress(const unsigned char * src, size_t n, unsigned char * dst, size_t cap)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < n)
+	{
+		unsigned char c = src[ip++];
+
+		if (c < 128)
+		{
+			size_t l = c + 1;
+			if (ip + l > n || op + l > cap) {return (size_t)-1;}
+
+			memcpy(dst + op,src + ip,l);
+			ip += l;
+			op += l;
+		}
+		else
+		{
+			size_t l = c - 125;
+			if (ip >= n || op + l > cap) {return (size_t)-1;}
+
+			memset(dst + op,src[ip++],l);
+			op += l;
+		}
+	}
+
+	return op;
+}
+
+/*! \brief Compress a buffer
+ *
+ * \param codec PACK_CODEC_SHUFFLE_LZ PACK_CODEC_XOR_DELTA PACK_CODEC_RLE
+ * \param src source
+ * \param n number of byte
+ * \param stride size of the element for shuffle and XOR-delta
+ * \param dst destination
+ * \param cap capacity of the destination
+ *
+ * \return the size of the compressed data, 0 if it does not fit in cap
+ *
+ */
+static inline size_t pack_compress(size_t codec, const unsigned char * src, size_t n, size_t stride, unsigned char * dst, size_t cap)
+{
+	if (n == 0)
+	{return 0;}
+
+	if (stride == 0)
+	{stride = 1;}
+
+	if (codec == PACK_CODEC_RLE)
+	{return pack_rle_compress(src,n,dst,cap);}
+
+	std::vector<unsigned char> tmp(n);
+
+	if (codec == PACK_CODEC_XOR_DELTA)
+	{
+		std::vector<unsigned char> dlt(n);
+		pack_xor_delta(src,dlt.data(),n,stride);
+		pack_shuffle(dlt.data(),tmp.data(),n,stride);
+	}
+	else if (codec == PACK_CODEC_SHUFFLE_LZ)
+	{pack_shuffle(src,tmp.data(),n,stride);}
+	else
+	{return 0;}
+
+	return pack_lz_compress(tmp.data(),n,dst,cap);
+}
+
+/*! \brief Decompress a buffer
+ *
+ * \param codec codec used to compress
+ * \param src compressed data
+ * \param n size of the compressed data
+ * \param stride size of the element for shuffle and XOR-delta
+ * \param dst destination
+ * \param raw size of the decompressed data
+ *
+ * \return true if the decompressed data has the expected size
+ *
+ */
+static inline bool pack_decompress(size_t codec, const unsigned char * src, size_t n, size_t stride, unsigned char * dst, size_t raw)
+{
+	if (raw == 0)
+	{return n == 0;}
+
+	if (stride == 0)
+	{stride = 1;}
+
+	if (codec == PACK_CODEC_NONE)
+	{
+		memcpy(dst,src,n);
+		return n == raw;
+	}
+
+	if (codec == PACK_CODEC_RLE)
+	{return pack_rle_decompress(src,n,dst,raw) == raw;}
+
+	std::vector<unsigned char> tmp(raw);
+
+	if (pack_lz_decompress(src,n,tmp.data(),raw) != raw)
+	{return false;}
+
+	pack_unshuffle(tmp.data(),dst,raw,stride);
+
+	if (codec == PACK_CODEC_XOR_DELTA)
+	{pack_xor_undelta(dst,raw,stride);}
+
+	return true;
+}
+
+/*! \brief Worst case size of a compressed block
+ *
+ * If the compression does not reduce the size the data are stored uncompressed
+ *
+ * \param raw size of the uncompressed data
+ *
+ * \return the worst case size of the block (header included)
+ *
+ */
+static inline size_t pack_compress_bound(size_t raw)
+{
+	return sizeof(pack_compress_header) + raw;
+}
+
+/*! \brief Pack into a temporary buffer and store it compressed in mem
+ *
+ * \param mem preallocated memory where to store the compressed block
+ * \param raw size of the uncompressed data (from packRequest)
+ * \param stride size of the element for shuffle and XOR-delta
+ * \param codec codec
+ * \param pack_f function that pack into an ExtPreAlloc
+ *
+ */
+template<typename Mem, typename lambda_f>
+void pack_compressed(ExtPreAlloc<Mem> & mem, size_t raw, size_t stride, size_t codec, lambda_f pack_f)
+{
+	Mem tmp;
+	tmp.allocate(raw);
+	ExtPreAlloc<Mem> ext(raw,tmp);
+	ext.incRef();
+
+	pack_f(ext);
+
+	// reserve the worst case, and release what is not used after compression
+	mem.allocate(pack_compress_bound(raw));
+	unsigned char * blk = (unsigned char *)mem.getPointer();
+
+	pack_compress_header hd;
+	hd.raw = ext.size();
+	hd.stride = stride;
+	hd.codec = codec;
+	hd.comp = 0;
+
+	if (codec != PACK_CODEC_NONE)
+	{hd.comp = pack_compress(codec,(unsigned char *)ext.getPointerBase(),hd.raw,stride,blk + sizeof(pack_compress_header),hd.raw);}
+
+	// no gain, store uncompressed
+	if (hd.comp == 0 || hd.comp >= hd.raw)
+	{
+		hd.codec = PACK_CODEC_NONE;
+		hd.comp = hd.raw;
+		memcpy(blk + sizeof(pack_compress_header),ext.getPointerBase(),hd.raw);
+	}
+
+	memcpy(blk,&hd,sizeof(pack_compress_header));
+
+	mem.shift_backward(0);
+	mem.allocate(sizeof(pack_compress_header) + hd.comp);
+
+	ext.decRef();
+}
+
+/*! \brief Decompress a block from mem and unpack it
+ *
+ * \param mem memory containing the compressed block
+ * \param ps unpack statistic
+ * \param unpack_f function that unpack from an ExtPreAlloc and an Unpack_stat
+ *
+ */
+template<typename Mem, typename lambda_f>
+void unpack_compressed(ExtPreAlloc<Mem> & mem, Unpack_stat & ps, lambda_f unpack_f)
+{
+	pack_compress_header hd;
+	memcpy(&hd,mem.getPointerOffset(ps.getOffset()),sizeof(pack_compress_header));
+	ps.addOffset(sizeof(pack_compress_header));
+
+	// uncompressed block, unpack in place
+	if (hd.codec == PACK_CODEC_NONE)
+	{
+		size_t start = ps.getOffset();
+		unpack_f(mem,ps);
+		ps.setOffset(start + hd.comp);
+		return;
+	}
+
+	Mem tmp;
+	tmp.allocate(hd.raw);
+	ExtPreAlloc<Mem> ext(hd.raw,tmp);
+	ext.incRef();
+
+	if (pack_decompress(hd.codec,(unsigned char *)mem.getPointerOffset(ps.getOffset()),hd.comp,hd.stride,(unsigned char *)tmp.getPointer(),hd.raw) == false)
+	{std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " corrupted compressed block" << std::endl;}
+
+	Unpack_stat ps_t;
+	unpack_f(ext,ps_t);
+
+	ps.addOffset(hd.comp);
+
+	ext.decRef();
+}
+
+/*! \brief Size of the packed element of T (used as stride by shuffle and XOR-delta)
+ *
+ * \tparam T vector or grid
+ * \tparam is_agg true if T contain aggregates
+ * \tparam prp properties
+ *
+ */
+template<typename T, bool is_agg, int ... prp>
+struct pack_compress_stride_impl
+{
+	typedef object<typename object_creator<typename T::value_type::type,prp...>::type> prp_object;
+
+	enum
+	{
+		value = (sizeof...(prp) == 0)?sizeof(typename T::value_type::type):sizeof(prp_object)
+	};
+};
+
+template<typename T, int ... prp>
+struct pack_compress_stride_impl<T,false,prp...>
+{
+	enum
+	{
+		value = sizeof(typename T::value_type)
+	};
+};
+
+/*! \brief Size of the packed element of a vector or a grid
+ *
+ * \tparam T vector or grid
+ * \tparam prp properties
+ *
+ */
+template<typename T, int ... prp>
+struct pack_compress_stride
+{
+	enum
+	{
+		value = pack_compress_stride_impl<T,has_typedef_type<typename T::value_type>::value,prp...>::value
+	};
+};
+
+/*! \brief Packer that compress the packed data
+ *
+ * Same interface of the Packer with a codec selected per pack call, packRequest report the
+ * worst case size (uncompressed data + header). The compressed block is self-described, the
+ * Unpacker_compress does not need to know the codec
+ *
+ * \snippet Packer_unit_tests.hpp Pack and unpack compressed
+ *
+ * \tparam T object type to pack
+ * \tparam Mem Memory origin HeapMemory CudaMemory ...
+ * \tparam Implementation of the packer (the Pack_selector choose the correct one)
+ *
+ */
+template<typename T, typename Mem, int pack_type = Pack_selector<T>::value>
+class Packer_compress
+{
+public:
+
+	/*! \brief Worst case size to pack the object
+	 *
+	 * \param obj object to pack
+	 * \param req counter to increment
+	 *
+	 */
+	static void packRequest(const T & obj, size_t & req)
+	{
+		size_t raw = 0;
+		Packer<T,Mem>::packRequest(obj,raw);
+		req += pack_compress_bound(raw);
+	}
+
+	/*! \brief Pack the object compressed
+	 *
+	 * \param mem preallocated memory where to pack
+	 * \param obj object to pack
+	 * \param sts pack statistic
+	 * \param codec codec
+	 *
+	 */
+	static void pack(ExtPreAlloc<Mem> & mem, const T & obj, Pack_stat & sts, size_t codec)
+	{
+		size_t raw = 0;
+		Packer<T,Mem>::packRequest(obj,raw);
+
+		pack_compressed(mem,raw,sizeof(T),codec,[&](ExtPreAlloc<Mem> & ext)
+		                                          {Packer<T,Mem>::pack(ext,obj,sts);});
+	}
+};
+
+//! Packer that compress vectors
+template<typename T, typename Mem>
+class Packer_compress<T,Mem,PACKER_GENERAL>
+{
+public:
+
+	/*! \brief Worst case size to pack the vector
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj vector to pack
+	 * \param req counter to increment
+	 *
+	 */
+	template<int ... prp> static void packRequest(const T & obj, size_t & req)
+	{
+		size_t raw = 0;
+		Packer<T,Mem>::template packRequest<prp...>(obj,raw);
+		req += pack_compress_bound(raw);
+	}
+
+	/*! \brief Pack the vector compressed
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack
+	 * \param obj vector to pack
+	 * \param sts pack statistic
+	 * \param codec codec
+	 *
+	 */
+	template<int ... prp> static void pack(ExtPreAlloc<Mem> & mem, const T & obj, Pack_stat & sts, size_t codec)
+	{
+		size_t raw = 0;
+		Packer<T,Mem>::template packRequest<prp...>(obj,raw);
+
+		pack_compressed(mem,raw,pack_compress_stride<T,prp...>::value,codec,[&](ExtPreAlloc<Mem> & ext)
+		                                                                      {Packer<T,Mem>::template pack<prp...>(ext,obj,sts);});
+	}
+};
+
+//! Packer that compress grids
+template<typename T, typename Mem>
+class Packer_compress<T,Mem,PACKER_GRID>
+{
+public:
+
+	/*! \brief Worst case size to pack the grid
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj grid to pack
+	 * \param req counter to increment
+	 *
+	 */
+	template<int ... prp> static void packRequest(const T & obj, size_t & req)
+	{
+		size_t raw = 0;
+		Packer<T,Mem,PACKER_GRID>::template packRequest<prp...>(obj,raw);
+		req += pack_compress_bound(raw);
+	}
+
+	/*! \brief Worst case size to pack a sub-grid
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj grid to pack
+	 * \param sub sub-grid iterator
+	 * \param req counter to increment
+	 *
+	 */
+	template<typename grid_sub_it_type, int ... prp> static void packRequest(T & obj, grid_sub_it_type & sub, size_t & req)
+	{
+		size_t raw = 0;
+		Packer<T,Mem,PACKER_GRID>::template packRequest<grid_sub_it_type,prp...>(obj,sub,raw);
+		req += pack_compress_bound(raw);
+	}
+
+	/*! \brief Pack the grid compressed
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack
+	 * \param obj grid to pack
+	 * \param sts pack statistic
+	 * \param codec codec
+	 *
+	 */
+	template<int ... prp> static void pack(ExtPreAlloc<Mem> & mem, const T & obj, Pack_stat & sts, size_t codec)
+	{
+		size_t raw = 0;
+		Packer<T,Mem,PACKER_GRID>::template packRequest<prp...>(obj,raw);
+
+		pack_compressed(mem,raw,pack_compress_stride<T,prp...>::value,codec,[&](ExtPreAlloc<Mem> & ext)
+		                                                                      {Packer<T,Mem,PACKER_GRID>::template pack<prp...>(ext,obj,sts);});
+	}
+
+	/*! \brief Pack a sub-grid compressed
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack
+	 * \param obj grid to pack
+	 * \param sub_it sub-grid iterator
+	 * \param sts pack statistic
+	 * \param codec codec
+	 *
+	 */
+	template<typename grid_sub_it_type, int ... prp> static void pack(ExtPreAlloc<Mem> & mem, T & obj, grid_sub_it_type & sub_it, Pack_stat & sts, size_t codec)
+	{
+		size_t raw = 0;
+		Packer<T,Mem,PACKER_GRID>::template packRequest<grid_sub_it_type,prp...>(obj,sub_it,raw);
+
+		pack_compressed(mem,raw,pack_compress_stride<T,prp...>::value,codec,[&](ExtPreAlloc<Mem> & ext)
+		                                                                      {Packer<T,Mem,PACKER_GRID>::template pack<grid_sub_it_type,prp...>(ext,obj,sub_it,sts);});
+	}
+};
+
+/*! \brief Unpacker of the blocks produced by Packer_compress
+ *
+ * \tparam T object type to unpack
+ * \tparam Mem Memory origin HeapMemory CudaMemory ...
+ * \tparam Implementation of the unpacker (the Pack_selector choose the correct one)
+ *
+ */
+template<typename T, typename Mem, int pack_type = Pack_selector<T>::value>
+class Unpacker_compress
+{
+public:
+
+	/*! \brief Unpack the object
+	 *
+	 * \param mem memory containing the compressed block
+	 * \param obj object where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	static void unpack(ExtPreAlloc<Mem> & mem, T & obj, Unpack_stat & ps)
+	{
+		unpack_compressed(mem,ps,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_t)
+		                            {Unpacker<T,Mem>::unpack(ext,obj,ps_t);});
+	}
+};
+
+//! Unpacker of compressed vectors
+template<typename T, typename Mem>
+class Unpacker_compress<T,Mem,PACKER_GENERAL>
+{
+public:
+
+	/*! \brief Unpack the vector
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem memory containing the compressed block
+	 * \param obj vector where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	template<unsigned int ... prp> static void unpack(ExtPreAlloc<Mem> & mem, T & obj, Unpack_stat & ps)
+	{
+		unpack_compressed(mem,ps,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_t)
+		                            {Unpacker<T,Mem>::template unpack<prp...>(ext,obj,ps_t);});
+	}
+};
+
+//! Unpacker of compressed grids
+template<typename T, typename Mem>
+class Unpacker_compress<T,Mem,PACKER_GRID>
+{
+public:
+
+	/*! \brief Unpack the grid
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem memory containing the compressed block
+	 * \param obj grid where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	template<unsigned int ... prp> static void unpack(ExtPreAlloc<Mem> & mem, T & obj, Unpack_stat & ps)
+	{
+		unpack_compressed(mem,ps,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_t)
+		                            {Unpacker<T,Mem,PACKER_GRID>::template unpack<prp...>(ext,obj,ps_t);});
+	}
+
+	/*! \brief Unpack a sub-grid
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam context_type context type
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem memory containing the compressed block
+	 * \param sub_it sub-grid iterator
+	 * \param obj grid where to unpack
+	 * \param ps unpack statistic
+	 * \param context context
+	 * \param opt options
+	 *
+	 */
+	template<typename grid_sub_it_type, typename context_type, unsigned int ... prp>
+	static void unpack(ExtPreAlloc<Mem> & mem, grid_sub_it_type & sub_it, T & obj, Unpack_stat & ps, context_type & context, rem_copy_opt opt)
+	{
+		unpack_compressed(mem,ps,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_t)
+		                            {Unpacker<T,Mem,PACKER_GRID>::template unpack<grid_sub_it_type,context_type,prp...>(ext,sub_it,obj,ps_t,context,opt);});
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_COMPRESS_HPP_ */
@@ -0,0 +1,1302 @@
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_CONTAINER_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_CONTAINER_HPP_
+
+#include "memory_ly/FileMemory.hpp"
+#include "Packer_Unpacker/has_pack_agg.hpp"
+#include "util/variadic_to_vmpl.hpp"
+#include "util/copy_compare/meta_copy.hpp"
+#include "Grid/util.hpp"
+#include "Grid/iterators/grid_key_dx_iterator_sub.hpp"
+#include "Space/Shape/Box.hpp"
+#include "util/util_debug.hpp"
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+//! Version of the container format
+#define PACK_CONT_VERSION 1
+
+//! Written in native byte order, it is read back as 0x04030201 on a machine with different endianness
+#define PACK_CONT_ENDIAN 0x01020304
+
+//! The file store an openfpm::vector
+#define PACK_CONT_KIND_VECTOR 0
+//! The file store a dense grid (grid_cpu)
+#define PACK_CONT_KIND_GRID 1
+//! The file store a sparse grid (sgrid_cpu)
+#define PACK_CONT_KIND_SGRID 2
+
+//! The property is an object without known type, it can be read only by an identical type
+#define PACK_CONT_TYPE_OPAQUE 0
+//! Signed integer
+#define PACK_CONT_TYPE_SINT 1
+//! Unsigned integer
+#define PACK_CONT_TYPE_UINT 2
+//! Floating point
+#define PACK_CONT_TYPE_FLOAT 3
+
+//! Number of points in a run of a sparse grid file (every run has a bounding box)
+#define PACK_CONT_RUN 4096
+
+//! Size of the buffer used to write the file
+#define PACK_CONT_WRITE_BUFFER (1024*1024)
+
+/*! \brief Description of a property stored in a container file
+ *
+ * A property of type T[N1][N2] is stored as N1*N2 scalars of type T
+ *
+ */
+struct pack_container_prop
+{
+	//! PACK_CONT_TYPE_OPAQUE, PACK_CONT_TYPE_SINT, PACK_CONT_TYPE_UINT or PACK_CONT_TYPE_FLOAT
+	unsigned int type;
+
+	//! size of the scalar
+	unsigned int scalar_size;
+
+	//! number of scalars (product of the array extents)
+	size_t n_comp;
+
+	//! size of the property
+	size_t size;
+
+	//! offset of the block of the property in the file
+	size_t offset;
+};
+
+/*! \brief Header at the beginning of a container file
+ *
+ * The file contain one block for each property (the values of the property for all the points
+ * in order), every block start at a multiple of FILE_MEMORY_ALIGN so it can be mapped alone.
+ * A vector store the elements in order, a grid in the order of grid_sm::LinId. A sparse grid
+ * also store the position of every point and a table of runs of PACK_CONT_RUN points with
+ * their bounding box
+ *
+ */
+struct pack_container_header
+{
+	//! Identify the file "OFPMCONT"
+	char magic[8];
+
+	//! version of the format
+	unsigned int version;
+
+	//! PACK_CONT_ENDIAN in the byte order of the machine that wrote the file
+	unsigned int endian;
+
+	//! PACK_CONT_KIND_VECTOR, PACK_CONT_KIND_GRID or PACK_CONT_KIND_SGRID
+	unsigned int kind;
+
+	//! layout of the container that wrote the file (FILE_MEMORY_LAYOUT_LIN or FILE_MEMORY_LAYOUT_INTE)
+	unsigned int layout;
+
+	//! dimensionality (1 for a vector)
+	unsigned int dim;
+
+	//! number of properties
+	unsigned int n_prop;
+
+	//! number of points stored
+	size_t n_ele;
+
+	//! size of the grid in each dimension (number of elements for a vector)
+	size_t sz[FILE_MEMORY_MAX_DIM];
+
+	//! number of runs (sparse grid)
+	size_t n_run;
+
+	//! offset of the positions of the points (sparse grid)
+	size_t off_pos;
+
+	//! offset of the table of runs (sparse grid)
+	size_t off_run;
+
+	//! properties
+	pack_container_prop prop[FILE_MEMORY_MAX_PROP];
+};
+
+/*! \brief Run of points of a sparse grid file
+ *
+ */
+struct pack_container_run
+{
+	//! first point of the run
+	size_t start;
+
+	//! number of points in the run
+	size_t n;
+
+	//! low corner of the bounding box of the points
+	long int low[FILE_MEMORY_MAX_DIM];
+
+	//! high corner of the bounding box of the points
+	long int high[FILE_MEMORY_MAX_DIM];
+};
+
+/*! \brief Reverse the byte order of n values of size sz
+ *
+ * \param ptr values
+ * \param sz size of one value
+ * \param n number of values
+ *
+ */
+static inline void pack_container_swap(void * ptr, size_t sz, size_t n)
+{
+	unsigned char * p = (unsigned char *)ptr;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		std::reverse(p,p + sz);
+		p += sz;
+	}
+}
+
+/*! \brief Reverse the byte order of all the fields of the header
+ *
+ * \param hd header
+ *
+ */
+static inline void pack_container_swap_header(pack_container_header & hd)
+{
+	pack_container_swap(&hd.version,sizeof(unsigned int),6);
+	pack_container_swap(&hd.n_ele,sizeof(size_t),1);
+	pack_container_swap(hd.sz,sizeof(size_t),FILE_MEMORY_MAX_DIM);
+	pack_container_swap(&hd.n_run,sizeof(size_t),3);
+
+	for (size_t i = 0 ; i < FILE_MEMORY_MAX_PROP ; i++)
+	{
+		pack_container_swap(&hd.prop[i].type,sizeof(unsigned int),2);
+		pack_container_swap(&hd.prop[i].n_comp,sizeof(size_t),3);
+	}
+}
+
+/*! \brief Type code of a scalar
+ *
+ * \tparam T scalar
+ *
+ */
+template<typename T, bool is_fund = std::is_fundamental<T>::value>
+struct pack_container_type
+{
+	enum
+	{
+		value = PACK_CONT_TYPE_OPAQUE
+	};
+};
+
+template<typename T>
+struct pack_container_type<T,true>
+{
+	enum
+	{
+		value = (std::is_floating_point<T>::value)?PACK_CONT_TYPE_FLOAT:((std::is_signed<T>::value)?PACK_CONT_TYPE_SINT:PACK_CONT_TYPE_UINT)
+	};
+};
+
+/*! \brief Fill the description of a property of type T
+ *
+ * \tparam T property type
+ *
+ * \param pc description to fill
+ *
+ */
+template<typename T>
+void pack_container_make_prop(pack_container_prop & pc)
+{
+	typedef typename std::remove_all_extents<T>::type scalar;
+
+	pc.type = pack_container_type<scalar>::value;
+	pc.scalar_size = sizeof(scalar);
+	pc.n_comp = sizeof(T) / sizeof(scalar);
+	pc.size = sizeof(T);
+	pc.offset = 0;
+}
+
+/*! \brief Read a scalar as a value of type V
+ *
+ * \param p scalar (native byte order)
+ * \param type type of the scalar
+ * \param size size of the scalar
+ *
+ * \return the value
+ *
+ */
+template<typename V>
+V pack_container_get(const unsigned char * p, unsigned int type, unsigned int size)
+{
+	if (type == PACK_CONT_TYPE_FLOAT)
+	{
+		if (size == sizeof(float))
+		{float v; memcpy(&v,p,sizeof(float)); return (V)v;}
+		if (size == sizeof(double))
+		{double v; memcpy(&v,p,sizeof(double)); return (V)v;}
+
+		long double v; memcpy(&v,p,sizeof(long double)); return (V)v;
+	}
+
+	if (type == PACK_CONT_TYPE_SINT)
+	{
+		switch (size)
+		{
+		case 1: {signed char v; memcpy(&v,p,1); return (V)v;}
+		case 2: {short int v; memcpy(&v,p,2); return (V)v;}
+		case 4: {int v; memcpy(&v,p,4); return (V)v;}
+		default: {long long int v; memcpy(&v,p,8); return (V)v;}
+		}
+	}
+
+	switch (size)
+	{
+	case 1: {unsigned char v; memcpy(&v,p,1); return (V)v;}
+	case 2: {unsigned short int v; memcpy(&v,p,2); return (V)v;}
+	case 4: {unsigned int v; memcpy(&v,p,4); return (V)v;}
+	default: {unsigned long long int v; memcpy(&v,p,8); return (V)v;}
+	}
+}
+
+/*! \brief Write a value of type V as a scalar
+ *
+ * \param p scalar
+ * \param type type of the scalar
+ * \param size size of the scalar
+ * \param v value
+ *
+ */
+template<typename V>
+void pack_container_set(unsigned char * p, unsigned int type, unsigned int size, V v)
+{
+	if (type == PACK_CONT_TYPE_FLOAT)
+	{
+		if (size == sizeof(float))
+		{float s = v; memcpy(p,&s,sizeof(float)); return;}
+		if (size == sizeof(double))
+		{double s = v; memcpy(p,&s,sizeof(double)); return;}
+
+		long double s = v; memcpy(p,&s,sizeof(long double)); return;
+	}
+
+	switch (size)
+	{
+	case 1: {unsigned char s = (unsigned char)v; memcpy(p,&s,1); return;}
+	case 2: {unsigned short int s = (unsigned short int)v; memcpy(p,&s,2); return;}
+	case 4: {unsigned int s = (unsigned int)v; memcpy(p,&s,4); return;}
+	default: {unsigned long long int s = (unsigned long long int)v; memcpy(p,&s,8); return;}
+	}
+}
+
+/*! \brief Check if a property stored in the file can be read into a property of the container
+ *
+ * The number of scalars must be the same, numeric scalars are converted, opaque objects must
+ * have the same size and the same byte order
+ *
+ * \param pd property of the container
+ * \param ps property stored in the file
+ * \param swap the file has a different byte order
+ *
+ * \return true if the property can be read
+ *
+ */
+static inline bool pack_container_compatible(const pack_container_prop & pd, const pack_container_prop & ps, bool swap)
+{
+	if (pd.n_comp != ps.n_comp)
+	{return false;}
+
+	if (pd.type == PACK_CONT_TYPE_OPAQUE || ps.type == PACK_CONT_TYPE_OPAQUE)
+	{return pd.type == ps.type && pd.size == ps.size && swap == false;}
+
+	return ps.scalar_size == 1 || ps.scalar_size == 2 || ps.scalar_size == 4 || ps.scalar_size == 8 ||
+		   (ps.type == PACK_CONT_TYPE_FLOAT && ps.scalar_size == sizeof(long double));
+}
+
+/*! \brief Convert a property stored in the file into a property of the container
+ *
+ * \param dst property of the container
+ * \param pd description of the property of the container
+ * \param src property stored in the file
+ * \param ps description of the property stored in the file
+ * \param swap the file has a different byte order
+ *
+ */
+static inline void pack_container_convert(void * dst, const pack_container_prop & pd, const unsigned char * src, const pack_container_prop & ps, bool swap)
+{
+	if (swap == false && pd.type == ps.type && pd.scalar_size == ps.scalar_size)
+	{
+		memcpy(dst,src,pd.size);
+		return;
+	}
+
+	unsigned char * d = (unsigned char *)dst;
+	unsigned char tmp[sizeof(long double)];
+
+	for (size_t i = 0 ; i < ps.n_comp ; i++)
+	{
+		memcpy(tmp,src,ps.scalar_size);
+
+		if (swap == true)
+		{std::reverse(tmp,tmp + ps.scalar_size);}
+
+		if (pd.type == PACK_CONT_TYPE_FLOAT || ps.type == PACK_CONT_TYPE_FLOAT)
+		{pack_container_set<double>(d,pd.type,pd.scalar_size,pack_container_get<double>(tmp,ps.type,ps.scalar_size));}
+		else if (ps.type == PACK_CONT_TYPE_SINT)
+		{pack_container_set<long long int>(d,pd.type,pd.scalar_size,pack_container_get<long long int>(tmp,ps.type,ps.scalar_size));}
+		else
+		{pack_container_set<unsigned long long int>(d,pd.type,pd.scalar_size,pack_container_get<unsigned long long int>(tmp,ps.type,ps.scalar_size));}
+
+		src += ps.scalar_size;
+		d += pd.scalar_size;
+	}
+}
+
+/*! \brief Buffered writer of a container file
+ *
+ */
+class pack_container_writer
+{
+	//! file descriptor
+	int fd;
+
+	//! offset in the file of the buffer
+	size_t off;
+
+	//! buffer
+	std::vector<unsigned char> buf;
+
+	//! false if a write failed
+	bool ok;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param fd file descriptor
+	 *
+	 */
+	pack_container_writer(int fd)
+	:fd(fd),off(0),ok(true)
+	{
+		buf.reserve(PACK_CONT_WRITE_BUFFER);
+	}
+
+	//! Write the buffer in the file
+	void flush()
+	{
+		size_t w = 0;
+
+		while (w < buf.size() && ok == true)
+		{
+			ssize_t r = pwrite(fd,buf.data() + w,buf.size() - w,off + w);
+			ok &= (r > 0);
+			w += (r > 0)?r:0;
+		}
+
+		off += buf.size();
+		buf.clear();
+	}
+
+	/*! \brief Move to a position in the file
+	 *
+	 * \param offset position
+	 *
+	 */
+	void seek(size_t offset)
+	{
+		flush();
+		off = offset;
+	}
+
+	/*! \brief Add data
+	 *
+	 * \param ptr data
+	 * \param sz size of the data
+	 *
+	 */
+	void add(const void * ptr, size_t sz)
+	{
+		if (buf.size() + sz > PACK_CONT_WRITE_BUFFER)
+		{flush();}
+
+		buf.insert(buf.end(),(const unsigned char *)ptr,(const unsigned char *)ptr + sz);
+	}
+
+	/*! \brief Return false if a write failed
+	 *
+	 * \return the status
+	 *
+	 */
+	bool isOk()
+	{
+		return ok;
+	}
+};
+
+/*! \brief Reader of a container file
+ *
+ * The header is read when the file is opened, the blocks are mapped only when requested, and
+ * their pages are loaded by the kernel when they are accessed. Reading some properties of a
+ * sub-box read only the pages that contain them
+ *
+ */
+class pack_container_file
+{
+	//! file name
+	std::string file;
+
+	//! header (in native byte order)
+	pack_container_header hd;
+
+	//! the file has a different byte order
+	bool swap;
+
+	//! mapped properties
+	FileMemory mem_prp[FILE_MEMORY_MAX_PROP];
+
+	//! mapped positions
+	FileMemory mem_pos;
+
+	//! mapped runs
+	FileMemory mem_run;
+
+	//! positions and runs in native byte order (when swapped)
+	std::vector<unsigned char> pos_run_swap[2];
+
+	/*! \brief map a block of the file
+	 *
+	 * \param mem memory where to map
+	 * \param off offset of the block
+	 * \param sz size of the block
+	 *
+	 * \return the pointer to the block
+	 *
+	 */
+	const unsigned char * map(FileMemory & mem, size_t off, size_t sz)
+	{
+		if (sz == 0)
+		{return NULL;}
+
+		if (mem.size() == 0)
+		{
+			if (mem.open(file,off,FILE_MEMORY_READ) == false || mem.allocate(sz) == false)
+			{return NULL;}
+		}
+
+		return (const unsigned char *)mem.getPointer();
+	}
+
+	/*! \brief map a block of int64 values and convert it in native byte order
+	 *
+	 * \param mem memory where to map
+	 * \param off offset of the block
+	 * \param sz size of the block
+	 * \param sw buffer for the converted block
+	 *
+	 * \return the pointer to the block
+	 *
+	 */
+	const unsigned char * map_native(FileMemory & mem, size_t off, size_t sz, std::vector<unsigned char> & sw)
+	{
+		const unsigned char * ptr = map(mem,off,sz);
+
+		if (swap == false || ptr == NULL)
+		{return ptr;}
+
+		if (sw.size() != sz)
+		{
+			sw.assign(ptr,ptr + sz);
+			pack_container_swap(sw.data(),sizeof(size_t),sz / sizeof(size_t));
+		}
+
+		return sw.data();
+	}
+
+public:
+
+	//! Constructor
+	pack_container_file()
+	:swap(false)
+	{
+		memset(&hd,0,sizeof(hd));
+	}
+
+	/*! \brief Open a container file and read its header
+	 *
+	 * \param file file name
+	 *
+	 * \return true if the file is a valid container file
+	 *
+	 */
+	bool open(const std::string & file)
+	{
+		this->file = file;
+
+		int fd = ::open(file.c_str(),O_RDONLY);
+
+		if (fd == -1)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error opening the file " << file << std::endl;
+			return false;
+		}
+
+		bool ok = pread(fd,&hd,sizeof(pack_container_header),0) == sizeof(pack_container_header);
+		close(fd);
+
+		if (ok == false || memcmp(hd.magic,"OFPMCONT",8) != 0)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " is not a container file" << std::endl;
+			return false;
+		}
+
+		swap = (hd.endian != PACK_CONT_ENDIAN);
+
+		if (swap == true)
+		{pack_container_swap_header(hd);}
+
+		if (hd.endian != PACK_CONT_ENDIAN)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " has an unknown byte order" << std::endl;
+			return false;
+		}
+
+		if (hd.version != PACK_CONT_VERSION)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " has version " << hd.version << " expected " << PACK_CONT_VERSION << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*! \brief Return the header of the file (in native byte order)
+	 *
+	 * \return the header
+	 *
+	 */
+	const pack_container_header & getHeader() const
+	{
+		return hd;
+	}
+
+	/*! \brief Return true if the file has been written on a machine with a different byte order
+	 *
+	 * \return true if the values must be swapped
+	 *
+	 */
+	bool isSwapped() const
+	{
+		return swap;
+	}
+
+	/*! \brief Check that the property i of the file can be read into a property of type T
+	 *
+	 * \tparam T property type
+	 *
+	 * \param i property
+	 *
+	 * \return true if it can be read
+	 *
+	 */
+	template<typename T> bool checkProperty(size_t i) const
+	{
+		pack_container_prop pd;
+		pack_container_make_prop<T>(pd);
+
+		if (i >= hd.n_prop || pack_container_compatible(pd,hd.prop[i],swap) == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the property " << i << " of " << file << " cannot be read into a property of type " << demangle(typeid(T).name()) << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	/*! \brief Map the block of the property i (values in the byte order of the file)
+	 *
+	 * \param i property
+	 *
+	 * \return pointer to the block, NULL if the file does not contain any point
+	 *
+	 */
+	const unsigned char * mapProperty(size_t i)
+	{
+		return map(mem_prp[i],hd.prop[i].offset,hd.n_ele * hd.prop[i].size);
+	}
+
+	/*! \brief Map the positions of the points of a sparse grid (dim long int for each point)
+	 *
+	 * \return pointer to the positions in native byte order
+	 *
+	 */
+	const long int * mapPositions()
+	{
+		return (const long int *)map_native(mem_pos,hd.off_pos,hd.n_ele * hd.dim * sizeof(long int),pos_run_swap[0]);
+	}
+
+	/*! \brief Map the runs of a sparse grid
+	 *
+	 * \return pointer to the runs in native byte order
+	 *
+	 */
+	const pack_container_run * mapRuns()
+	{
+		return (const pack_container_run *)map_native(mem_run,hd.off_run,hd.n_run * sizeof(pack_container_run),pos_run_swap[1]);
+	}
+
+	/*! \brief Check that the file store a container of a given kind and dimensionality
+	 *
+	 * \param kind kind of container
+	 * \param dim dimensionality
+	 *
+	 * \return true if it match
+	 *
+	 */
+	bool checkKind(unsigned int kind, unsigned int dim) const
+	{
+		if (hd.kind != kind || hd.dim != dim)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " store a container of kind " << hd.kind << " and dimensionality " << hd.dim
+					  << " expected kind " << kind << " and dimensionality " << dim << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+};
+
+//! Check if T has a chunking (it is a sparse grid)
+template<typename T, typename Sfinae = void>
+struct has_chunking_type: std::false_type {};
+
+template<typename T>
+struct has_chunking_type<T, typename Void< typename T::chunking_type>::type> : std::true_type
+{};
+
+/*! \brief Kind of a container
+ *
+ * \tparam T container
+ *
+ */
+template<typename T>
+struct pack_container_kind
+{
+	enum
+	{
+		value = (is_grid<T>::value == false)?PACK_CONT_KIND_VECTOR:((has_chunking_type<T>::value)?PACK_CONT_KIND_SGRID:PACK_CONT_KIND_GRID)
+	};
+};
+
+/*! \brief How the points of a container are visited, written and read
+ *
+ * \tparam cont_type container
+ * \tparam kind kind of container
+ *
+ */
+template<typename cont_type, int kind = pack_container_kind<cont_type>::value>
+struct pack_container_io
+{
+	//! dimensionality
+	static const unsigned int dims = 1;
+
+	//! layout
+	static const unsigned int layout = (is_layout_inte<typename cont_type::layout_base_>::value)?FILE_MEMORY_LAYOUT_INTE:FILE_MEMORY_LAYOUT_LIN;
+
+	//! size of the container (number of elements)
+	static void getSize(const cont_type & c, size_t (& sz)[FILE_MEMORY_MAX_DIM])
+	{sz[0] = c.size();}
+
+	//! number of points stored
+	static size_t n_ele(const cont_type & c)
+	{return c.size();}
+
+	//! visit the points in the order they are stored
+	template<typename lambda_f> static void for_each(const cont_type & c, lambda_f f)
+	{
+		for (size_t i = 0 ; i < c.size() ; i++)
+		{f(i);}
+	}
+
+	//! get the property p of a point
+	template<unsigned int p, typename key_type> static auto get(cont_type & c, const key_type & key) -> decltype(c.template get<p>(key))
+	{return c.template get<p>(key);}
+
+	//! get the property p of a point
+	template<unsigned int p, typename key_type> static auto get(const cont_type & c, const key_type & key) -> decltype(c.template get<p>(key))
+	{return c.template get<p>(key);}
+
+	//! a vector does not store the positions
+	static void write_positions(const cont_type & c, const pack_container_header & hd, pack_container_writer & w)
+	{}
+};
+
+template<typename cont_type>
+struct pack_container_io<cont_type,PACK_CONT_KIND_GRID>
+{
+	static const unsigned int dims = cont_type::dims;
+
+	static const unsigned int layout = (is_layout_inte<typename cont_type::layout_base_>::value)?FILE_MEMORY_LAYOUT_INTE:FILE_MEMORY_LAYOUT_LIN;
+
+	static void getSize(const cont_type & c, size_t (& sz)[FILE_MEMORY_MAX_DIM])
+	{
+		for (size_t i = 0 ; i < dims ; i++)
+		{sz[i] = c.getGrid().size(i);}
+	}
+
+	static size_t n_ele(const cont_type & c)
+	{return c.getGrid().size();}
+
+	template<typename lambda_f> static void for_each(const cont_type & c, lambda_f f)
+	{
+		grid_key_dx_iterator<dims> it(c.getGrid());
+
+		while (it.isNext())
+		{
+			f(it.get());
+			++it;
+		}
+	}
+
+	template<unsigned int p, typename key_type> static auto get(cont_type & c, const key_type & key) -> decltype(c.template get<p>(key))
+	{return c.template get<p>(key);}
+
+	template<unsigned int p, typename key_type> static auto get(const cont_type & c, const key_type & key) -> decltype(c.template get<p>(key))
+	{return c.template get<p>(key);}
+
+	static void write_positions(const cont_type & c, const pack_container_header & hd, pack_container_writer & w)
+	{}
+
+	//! recreate the grid with a new size
+	static void recreate(cont_type & c, const size_t (& sz)[dims])
+	{
+		cont_type g_new(sz);
+		g_new.setMemory();
+		c.swap(g_new);
+	}
+};
+
+template<typename cont_type>
+struct pack_container_io<cont_type,PACK_CONT_KIND_SGRID>
+{
+	static const unsigned int dims = cont_type::dims;
+
+	static const unsigned int layout = (is_layout_inte<typename cont_type::memory_traits>::value)?FILE_MEMORY_LAYOUT_INTE:FILE_MEMORY_LAYOUT_LIN;
+
+	static void getSize(const cont_type & c, size_t (& sz)[FILE_MEMORY_MAX_DIM])
+	{
+		for (size_t i = 0 ; i < dims ; i++)
+		{sz[i] = c.getGrid().size(i);}
+	}
+
+	static size_t n_ele(const cont_type & c)
+	{return c.size();}
+
+	template<typename lambda_f> static void for_each(const cont_type & c, lambda_f f)
+	{
+		auto it = c.getIterator();
+
+		while (it.isNext())
+		{
+			f(it.get());
+			++it;
+		}
+	}
+
+	//! get the property p of a point, the point is inserted if it does not exist
+	template<unsigned int p, typename key_type> static auto get(cont_type & c, const key_type & key) -> decltype(c.template insert<p>(key))
+	{return c.template insert<p>(key);}
+
+	template<unsigned int p, typename key_type> static auto get(const cont_type & c, const key_type & key) -> decltype(c.template get<p>(key))
+	{return c.template get<p>(key);}
+
+	//! remove all the points and resize the grid
+	static void recreate(cont_type & c, const size_t (& sz)[dims])
+	{
+		c.clear();
+		c.resize(sz);
+	}
+
+	//! write the positions of the points (in the order of the iterator) and the table of runs
+	static void write_positions(const cont_type & c, const pack_container_header & hd, pack_container_writer & w)
+	{
+		std::vector<pack_container_run> runs(hd.n_run);
+		size_t cnt = 0;
+
+		w.seek(hd.off_pos);
+
+		for_each(c,[&](const grid_key_dx<dims> & key)
+		{
+			pack_container_run & r = runs[cnt / PACK_CONT_RUN];
+
+			if (cnt % PACK_CONT_RUN == 0)
+			{
+				r.start = cnt;
+				r.n = 0;
+				for (size_t i = 0 ; i < FILE_MEMORY_MAX_DIM ; i++)
+				{
+					r.low[i] = (i < dims)?key.get(i):0;
+					r.high[i] = (i < dims)?key.get(i):0;
+				}
+			}
+
+			for (size_t i = 0 ; i < dims ; i++)
+			{
+				long int k = key.get(i);
+
+				r.low[i] = (k < r.low[i])?k:r.low[i];
+				r.high[i] = (k > r.high[i])?k:r.high[i];
+
+				w.add(&k,sizeof(long int));
+			}
+
+			r.n++;
+			cnt++;
+		});
+
+		w.seek(hd.off_run);
+		w.add(runs.data(),runs.size()*sizeof(pack_container_run));
+	}
+};
+
+/*! \brief Fill the description of every property in the header
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct pack_container_fill_prop
+{
+	//! header
+	pack_container_header & hd;
+
+	/*! \brief constructor
+	 *
+	 * \param hd header to fill
+	 *
+	 */
+	pack_container_fill_prop(pack_container_header & hd)
+	:hd(hd)
+	{}
+
+	//! It fill the description of the property
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		pack_container_make_prop<typename boost::mpl::at<typename T::type,t_prp>::type>(hd.prop[t_prp::value]);
+	}
+};
+
+/*! \brief Write the block of every property
+ *
+ * \tparam cont_type container
+ *
+ */
+template<typename cont_type>
+struct pack_container_write_prp
+{
+	//! container
+	const cont_type & c;
+
+	//! header
+	const pack_container_header & hd;
+
+	//! writer
+	pack_container_writer & w;
+
+	/*! \brief constructor
+	 *
+	 * \param c container
+	 * \param hd header
+	 * \param w writer
+	 *
+	 */
+	pack_container_write_prp(const cont_type & c, const pack_container_header & hd, pack_container_writer & w)
+	:c(c),hd(hd),w(w)
+	{}
+
+	//! It write the block of the property
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		typedef typename boost::mpl::at<typename cont_type::value_type::type,t_prp>::type prp_type;
+
+		w.seek(hd.prop[t_prp::value].offset);
+
+		pack_container_io<cont_type>::for_each(c,[&](const auto & key)
+		{
+			typedef typename std::remove_const<typename std::remove_reference<decltype(pack_container_io<cont_type>::template get<t_prp::value>(c,key))>::type>::type src_type;
+
+			prp_type tmp;
+			meta_copy_d<src_type,prp_type>::meta_copy_d_(pack_container_io<cont_type>::template get<t_prp::value>(c,key),tmp);
+
+			w.add(&tmp,sizeof(prp_type));
+		});
+	}
+};
+
+/*! \brief Read the block of every selected property for a set of points
+ *
+ * \tparam cont_type container
+ * \tparam it_type function that visit the points to read, it(f) call f(key,id) with key the point
+ *         in the container and id the point in the file
+ *
+ */
+template<typename cont_type, typename it_type>
+struct pack_container_read_prp
+{
+	//! container
+	cont_type & c;
+
+	//! file
+	pack_container_file & f;
+
+	//! points to read
+	it_type & it;
+
+	//! false if a property cannot be read
+	bool ok;
+
+	/*! \brief constructor
+	 *
+	 * \param c container
+	 * \param f file
+	 * \param it points to read
+	 *
+	 */
+	pack_container_read_prp(cont_type & c, pack_container_file & f, it_type & it)
+	:c(c),f(f),it(it),ok(true)
+	{}
+
+	//! It read the property
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		typedef typename boost::mpl::at<typename cont_type::value_type::type,t_prp>::type prp_type;
+
+		if (f.template checkProperty<prp_type>(t_prp::value) == false)
+		{
+			ok = false;
+			return;
+		}
+
+		pack_container_prop pd;
+		pack_container_make_prop<prp_type>(pd);
+
+		const pack_container_prop & ps = f.getHeader().prop[t_prp::value];
+		const unsigned char * base = f.mapProperty(t_prp::value);
+		bool swap = f.isSwapped();
+
+		it([&](const auto & key, size_t id)
+		{
+			typedef typename std::remove_reference<decltype(pack_container_io<cont_type>::template get<t_prp::value>(c,key))>::type dst_type;
+
+			prp_type tmp;
+			pack_container_convert(&tmp,pd,base + id*ps.size,ps,swap);
+
+			meta_copy_d<prp_type,dst_type>::meta_copy_d_(tmp,pack_container_io<cont_type>::template get<t_prp::value>(c,key));
+		});
+	}
+};
+
+/*! \brief Read the selected properties (all if prp is empty)
+ *
+ * \tparam prp properties to read
+ *
+ * \param c container
+ * \param f file
+ * \param it points to read (see pack_container_read_prp)
+ *
+ * \return true if all the properties have been read
+ *
+ */
+template<unsigned int ... prp, typename cont_type, typename it_type>
+bool pack_container_read_selected(cont_type & c, pack_container_file & f, it_type & it)
+{
+	typedef typename cont_type::value_type T;
+
+	typedef typename std::conditional<sizeof...(prp) == 0,
+									  boost::mpl::range_c<int,0,T::max_prop>,
+									  typename to_boost_vmpl<prp...>::type>::type prp_seq;
+
+	pack_container_read_prp<cont_type,it_type> rp(c,f,it);
+	boost::mpl::for_each_ref<prp_seq>(rp);
+
+	return rp.ok;
+}
+
+/*! \brief Write a vector, a grid or a sparse grid in a self-describing container file
+ *
+ * The file contain the kind of container, the dimensionality, the type of every property,
+ * the layout and the byte order. It can be read by a program that use a different aggregate,
+ * as long as the properties read have the same number of components (numeric properties are
+ * converted). The data are written through a small buffer, no copy of the container is created
+ *
+ * \snippet Packer_unit_tests.hpp Write and read a container file
+ *
+ * \param c container
+ * \param file file name
+ *
+ * \return true if succeed
+ *
+ */
+template<typename cont_type>
+bool pack_container_write(const cont_type & c, const std::string & file)
+{
+	typedef typename cont_type::value_type T;
+	typedef pack_container_io<cont_type> io;
+
+	static_assert(has_pack_agg<T>::result::value == false,"the properties with a pack() member cannot be stored in a container file");
+	static_assert(T::max_prop <= FILE_MEMORY_MAX_PROP,"too many properties, increase FILE_MEMORY_MAX_PROP");
+	static_assert(io::dims <= FILE_MEMORY_MAX_DIM,"too many dimensions, increase FILE_MEMORY_MAX_DIM");
+	static_assert(sizeof(pack_container_header) <= FILE_MEMORY_ALIGN,"the header does not fit before the first block");
+
+	pack_container_header hd;
+	memset(&hd,0,sizeof(pack_container_header));
+	memcpy(hd.magic,"OFPMCONT",8);
+
+	hd.version = PACK_CONT_VERSION;
+	hd.endian = PACK_CONT_ENDIAN;
+	hd.kind = pack_container_kind<cont_type>::value;
+	hd.layout = io::layout;
+	hd.dim = io::dims;
+	hd.n_prop = T::max_prop;
+	hd.n_ele = io::n_ele(c);
+	io::getSize(c,hd.sz);
+
+	pack_container_fill_prop<T> fp(hd);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fp);
+
+	// every block start at a multiple of FILE_MEMORY_ALIGN
+
+	auto align = [](size_t off) {return (off + FILE_MEMORY_ALIGN - 1) / FILE_MEMORY_ALIGN * FILE_MEMORY_ALIGN;};
+
+	size_t off = FILE_MEMORY_ALIGN;
+
+	if (hd.kind == PACK_CONT_KIND_SGRID)
+	{
+		hd.n_run = (hd.n_ele + PACK_CONT_RUN - 1) / PACK_CONT_RUN;
+		hd.off_pos = off;
+		off = align(off + hd.n_ele * hd.dim * sizeof(long int));
+		hd.off_run = off;
+		off = align(off + hd.n_run * sizeof(pack_container_run));
+	}
+
+	for (size_t i = 0 ; i < hd.n_prop ; i++)
+	{
+		hd.prop[i].offset = off;
+		off = align(off + hd.n_ele * hd.prop[i].size);
+	}
+
+	int fd = ::open(file.c_str(),O_RDWR | O_CREAT | O_TRUNC,0644);
+
+	if (fd == -1)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error creating the file " << file << std::endl;
+		return false;
+	}
+
+	pack_container_writer w(fd);
+	w.add(&hd,sizeof(pack_container_header));
+
+	io::write_positions(c,hd,w);
+
+	pack_container_write_prp<cont_type> wp(c,hd,w);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(wp);
+
+	w.flush();
+
+	bool ok = w.isOk();
+	ok &= ftruncate(fd,off) == 0;
+
+	close(fd);
+
+	if (ok == false)
+	{std::cerr << __FILE__ << ":" << __LINE__ << " error writing the file " << file << std::endl;}
+
+	return ok;
+}
+
+/*! \brief Read the elements [start,stop) of a vector stored in a container file
+ *
+ * The vector is resized to stop - start elements, only the selected properties are read
+ *
+ * \tparam prp properties to read (all if empty)
+ *
+ * \param v vector
+ * \param file file name
+ * \param start first element
+ * \param stop one past the last element
+ *
+ * \return true if succeed
+ *
+ */
+template<unsigned int ... prp, typename vector_type>
+bool pack_container_read_range(vector_type & v, const std::string & file, size_t start, size_t stop)
+{
+	pack_container_file f;
+
+	if (f.open(file) == false || f.checkKind(PACK_CONT_KIND_VECTOR,1) == false)
+	{return false;}
+
+	stop = (stop > f.getHeader().n_ele)?f.getHeader().n_ele:stop;
+	start = (start > stop)?stop:start;
+
+	v.resize(stop - start);
+
+	auto it = [&](auto f_key)
+	{
+		for (size_t i = start ; i < stop ; i++)
+		{f_key(i - start,i);}
+	};
+
+	return pack_container_read_selected<prp...>(v,f,it);
+}
+
+/*! \brief Read the points inside a box of a grid or a sparse grid stored in a container file
+ *
+ * If the grid does not have the size stored in the file it is recreated with that size, otherwise the
+ * points outside the box and the properties not read are retained. So a restart can read the
+ * properties and the sub-boxes it need one by one
+ *
+ * \tparam prp properties to read (all if empty)
+ *
+ * \param g grid
+ * \param file file name
+ * \param box box to read (extremes included)
+ *
+ * \return true if succeed
+ *
+ */
+template<unsigned int ... prp, typename grid_type>
+bool pack_container_read_box(grid_type & g, const std::string & file, const Box<grid_type::dims,long int> & box)
+{
+	const unsigned int dim = grid_type::dims;
+
+	pack_container_file f;
+
+	if (f.open(file) == false || f.checkKind(pack_container_kind<grid_type>::value,dim) == false)
+	{return false;}
+
+	const pack_container_header & hd = f.getHeader();
+
+	size_t sz[dim];
+	bool same = true;
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		sz[i] = hd.sz[i];
+		same &= (sz[i] == g.getGrid().size(i));
+	}
+
+	if (hd.kind == PACK_CONT_KIND_GRID)
+	{
+		if (same == false)
+		{pack_container_io<grid_type>::recreate(g,sz);}
+
+		// intersection of the box with the grid
+
+		grid_key_dx<dim> start;
+		grid_key_dx<dim> stop;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			start.set_d(i,(box.getLow(i) < 0)?0:box.getLow(i));
+			stop.set_d(i,(box.getHigh(i) >= (long int)sz[i])?(long int)sz[i]-1:box.getHigh(i));
+
+			if (start.get(i) > stop.get(i))
+			{return true;}
+		}
+
+		grid_sm<dim,void> gs(sz);
+
+		auto it = [&](auto f_key)
+		{
+			grid_key_dx_iterator_sub<dim> sub(gs,start,stop);
+
+			while (sub.isNext())
+			{
+				auto key = sub.get();
+				f_key(key,gs.LinId(key));
+				++sub;
+			}
+		};
+
+		return pack_container_read_selected<prp...>(g,f,it);
+	}
+
+	if (same == false)
+	{pack_container_io<grid_type>::recreate(g,sz);}
+
+	const long int * pos = f.mapPositions();
+	const pack_container_run * runs = f.mapRuns();
+
+	auto it = [&](auto f_key)
+	{
+		for (size_t r = 0 ; r < hd.n_run ; r++)
+		{
+			bool inte = true;
+			for (size_t i = 0 ; i < dim ; i++)
+			{inte &= (runs[r].low[i] <= box.getHigh(i) && runs[r].high[i] >= box.getLow(i));}
+
+			if (inte == false)
+			{continue;}
+
+			for (size_t k = runs[r].start ; k < runs[r].start + runs[r].n ; k++)
+			{
+				grid_key_dx<dim> key;
+				bool inside = true;
+
+				for (size_t i = 0 ; i < dim ; i++)
+				{
+					key.set_d(i,pos[k*dim + i]);
+					inside &= (key.get(i) >= box.getLow(i) && key.get(i) <= box.getHigh(i));
+				}
+
+				if (inside == true)
+				{f_key(key,k);}
+			}
+		}
+	};
+
+	return pack_container_read_selected<prp...>(g,f,it);
+}
+
+/*! \brief Read a vector, a grid or a sparse grid stored in a container file
+ *
+ * \tparam prp properties to read (all if empty)
+ *
+ * \param c container
+ * \param file file name
+ *
+ * \return true if succeed
+ *
+ */
+template<unsigned int ... prp, typename cont_type>
+typename std::enable_if<pack_container_kind<cont_type>::value == PACK_CONT_KIND_VECTOR,bool>::type
+pack_container_read(cont_type & c, const std::string & file)
+{
+	return pack_container_read_range<prp...>(c,file,0,(size_t)-1);
+}
+
+/*! \brief Read a vector, a grid or a sparse grid stored in a container file
+ *
+ * \tparam prp properties to read (all if empty)
+ *
+ * \param c container
+ * \param file file name
+ *
+ * \return true if succeed
+ *
+ */
+template<unsigned int ... prp, typename cont_type>
+typename std::enable_if<pack_container_kind<cont_type>::value != PACK_CONT_KIND_VECTOR,bool>::type
+pack_container_read(cont_type & c, const std::string & file)
+{
+	Box<cont_type::dims,long int> box;
+
+	for (size_t i = 0 ; i < cont_type::dims ; i++)
+	{
+		box.setLow(i,std::numeric_limits<long int>::min());
+		box.setHigh(i,std::numeric_limits<long int>::max());
+	}
+
+	return pack_container_read_box<prp...>(c,file,box);
+}
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_CONTAINER_HPP_ */
@@ -0,0 +1,978 @@
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_IOVEC_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_IOVEC_HPP_
+
+#include <vector>
+#include <cstring>
+#include "Packer.hpp"
+#include "Unpacker.hpp"
+#include "Grid/iterators/grid_key_dx_iterator.hpp"
+
+/*! \brief Rows of a sub-grid smaller than this (in byte) are copied in the staging buffer
+ *         instead of being referenced (too many small segments cost more than the copy)
+ *
+ */
+#ifndef PACK_IOVEC_MIN_SEGMENT
+#define PACK_IOVEC_MIN_SEGMENT 256
+#endif
+
+//! A segment of a scatter/gather pack (like struct iovec)
+struct pack_iovec_seg
+{
+	//! pointer to the data
+	const void * ptr;
+
+	//! length in byte
+	size_t len;
+};
+
+/*! \brief Scatter/gather pack buffer
+ *
+ * Instead of copying the data in a contiguous buffer, the packed message is described by a list of
+ * segments (pointer,length). The segments point directly to the memory of the packed objects when
+ * their layout is already the packed layout (vector and grids with memory_traits_lin packing all the properties),
+ * the rest (headers, property selections, interleaved layouts, nested objects) is packed with the standard Packer
+ * in a staging buffer and referenced from there.
+ *
+ * Concatenating the segments give exactly the same bytes produced by the standard Packer, so the segments
+ * can be given directly to writev/MPI_Type_create_hindexed or gathered. The referenced objects must
+ * not be modified until the message has been consumed.
+ *
+ * \see Packer_iovec Unpack_iovec
+ *
+ * \snippet Packer_unit_tests.hpp Pack and unpack with segments
+ *
+ * \tparam Mem memory of the staging buffer
+ *
+ */
+template<typename Mem>
+class Pack_iovec
+{
+	//! segments
+	std::vector<pack_iovec_seg> seg;
+
+	//! staging memory
+	Mem stg;
+
+	//! staging buffer
+	ExtPreAlloc<Mem> * ext;
+
+	//! total number of byte
+	size_t tot;
+
+	//! start of the actual staging
+	size_t stg_start;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param req size of the staging buffer (calculated with Packer_iovec::packRequest)
+	 *
+	 */
+	Pack_iovec(size_t req)
+	:tot(0),stg_start(0)
+	{
+		stg.allocate(req);
+		ext = new ExtPreAlloc<Mem>(req,stg);
+		ext->incRef();
+	}
+
+	//! Destructor
+	~Pack_iovec()
+	{
+		ext->decRef();
+		delete ext;
+	}
+
+	/*! \brief Add a segment referencing memory outside the staging buffer
+	 *
+	 * If the segment follow the previous one in memory the two are merged
+	 *
+	 * \param ptr pointer to the data
+	 * \param len number of byte
+	 *
+	 */
+	void addSegment(const void * ptr, size_t len)
+	{
+		if (len == 0)
+		{return;}
+
+		tot += len;
+
+		if (seg.size() != 0 && (const char *)seg.back().ptr + seg.back().len == (const char *)ptr)
+		{
+			seg.back().len += len;
+			return;
+		}
+
+		seg.push_back(pack_iovec_seg{ptr,len});
+	}
+
+	/*! \brief Staging buffer where the data that cannot be referenced are packed
+	 *
+	 * Everything packed between startStaging() and stopStaging() become one segment
+	 *
+	 * \return the staging buffer
+	 *
+	 */
+	ExtPreAlloc<Mem> & getStaging()
+	{
+		return *ext;
+	}
+
+	//! Start to pack in the staging buffer
+	void startStaging()
+	{
+		stg_start = ext->size();
+	}
+
+	//! Stop to pack in the staging buffer and add the packed data as segment
+	void stopStaging()
+	{
+		addSegment(ext->getPointerOffset(stg_start),ext->size() - stg_start);
+	}
+
+	/*! \brief Number of segments
+	 *
+	 * \return the number of segments
+	 *
+	 */
+	size_t getNSegments() const
+	{
+		return seg.size();
+	}
+
+	/*! \brief Get the segment i
+	 *
+	 * \param i segment
+	 *
+	 * \return the segment
+	 *
+	 */
+	const pack_iovec_seg & getSegment(size_t i) const
+	{
+		return seg[i];
+	}
+
+	/*! \brief Get all the segments
+	 *
+	 * \return the segments
+	 *
+	 */
+	const std::vector<pack_iovec_seg> & getSegments() const
+	{
+		return seg;
+	}
+
+	/*! \brief Total size of the message
+	 *
+	 * \return the sum of the length of the segments
+	 *
+	 */
+	size_t size() const
+	{
+		return tot;
+	}
+
+	/*! \brief Number of byte copied in the staging buffer
+	 *
+	 * \return the number of byte copied
+	 *
+	 */
+	size_t stagingSize() const
+	{
+		return ext->size();
+	}
+
+	/*! \brief Copy the message in a contiguous buffer
+	 *
+	 * \param dst destination (at least size() byte)
+	 *
+	 */
+	void gather(void * dst) const
+	{
+		char * d = (char *)dst;
+
+		for (size_t i = 0 ; i < seg.size() ; i++)
+		{
+			memcpy(d,seg[i].ptr,seg[i].len);
+			d += seg[i].len;
+		}
+	}
+};
+
+/*! \brief Read a message described by segments
+ *
+ * \see Unpacker_iovec
+ *
+ */
+class Unpack_iovec
+{
+	//! segments
+	const pack_iovec_seg * seg;
+
+	//! number of segments
+	size_t n_seg;
+
+	//! actual segment
+	size_t act;
+
+	//! offset inside the actual segment
+	size_t off;
+
+	//! Skip the finished (or empty) segments
+	void next_seg()
+	{
+		while (act < n_seg && off == seg[act].len)
+		{
+			act++;
+			off = 0;
+		}
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param seg segments
+	 * \param n_seg number of segments
+	 *
+	 */
+	Unpack_iovec(const pack_iovec_seg * seg, size_t n_seg)
+	:seg(seg),n_seg(n_seg),act(0),off(0)
+	{
+		next_seg();
+	}
+
+	/*! \brief Constructor
+	 *
+	 * \param seg segments
+	 *
+	 */
+	Unpack_iovec(const std::vector<pack_iovec_seg> & seg)
+	:seg(seg.data()),n_seg(seg.size()),act(0),off(0)
+	{
+		next_seg();
+	}
+
+	/*! \brief Copy n byte from the message, crossing the segments boundary
+	 *
+	 * \param dst destination
+	 * \param n number of byte
+	 *
+	 */
+	void read(void * dst, size_t n)
+	{
+		char * d = (char *)dst;
+
+		while (n != 0)
+		{
+			if (act >= n_seg)
+			{
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " reading after the end of the message" << std::endl;
+				return;
+			}
+
+			size_t cp = std::min(n,seg[act].len - off);
+			memcpy(d,(const char *)seg[act].ptr + off,cp);
+
+			d += cp;
+			n -= cp;
+			off += cp;
+			next_seg();
+		}
+	}
+
+	/*! \brief Copy n byte from the message without consuming them
+	 *
+	 * \param dst destination
+	 * \param n number of byte
+	 *
+	 */
+	void peek(void * dst, size_t n)
+	{
+		size_t act_s = act;
+		size_t off_s = off;
+
+		read(dst,n);
+
+		act = act_s;
+		off = off_s;
+	}
+
+	/*! \brief Skip n byte
+	 *
+	 * \param n number of byte
+	 *
+	 */
+	void skip(size_t n)
+	{
+		while (n != 0 && act < n_seg)
+		{
+			size_t cp = std::min(n,seg[act].len - off);
+
+			n -= cp;
+			off += cp;
+			next_seg();
+		}
+	}
+
+	/*! \brief Number of byte not read
+	 *
+	 * \return the remaining byte
+	 *
+	 */
+	size_t remaining() const
+	{
+		size_t r = 0;
+
+		for (size_t i = act ; i < n_seg ; i++)
+		{r += seg[i].len;}
+
+		return r - off;
+	}
+};
+
+/*! \brief Check if the packed layout of T with the properties prp is its memory layout
+ *
+ * \tparam T vector or grid
+ * \tparam is_agg true if T contain aggregates
+ * \tparam prp properties
+ *
+ */
+template<typename T, bool is_agg, int ... prp>
+struct pack_iovec_zero_copy_impl
+{
+	typedef typename T::value_type vT;
+
+	//! the properties are all the properties in order
+	template<bool all, int ... prp2>
+	struct all_prp
+	{
+		enum
+		{
+			value = sizeof...(prp2) == vT::max_prop && is_contiguos<prp2...>::type::value
+		};
+	};
+
+	template<int ... prp2>
+	struct all_prp<true,prp2...>
+	{
+		enum
+		{
+			value = true
+		};
+	};
+
+	enum
+	{
+		simple = has_pack_agg<vT,prp...>::result::value == false,
+		value = std::is_same<typename T::layout_type,typename memory_traits_lin<vT>::type>::value &&
+		        simple &&
+		        all_prp<sizeof...(prp) == 0,prp...>::value
+	};
+};
+
+template<typename T, int ... prp>
+struct pack_iovec_zero_copy_impl<T,false,prp...>
+{
+	enum
+	{
+		simple = false,
+		value = false
+	};
+};
+
+/*! \brief Check if an object can be packed referencing its memory
+ *
+ * value is true when the object can be referenced, simple is true when the properties
+ * do not have nested objects (so the size of the packed message is known from its header)
+ *
+ * \tparam T vector or grid
+ * \tparam prp properties
+ *
+ */
+template<typename T, int ... prp>
+struct pack_iovec_zero_copy
+{
+	typedef pack_iovec_zero_copy_impl<T,has_typedef_type<typename T::value_type>::value,prp...> impl;
+
+	enum
+	{
+		simple = impl::simple,
+		value = impl::value
+	};
+};
+
+/*! \brief Scatter/gather packer
+ *
+ * Same interface of the Packer, but the object is packed into a Pack_iovec. Primitives and
+ * objects are copied in the staging buffer
+ *
+ * \tparam T object type to pack
+ * \tparam Mem Memory of the staging buffer
+ * \tparam Implementation of the packer (the Pack_selector choose the correct one)
+ *
+ */
+template<typename T, typename Mem, int pack_type = Pack_selector<T>::value>
+class Packer_iovec
+{
+public:
+
+	/*! \brief Size required in the staging buffer
+	 *
+	 * \param obj object to pack
+	 * \param req counter to increment
+	 *
+	 */
+	static void packRequest(const T & obj, size_t & req)
+	{
+		Packer<T,Mem>::packRequest(obj,req);
+	}
+
+	/*! \brief Pack the object
+	 *
+	 * \param iov scatter/gather buffer
+	 * \param obj object to pack
+	 * \param sts pack statistic
+	 *
+	 */
+	static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+	{
+		iov.startStaging();
+		Packer<T,Mem>::pack(iov.getStaging(),obj,sts);
+		iov.stopStaging();
+	}
+};
+
+//! Scatter/gather packer for vectors
+template<typename T, typename Mem>
+class Packer_iovec<T,Mem,PACKER_GENERAL>
+{
+	//! pack referencing the memory of the vector
+	template<bool zero_copy, int ... prp>
+	struct pack_impl
+	{
+		static void packRequest(const T & obj, size_t & req)
+		{
+			req += sizeof(size_t);
+		}
+
+		static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+		{
+			iov.startStaging();
+			Packer<size_t,Mem>::pack(iov.getStaging(),obj.size(),sts);
+			iov.stopStaging();
+
+			iov.addSegment(obj.getPointer(),obj.size() * sizeof(typename T::value_type::type));
+
+			sts.incReq();
+		}
+	};
+
+	//! pack copying in the staging buffer
+	template<int ... prp>
+	struct pack_impl<false,prp...>
+	{
+		static void packRequest(const T & obj, size_t & req)
+		{
+			Packer<T,Mem>::template packRequest<prp...>(obj,req);
+		}
+
+		static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+		{
+			iov.startStaging();
+			Packer<T,Mem>::template pack<prp...>(iov.getStaging(),obj,sts);
+			iov.stopStaging();
+		}
+	};
+
+public:
+
+	/*! \brief Size required in the staging buffer
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj vector to pack
+	 * \param req counter to increment
+	 *
+	 */
+	template<int ... prp> static void packRequest(const T & obj, size_t & req)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::packRequest(obj,req);
+	}
+
+	/*! \brief Pack the vector
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param iov scatter/gather buffer
+	 * \param obj vector to pack
+	 * \param sts pack statistic
+	 *
+	 */
+	template<int ... prp> static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::pack(iov,obj,sts);
+	}
+};
+
+//! Scatter/gather packer for grids
+template<typename T, typename Mem>
+class Packer_iovec<T,Mem,PACKER_GRID>
+{
+	/*! \brief check if the rows of the box are referenced or copied
+	 *
+	 * \param obj grid
+	 * \param start start of the box
+	 * \param stop stop of the box
+	 *
+	 * \return true if the rows are referenced
+	 *
+	 */
+	static bool sub_reference_rows(const T & obj, const grid_key_dx<T::dims> & start, const grid_key_dx<T::dims> & stop)
+	{
+		size_t row = (stop.get(0) - start.get(0) + 1) * sizeof(typename T::value_type::type);
+
+		// rows covering the full grid in direction 0 are merged in slabs
+		return row >= PACK_IOVEC_MIN_SEGMENT || (start.get(0) == 0 && stop.get(0) == (long int)obj.getGrid().size(0) - 1);
+	}
+
+	//! pack referencing the memory of the grid
+	template<bool zero_copy, int ... prp>
+	struct pack_impl
+	{
+		static void packRequest(const T & obj, size_t & req)
+		{
+			req += T::dims*sizeof(size_t);
+		}
+
+		static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+		{
+			iov.startStaging();
+			for (size_t i = 0 ; i < T::dims ; i++)
+			{Packer<size_t,Mem>::pack(iov.getStaging(),obj.getGrid().size(i),sts);}
+			iov.stopStaging();
+
+			iov.addSegment(obj.getPointer(),obj.size() * sizeof(typename T::value_type::type));
+
+			sts.incReq();
+		}
+
+		template<typename grid_sub_it_type> static void packRequest(T & obj, grid_sub_it_type & sub, size_t & req)
+		{
+			if (sub_reference_rows(obj,sub.getStart(),sub.getStop()) == false)
+			{req += sub.getVolume() * sizeof(typename T::value_type::type);}
+		}
+
+		template<typename grid_sub_it_type> static void pack(Pack_iovec<Mem> & iov, T & obj, grid_sub_it_type & sub_it, Pack_stat & sts)
+		{
+			grid_key_dx<T::dims> start = sub_it.getStart();
+			grid_key_dx<T::dims> stop = sub_it.getStop();
+
+			size_t sz[T::dims];
+			for (size_t i = 0 ; i < T::dims ; i++)
+			{
+				if (stop.get(i) < start.get(i))
+				{return;}
+
+				sz[i] = stop.get(i) - start.get(i) + 1;
+			}
+
+			size_t row = sz[0] * sizeof(typename T::value_type::type);
+			bool ref = sub_reference_rows(obj,start,stop);
+			const char * base = (const char *)obj.getPointer();
+
+			// iterate the first point of each row
+			sz[0] = 1;
+			grid_sm<T::dims,void> g_rows(sz);
+			grid_key_dx_iterator<T::dims> it(g_rows);
+
+			if (ref == false)
+			{iov.startStaging();}
+
+			while (it.isNext())
+			{
+				grid_key_dx<T::dims> key = start + it.get();
+				const char * src = base + obj.getGrid().LinId(key) * sizeof(typename T::value_type::type);
+
+				if (ref == true)
+				{iov.addSegment(src,row);}
+				else
+				{
+					iov.getStaging().allocate(row);
+					memcpy(iov.getStaging().getPointer(),src,row);
+				}
+
+				++it;
+			}
+
+			if (ref == false)
+			{iov.stopStaging();}
+
+			sts.incReq();
+		}
+	};
+
+	//! pack copying in the staging buffer
+	template<int ... prp>
+	struct pack_impl<false,prp...>
+	{
+		static void packRequest(const T & obj, size_t & req)
+		{
+			Packer<T,Mem,PACKER_GRID>::template packRequest<prp...>(obj,req);
+		}
+
+		static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+		{
+			iov.startStaging();
+			Packer<T,Mem,PACKER_GRID>::template pack<prp...>(iov.getStaging(),obj,sts);
+			iov.stopStaging();
+		}
+
+		template<typename grid_sub_it_type> static void packRequest(T & obj, grid_sub_it_type & sub, size_t & req)
+		{
+			Packer<T,Mem,PACKER_GRID>::template packRequest<grid_sub_it_type,prp...>(obj,sub,req);
+		}
+
+		template<typename grid_sub_it_type> static void pack(Pack_iovec<Mem> & iov, T & obj, grid_sub_it_type & sub_it, Pack_stat & sts)
+		{
+			iov.startStaging();
+			Packer<T,Mem,PACKER_GRID>::template pack<grid_sub_it_type,prp...>(iov.getStaging(),obj,sub_it,sts);
+			iov.stopStaging();
+		}
+	};
+
+public:
+
+	/*! \brief Size required in the staging buffer
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj grid to pack
+	 * \param req counter to increment
+	 *
+	 */
+	template<int ... prp> static void packRequest(const T & obj, size_t & req)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::packRequest(obj,req);
+	}
+
+	/*! \brief Size required in the staging buffer to pack a sub-grid
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam prp properties to pack
+	 *
+	 * \param obj grid to pack
+	 * \param sub sub-grid iterator
+	 * \param req counter to increment
+	 *
+	 */
+	template<typename grid_sub_it_type, int ... prp> static void packRequest(T & obj, grid_sub_it_type & sub, size_t & req)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::packRequest(obj,sub,req);
+	}
+
+	/*! \brief Pack the grid
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param iov scatter/gather buffer
+	 * \param obj grid to pack
+	 * \param sts pack statistic
+	 *
+	 */
+	template<int ... prp> static void pack(Pack_iovec<Mem> & iov, const T & obj, Pack_stat & sts)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::pack(iov,obj,sts);
+	}
+
+	/*! \brief Pack a sub-grid
+	 *
+	 * A row of the sub-grid is a segment, rows shorter than PACK_IOVEC_MIN_SEGMENT are copied
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam prp properties to pack
+	 *
+	 * \param iov scatter/gather buffer
+	 * \param obj grid to pack
+	 * \param sub_it sub-grid iterator
+	 * \param sts pack statistic
+	 *
+	 */
+	template<typename grid_sub_it_type, int ... prp> static void pack(Pack_iovec<Mem> & iov, T & obj, grid_sub_it_type & sub_it, Pack_stat & sts)
+	{
+		pack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::pack(iov,obj,sub_it,sts);
+	}
+};
+
+/*! \brief Unpack from a message described by segments
+ *
+ * Primitives and objects are copied from the segments
+ *
+ * \tparam T object type to unpack
+ * \tparam Mem Memory type
+ * \tparam Implementation of the unpacker (the Pack_selector choose the correct one)
+ *
+ */
+template<typename T, typename Mem, int pack_type = Pack_selector<T>::value>
+class Unpacker_iovec
+{
+public:
+
+	/*! \brief Unpack the object
+	 *
+	 * \param iov message
+	 * \param obj object where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+	{
+		iov.read(&obj,sizeof(T));
+		ps.addOffset(sizeof(T));
+	}
+};
+
+/*! \brief Unpack with the standard Unpacker the next n byte of the message
+ *
+ * \param iov message
+ * \param n number of byte
+ * \param f function that unpack from an ExtPreAlloc
+ *
+ * \return the number of byte unpacked
+ *
+ */
+template<typename Mem, typename lambda_f>
+size_t unpack_iovec_gathered(Unpack_iovec & iov, size_t n, lambda_f f)
+{
+	Mem tmp;
+	tmp.allocate(n);
+	ExtPreAlloc<Mem> ext(n,tmp);
+	ext.incRef();
+
+	iov.peek(tmp.getPointer(),n);
+
+	Unpack_stat ps_g;
+	f(ext,ps_g);
+	iov.skip(ps_g.getOffset());
+
+	ext.decRef();
+
+	return ps_g.getOffset();
+}
+
+//! Unpack a vector from a message described by segments
+template<typename T, typename Mem>
+class Unpacker_iovec<T,Mem,PACKER_GENERAL>
+{
+	//! the data are read directly in the vector memory
+	template<bool zero_copy, unsigned int ... prp>
+	struct unpack_impl
+	{
+		static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+		{
+			size_t n;
+			iov.read(&n,sizeof(size_t));
+
+			obj.resize(n);
+			iov.read(obj.getPointer(),n * sizeof(typename T::value_type::type));
+
+			ps.addOffset(sizeof(size_t) + n * sizeof(typename T::value_type::type));
+		}
+	};
+
+	//! size of the packed vector, calculated from its header
+	template<bool simple, unsigned int ... prp>
+	struct msg_size
+	{
+		static size_t get(Unpack_iovec & iov)
+		{
+			size_t n_ele;
+			iov.peek(&n_ele,sizeof(size_t));
+
+			return sizeof(size_t) + T::template packMem<prp...>(n_ele,0);
+		}
+	};
+
+	//! with nested objects the size is unknown, all the rest of the message is gathered
+	template<unsigned int ... prp>
+	struct msg_size<false,prp...>
+	{
+		static size_t get(Unpack_iovec & iov)
+		{
+			return iov.remaining();
+		}
+	};
+
+	//! the message is gathered and unpacked with the standard Unpacker
+	template<unsigned int ... prp>
+	struct unpack_impl<false,prp...>
+	{
+		static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+		{
+			size_t n = msg_size<pack_iovec_zero_copy<T,prp...>::simple,prp...>::get(iov);
+
+			ps.addOffset(unpack_iovec_gathered<Mem>(iov,n,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_g)
+			                                             {Unpacker<T,Mem>::template unpack<prp...>(ext,obj,ps_g);}));
+		}
+	};
+
+public:
+
+	/*! \brief Unpack the vector
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param iov message
+	 * \param obj vector where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	template<unsigned int ... prp> static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+	{
+		unpack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::unpack(iov,obj,ps);
+	}
+};
+
+//! Unpack a grid from a message described by segments
+template<typename T, typename Mem>
+class Unpacker_iovec<T,Mem,PACKER_GRID>
+{
+	//! the data are read directly in the grid memory
+	template<bool zero_copy, unsigned int ... prp>
+	struct unpack_impl
+	{
+		static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+		{
+			size_t dims[T::dims];
+			iov.read(dims,T::dims*sizeof(size_t));
+
+			obj.resize(dims);
+			iov.read(obj.getPointer(),obj.size() * sizeof(typename T::value_type::type));
+
+			ps.addOffset(T::dims*sizeof(size_t) + obj.size() * sizeof(typename T::value_type::type));
+		}
+
+		template<typename grid_sub_it_type, typename context_type>
+		static void unpack(Unpack_iovec & iov, grid_sub_it_type & sub_it, T & obj, Unpack_stat & ps, context_type & context, rem_copy_opt opt)
+		{
+			grid_key_dx<T::dims> start = sub_it.getStart();
+			grid_key_dx<T::dims> stop = sub_it.getStop();
+
+			size_t sz[T::dims];
+			for (size_t i = 0 ; i < T::dims ; i++)
+			{
+				if (stop.get(i) < start.get(i))
+				{return;}
+
+				sz[i] = stop.get(i) - start.get(i) + 1;
+			}
+
+			size_t row = sz[0] * sizeof(typename T::value_type::type);
+			char * base = (char *)obj.getPointer();
+
+			sz[0] = 1;
+			grid_sm<T::dims,void> g_rows(sz);
+			grid_key_dx_iterator<T::dims> it(g_rows);
+
+			while (it.isNext())
+			{
+				grid_key_dx<T::dims> key = start + it.get();
+				iov.read(base + obj.getGrid().LinId(key) * sizeof(typename T::value_type::type),row);
+
+				ps.addOffset(row);
+
+				++it;
+			}
+		}
+	};
+
+	//! size of the packed grid, calculated from its header
+	template<bool simple, unsigned int ... prp>
+	struct msg_size
+	{
+		static size_t get(Unpack_iovec & iov)
+		{
+			size_t dims[T::dims];
+			iov.peek(dims,T::dims*sizeof(size_t));
+
+			size_t n_ele = 1;
+			for (size_t i = 0 ; i < T::dims ; i++)
+			{n_ele *= dims[i];}
+
+			return T::dims*sizeof(size_t) + T::template packMem<prp...>(n_ele,0);
+		}
+	};
+
+	//! with nested objects the size is unknown, all the rest of the message is gathered
+	template<unsigned int ... prp>
+	struct msg_size<false,prp...>
+	{
+		static size_t get(Unpack_iovec & iov)
+		{
+			return iov.remaining();
+		}
+	};
+
+	//! the message is gathered and unpacked with the standard Unpacker
+	template<unsigned int ... prp>
+	struct unpack_impl<false,prp...>
+	{
+		static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+		{
+			size_t n = msg_size<pack_iovec_zero_copy<T,prp...>::simple,prp...>::get(iov);
+
+			ps.addOffset(unpack_iovec_gathered<Mem>(iov,n,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_g)
+			                                             {Unpacker<T,Mem,PACKER_GRID>::template unpack<prp...>(ext,obj,ps_g);}));
+		}
+
+		template<typename grid_sub_it_type, typename context_type>
+		static void unpack(Unpack_iovec & iov, grid_sub_it_type & sub_it, T & obj, Unpack_stat & ps, context_type & context, rem_copy_opt opt)
+		{
+			typedef object<typename object_creator<typename T::value_type::type,prp...>::type> prp_object;
+			size_t n = sub_it.getVolume() * sizeof(prp_object);
+
+			ps.addOffset(unpack_iovec_gathered<Mem>(iov,n,[&](ExtPreAlloc<Mem> & ext, Unpack_stat & ps_g)
+			                                             {Unpacker<T,Mem,PACKER_GRID>::template unpack<grid_sub_it_type,context_type,prp...>(ext,sub_it,obj,ps_g,context,opt);}));
+		}
+	};
+
+public:
+
+	/*! \brief Unpack the grid
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param iov message
+	 * \param obj grid where to unpack
+	 * \param ps unpack statistic
+	 *
+	 */
+	template<unsigned int ... prp> static void unpack(Unpack_iovec & iov, T & obj, Unpack_stat & ps)
+	{
+		unpack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::unpack(iov,obj,ps);
+	}
+
+	/*! \brief Unpack a sub-grid
+	 *
+	 * \tparam grid_sub_it_type sub-grid iterator
+	 * \tparam context_type context type
+	 * \tparam prp properties to unpack
+	 *
+	 * \param iov message
+	 * \param sub_it sub-grid iterator
+	 * \param obj grid where to unpack
+	 * \param ps unpack statistic
+	 * \param context context
+	 * \param opt options
+	 *
+	 */
+	template<typename grid_sub_it_type, typename context_type, unsigned int ... prp>
+	static void unpack(Unpack_iovec & iov, grid_sub_it_type & sub_it, T & obj, Unpack_stat & ps, context_type & context, rem_copy_opt opt)
+	{
+		unpack_impl<pack_iovec_zero_copy<T,prp...>::value,prp...>::unpack(iov,sub_it,obj,ps,context,opt);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_IOVEC_HPP_ */
@@ -0,0 +1,736 @@
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_STREAM_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_STREAM_HPP_
+
+#include <vector>
+#include <cstring>
+#include "Packer_container.hpp"
+#include "util/object_creator.hpp"
+
+//! Default size of the chunks produced by pack_stream (in byte)
+#ifndef PACK_STREAM_CHUNK
+#define PACK_STREAM_CHUNK (4*1024*1024)
+#endif
+
+/*! \brief Object that store the selected properties of one point in a chunk
+ *
+ * \tparam cont_type container
+ * \tparam prp selected properties (all if empty)
+ *
+ */
+template<typename cont_type, int ... prp>
+struct pack_stream_object
+{
+	//! aggregate of the container
+	typedef typename cont_type::value_type T;
+
+	//! object with the selected properties
+	typedef object<typename object_creator<typename T::type,prp...>::type> prp_object;
+
+	//! selected properties
+	typedef typename std::conditional<sizeof...(prp) == 0,
+									  boost::mpl::range_c<int,0,T::max_prop>,
+									  typename to_boost_vmpl<prp...>::type>::type vprp;
+};
+
+/*! \brief Copy the selected properties of a point from the container to the object (or back)
+ *
+ * \tparam to_obj true copy from the container to the object, false from the object to the container
+ * \tparam cont_type container
+ * \tparam key_type key of the point
+ * \tparam prp_object object
+ * \tparam vprp selected properties
+ *
+ */
+template<bool to_obj, typename cont_type, typename key_type, typename prp_object, typename vprp>
+struct pack_stream_copy
+{
+	//! container
+	cont_type & c;
+
+	//! point
+	const key_type & key;
+
+	//! object
+	prp_object & obj;
+
+	/*! \brief constructor
+	 *
+	 * \param c container
+	 * \param key point
+	 * \param obj object
+	 *
+	 */
+	pack_stream_copy(cont_type & c, const key_type & key, prp_object & obj)
+	:c(c),key(key),obj(obj)
+	{}
+
+	//! It copy one property
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		typedef pack_container_io<typename std::remove_const<cont_type>::type> io;
+		typedef typename boost::mpl::at<vprp,t_prp>::type prp_id;
+		typedef typename boost::mpl::at<typename prp_object::type,t_prp>::type obj_type;
+		typedef typename std::remove_const<typename std::remove_reference<decltype(io::template get<prp_id::value>(c,key))>::type>::type cont_prp_type;
+
+		copy(boost::mpl::bool_<to_obj>(),io::template get<prp_id::value>(c,key),boost::fusion::at_c<t_prp::value>(obj.data),(cont_prp_type *)NULL,(obj_type *)NULL);
+	}
+
+	//! from the container to the object
+	template<typename src_type, typename dst_type, typename cont_prp_type, typename obj_type>
+	static void copy(boost::mpl::bool_<true>, src_type && src, dst_type & dst, cont_prp_type *, obj_type *)
+	{
+		meta_copy_d<cont_prp_type,obj_type>::meta_copy_d_(src,dst);
+	}
+
+	//! from the object to the container
+	template<typename dst_type, typename src_type, typename cont_prp_type, typename obj_type>
+	static void copy(boost::mpl::bool_<false>, dst_type && dst, src_type & src, cont_prp_type *, obj_type *)
+	{
+		meta_copy_d<obj_type,cont_prp_type>::meta_copy_d_(src,dst);
+	}
+};
+
+/*! \brief Visit the points of a vector chunk by chunk
+ *
+ * A chunk of a vector is [size_t size of the vector][size_t first element][size_t n][n objects]
+ *
+ * \tparam cont_type container
+ * \tparam kind kind of the container
+ *
+ */
+template<typename cont_type, int kind = pack_container_kind<cont_type>::value>
+class pack_stream_cursor
+{
+	//! next element to pack
+	size_t i;
+
+	//! header of a chunk
+	struct header
+	{
+		//! size of the vector
+		size_t size;
+		//! first element
+		size_t start;
+		//! number of elements
+		size_t n;
+	};
+
+public:
+
+	//! size of the header of a chunk
+	static const size_t hdr_size = sizeof(header);
+
+	//! size of the position of a point
+	static const size_t key_size = 0;
+
+	/*! \brief Constructor
+	 *
+	 * \param c container
+	 *
+	 */
+	pack_stream_cursor(const cont_type & c)
+	:i(0)
+	{}
+
+	/*! \brief Check if there are points to pack
+	 *
+	 * \param c container
+	 *
+	 * \return true if there are points to pack
+	 *
+	 */
+	bool isNext(const cont_type & c)
+	{
+		return i < c.size();
+	}
+
+	/*! \brief Write the header of the next chunk
+	 *
+	 * \param c container
+	 * \param ptr chunk
+	 * \param n_max maximum number of points in the chunk
+	 *
+	 * \return the number of points in the chunk
+	 *
+	 */
+	size_t next(const cont_type & c, unsigned char * ptr, size_t n_max)
+	{
+		header hd;
+		hd.size = c.size();
+		hd.start = i;
+		hd.n = std::min(n_max,c.size() - i);
+
+		memcpy(ptr,&hd,sizeof(header));
+
+		i += hd.n;
+		return hd.n;
+	}
+
+	/*! \brief Check the header of a chunk and resize the vector
+	 *
+	 * \param c container
+	 * \param ptr chunk
+	 * \param sz size of the chunk
+	 * \param obj_size size of the object of a point
+	 *
+	 * \return false if the chunk is corrupted
+	 *
+	 */
+	static bool unpack(cont_type & c, const unsigned char * ptr, size_t sz, size_t obj_size)
+	{
+		header hd;
+
+		if (sz < sizeof(header))
+		{return false;}
+
+		memcpy(&hd,ptr,sizeof(header));
+
+		if (hd.start > hd.size || hd.n > hd.size - hd.start || sz != sizeof(header) + hd.n*obj_size)
+		{return false;}
+
+		if (c.size() != hd.size)
+		{c.resize(hd.size);}
+
+		return true;
+	}
+
+	/*! \brief Visit the points of a chunk
+	 *
+	 * \param ptr chunk
+	 * \param f called for every point f(key)
+	 *
+	 * \return the number of points
+	 *
+	 */
+	template<typename lambda_f> static size_t visit(const unsigned char * ptr, lambda_f f)
+	{
+		header hd;
+		memcpy(&hd,ptr,sizeof(header));
+
+		for (size_t k = 0 ; k < hd.n ; k++)
+		{f(hd.start+k);}
+
+		return hd.n;
+	}
+};
+
+/*! \brief Visit the points of a grid chunk by chunk
+ *
+ * A chunk of a grid is [size_t size of the grid[dim]][long int start[dim]][long int stop[dim]][objects],
+ * the chunk contain the box start-stop in the order of grid_key_dx_iterator_sub. The boxes are full
+ * in the first dimensions (the fastest), so the points of a box are contiguous in a linear layout
+ *
+ */
+template<typename cont_type>
+class pack_stream_cursor<cont_type,PACK_CONT_KIND_GRID>
+{
+	//! dimensionality
+	static const unsigned int dim = cont_type::dims;
+
+	//! start of the next box
+	grid_key_dx<dim> cur;
+
+	//! all the points has been visited
+	bool end;
+
+	//! header of a chunk
+	struct header
+	{
+		//! size of the grid
+		size_t sz[dim];
+		//! start of the box
+		long int start[dim];
+		//! stop of the box
+		long int stop[dim];
+	};
+
+	/*! \brief Number of points in the box of a chunk
+	 *
+	 * \param hd header
+	 *
+	 * \return the number of points
+	 *
+	 */
+	static size_t volume(const header & hd)
+	{
+		size_t vol = 1;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{vol *= (hd.stop[i] >= hd.start[i])?(hd.stop[i] - hd.start[i] + 1):0;}
+
+		return vol;
+	}
+
+public:
+
+	static const size_t hdr_size = sizeof(header);
+
+	static const size_t key_size = 0;
+
+	pack_stream_cursor(const cont_type & c)
+	:end(c.getGrid().size() == 0)
+	{
+		cur.zero();
+	}
+
+	bool isNext(const cont_type & c)
+	{
+		return end == false;
+	}
+
+	size_t next(const cont_type & c, unsigned char * ptr, size_t n_max)
+	{
+		header hd;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			hd.sz[i] = c.getGrid().size(i);
+			hd.start[i] = 0;
+			hd.stop[i] = -1;
+		}
+
+		if (end == false)
+		{
+			// the box is full in the dimensions < d, [cur_d,cur_d + m - 1] in d and one point in the dimensions > d
+
+			size_t d = 0;
+			size_t prod = 1;
+
+			while (d < dim && prod * hd.sz[d] <= n_max && cur.get(d) == 0)
+			{
+				prod *= hd.sz[d];
+				d++;
+			}
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				hd.start[i] = (i < d)?0:cur.get(i);
+				hd.stop[i] = (i < d)?(long int)hd.sz[i]-1:cur.get(i);
+			}
+
+			if (d == dim)
+			{end = true;}
+			else
+			{
+				size_t m = std::min(n_max / prod,hd.sz[d] - cur.get(d));
+				hd.stop[d] = cur.get(d) + m - 1;
+
+				// move to the next box
+
+				cur.set_d(d,cur.get(d) + m);
+
+				for (size_t i = d ; i < dim && cur.get(i) == (long int)hd.sz[i] ; i++)
+				{
+					cur.set_d(i,0);
+
+					if (i + 1 == dim)
+					{end = true;}
+					else
+					{cur.set_d(i+1,cur.get(i+1) + 1);}
+				}
+			}
+		}
+
+		memcpy(ptr,&hd,sizeof(header));
+
+		return volume(hd);
+	}
+
+	static bool unpack(cont_type & c, const unsigned char * ptr, size_t sz, size_t obj_size)
+	{
+		header hd;
+
+		if (sz < sizeof(header))
+		{return false;}
+
+		memcpy(&hd,ptr,sizeof(header));
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if (hd.stop[i] >= hd.start[i] && (hd.start[i] < 0 || hd.stop[i] >= (long int)hd.sz[i]))
+			{return false;}
+		}
+
+		if (sz != sizeof(header) + volume(hd)*obj_size)
+		{return false;}
+
+		bool same = true;
+		for (size_t i = 0 ; i < dim ; i++)
+		{same &= (hd.sz[i] == c.getGrid().size(i));}
+
+		if (same == false)
+		{pack_container_io<cont_type>::recreate(c,hd.sz);}
+
+		return true;
+	}
+
+	template<typename lambda_f> static size_t visit(const unsigned char * ptr, lambda_f f)
+	{
+		header hd;
+		memcpy(&hd,ptr,sizeof(header));
+
+		grid_key_dx<dim> start;
+		grid_key_dx<dim> stop;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			start.set_d(i,hd.start[i]);
+			stop.set_d(i,hd.stop[i]);
+
+			if (hd.stop[i] < hd.start[i])
+			{return 0;}
+		}
+
+		grid_sm<dim,void> gs(hd.sz);
+		grid_key_dx_iterator_sub<dim> it(gs,start,stop);
+
+		while (it.isNext())
+		{
+			f(it.get());
+			++it;
+		}
+
+		return volume(hd);
+	}
+};
+
+/*! \brief Visit the points of a sparse grid chunk by chunk
+ *
+ * A chunk of a sparse grid is [size_t size of the grid[dim]][size_t n][n x long int key[dim]][n objects],
+ * the points are in the order of the sparse grid iterator
+ *
+ */
+template<typename cont_type>
+class pack_stream_cursor<cont_type,PACK_CONT_KIND_SGRID>
+{
+	//! dimensionality
+	static const unsigned int dim = cont_type::dims;
+
+	//! iterator over the existing points
+	decltype(std::declval<const cont_type &>().getIterator()) it;
+
+	//! header of a chunk
+	struct header
+	{
+		//! size of the grid
+		size_t sz[dim];
+		//! number of points
+		size_t n;
+	};
+
+public:
+
+	static const size_t hdr_size = sizeof(header);
+
+	static const size_t key_size = dim*sizeof(long int);
+
+	pack_stream_cursor(const cont_type & c)
+	:it(c.getIterator())
+	{}
+
+	bool isNext(const cont_type & c)
+	{
+		return it.isNext();
+	}
+
+	size_t next(const cont_type & c, unsigned char * ptr, size_t n_max)
+	{
+		header hd;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{hd.sz[i] = c.getGrid().size(i);}
+
+		// the positions are written first, the objects follow
+
+		hd.n = 0;
+		long int k[dim];
+
+		while (hd.n < n_max && it.isNext())
+		{
+			auto key = it.get();
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{k[i] = key.get(i);}
+
+			memcpy(ptr + sizeof(header) + hd.n*sizeof(k),k,sizeof(k));
+
+			hd.n++;
+			++it;
+		}
+
+		memcpy(ptr,&hd,sizeof(header));
+
+		return hd.n;
+	}
+
+	static bool unpack(cont_type & c, const unsigned char * ptr, size_t sz, size_t obj_size)
+	{
+		header hd;
+
+		if (sz < sizeof(header))
+		{return false;}
+
+		memcpy(&hd,ptr,sizeof(header));
+
+		if (sz != sizeof(header) + hd.n*(key_size + obj_size))
+		{return false;}
+
+		bool same = true;
+		for (size_t i = 0 ; i < dim ; i++)
+		{same &= (hd.sz[i] == c.getGrid().size(i));}
+
+		if (same == false)
+		{pack_container_io<cont_type>::recreate(c,hd.sz);}
+
+		return true;
+	}
+
+	template<typename lambda_f> static size_t visit(const unsigned char * ptr, lambda_f f)
+	{
+		header hd;
+		memcpy(&hd,ptr,sizeof(header));
+
+		long int k[dim];
+		grid_key_dx<dim> key;
+
+		for (size_t j = 0 ; j < hd.n ; j++)
+		{
+			memcpy(k,ptr + sizeof(header) + j*sizeof(k),sizeof(k));
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{key.set_d(i,k[i]);}
+
+			f(key);
+		}
+
+		return hd.n;
+	}
+};
+
+/*! \brief Pack a vector, a grid or a sparse grid in chunks of bounded size
+ *
+ * Packer need a buffer as big as the packed container (calculated with packRequest). pack_stream produce the
+ * packed data one chunk at a time in a buffer of fixed capacity, so the extra memory is one chunk whatever the
+ * size of the container. Every chunk is an independent message that contain the selected properties of a
+ * set of points (a range of a vector, a box of a grid, a list of points of a sparse grid) and can be
+ * unpacked alone, in any order, with unpack_stream. The chunks can be pulled one by one
+ *
+ * \snippet Packer_unit_tests.hpp Pack and unpack in chunks
+ *
+ * or given to a sink
+ *
+ * \snippet Packer_unit_tests.hpp Pack in chunks with a sink
+ *
+ * The container must not be modified until all the chunks have been produced
+ *
+ * \tparam cont_type openfpm::vector, grid_base or sgrid_cpu
+ * \tparam prp properties to pack (all if empty)
+ *
+ */
+template<typename cont_type, int ... prp>
+class pack_stream
+{
+	//! object with the selected properties
+	typedef typename pack_stream_object<cont_type,prp...>::prp_object prp_object;
+
+	//! selected properties
+	typedef typename pack_stream_object<cont_type,prp...>::vprp vprp;
+
+	//! cursor
+	typedef pack_stream_cursor<cont_type> cursor;
+
+	static_assert(has_pack_agg<typename cont_type::value_type,prp...>::result::value == false,"the properties with a pack() member cannot be packed in chunks");
+
+	//! container
+	const cont_type & c;
+
+	//! chunk
+	std::vector<unsigned char> buf;
+
+	//! size of the actual chunk
+	size_t sz;
+
+	//! maximum number of points in a chunk
+	size_t n_max;
+
+	//! position of the next point
+	cursor cur;
+
+	//! no chunk has been produced yet
+	bool first;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param c container to pack
+	 * \param chunk_size maximum size of a chunk in byte
+	 *
+	 */
+	pack_stream(const cont_type & c, size_t chunk_size = PACK_STREAM_CHUNK)
+	:c(c),sz(0),n_max(0),cur(c),first(true)
+	{
+		if (chunk_size < cursor::hdr_size + cursor::key_size + sizeof(prp_object))
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the chunk size " << chunk_size << " cannot contain one point, the minimum is "
+					  << cursor::hdr_size + cursor::key_size + sizeof(prp_object) << std::endl;
+			return;
+		}
+
+		n_max = (chunk_size - cursor::hdr_size) / (cursor::key_size + sizeof(prp_object));
+		buf.resize(chunk_size);
+	}
+
+	/*! \brief Produce the next chunk
+	 *
+	 * An empty container produce one chunk without points (so unpack_stream can resize the destination)
+	 *
+	 * \return false if all the chunks have been produced
+	 *
+	 */
+	bool next()
+	{
+		if (n_max == 0 || (first == false && cur.isNext(c) == false))
+		{return false;}
+
+		first = false;
+
+		unsigned char * ptr = buf.data();
+
+		// the objects follow the header and the positions of the points
+
+		size_t n = cur.next(c,ptr,n_max);
+		size_t off = cursor::hdr_size + n*cursor::key_size;
+
+		cursor::visit(ptr,[&](const auto & key)
+		{
+			typedef typename std::remove_const<typename std::remove_reference<decltype(key)>::type>::type key_type;
+
+			prp_object obj;
+			pack_stream_copy<true,const cont_type,key_type,prp_object,vprp> cp(c,key,obj);
+			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,prp_object::max_prop>>(cp);
+
+			memcpy(ptr + off,&obj.data,sizeof(prp_object));
+			off += sizeof(prp_object);
+		});
+
+		sz = cursor::hdr_size + n*(cursor::key_size + sizeof(prp_object));
+
+		return true;
+	}
+
+	/*! \brief Pointer to the actual chunk
+	 *
+	 * \return the pointer to the chunk
+	 *
+	 */
+	const void * getPointer() const
+	{
+		return buf.data();
+	}
+
+	/*! \brief Size of the actual chunk
+	 *
+	 * \return the size in byte
+	 *
+	 */
+	size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief Produce all the chunks and give them to a sink
+	 *
+	 * \param sink called for every chunk sink(ptr,size)
+	 *
+	 * \return false if the chunk size is too small
+	 *
+	 */
+	template<typename sink_type> bool pack(sink_type sink)
+	{
+		if (n_max == 0)
+		{return false;}
+
+		while (next() == true)
+		{sink(getPointer(),size());}
+
+		return true;
+	}
+};
+
+/*! \brief Unpack the chunks produced by pack_stream
+ *
+ * The destination is resized (or recreated) with the size of the packed container when the first
+ * chunk arrive, every chunk write only its points. The chunks can be given in any order
+ *
+ * \tparam cont_type openfpm::vector, grid_base or sgrid_cpu
+ * \tparam prp properties packed (all if empty), the same used with pack_stream
+ *
+ */
+template<typename cont_type, unsigned int ... prp>
+class unpack_stream
+{
+	//! object with the selected properties
+	typedef typename pack_stream_object<cont_type,prp...>::prp_object prp_object;
+
+	//! selected properties
+	typedef typename pack_stream_object<cont_type,prp...>::vprp vprp;
+
+	//! cursor
+	typedef pack_stream_cursor<cont_type> cursor;
+
+	//! container
+	cont_type & c;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param c container where to unpack
+	 *
+	 */
+	unpack_stream(cont_type & c)
+	:c(c)
+	{}
+
+	/*! \brief Unpack one chunk
+	 *
+	 * \param ptr chunk
+	 * \param sz size of the chunk
+	 *
+	 * \return false if the chunk is corrupted or has been packed with different properties
+	 *
+	 */
+	bool unpack(const void * ptr, size_t sz)
+	{
+		const unsigned char * p = (const unsigned char *)ptr;
+
+		if (cursor::unpack(c,p,sz,sizeof(prp_object)) == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the chunk of size " << sz << " is corrupted or has been packed with different properties" << std::endl;
+			return false;
+		}
+
+		// the objects are at the end of the chunk
+
+		size_t n = (sz - cursor::hdr_size) / (cursor::key_size + sizeof(prp_object));
+		size_t off = sz - n*sizeof(prp_object);
+
+		cursor::visit(p,[&](const auto & key)
+		{
+			typedef typename std::remove_const<typename std::remove_reference<decltype(key)>::type>::type key_type;
+
+			prp_object obj;
+			memcpy((void *)&obj.data,p + off,sizeof(prp_object));
+			off += sizeof(prp_object);
+
+			pack_stream_copy<false,cont_type,key_type,prp_object,vprp> cp(c,key,obj);
+			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,prp_object::max_prop>>(cp);
+		});
+
+		return true;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_STREAM_HPP_ */
@@ -11,6 +11,10 @@
 #include "Pack_selector.hpp"
 #include "Packer.hpp"
 #include "Unpacker.hpp"
+#include "Packer_iovec.hpp"
+#include "Packer_compress.hpp"
+#include "Packer_container.hpp"
+#include "Packer_stream.hpp"
 #include "Grid/grid_util_test.hpp"
 #include <iostream>
 #include "Vector/vector_test_util.hpp"
@@ -352,6 +356,738 @@ BOOST_AUTO_TEST_CASE ( packer_selector_test )
 	BOOST_REQUIRE_EQUAL(Pack_selector<b_test>::value,PACKER_OBJECTS_WITH_POINTER_CHECK);
 }
 
+BOOST_AUTO_TEST_CASE ( packer_unpacker_iovec_test )
+{
+	typedef aggregate<float,float[3],int> aggr;
+	typedef grid_cpu<3,aggr> grid_lin;
+
+	size_t sc = 7;
+
+	openfpm::vector<aggr> v;
+	v.resize(1000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i + 1;
+		v.template get<1>(i)[1] = i + 2;
+		v.template get<1>(i)[2] = i + 3;
+		v.template get<2>(i) = 3*i;
+	}
+
+	size_t sz[] = {16,16,16};
+	grid_lin g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+		size_t lin = g.getGrid().LinId(key);
+
+		g.template get<0>(key) = lin;
+		g.template get<1>(key)[0] = lin + 1;
+		g.template get<1>(key)[1] = lin + 2;
+		g.template get<1>(key)[2] = lin + 3;
+		g.template get<2>(key) = 5*lin;
+
+		++it;
+	}
+
+	// long rows (referenced), full rows (merged in slabs), short rows (copied)
+	grid_key_dx_iterator_sub<3> sub_l(g.getGrid(),{1,2,3},{14,13,12});
+	grid_key_dx_iterator_sub<3> sub_f(g.getGrid(),{0,0,3},{15,15,5});
+	grid_key_dx_iterator_sub<3> sub_s(g.getGrid(),{1,1,1},{3,3,3});
+
+	//! [Pack and unpack with segments]
+
+	// Standard pack
+	size_t req = 0;
+	Packer<size_t,HeapMemory>::packRequest(sc,req);
+	Packer<openfpm::vector<aggr>,HeapMemory>::packRequest<>(v,req);
+	Packer<openfpm::vector<aggr>,HeapMemory>::packRequest<0,2>(v,req);
+	Packer<grid_lin,HeapMemory>::packRequest<>(g,req);
+	Packer<grid_lin,HeapMemory>::packRequest<0,2>(g,req);
+	Packer<grid_lin,HeapMemory>::packRequest<decltype(sub_l),0,1,2>(g,sub_l,req);
+	Packer<grid_lin,HeapMemory>::packRequest<decltype(sub_f),0,1,2>(g,sub_f,req);
+	Packer<grid_lin,HeapMemory>::packRequest<decltype(sub_s),0,1,2>(g,sub_s,req);
+
+	HeapMemory pmem;
+	pmem.allocate(req);
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+
+	Packer<size_t,HeapMemory>::pack(mem,sc,sts);
+	Packer<openfpm::vector<aggr>,HeapMemory>::pack<>(mem,v,sts);
+	Packer<openfpm::vector<aggr>,HeapMemory>::pack<0,2>(mem,v,sts);
+	Packer<grid_lin,HeapMemory>::pack<>(mem,g,sts);
+	Packer<grid_lin,HeapMemory>::pack<0,2>(mem,g,sts);
+	Packer<grid_lin,HeapMemory>::pack<decltype(sub_l),0,1,2>(mem,g,sub_l,sts);
+	Packer<grid_lin,HeapMemory>::pack<decltype(sub_f),0,1,2>(mem,g,sub_f,sts);
+	Packer<grid_lin,HeapMemory>::pack<decltype(sub_s),0,1,2>(mem,g,sub_s,sts);
+
+	// Pack with segments, the sizing pass give only the size of the staging buffer
+	size_t req_stg = 0;
+	Packer_iovec<size_t,HeapMemory>::packRequest(sc,req_stg);
+	Packer_iovec<openfpm::vector<aggr>,HeapMemory>::packRequest<>(v,req_stg);
+	Packer_iovec<openfpm::vector<aggr>,HeapMemory>::packRequest<0,2>(v,req_stg);
+	Packer_iovec<grid_lin,HeapMemory>::packRequest<>(g,req_stg);
+	Packer_iovec<grid_lin,HeapMemory>::packRequest<0,2>(g,req_stg);
+	Packer_iovec<grid_lin,HeapMemory>::packRequest<decltype(sub_l),0,1,2>(g,sub_l,req_stg);
+	Packer_iovec<grid_lin,HeapMemory>::packRequest<decltype(sub_f),0,1,2>(g,sub_f,req_stg);
+	Packer_iovec<grid_lin,HeapMemory>::packRequest<decltype(sub_s),0,1,2>(g,sub_s,req_stg);
+
+	Pack_iovec<HeapMemory> iov(req_stg);
+	Pack_stat sts_iov;
+
+	Packer_iovec<size_t,HeapMemory>::pack(iov,sc,sts_iov);
+	Packer_iovec<openfpm::vector<aggr>,HeapMemory>::pack<>(iov,v,sts_iov);
+	Packer_iovec<openfpm::vector<aggr>,HeapMemory>::pack<0,2>(iov,v,sts_iov);
+	Packer_iovec<grid_lin,HeapMemory>::pack<>(iov,g,sts_iov);
+	Packer_iovec<grid_lin,HeapMemory>::pack<0,2>(iov,g,sts_iov);
+	Packer_iovec<grid_lin,HeapMemory>::pack<decltype(sub_l),0,1,2>(iov,g,sub_l,sts_iov);
+	Packer_iovec<grid_lin,HeapMemory>::pack<decltype(sub_f),0,1,2>(iov,g,sub_f,sts_iov);
+	Packer_iovec<grid_lin,HeapMemory>::pack<decltype(sub_s),0,1,2>(iov,g,sub_s,sts_iov);
+
+	//! [Pack and unpack with segments]
+
+	// the segments contain exactly the standard message
+	BOOST_REQUIRE_EQUAL(iov.size(),req);
+	BOOST_REQUIRE_EQUAL(iov.stagingSize(),req_stg);
+
+	std::vector<char> gath(req);
+	iov.gather(gath.data());
+	BOOST_REQUIRE_EQUAL(memcmp(gath.data(),mem.getPointerBase(),req),0);
+
+	// the vector, the grid and the long rows are referenced, not copied
+	size_t stg_expected = sizeof(size_t) + 2*sizeof(size_t) + v.template packMem<0,2>(v.size(),0) + 3*sizeof(size_t) +
+	                      3*sizeof(size_t) + g.template packMem<0,2>(g.size(),0) + sub_s.getVolume()*sizeof(aggr::type);
+	BOOST_REQUIRE_EQUAL(req_stg,stg_expected);
+
+	bool found_v = false;
+	bool found_g = false;
+	for (size_t i = 0 ; i < iov.getNSegments() ; i++)
+	{
+		if (iov.getSegment(i).ptr == v.getPointer() && iov.getSegment(i).len == v.size()*sizeof(aggr::type))
+		{found_v = true;}
+		if (iov.getSegment(i).ptr == g.getPointer() && iov.getSegment(i).len == g.size()*sizeof(aggr::type))
+		{found_g = true;}
+	}
+
+	BOOST_REQUIRE_EQUAL(found_v,true);
+	BOOST_REQUIRE_EQUAL(found_g,true);
+
+	// the full rows of sub_f are merged in one slab
+	const char * slab = (const char *)g.getPointer() + g.getGrid().LinId(grid_key_dx<3>({0,0,3}))*sizeof(aggr::type);
+	bool found_slab = false;
+	for (size_t i = 0 ; i < iov.getNSegments() ; i++)
+	{
+		if (iov.getSegment(i).ptr == slab && iov.getSegment(i).len == sub_f.getVolume()*sizeof(aggr::type))
+		{found_slab = true;}
+	}
+
+	BOOST_REQUIRE_EQUAL(found_slab,true);
+
+	// Unpack directly from the segments
+	Unpack_iovec uiov(iov.getSegments());
+	Unpack_stat ps;
+
+	size_t sc2 = 0;
+	openfpm::vector<aggr> v2;
+	openfpm::vector<aggr> v3;
+	grid_lin g2;
+	grid_lin g4;
+	grid_lin g3(sz);
+	g3.setMemory();
+
+	Unpacker_iovec<size_t,HeapMemory>::unpack(uiov,sc2,ps);
+	Unpacker_iovec<openfpm::vector<aggr>,HeapMemory>::unpack<>(uiov,v2,ps);
+	Unpacker_iovec<openfpm::vector<aggr>,HeapMemory>::unpack<0,2>(uiov,v3,ps);
+	Unpacker_iovec<grid_lin,HeapMemory>::unpack<>(uiov,g2,ps);
+	Unpacker_iovec<grid_lin,HeapMemory>::unpack<0,2>(uiov,g4,ps);
+
+	int ctx = 0;
+	Unpacker_iovec<grid_lin,HeapMemory>::unpack<decltype(sub_l),int,0,1,2>(uiov,sub_l,g3,ps,ctx,rem_copy_opt::NONE_OPT);
+	Unpacker_iovec<grid_lin,HeapMemory>::unpack<decltype(sub_f),int,0,1,2>(uiov,sub_f,g3,ps,ctx,rem_copy_opt::NONE_OPT);
+	Unpacker_iovec<grid_lin,HeapMemory>::unpack<decltype(sub_s),int,0,1,2>(uiov,sub_s,g3,ps,ctx,rem_copy_opt::NONE_OPT);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),req);
+	BOOST_REQUIRE_EQUAL(uiov.remaining(),0ul);
+
+	BOOST_REQUIRE_EQUAL(sc2,sc);
+	BOOST_REQUIRE_EQUAL(v2.size(),v.size());
+	BOOST_REQUIRE_EQUAL(v3.size(),v.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[1] == v.template get<1>(i)[1];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(i) == v.template get<2>(i);
+
+		match &= v3.template get<0>(i) == v.template get<0>(i);
+		match &= v3.template get<2>(i) == v.template get<2>(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<0>(key) == g.template get<0>(key);
+		match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+		match &= g2.template get<2>(key) == g.template get<2>(key);
+
+		match &= g4.template get<0>(key) == g.template get<0>(key);
+		match &= g4.template get<2>(key) == g.template get<2>(key);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid_key_dx_iterator_sub<3> * subs[3] = {&sub_l,&sub_f,&sub_s};
+
+	for (size_t i = 0 ; i < 3 ; i++)
+	{
+		subs[i]->reset();
+
+		while (subs[i]->isNext())
+		{
+			auto key = subs[i]->get();
+
+			match &= g3.template get<0>(key) == g.template get<0>(key);
+			match &= g3.template get<1>(key)[1] == g.template get<1>(key)[1];
+			match &= g3.template get<2>(key) == g.template get<2>(key);
+
+			++(*subs[i]);
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	mem.decRef();
+	delete &mem;
+}
+
+BOOST_AUTO_TEST_CASE ( packer_unpacker_compress_codec_test )
+{
+	size_t sizes[] = {0,1,5,17,1000,70000};
+	size_t codecs[] = {PACK_CODEC_SHUFFLE_LZ,PACK_CODEC_XOR_DELTA,PACK_CODEC_RLE};
+
+	for (size_t s = 0 ; s < sizeof(sizes)/sizeof(size_t) ; s++)
+	{
+		size_t n = sizes[s];
+
+		// random, constant and smooth data
+		std::vector<unsigned char> data[3];
+		for (size_t k = 0 ; k < 3 ; k++)
+		{data[k].resize(n);}
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			data[0][i] = rand();
+			data[1][i] = 0;
+		}
+
+		for (size_t i = 0 ; i + sizeof(float) <= n ; i += sizeof(float))
+		{
+			float f = sin(0.001*i);
+			memcpy(&data[2][i],&f,sizeof(float));
+		}
+
+		for (size_t k = 0 ; k < 3 ; k++)
+		{
+			for (size_t c = 0 ; c < 3 ; c++)
+			{
+				// twice the size, so the random data always fit
+				std::vector<unsigned char> comp(2*n + 16);
+				std::vector<unsigned char> dec(n);
+
+				size_t sc = pack_compress(codecs[c],data[k].data(),n,sizeof(float),comp.data(),comp.size());
+
+				// nothing to compress
+				if (n == 0)
+				{
+					BOOST_REQUIRE_EQUAL(sc,0ul);
+					continue;
+				}
+
+				BOOST_REQUIRE(sc != 0);
+
+				bool ret = pack_decompress(codecs[c],comp.data(),sc,sizeof(float),dec.data(),n);
+
+				BOOST_REQUIRE_EQUAL(ret,true);
+				BOOST_REQUIRE(dec == data[k]);
+
+				// constant data must compress
+				if (k == 1 && n >= 1000)
+				{BOOST_REQUIRE(sc < n / 50);}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE ( packer_unpacker_compress_test )
+{
+	typedef aggregate<float,float[3]> aggr;
+
+	// smooth field
+	openfpm::vector<aggr> v;
+	v.resize(10000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = sin(0.001*i);
+		v.template get<1>(i)[0] = 1.0 + 0.0001*i;
+		v.template get<1>(i)[1] = cos(0.001*i);
+		v.template get<1>(i)[2] = 2.0;
+	}
+
+	// mostly-background mask
+	openfpm::vector<aggregate<unsigned char>> mask;
+	mask.resize(10000);
+
+	for (size_t i = 0 ; i < mask.size() ; i++)
+	{mask.template get<0>(i) = (i % 1000 == 0)?1:0;}
+
+	// random data (not compressible)
+	openfpm::vector<aggregate<size_t>> rnd;
+	rnd.resize(1000);
+
+	for (size_t i = 0 ; i < rnd.size() ; i++)
+	{rnd.template get<0>(i) = ((size_t)rand() << 32) + rand();}
+
+	size_t sz[] = {32,32,32};
+	grid_cpu<3,aggr> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0)*0.1 + key.get(1)*0.01;
+		g.template get<1>(key)[0] = 1.0;
+		g.template get<1>(key)[1] = key.get(2);
+		g.template get<1>(key)[2] = 0.0;
+
+		++it;
+	}
+
+	grid_key_dx_iterator_sub<3> sub(g.getGrid(),{1,2,3},{20,21,22});
+
+	double dd = 3.0;
+
+	//! [Pack and unpack compressed]
+
+	// packRequest report the worst case
+	size_t req = 0;
+	Packer_compress<double,HeapMemory>::packRequest(dd,req);
+	Packer_compress<openfpm::vector<aggr>,HeapMemory>::packRequest<>(v,req);
+	Packer_compress<openfpm::vector<aggr>,HeapMemory>::packRequest<0>(v,req);
+	Packer_compress<openfpm::vector<aggregate<unsigned char>>,HeapMemory>::packRequest<>(mask,req);
+	Packer_compress<openfpm::vector<aggregate<size_t>>,HeapMemory>::packRequest<>(rnd,req);
+	Packer_compress<grid_cpu<3,aggr>,HeapMemory>::packRequest<>(g,req);
+	Packer_compress<grid_cpu<3,aggr>,HeapMemory>::packRequest<decltype(sub),0,1>(g,sub,req);
+
+	HeapMemory pmem;
+	pmem.allocate(req);
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+
+	// the codec is selected per pack call
+	Packer_compress<double,HeapMemory>::pack(mem,dd,sts,PACK_CODEC_SHUFFLE_LZ);
+	size_t s_start = mem.size();
+	Packer_compress<openfpm::vector<aggr>,HeapMemory>::pack<>(mem,v,sts,PACK_CODEC_XOR_DELTA);
+	size_t s_v = mem.size() - s_start;
+	Packer_compress<openfpm::vector<aggr>,HeapMemory>::pack<0>(mem,v,sts,PACK_CODEC_NONE);
+	s_start = mem.size();
+	Packer_compress<openfpm::vector<aggregate<unsigned char>>,HeapMemory>::pack<>(mem,mask,sts,PACK_CODEC_RLE);
+	size_t s_mask = mem.size() - s_start;
+	s_start = mem.size();
+	Packer_compress<openfpm::vector<aggregate<size_t>>,HeapMemory>::pack<>(mem,rnd,sts,PACK_CODEC_SHUFFLE_LZ);
+	size_t s_rnd = mem.size() - s_start;
+	s_start = mem.size();
+	Packer_compress<grid_cpu<3,aggr>,HeapMemory>::pack<>(mem,g,sts,PACK_CODEC_SHUFFLE_LZ);
+	size_t s_g = mem.size() - s_start;
+	Packer_compress<grid_cpu<3,aggr>,HeapMemory>::pack<decltype(sub),0,1>(mem,g,sub,sts,PACK_CODEC_XOR_DELTA);
+
+	//! [Pack and unpack compressed]
+
+	BOOST_REQUIRE(mem.size() <= req);
+
+	// the smooth field, the mask and the grid are compressed, the random data are stored as they are
+	BOOST_REQUIRE(s_v < v.size()*sizeof(aggr::type) / 2);
+	BOOST_REQUIRE(s_mask < mask.size() / 20);
+	BOOST_REQUIRE_EQUAL(s_rnd,pack_compress_bound(sizeof(size_t) + rnd.size()*sizeof(size_t)));
+	BOOST_REQUIRE(s_g < g.size()*sizeof(aggr::type) / 4);
+
+	Unpack_stat ps;
+
+	double dd2;
+	openfpm::vector<aggr> v2;
+	openfpm::vector<aggr> v3;
+	openfpm::vector<aggregate<unsigned char>> mask2;
+	openfpm::vector<aggregate<size_t>> rnd2;
+	grid_cpu<3,aggr> g2;
+	grid_cpu<3,aggr> g3(sz);
+	g3.setMemory();
+
+	Unpacker_compress<double,HeapMemory>::unpack(mem,dd2,ps);
+	Unpacker_compress<openfpm::vector<aggr>,HeapMemory>::unpack<>(mem,v2,ps);
+	Unpacker_compress<openfpm::vector<aggr>,HeapMemory>::unpack<0>(mem,v3,ps);
+	Unpacker_compress<openfpm::vector<aggregate<unsigned char>>,HeapMemory>::unpack<>(mem,mask2,ps);
+	Unpacker_compress<openfpm::vector<aggregate<size_t>>,HeapMemory>::unpack<>(mem,rnd2,ps);
+	Unpacker_compress<grid_cpu<3,aggr>,HeapMemory>::unpack<>(mem,g2,ps);
+
+	int ctx = 0;
+	Unpacker_compress<grid_cpu<3,aggr>,HeapMemory>::unpack<decltype(sub),int,0,1>(mem,sub,g3,ps,ctx,rem_copy_opt::NONE_OPT);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),mem.size());
+
+	BOOST_REQUIRE_EQUAL(dd2,dd);
+	BOOST_REQUIRE_EQUAL(v2.size(),v.size());
+	BOOST_REQUIRE_EQUAL(v3.size(),v.size());
+	BOOST_REQUIRE_EQUAL(mask2.size(),mask.size());
+	BOOST_REQUIRE_EQUAL(rnd2.size(),rnd.size());
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[1] == v.template get<1>(i)[1];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v3.template get<0>(i) == v.template get<0>(i);
+		match &= mask2.template get<0>(i) == mask.template get<0>(i);
+	}
+
+	for (size_t i = 0 ; i < rnd.size() ; i++)
+	{match &= rnd2.template get<0>(i) == rnd.template get<0>(i);}
+
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<0>(key) == g.template get<0>(key);
+		match &= g2.template get<1>(key)[1] == g.template get<1>(key)[1];
+
+		++it2;
+	}
+
+	sub.reset();
+
+	while (sub.isNext())
+	{
+		auto key = sub.get();
+
+		match &= g3.template get<0>(key) == g.template get<0>(key);
+		match &= g3.template get<1>(key)[1] == g.template get<1>(key)[1];
+
+		++sub;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	mem.decRef();
+	delete &mem;
+}
+
+BOOST_AUTO_TEST_CASE ( packer_unpacker_container_test )
+{
+	typedef aggregate<double,float[3],int> aggr;
+
+	openfpm::vector<aggr> v;
+	v.resize(5000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = 0.5*i;
+		v.template get<1>(i)[0] = i;
+		v.template get<1>(i)[1] = 2.0*i;
+		v.template get<1>(i)[2] = 3.0*i;
+		v.template get<2>(i) = -(int)i;
+	}
+
+	size_t sz[] = {24,20,16};
+	grid_cpu<3,aggr> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + key.get(1)*100 + key.get(2)*10000;
+		g.template get<1>(key)[0] = key.get(0);
+		g.template get<1>(key)[1] = key.get(1);
+		g.template get<1>(key)[2] = key.get(2);
+		g.template get<2>(key) = key.get(2);
+
+		++it;
+	}
+
+	//! [Write and read a container file]
+
+	BOOST_REQUIRE_EQUAL(pack_container_write(v,"container_vector.bin"),true);
+	BOOST_REQUIRE_EQUAL(pack_container_write(g,"container_grid.bin"),true);
+
+	// the header describe the content
+	pack_container_file f;
+	BOOST_REQUIRE_EQUAL(f.open("container_grid.bin"),true);
+	BOOST_REQUIRE_EQUAL(f.getHeader().kind,PACK_CONT_KIND_GRID);
+	BOOST_REQUIRE_EQUAL(f.getHeader().dim,3u);
+	BOOST_REQUIRE_EQUAL(f.getHeader().n_prop,3u);
+	BOOST_REQUIRE_EQUAL(f.getHeader().n_ele,24ul*20*16);
+	BOOST_REQUIRE_EQUAL(f.getHeader().prop[1].type,PACK_CONT_TYPE_FLOAT);
+	BOOST_REQUIRE_EQUAL(f.getHeader().prop[1].n_comp,3ul);
+	BOOST_REQUIRE_EQUAL(f.getHeader().prop[2].type,PACK_CONT_TYPE_SINT);
+
+	// read everything
+	openfpm::vector<aggr> v2;
+	BOOST_REQUIRE_EQUAL(pack_container_read(v2,"container_vector.bin"),true);
+
+	// read only the property 1 of a range with a different type (float to double) and layout
+	openfpm::vector<aggregate<int,double[3]>,HeapMemory,memory_traits_inte> v3;
+	BOOST_REQUIRE_EQUAL((pack_container_read_range<1>(v3,"container_vector.bin",1000,1100)),true);
+
+	// read the properties 0 and 1 of a sub-box in a grid with inte layout
+	grid_base<3,aggr,HeapMemory,memory_traits_inte<aggr>::type> g2;
+	Box<3,long int> box({3,4,5},{10,11,12});
+	BOOST_REQUIRE_EQUAL((pack_container_read_box<0,1>(g2,"container_grid.bin",box)),true);
+
+	//! [Write and read a container file]
+
+	BOOST_REQUIRE_EQUAL(v2.size(),v.size());
+	BOOST_REQUIRE_EQUAL(v3.size(),100ul);
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(i) == v.template get<2>(i);
+	}
+
+	for (size_t i = 0 ; i < v3.size() ; i++)
+	{
+		match &= v3.template get<1>(i)[0] == v.template get<1>(i+1000)[0];
+		match &= v3.template get<1>(i)[1] == v.template get<1>(i+1000)[1];
+		match &= v3.template get<1>(i)[2] == v.template get<1>(i+1000)[2];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(0),24ul);
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),16ul);
+
+	grid_key_dx_iterator_sub<3> sub(g.getGrid(),{3,4,5},{10,11,12});
+	size_t cnt = 0;
+
+	while (sub.isNext())
+	{
+		auto key = sub.get();
+
+		match &= g2.template get<0>(key) == g.template get<0>(key);
+		match &= g2.template get<1>(key)[0] == g.template get<1>(key)[0];
+		match &= g2.template get<1>(key)[1] == g.template get<1>(key)[1];
+		match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+
+		cnt++;
+		++sub;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,8ul*8*8);
+
+	// a property with a different number of components cannot be read
+	openfpm::vector<aggregate<double,float[2]>> v4;
+	BOOST_REQUIRE_EQUAL((pack_container_read<1>(v4,"container_vector.bin")),false);
+
+	// the kind of container must match
+	BOOST_REQUIRE_EQUAL(pack_container_read(v2,"container_grid.bin"),false);
+
+	remove("container_vector.bin");
+	remove("container_grid.bin");
+}
+
+BOOST_AUTO_TEST_CASE ( packer_unpacker_stream_test )
+{
+	typedef aggregate<double,float[3],int> aggr;
+
+	openfpm::vector<aggr> v;
+	v.resize(10000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = 0.5*i;
+		v.template get<1>(i)[0] = i;
+		v.template get<1>(i)[1] = 2.0*i;
+		v.template get<1>(i)[2] = 3.0*i;
+		v.template get<2>(i) = -(int)i;
+	}
+
+	size_t sz[] = {37,23,19};
+	grid_cpu<3,aggr> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + key.get(1)*100 + key.get(2)*10000;
+		g.template get<1>(key)[0] = key.get(0);
+		g.template get<1>(key)[1] = key.get(1);
+		g.template get<1>(key)[2] = key.get(2);
+		g.template get<2>(key) = key.get(2);
+
+		++it;
+	}
+
+	//! [Pack and unpack in chunks]
+
+	openfpm::vector<aggr> v2;
+	unpack_stream<openfpm::vector<aggr>> us(v2);
+
+	// chunks of at most 4KB, only the last chunk is needed in memory
+	pack_stream<openfpm::vector<aggr>> ps(v,4096);
+
+	size_t n_chunks = 0;
+
+	while (ps.next() == true)
+	{
+		BOOST_REQUIRE(ps.size() <= 4096);
+		BOOST_REQUIRE_EQUAL(us.unpack(ps.getPointer(),ps.size()),true);
+		n_chunks++;
+	}
+
+	//! [Pack and unpack in chunks]
+
+	BOOST_REQUIRE(n_chunks > 1);
+	BOOST_REQUIRE_EQUAL(v2.size(),v.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(i) == v.template get<2>(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// selected properties into a vector with inte layout, chunks unpacked in reverse order
+
+	std::vector<std::vector<unsigned char>> chunks;
+
+	//! [Pack in chunks with a sink]
+
+	pack_stream<openfpm::vector<aggr>,1,2> ps_sel(v,1000);
+	ps_sel.pack([&](const void * ptr, size_t sz)
+	{
+		chunks.push_back(std::vector<unsigned char>((const unsigned char *)ptr,(const unsigned char *)ptr + sz));
+	});
+
+	//! [Pack in chunks with a sink]
+
+	openfpm::vector<aggr,HeapMemory,memory_traits_inte> v3;
+	unpack_stream<openfpm::vector<aggr,HeapMemory,memory_traits_inte>,1,2> us_sel(v3);
+
+	for (long int i = chunks.size() - 1 ; i >= 0 ; i--)
+	{BOOST_REQUIRE_EQUAL(us_sel.unpack(chunks[i].data(),chunks[i].size()),true);}
+
+	BOOST_REQUIRE_EQUAL(v3.size(),v.size());
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v3.template get<1>(i)[1] == v.template get<1>(i)[1];
+		match &= v3.template get<2>(i) == v.template get<2>(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// a chunk packed with other properties is rejected
+	unpack_stream<openfpm::vector<aggr>,0> us_wrong(v2);
+	BOOST_REQUIRE_EQUAL(us_wrong.unpack(chunks[0].data(),chunks[0].size()),false);
+
+	// grid, the chunks contain boxes of planes, rows and pieces of rows
+
+	size_t chunk_sizes[] = {200,2000,20000,100000,1000000};
+
+	for (size_t k = 0 ; k < sizeof(chunk_sizes)/sizeof(size_t) ; k++)
+	{
+		grid_base<3,aggr,HeapMemory,memory_traits_inte<aggr>::type> g2;
+		unpack_stream<decltype(g2),0,1> us_g2(g2);
+
+		pack_stream<grid_cpu<3,aggr>,0,1> ps_g(g,chunk_sizes[k]);
+
+		size_t cnt = 0;
+
+		ps_g.pack([&](const void * ptr, size_t sz)
+		{
+			BOOST_REQUIRE(sz <= chunk_sizes[k]);
+			BOOST_REQUIRE_EQUAL(us_g2.unpack(ptr,sz),true);
+			cnt++;
+		});
+
+		BOOST_REQUIRE_EQUAL(g2.getGrid().size(0),37ul);
+		BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),19ul);
+
+		auto it = g.getIterator();
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			match &= g2.template get<0>(key) == g.template get<0>(key);
+			match &= g2.template get<1>(key)[0] == g.template get<1>(key)[0];
+			match &= g2.template get<1>(key)[1] == g.template get<1>(key)[1];
+			match &= g2.template get<1>(key)[2] == g.template get<1>(key)[2];
+
+			++it;
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+
+		// the whole grid fit in one chunk only with the biggest size
+		BOOST_REQUIRE_EQUAL(cnt == 1,k == 4);
+	}
+
+	// an empty vector produce one chunk that empty the destination
+
+	openfpm::vector<aggr> v_empty;
+	pack_stream<openfpm::vector<aggr>> ps_empty(v_empty,4096);
+
+	BOOST_REQUIRE_EQUAL(ps_empty.next(),true);
+	BOOST_REQUIRE_EQUAL(us.unpack(ps_empty.getPointer(),ps_empty.size()),true);
+	BOOST_REQUIRE_EQUAL(ps_empty.next(),false);
+	BOOST_REQUIRE_EQUAL(v2.size(),0ul);
+
+	// the chunk must contain at least one point
+	pack_stream<openfpm::vector<aggr>> ps_small(v,16);
+	BOOST_REQUIRE_EQUAL(ps_small.next(),false);
+}
+
 BOOST_AUTO_TEST_CASE ( packer_memory_traits_inte )
 {
 
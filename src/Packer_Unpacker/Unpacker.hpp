@@ -397,27 +397,59 @@ public:
 			// get the first element to get the chunking size
 			typedef typename boost::mpl::at<typename T::T_type::type,boost::mpl::int_<0>>::type cnk_size;
 
-			if (sizeof...(prp) == 0)
-			{
-				encapc<1,T_nc,typename memory_traits_lin< T_nc >::type> enc(*static_cast<typename T_nc::type *>((void *)((unsigned char *)mem.getPointerBase() + ps.getOffset())));
-				copy_unpacker_chunk<encapc<1,T_nc,typename memory_traits_lin< T_nc >::type>,
-									decltype(obj)> cp(enc,obj,sub_id);
-
-				boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::T_type::max_prop>>(cp);
-				ps.addOffset(sizeof(T_nc));
-			}
-			else
-			{
-				typedef object<typename object_creator_chunking<typename T::type,prp...>::type> prp_object;
-				encapc<1,prp_object,typename memory_traits_lin< prp_object >::type> enc(*static_cast<typename prp_object::type *>((void *)((unsigned char *)mem.getPointerBase() + ps.getOffset())));
-				object_s_di<decltype(enc),T,OBJ_ENCAP_CHUNKING,prp ... >(enc,obj,sub_id);
-				ps.addOffset(sizeof(prp_object));
-			}
+			unpack_ptr<T_nc,prp...>((unsigned char *)mem.getPointerBase() + ps.getOffset(),obj,sub_id);
+			ps.addOffset(unpackSize<T_nc,prp...>());
 		}
 
 		// update statistic
 	}
 
+	/*! \brief Size of one packed element of the chunk
+	 *
+	 * \tparam T_nc object without chunking
+	 *
+	 * \return the number of bytes unpack() consume for one element
+	 *
+	 */
+	template<typename T_nc, unsigned int ... prp> static constexpr size_t unpackSize()
+	{
+		return (sizeof...(prp) == 0)?sizeof(T_nc):sizeof(object<typename object_creator_chunking<typename T::type,prp...>::type>);
+	}
+
+	/*! \brief Unpack one element packed at the address ptr into the element sub_id of the chunk
+	 *
+	 * It does not touch the memory object, so different elements can be unpacked concurrently
+	 *
+	 * \note valid only when the properties do not have a pack() member (has_pack_encap is false)
+	 *
+	 * \tparam T_nc object without chunking
+	 *
+	 * \param ptr where the element is packed
+	 * \param obj chunk
+	 * \param sub_id element in the chunk
+	 *
+	 */
+	template<typename T_nc, unsigned int ... prp>
+	static inline void unpack_ptr(void * ptr,
+								  T & obj,
+								  size_t sub_id)
+	{
+		if (sizeof...(prp) == 0)
+		{
+			encapc<1,T_nc,typename memory_traits_lin< T_nc >::type> enc(*static_cast<typename T_nc::type *>(ptr));
+			copy_unpacker_chunk<encapc<1,T_nc,typename memory_traits_lin< T_nc >::type>,
+								decltype(obj)> cp(enc,obj,sub_id);
+
+			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::T_type::max_prop>>(cp);
+		}
+		else
+		{
+			typedef object<typename object_creator_chunking<typename T::type,prp...>::type> prp_object;
+			encapc<1,prp_object,typename memory_traits_lin< prp_object >::type> enc(*static_cast<typename prp_object::type *>(ptr));
+			object_s_di<decltype(enc),T,OBJ_ENCAP_CHUNKING,prp ... >(enc,obj,sub_id);
+		}
+	}
+
 	/*! \brief
 	 *
 	 * is this needed
@@ -15,11 +15,13 @@
 #include "hash_map/hopscotch_set.h"
 #include "Vector/map_vector.hpp"
 #include "util/variadic_to_vmpl.hpp"
+#include "util/thread_pool.hpp"
 #include "data_type/aggregate.hpp"
 #include "SparseGridUtil.hpp"
 #include "SparseGrid_iterator.hpp"
 #include "SparseGrid_iterator_block.hpp"
 #include "SparseGrid_conv_opt.hpp"
+#include <algorithm>
 //#include "util/debug.hpp"
 // We do not want parallel writer
 
@@ -214,7 +216,7 @@ struct copy_sparse_to_sparse_bb_impl<T[N1]>
 	{
 		typedef typename std::remove_reference<decltype(dst.template get<prop>()[0][pos_id_dst])>::type copy_rtype;
 
-		for (int i = 0 ; i < N1 ; i++)
+		for (size_t i = 0 ; i < N1 ; i++)
 		{
 			meta_copy<copy_rtype>::meta_copy_(src.template get<prop>()[i][pos_id_src],dst.template get<prop>()[i][pos_id_dst]);
 		}
@@ -229,9 +231,9 @@ struct copy_sparse_to_sparse_bb_impl<T[N1][N2]>
 	{
 		typedef typename std::remove_reference<decltype(dst.template get<prop>()[0][0][pos_id_dst])>::type copy_rtype;
 
-		for (int i = 0 ; i < N1 ; i++)
+		for (size_t i = 0 ; i < N1 ; i++)
 		{
-			for (int j = 0 ; j < N2 ; j++)
+			for (size_t j = 0 ; j < N2 ; j++)
 			{
 				meta_copy<copy_rtype>::meta_copy_(src.template get<prop>()[i][j][pos_id_src],dst.template get<prop>()[i][j][pos_id_dst]);
 			}
@@ -316,6 +318,98 @@ public:
 
 
 
+template<typename T>
+struct copy_vector_to_chunk_impl
+{
+	template<template<typename,typename> class op, unsigned int prop, typename Tsrc, typename Tdst>
+	static void copy(const Tsrc & src, size_t id_src, Tdst & dst, short int pos_id_dst)
+	{
+		typedef typename std::remove_reference<decltype(dst.template get<prop>()[pos_id_dst])>::type copy_rtype;
+
+		meta_copy_op<op,copy_rtype>::meta_copy_op_(src.template get<prop>(id_src),dst.template get<prop>()[pos_id_dst]);
+	}
+};
+
+template<typename T, unsigned int N1>
+struct copy_vector_to_chunk_impl<T[N1]>
+{
+	template<template<typename,typename> class op, unsigned int prop, typename Tsrc, typename Tdst>
+	static void copy(const Tsrc & src, size_t id_src, Tdst & dst, short int pos_id_dst)
+	{
+		typedef typename std::remove_reference<decltype(dst.template get<prop>()[0][pos_id_dst])>::type copy_rtype;
+
+		for (size_t i = 0 ; i < N1 ; i++)
+		{
+			meta_copy_op<op,copy_rtype>::meta_copy_op_(src.template get<prop>(id_src)[i],dst.template get<prop>()[i][pos_id_dst]);
+		}
+	}
+};
+
+template<typename T, unsigned int N1, unsigned int N2>
+struct copy_vector_to_chunk_impl<T[N1][N2]>
+{
+	template<template<typename,typename> class op, unsigned int prop, typename Tsrc, typename Tdst>
+	static void copy(const Tsrc & src, size_t id_src, Tdst & dst, short int pos_id_dst)
+	{
+		typedef typename std::remove_reference<decltype(dst.template get<prop>()[0][0][pos_id_dst])>::type copy_rtype;
+
+		for (size_t i = 0 ; i < N1 ; i++)
+		{
+			for (size_t j = 0 ; j < N2 ; j++)
+			{
+				meta_copy_op<op,copy_rtype>::meta_copy_op_(src.template get<prop>(id_src)[i][j],dst.template get<prop>()[i][j][pos_id_dst]);
+			}
+		}
+	}
+};
+
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * It copy the properties prp of one element of a vector into one element of a chunk applying the operation op
+ *
+ * \tparam op operation (replace_, add_, ...)
+ * \tparam Tsrc vector type
+ * \tparam Tdst chunk type
+ * \tparam aggrType aggregate type of the sparse grid
+ * \tparam prp properties to copy
+ *
+ */
+template<template<typename,typename> class op, typename Tsrc,typename Tdst, typename aggrType, unsigned int ... prp>
+class copy_vector_to_chunk
+{
+	//! source
+	const Tsrc & src;
+
+	//! element in the source
+	size_t id_src;
+
+	//! destination
+	Tdst & dst;
+
+	//! destination position in the chunk
+	short int pos_id_dst;
+
+	//! Convert the packed properties into an MPL vector
+	typedef typename to_boost_vmpl<prp...>::type v_prp;
+
+public:
+
+	copy_vector_to_chunk(const Tsrc & src, size_t id_src, Tdst & dst, short int pos_id_dst)
+	:src(src),id_src(id_src),dst(dst),pos_id_dst(pos_id_dst)
+	{}
+
+	//! It call the copy function for each property
+	template<typename T>
+	inline void operator()(T& t) const
+	{
+		typedef typename boost::mpl::at<v_prp,boost::mpl::int_<T::value>>::type idx_type;
+		typedef typename boost::mpl::at<typename aggrType::type, idx_type>::type copy_rtype;
+
+		copy_vector_to_chunk_impl<copy_rtype>::template copy<op,idx_type::value>(src,id_src,dst,pos_id_dst);
+	}
+
+};
+
 /*! \brief this class is a functor for "for_each" algorithm
  *
  * This class is a functor for "for_each" algorithm. For each
@@ -503,6 +597,12 @@ class sgrid_cpu
 	//! for each chunk store the neighborhood chunks
 	openfpm::vector<int> NNlist;
 
+	//! points inserted concurrently, one buffer for each thread
+	openfpm::vector<openfpm::vector<grid_key_dx<dim>>> cins_keys;
+
+	//! data inserted concurrently, one buffer for each thread
+	openfpm::vector<openfpm::vector<T>> cins_data;
+
 	/*! \brief Given a key return the chunk than contain that key, in case that chunk does not exist return the key of the
 	 *         background chunk
 	 *
@@ -560,6 +660,8 @@ class sgrid_cpu
 
 			map[lin_id] = i;
 		}
+
+		findNN = false;
 	}
 
 	/*! \brief Eliminate empty chunks
@@ -758,6 +860,39 @@ class sgrid_cpu
 		exist = true;
 	}
 
+	/*! \brief Fill the table NNlist with the neighborhood chunks of every chunk
+	 *
+	 * For each chunk it store the chunks in +z,-z,+y,-y,+x,-x (the order used by loadBorder), -1 if the chunk does
+	 * not exist. The chunks are searched with findChunk, so they can be processed in parallel
+	 *
+	 */
+	void construct_NNlist()
+	{
+		openfpm::parallel_for(0,chunks.size(),[&](size_t i)
+		{
+			grid_key_dx<dim> pos = getChunkPos(i);
+
+			size_t s = i*NNStar_c<dim>::nNN;
+
+			for (int d = dim-1 ; d >= 0 ; d--)
+			{
+				for (int k = 1 ; k >= -1 ; k -= 2)
+				{
+					grid_key_dx<dim> p = pos;
+					p.set_d(d,p.get(d) + k);
+
+					bool exist;
+					size_t r = findChunk(p,exist);
+
+					NNlist.get(s) = (exist == true)?(int)r:-1;
+					s++;
+				}
+			}
+		},512);
+
+		findNN = true;
+	}
+
 	/*! Given a key v1 in coordinates it calculate the chunk position and the  position in the chunk
 	 *
 	 * \param v1 coordinates
@@ -778,6 +913,27 @@ class sgrid_cpu
 		sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
 	}
 
+	/*! \brief Like pre_get but it does not use the cache, so it can be called concurrently
+	 *
+	 * \param v1 point to search
+	 * \param active_cnk return the chunk
+	 * \param sub_id return the index inside the chunk
+	 * \param exist return true if the chunk exist
+	 *
+	 */
+	inline void pre_get_nc(const grid_key_dx<dim> & v1, size_t & active_cnk, size_t & sub_id, bool & exist) const
+	{
+		grid_key_dx<dim> kh = v1;
+		grid_key_dx<dim> kl;
+
+		// shift the key
+		key_shift<dim,chunking>::shift(kh,kl);
+
+		active_cnk = findChunk(kh,exist);
+
+		sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
+	}
+
 	/*! \brief Before insert data you have to do this
 	 *
 	 * \param v1 grid key where you want to insert data
@@ -809,8 +965,9 @@ class sgrid_cpu
 			auto fnd = map.find(lin_id);
 			if (fnd == map.end())
 			{
-				// we do not have it in the map create a chunk
+				// we do not have it in the map create a chunk, the neighborhood table is not valid anymore
 
+				findNN = false;
 				map[lin_id] = chunks.size();
 				chunks.add();
 				header_inf.add();
@@ -891,6 +1048,337 @@ class sgrid_cpu
 		}
 	}
 
+	/*! \brief Mark the existing points of the chunk i that are inside the box section
+	 *
+	 * The points are the one visited by pack() with a sub-grid iterator, so it can be called
+	 * concurrently on different chunks
+	 *
+	 * \param i chunk
+	 * \param gs_cnk grid of the chunk
+	 * \param section box to pack
+	 * \param mask_to_pack output mask of the points to pack
+	 *
+	 * \return the number of points to pack
+	 *
+	 */
+	size_t mask_chunk_section(size_t i,
+							  const grid_sm<dim,void> & gs_cnk,
+							  const Box<dim,size_t> & section,
+							  unsigned char (& mask_to_pack)[chunking::size::value]) const
+	{
+		auto & hc = header_inf.get(i);
+		auto & hm = header_mask.get(i);
+
+		memset(mask_to_pack,0,sizeof(mask_to_pack));
+
+		Box<dim,size_t> bc;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{
+			bc.setLow(j,hc.pos.get(j));
+			bc.setHigh(j,hc.pos.get(j) + sz_cnk[j] - 1);
+		}
+
+		// now we intersect the chunk box with the box
+
+		Box<dim,size_t> inte;
+		if (bc.Intersect(section,inte) == false)
+		{return 0;}
+
+		inte -= hc.pos.toPoint();
+
+		size_t cnt = 0;
+		grid_key_dx_iterator_sub<dim,no_stencil,grid_sm<dim,void>> sit(gs_cnk,inte.getKP1(),inte.getKP2());
+
+		while (sit.isNext())
+		{
+			size_t sub_id = gs_cnk.LinId(sit.get());
+
+			if (hm.mask[sub_id] & 1)
+			{
+				mask_to_pack[sub_id] |= 1;
+				cnt++;
+			}
+
+			++sit;
+		}
+
+		return cnt;
+	}
+
+	/*! \brief Pack the chunks in parallel (two phases)
+	 *
+	 * In the first phase every thread calculate the size of its chunks, a prefix sum give
+	 * where every chunk start. In the second phase the threads write the chunks concurrently
+	 * in the preallocated buffer. The bytes produced are the same of the sequential pack
+	 *
+	 * \note the properties must not have a pack() member
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack the objects
+	 * \param start first chunk
+	 * \param stop one past the last chunk
+	 * \param skip_empty true for the format of the sub-grid pack (the chunks without points to pack are skipped),
+	 *        false for the format of the full pack
+	 * \param cnk_mask function that given a chunk fill the mask of the points to pack and return how many they are
+	 * \param cnk_pos function that given a chunk return the position to pack
+	 * \param sts pack statistic
+	 *
+	 */
+	template<int ... prp, typename lambda_m, typename lambda_p>
+	void pack_chunks_parallel(ExtPreAlloc<S> & mem,
+							  size_t start,
+							  size_t stop,
+							  bool skip_empty,
+							  lambda_m cnk_mask,
+							  lambda_p cnk_pos,
+							  Pack_stat & sts) const
+	{
+		typedef Packer<decltype(chunks.get_o(0)),S,PACKER_ENCAP_OBJECTS_CHUNKING> packer_cnk;
+
+		const size_t hdr = sizeof(header_mask.get(0).mask) + sizeof(header_inf.get(0).pos) + sizeof(header_inf.get(0).nele);
+		const size_t es = packer_cnk::template packSize<T,prp...>();
+
+		// Phase 1: number of points of every chunk, than prefix sum
+
+		size_t n_cnk = stop - start;
+		openfpm::vector<size_t> offset;
+		offset.resize(n_cnk+1);
+
+		openfpm::parallel_for(start,stop,[&](size_t i)
+		{
+			unsigned char mask_to_pack[chunking::size::value];
+			offset.get(i-start+1) = cnk_mask(i,mask_to_pack);
+		},64);
+
+		size_t n_packed_chunk = 0;
+		size_t n_ele = 0;
+
+		offset.get(0) = 0;
+		for (size_t i = 1 ; i <= n_cnk ; i++)
+		{
+			size_t cnt = offset.get(i);
+			bool packed = (skip_empty == false || cnt != 0);
+
+			n_packed_chunk += packed;
+			n_ele += cnt;
+
+			offset.get(i) = offset.get(i-1) + ((packed == true)?hdr + cnt*es:0);
+		}
+
+		// number of chunks and size of the grid
+
+		size_t head[dim+1];
+		head[0] = n_packed_chunk;
+		for (size_t i = 0 ; i < dim ; i++)
+		{head[i+1] = getGrid().size(i);}
+
+		mem.allocate(sizeof(head) + offset.get(n_cnk));
+		unsigned char * base = (unsigned char *)mem.getPointer();
+
+		memcpy(base,head,sizeof(head));
+		base += sizeof(head);
+
+		// Phase 2: every chunk is written at its offset
+
+		openfpm::parallel_for(start,stop,[&](size_t i)
+		{
+			if (offset.get(i-start+1) == offset.get(i-start))
+			{return;}
+
+			unsigned char mask_to_pack[chunking::size::value];
+			cnk_mask(i,mask_to_pack);
+
+			grid_key_dx<dim> pos = cnk_pos(i);
+			unsigned char * ptr = base + offset.get(i-start);
+
+			memcpy(ptr,mask_to_pack,sizeof(mask_to_pack));
+			ptr += sizeof(mask_to_pack);
+			memcpy(ptr,&pos,sizeof(pos));
+			ptr += sizeof(pos);
+			memcpy(ptr,&header_inf.get(i).nele,sizeof(header_inf.get(i).nele));
+			ptr += sizeof(header_inf.get(i).nele);
+
+			for (size_t j = 0 ; j < chunking::size::value ; j++)
+			{
+				if (mask_to_pack[j] & 1)
+				{
+					packer_cnk::template pack_ptr<T,prp...>(ptr,chunks.get_o(i),j);
+					ptr += es;
+				}
+			}
+		},64);
+
+		// update the statistic like the sequential pack (the number of chunks is counted only in the full pack)
+		sts.incReq(dim + (skip_empty == false) + 3*n_packed_chunk + n_ele);
+	}
+
+	/*! \brief Unpack the chunks in parallel
+	 *
+	 * The headers are read first to find where the points of every chunk are packed, than all
+	 * the missing chunks are created in one batch and the points are copied concurrently. It
+	 * work only when every chunk received map on one of our chunks (the shifted position of the
+	 * chunk is a multiple of the chunk size), otherwise it return false without touching the grid.
+	 * The properties must not have an unpack() member
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem memory from where to unpack
+	 * \param n_chunks number of chunks packed
+	 * \param shift shift to apply to the position of the chunks
+	 * \param ps unpack statistic
+	 *
+	 * \return true if the chunks has been unpacked
+	 *
+	 */
+	template<unsigned int ... prp, typename S2>
+	bool unpack_chunks_parallel(ExtPreAlloc<S2> & mem,
+								size_t n_chunks,
+								const grid_key_dx<dim> & shift,
+								Unpack_stat & ps)
+	{
+		typedef Unpacker<decltype(chunks.get_o(0)),S2,PACKER_ENCAP_OBJECTS_CHUNKING> unpacker_cnk;
+
+		const size_t es = unpacker_cnk::template unpackSize<T,prp...>();
+
+		openfpm::vector<cheader<dim>> header_inf_tmp;
+		openfpm::vector<mheader<chunking::size::value>> header_mask_tmp;
+		openfpm::vector<size_t> offset;
+		openfpm::vector<size_t> cnk_id;
+
+		header_inf_tmp.resize(n_chunks);
+		header_mask_tmp.resize(n_chunks);
+		offset.resize(n_chunks);
+		cnk_id.resize(n_chunks);
+
+		// read the headers and skip the points
+
+		for (size_t i = 0 ; i < n_chunks ; i++)
+		{
+			auto & hc = header_inf_tmp.get(i);
+			auto & hm = header_mask_tmp.get(i);
+
+			Unpacker<typename std::remove_reference<decltype(header_mask.get(i).mask)>::type ,S2>::unpack(mem,hm.mask,ps);
+			Unpacker<typename std::remove_reference<decltype(header_inf.get(i).pos)>::type ,S2>::unpack(mem,hc.pos,ps);
+			Unpacker<typename std::remove_reference<decltype(header_inf.get(i).nele)>::type ,S2>::unpack(mem,hc.nele,ps);
+
+			for (size_t j = 0 ; j < dim ; j++)
+			{
+				if ((hc.pos.get(j) + shift.get(j)) % (long int)sz_cnk[j] != 0)
+				{return false;}
+			}
+
+			size_t cnt = 0;
+			for (size_t j = 0 ; j < chunking::size::value ; j++)
+			{cnt += hm.mask[j] & 1;}
+
+			offset.get(i) = ps.getOffset();
+			ps.addOffset(cnt*es);
+		}
+
+		// find the chunks, the missing one are created in one batch
+
+		size_t n_old = chunks.size();
+		size_t n_cnk = n_old;
+
+		for (size_t i = 0 ; i < n_chunks ; i++)
+		{
+			grid_key_dx<dim> kh = header_inf_tmp.get(i).pos + shift;
+			grid_key_dx<dim> kl;
+
+			key_shift<dim,chunking>::shift(kh,kl);
+			long int lin_id = g_sm_shift.LinId(kh);
+
+			auto fnd = map.find(lin_id);
+			if (fnd == map.end())
+			{
+				map[lin_id] = n_cnk;
+				cnk_id.get(i) = n_cnk;
+				n_cnk++;
+			}
+			else
+			{cnk_id.get(i) = fnd->second;}
+		}
+
+		if (n_cnk != n_old)
+		{
+			findNN = false;
+
+			chunks.resize(n_cnk);
+			header_inf.resize(n_cnk);
+			header_mask.resize(n_cnk);
+		}
+
+		// two packed chunks that go in the same chunk cannot be unpacked concurrently
+
+		openfpm::vector<unsigned char> used;
+		openfpm::vector<unsigned char> init;
+		used.resize(n_cnk);
+		init.resize(n_chunks);
+		memset(&used.get(0),0,n_cnk);
+
+		bool unique = true;
+		for (size_t i = 0 ; i < n_chunks ; i++)
+		{
+			size_t cnk = cnk_id.get(i);
+
+			unique &= (used.get(cnk) == 0);
+			init.get(i) = (cnk >= n_old && used.get(cnk) == 0);
+			used.get(cnk) = 1;
+		}
+
+		auto unpack_cnk = [&](size_t i)
+		{
+			size_t cnk = cnk_id.get(i);
+
+			auto & hc = header_inf.get(cnk);
+			auto & hm = header_mask.get(cnk);
+			auto & hm_p = header_mask_tmp.get(i);
+
+			if (init.get(i) == true)
+			{
+				grid_key_dx<dim> kl;
+				hc.pos = header_inf_tmp.get(i).pos + shift;
+
+				key_shift<dim,chunking>::shift(hc.pos,kl);
+				key_shift<dim,chunking>::cpos(hc.pos);
+				hc.nele = 0;
+
+				for (size_t j = 0 ; j < chunking::size::value ; j++)
+				{hm.mask[j] = 0;}
+			}
+
+			auto block = chunks.get_o(cnk);
+			unsigned char * ptr = (unsigned char *)mem.getPointerBase() + offset.get(i);
+
+			for (size_t j = 0 ; j < chunking::size::value ; j++)
+			{
+				if ((hm_p.mask[j] & 1) == 0)
+				{continue;}
+
+				grid_key_dx<dim> kl = pos_chunk[j];
+				size_t sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
+
+				hc.nele = (hm.mask[sub_id])?hc.nele:hc.nele + 1;
+				hm.mask[sub_id] |= 1;
+
+				unpacker_cnk::template unpack_ptr<T,prp...>(ptr,block,sub_id);
+				ptr += es;
+			}
+		};
+
+		if (unique == true)
+		{openfpm::parallel_for(0,n_chunks,unpack_cnk,64);}
+		else
+		{
+			for (size_t i = 0 ; i < n_chunks ; i++)
+			{unpack_cnk(i);}
+		}
+
+		return true;
+	}
+
 public:
 
 	//! it define that this data-structure is a grid
@@ -1085,6 +1573,271 @@ public:
 		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get<p>(chunks,active_cnk,sub_id);
 	}
 
+	/*! \brief Insert a set of points
+	 *
+	 * The points are sorted by chunk, the missing chunks are created in one pass and the masks
+	 * and the data are filled chunk by chunk (in parallel across the chunks). The result is the
+	 * same of calling insert for every point in the order of keys, if a point appear more than
+	 * once the last value win
+	 *
+	 * \tparam prp properties to copy from data (if none only the points are created)
+	 *
+	 * \param keys points to insert
+	 * \param data values to insert, the element i go in keys.get(i)
+	 *
+	 */
+	template<unsigned int ... prp, typename vector_keys_type, typename vector_data_type>
+	void insert_bulk(const vector_keys_type & keys, const vector_data_type & data)
+	{
+		insert_bulk_op<replace_,prp...>(keys,data);
+	}
+
+	/*! \brief Insert a set of points merging the values with the operation op
+	 *
+	 * Like insert_bulk, but when a point already exist (or appear more than once in keys) the value is
+	 * merged with op (for example add_ accumulate the values). The values are merged in the order of keys
+	 *
+	 * \tparam op operation (replace_, add_, ...)
+	 * \tparam prp properties to copy from data
+	 *
+	 * \param keys points to insert
+	 * \param data values to insert, the element i go in keys.get(i)
+	 *
+	 */
+	template<template<typename,typename> class op, unsigned int ... prp, typename vector_keys_type, typename vector_data_type>
+	void insert_bulk_op(const vector_keys_type & keys, const vector_data_type & data)
+	{
+		size_t n = keys.size();
+
+		if (sizeof...(prp) != 0 && data.size() != n)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the number of keys " << n << " does not match the number of values " << data.size() << std::endl;
+			return;
+		}
+
+		if (n == 0)	{return;}
+
+		// chunk and position inside the chunk of every point
+
+		openfpm::vector<size_t> lin_cnk;
+		openfpm::vector<short int> sub_id;
+		openfpm::vector<size_t> ord;
+
+		lin_cnk.resize(n);
+		sub_id.resize(n);
+		ord.resize(n);
+
+		openfpm::parallel_for(0,n,[&](size_t i)
+		{
+			grid_key_dx<dim> kh = keys.get(i);
+			grid_key_dx<dim> kl;
+
+			// shift the key
+			key_shift<dim,chunking>::shift(kh,kl);
+
+			lin_cnk.get(i) = g_sm_shift.LinId(kh);
+			sub_id.get(i) = sublin<dim,typename chunking::shift_c>::lin(kl);
+			ord.get(i) = i;
+		},4096);
+
+		// sort by chunk, the points of the same chunk stay in insertion order
+
+		std::sort(&ord.get(0),&ord.get(0) + n,[&](size_t a, size_t b)
+		{
+			return (lin_cnk.get(a) < lin_cnk.get(b)) || (lin_cnk.get(a) == lin_cnk.get(b) && a < b);
+		});
+
+		// find the chunks, the missing one take the next free ids
+
+		openfpm::vector<size_t> seg;
+		openfpm::vector<size_t> seg_cnk;
+
+		size_t n_old = chunks.size();
+		size_t n_cnk = n_old;
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			size_t lin = lin_cnk.get(ord.get(i));
+
+			if (i != 0 && lin == lin_cnk.get(ord.get(i-1)))
+			{continue;}
+
+			seg.add(i);
+
+			auto fnd = map.find(lin);
+			if (fnd == map.end())
+			{
+				map[lin] = n_cnk;
+				seg_cnk.add(n_cnk);
+				n_cnk++;
+			}
+			else
+			{seg_cnk.add(fnd->second);}
+		}
+		seg.add(n);
+
+		// create all the new chunks, the neighborhood table is not valid anymore
+
+		if (n_cnk != n_old)
+		{
+			findNN = false;
+
+			chunks.resize(n_cnk);
+			header_inf.resize(n_cnk);
+			header_mask.resize(n_cnk);
+		}
+
+		// fill chunk by chunk
+
+		openfpm::parallel_for(0,seg_cnk.size(),[&](size_t s)
+		{
+			size_t cnk = seg_cnk.get(s);
+
+			auto & hc = header_inf.get(cnk);
+			auto & hm = header_mask.get(cnk);
+
+			if (cnk >= n_old)
+			{
+				grid_key_dx<dim> kl;
+				hc.pos = keys.get(ord.get(seg.get(s)));
+
+				key_shift<dim,chunking>::shift(hc.pos,kl);
+				key_shift<dim,chunking>::cpos(hc.pos);
+				hc.nele = 0;
+
+				for (size_t i = 0 ; i < chunking::size::value ; i++)
+				{hm.mask[i] = 0;}
+			}
+
+			auto block = chunks.get(cnk);
+
+			for (size_t j = seg.get(s) ; j < seg.get(s+1) ; j++)
+			{
+				size_t i = ord.get(j);
+				short int sid = sub_id.get(i);
+
+				if (hm.mask[sid] & 1)
+				{
+					copy_vector_to_chunk<op,vector_data_type,decltype(block),T,prp...> cvc(data,i,block,sid);
+					boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(prp)>>(cvc);
+				}
+				else
+				{
+					copy_vector_to_chunk<replace_,vector_data_type,decltype(block),T,prp...> cvc(data,i,block,sid);
+					boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(prp)>>(cvc);
+
+					hc.nele = (hm.mask[sid])?hc.nele:hc.nele + 1;
+					hm.mask[sid] |= 1;
+				}
+			}
+		},16);
+	}
+
+	/*! \brief Prepare the grid for the concurrent insertion
+	 *
+	 * Every thread insert with insertConcurrent in its own buffer (identified by a number in [0,n_buf)), the
+	 * points are merged into the grid by flushConcurrent. Until the flush the grid is not modified, so all the
+	 * threads can read it with getConcurrent and existPointConcurrent
+	 *
+	 * \param n_buf number of buffers (usually the number of threads)
+	 *
+	 */
+	void initConcurrent(size_t n_buf)
+	{
+		cins_keys.resize(n_buf);
+		cins_data.resize(n_buf);
+
+		for (size_t i = 0 ; i < n_buf ; i++)
+		{
+			cins_keys.get(i).clear();
+			cins_data.get(i).clear();
+		}
+	}
+
+	/*! \brief Insert a point in the buffer buf, it can be called concurrently by several threads as far as
+	 *         every thread use a different buffer
+	 *
+	 * \param buf buffer
+	 * \param v1 point to insert
+	 *
+	 * \return the element to fill (only the properties merged by flushConcurrent are used)
+	 *
+	 */
+	inline auto insertConcurrent(size_t buf, const grid_key_dx<dim> & v1) -> decltype(cins_data.get(0).get(0))
+	{
+		cins_keys.get(buf).add(v1);
+		cins_data.get(buf).add();
+
+		return cins_data.get(buf).get(cins_data.get(buf).size()-1);
+	}
+
+	/*! \brief Merge the points inserted with insertConcurrent into the grid
+	 *
+	 * The buffers are merged in order (0,1,...) and every buffer in the order of insertion, so the final state
+	 * depend only on what every buffer contain and not on the scheduling of the threads. When a point already exist
+	 * (or it has been inserted more than once) the values are merged with op
+	 *
+	 * \tparam op operation (replace_ the last value win, add_ accumulate, ...)
+	 * \tparam prp properties to merge
+	 *
+	 */
+	template<template<typename,typename> class op, unsigned int ... prp>
+	void flushConcurrent()
+	{
+		for (size_t i = 0 ; i < cins_keys.size() ; i++)
+		{
+			insert_bulk_op<op,prp...>(cins_keys.get(i),cins_data.get(i));
+
+			cins_keys.get(i).clear();
+			cins_data.get(i).clear();
+		}
+	}
+
+	/*! \brief Get the value of a point, unlike get it can be called concurrently by several threads
+	 *         (as far as no thread modify the grid)
+	 *
+	 * \param v1 point
+	 *
+	 * \return the value (the background value if the point does not exist)
+	 *
+	 */
+	template <unsigned int p>
+	inline auto getConcurrent(const grid_key_dx<dim> & v1) const -> decltype(get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,0))
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get_nc(v1,active_cnk,sub_id,exist);
+
+		if (exist == false || (header_mask.get(active_cnk).mask[sub_id] & 1) == 0)
+		{return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,sub_id);}
+
+		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,active_cnk,sub_id);
+	}
+
+	/*! \brief Check if the point exist, unlike existPoint it can be called concurrently by several threads
+	 *         (as far as no thread modify the grid)
+	 *
+	 * \param v1 point
+	 *
+	 * \return true if the point exist
+	 *
+	 */
+	inline bool existPointConcurrent(const grid_key_dx<dim> & v1) const
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get_nc(v1,active_cnk,sub_id,exist);
+
+		if (exist == false)
+		{return false;}
+
+		return (header_mask.get(active_cnk).mask[sub_id] & 1) != 0;
+	}
+
 	/*! \brief Get the reference of the selected element
 	 *
 	 * \param v1 grid_key that identify the element in the grid
@@ -1492,6 +2245,22 @@ public:
 
 		// Here we have to calculate the number of points to pack (skip the background)
 
+		if (has_pack_agg<T,prp...>::result::value == false)
+		{
+			const size_t hdr = sizeof(header_mask.get(0).mask) + sizeof(header_inf.get(0).pos) + sizeof(header_inf.get(0).nele);
+
+			req += openfpm::parallel_reduce(1,header_inf.size(),(size_t)0,[&](size_t i)
+			{
+				size_t cnt = 0;
+				for (size_t j = 0 ; j < chunking::size::value ; j++)
+				{cnt += header_mask.get(i).mask[j] & 1;}
+
+				return hdr + this->packMem<prp...>(cnt,0);
+			},[](size_t a, size_t b){return a + b;},64);
+
+			return;
+		}
+
 		for (size_t i = 1 ; i < header_inf.size() ; i++)
 		{
 			auto & hm = header_mask.get(i);
@@ -1568,6 +2337,21 @@ public:
 			section_to_pack.setHigh(i,sub_it.getStop().get(i));
 		}
 
+		if (has_pack_agg<T,prp...>::result::value == false)
+		{
+			const size_t hdr = sizeof(header_mask.get(0)) + sizeof(header_inf.get(0).pos) + sizeof(header_inf.get(0).nele);
+
+			req += openfpm::parallel_reduce(0,header_inf.size(),(size_t)0,[&](size_t i)
+			{
+				unsigned char mask_to_pack[chunking::size::value];
+				size_t cnt = mask_chunk_section(i,gs_cnk,section_to_pack,mask_to_pack);
+
+				return (cnt == 0)?0:hdr + this->packMem<prp...>(cnt,0);
+			},[](size_t a, size_t b){return a + b;},64);
+
+			return;
+		}
+
 		for (size_t i = 0 ; i < header_inf.size() ; i++)
 		{
 			auto & hm = header_mask.get(i);
@@ -1654,6 +2438,28 @@ public:
 	{
 		grid_sm<dim,void> gs_cnk(sz_cnk);
 
+		if (has_pack_agg<T,prp...>::result::value == false)
+		{
+			Box<dim,size_t> section_to_pack;
+
+			for (size_t i = 0; i < dim ; i++)
+			{
+				section_to_pack.setLow(i,sub_it.getStart().get(i));
+				section_to_pack.setHigh(i,sub_it.getStop().get(i));
+			}
+
+			grid_key_dx<dim> start = sub_it.getStart();
+
+			pack_chunks_parallel<prp...>(mem,0,header_inf.size(),true,
+										 [&](size_t i, unsigned char (& mask_to_pack)[chunking::size::value])
+										 {return mask_chunk_section(i,gs_cnk,section_to_pack,mask_to_pack);},
+										 [&](size_t i)
+										 {return header_inf.get(i).pos - start;},
+										 sts);
+
+			return;
+		}
+
 		// Here we allocate a size_t that indicate the number of chunk we are packing,
 		// because we do not know a priory, we will fill it later
 
@@ -1849,6 +2655,26 @@ public:
 	{
 		grid_sm<dim,void> gs_cnk(sz_cnk);
 
+		if (has_pack_agg<T,prp...>::result::value == false)
+		{
+			pack_chunks_parallel<prp...>(mem,1,header_inf.size(),false,
+										 [&](size_t i, unsigned char (& mask_to_pack)[chunking::size::value])
+										 {
+											size_t cnt = 0;
+											for (size_t j = 0 ; j < chunking::size::value ; j++)
+											{
+												mask_to_pack[j] = header_mask.get(i).mask[j];
+												cnt += mask_to_pack[j] & 1;
+											}
+											return cnt;
+										 },
+										 [&](size_t i)
+										 {return header_inf.get(i).pos;},
+										 sts);
+
+			return;
+		}
+
 		// Here we allocate a size_t that indicate the number of chunk we are packing,
 		// because we do not know a priory, we will fill it later
 
@@ -2070,6 +2896,26 @@ public:
 		return act_cnk;
 	}
 
+	/*! \brief Give a chunk position (as returned by getChunkPos) it return the chunk. In case the chunk does not
+	 *         exist it return the background chunk
+	 *
+	 * Unlike getChunk it does not use the cache, so it can be called concurrently by several threads
+	 *
+	 * \param pos chunk position
+	 * \param exist return true if the chunk exist
+	 *
+	 * \return the chunk
+	 *
+	 */
+	size_t findChunk(const grid_key_dx<dim> & pos, bool & exist) const
+	{
+		auto fnd = map.find(g_sm_shift.LinId(pos));
+
+		exist = (fnd != map.end());
+
+		return (exist == true)?fnd->second:0;
+	}
+
 	/*! \brief Get the position of a chunk
 	 *
 	 * \param chunk_id
@@ -2093,16 +2939,14 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, unsigned int N, typename lambda_f, typename ... ArgsT >
-	void conv(int (& stencil)[N][dim], grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv(int (& stencil)[N][dim], grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
 		if (findNN == false)
-		{conv_impl<dim>::template conv<false,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv<true,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,func);}
+		{construct_NNlist();}
 
-		findNN = true;
+		conv_impl<dim>::template conv<true,NNStar_c<dim>,prop_src,prop_dst,stencil_size>(stencil,start,stop,*this,func);
 	}
 
 	/*! \brief apply a convolution from start to stop point using the function func and arguments args
@@ -2114,16 +2958,14 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename lambda_f, typename ... ArgsT >
-	void conv_cross(grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv_cross(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(2*dim * chunks.size());
 
 		if (findNN == false)
-		{conv_impl<dim>::template conv_cross<false,prop_src,prop_dst,stencil_size>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross<true,prop_src,prop_dst,stencil_size>(start,stop,*this,func);}
+		{construct_NNlist();}
 
-		findNN = true;
+		conv_impl<dim>::template conv_cross<true,prop_src,prop_dst,stencil_size>(start,stop,*this,func);
 	}
 
 	/*! \brief apply a convolution from start to stop point using the function func and arguments args
@@ -2145,11 +2987,9 @@ public:
 		NNlist.resize(2*dim * chunks.size());
 
 		if (findNN == false)
-		{conv_impl<dim>::template conv_cross_ids<false,stencil_size,prop_type>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross_ids<true,stencil_size,prop_type>(start,stop,*this,func);}
+		{construct_NNlist();}
 
-		findNN = true;
+		conv_impl<dim>::template conv_cross_ids<true,stencil_size,prop_type>(start,stop,*this,func);
 	}
 
 	/*! \brief apply a convolution using the stencil N
@@ -2157,16 +2997,14 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src1, unsigned int prop_src2 ,unsigned int prop_dst1, unsigned int prop_dst2 ,unsigned int stencil_size, unsigned int N, typename lambda_f, typename ... ArgsT >
-	void conv2(int (& stencil)[N][dim], grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv2(int (& stencil)[N][dim], grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
 		if (findNN == false)
-		{conv_impl<dim>::template conv2<false,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv2<true,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,func);}
+		{construct_NNlist();}
 
-		findNN = true;
+		conv_impl<dim>::template conv2<true,NNStar_c<dim>,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(stencil,start,stop,*this,func);
 	}
 
 	/*! \brief apply a convolution using the stencil N
@@ -2174,16 +3012,14 @@ public:
 	 *
 	 */
 	template<unsigned int prop_src1, unsigned int prop_src2 ,unsigned int prop_dst1, unsigned int prop_dst2 ,unsigned int stencil_size, typename lambda_f, typename ... ArgsT >
-	void conv_cross2(grid_key_dx<3> start, grid_key_dx<3> stop , lambda_f func, ArgsT ... args)
+	void conv_cross2(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
 	{
 		NNlist.resize(NNStar_c<dim>::nNN * chunks.size());
 
 		if (findNN == false)
-		{conv_impl<dim>::template conv_cross2<false,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,func);}
-		else
-		{conv_impl<dim>::template conv_cross2<true,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,func);}
+		{construct_NNlist();}
 
-		findNN = true;
+		conv_impl<dim>::template conv_cross2<true,prop_src1,prop_src2,prop_dst1,prop_dst2,stencil_size>(start,stop,*this,func);
 	}
 
 	/*! \brief unpack the sub-grid object
@@ -2214,6 +3050,17 @@ public:
 		for (size_t i = 0 ; i < dim ; i++)
 		{Unpacker<size_t,S2>::unpack(mem,sz[i],ps);}
 
+		// when the chunks received go one to one on our chunks we unpack in parallel
+
+		Unpack_stat ps_par = ps;
+
+		if (has_pack_agg<T,prp...>::result::value == false &&
+			unpack_chunks_parallel<prp...>(mem,n_chunks,sub_it.getStart(),ps_par) == true)
+		{
+			ps = ps_par;
+			return;
+		}
+
 		openfpm::vector<cheader<dim>> header_inf_tmp;
 		openfpm::vector<mheader<chunking::size::value>> header_mask_tmp;
 		openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base > chunks_tmp;
@@ -2451,6 +3298,9 @@ public:
 
 		empty_v = sg.empty_v;
 
+		// the neighborhood table is recalculated at the first convolution
+		findNN = false;
+
 		return *this;
 	}
 
@@ -2553,6 +3403,9 @@ public:
 
 		empty_v = sg.empty_v;
 
+		// the neighborhood table is recalculated at the first convolution
+		findNN = false;
+
 		return *this;
 	}
 
@@ -18,6 +18,9 @@ const static int cnk_mask = 2;
 //! When we have more that 1024 to remove remove them
 #define FLUSH_REMOVE 1024
 
+//! Number of chunks that a thread take at time in the parallel convolutions
+#define SGRID_CONV_GRAIN 8
+
 template<typename T>
 struct encapsulated_type
 {
@@ -393,22 +396,22 @@ struct key_shift<4,chunk>
 {
 	inline static void shift(grid_key_dx<4> & kh, grid_key_dx<4> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<4> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
 	}
 };
 
@@ -429,25 +432,25 @@ struct key_shift<5,chunk>
 {
 	inline static void shift(grid_key_dx<5> & kh, grid_key_dx<5> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<5> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
 	}
 
 };
@@ -469,28 +472,28 @@ struct key_shift<6,chunk>
 {
 	inline static void shift(grid_key_dx<6> & kh, grid_key_dx<6> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<6> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) << boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
 	}
 };
 
@@ -514,31 +517,31 @@ struct key_shift<7,chunk>
 {
 	inline static void shift(grid_key_dx<7> & kh, grid_key_dx<7> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kl.set_d(6,kh.get(6) & (boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value - 1));
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kl.set_d(6,kh.get(6) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<6>>::type::value - 1));
+		kh.set_d(6,kh.get(6) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<7> & kh)
 	{
-		kh.set_d(0,kh.get(0) << boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) << boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) << boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) << boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) << boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) << boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kh.set_d(6,kh.get(6) << boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
+		kh.set_d(0,kh.get(0) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kh.set_d(6,kh.get(6) << boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
 	}
 };
 
@@ -561,34 +564,34 @@ struct key_shift<8,chunk>
 {
 	inline static void shift(grid_key_dx<8> & kh, grid_key_dx<8> & kl)
 	{
-		kl.set_d(0,kh.get(0) & (boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value - 1));
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kl.set_d(1,kh.get(1) & (boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value - 1));
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kl.set_d(2,kh.get(2) & (boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value - 1));
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kl.set_d(3,kh.get(3) & (boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value - 1));
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kl.set_d(4,kh.get(4) & (boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value - 1));
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kl.set_d(5,kh.get(5) & (boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value - 1));
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kl.set_d(6,kh.get(6) & (boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value - 1));
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
-		kl.set_d(7,kh.get(7) & (boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value - 1));
-		kh.set_d(7,kh.get(7) >> boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value);
+		kl.set_d(0,kh.get(0) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<0>>::type::value - 1));
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kl.set_d(1,kh.get(1) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<1>>::type::value - 1));
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kl.set_d(2,kh.get(2) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<2>>::type::value - 1));
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kl.set_d(3,kh.get(3) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<3>>::type::value - 1));
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kl.set_d(4,kh.get(4) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<4>>::type::value - 1));
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kl.set_d(5,kh.get(5) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<5>>::type::value - 1));
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kl.set_d(6,kh.get(6) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<6>>::type::value - 1));
+		kh.set_d(6,kh.get(6) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
+		kl.set_d(7,kh.get(7) & (boost::mpl::at<typename chunk::type,boost::mpl::int_<7>>::type::value - 1));
+		kh.set_d(7,kh.get(7) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<7>>::type::value);
 	}
 
 	inline static void cpos(grid_key_dx<8> & kh)
 	{
-		kh.set_d(0,kh.get(0) >> boost::mpl::at<chunk,boost::mpl::int_<0>>::type::value);
-		kh.set_d(1,kh.get(1) >> boost::mpl::at<chunk,boost::mpl::int_<1>>::type::value);
-		kh.set_d(2,kh.get(2) >> boost::mpl::at<chunk,boost::mpl::int_<2>>::type::value);
-		kh.set_d(3,kh.get(3) >> boost::mpl::at<chunk,boost::mpl::int_<3>>::type::value);
-		kh.set_d(4,kh.get(4) >> boost::mpl::at<chunk,boost::mpl::int_<4>>::type::value);
-		kh.set_d(5,kh.get(5) >> boost::mpl::at<chunk,boost::mpl::int_<5>>::type::value);
-		kh.set_d(6,kh.get(6) >> boost::mpl::at<chunk,boost::mpl::int_<6>>::type::value);
-		kh.set_d(7,kh.get(7) >> boost::mpl::at<chunk,boost::mpl::int_<7>>::type::value);
+		kh.set_d(0,kh.get(0) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<0>>::type::value);
+		kh.set_d(1,kh.get(1) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<1>>::type::value);
+		kh.set_d(2,kh.get(2) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<2>>::type::value);
+		kh.set_d(3,kh.get(3) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<3>>::type::value);
+		kh.set_d(4,kh.get(4) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<4>>::type::value);
+		kh.set_d(5,kh.get(5) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<5>>::type::value);
+		kh.set_d(6,kh.get(6) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<6>>::type::value);
+		kh.set_d(7,kh.get(7) >> boost::mpl::at<typename chunk::shift,boost::mpl::int_<7>>::type::value);
 	}
 };
 
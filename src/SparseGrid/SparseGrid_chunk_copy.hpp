@@ -12,6 +12,8 @@
 #include <Vc/Vc>
 #endif
 #include "util/mathutil.hpp"
+#include "util/ct_array.hpp"
+#include "util/create_vmpl_sequence.hpp"
 
 
 /*! \brief Check if the point in the chunk exist
@@ -152,6 +154,65 @@ struct copy_xyz
 	}
 };
 
+//! Copy block in any dimension, the chunk is copied row by row along x
+template<unsigned int dim, int stencil_size, typename chunking>
+struct copy_xyz_nd
+{
+	template<unsigned int N1, typename T, typename headerType, typename chunkType>
+	inline static void copy(T ptr[N1], unsigned char mask[N1], headerType & h , const chunkType & chunk)
+	{
+		typedef typename generate_array_vector<size_t,typename chunking::type>::result sz;
+
+		const int sx = sz::data[0];
+		const int n_rows = vmpl_reduce_prod<typename chunking::type>::type::value / sx;
+
+		int row[dim];
+
+		for (int i = 0 ; i < dim ; i++)
+		{row[i] = 0;}
+
+		int s2 = 0;
+
+		for (int r = 0 ; r < n_rows ; r++)
+		{
+			// start of the row in the block with border
+			int s = stencil_size;
+			int stride = sx + 2*stencil_size;
+
+			for (int i = 1 ; i < dim ; i++)
+			{
+				s += (row[i] + stencil_size)*stride;
+				stride *= sz::data[i] + 2*stencil_size;
+			}
+
+			for (int k = 0 ; k < sx ; k++)
+			{
+				ptr[s+k] = chunk[s2];
+				mask[s+k] = exist_sub(h,s2);
+
+				s2++;
+			}
+
+			// next row
+
+			for (int i = 1 ; i < dim ; i++)
+			{
+				row[i]++;
+
+				if (row[i] < (int)sz::data[i])	{break;}
+				row[i] = 0;
+			}
+		}
+	}
+
+	template<unsigned int N1, typename T, typename chunkType>
+	inline static void store(T ptr[N1] , chunkType & chunk)
+	{
+		for (int s2 = 0 ; s2 < vmpl_reduce_prod<typename chunking::type>::type::value ; s2++)
+		{chunk[s2] = ptr[s2];}
+	}
+};
+
 template<unsigned int i>
 struct multi_mask
 {};
@@ -63,53 +63,6 @@ struct ids_crs
 
 
 
-template<unsigned int dim>
-struct conv_impl
-{
-	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
-	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv operation not implemented for this dimension " << std::endl;
-#else
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv is unsupported when compiled on NVCC " << std::endl;
-#endif
-	}
-
-	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
-	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross operation not implemented for this dimension " << std::endl;
-#else
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross is unsupported when compiled on NVCC " << std::endl;
-#endif
-	}
-
-	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
-			 unsigned int prop_dst1, unsigned int prop_dst2,
-			 unsigned int stencil_size , unsigned int N,
-			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
-	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv2 operation not implemented for this dimension " << std::endl;
-#else
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv2 is unsupported when compiled on NVCC " << std::endl;
-#endif
-	}
-
-	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
-	{
-#ifndef __NVCC__
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 operation not implemented for this dimension " << std::endl;
-#else
-		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 is unsupported when compiled on NVCC " << std::endl;
-#endif
-	}
-};
-
 #if !defined(__NVCC__) || defined(CUDA_ON_CPU)
 
 
@@ -199,663 +152,1109 @@ void load_crs_v(vect_type & cs1, chunk_type & chunk,  ids_type & ids)
 	}
 }
 
-struct cross_stencil_v
+/*! \brief Calculate the offsets to jump from the chunk cid to its -x,+x,-y,+y,-z,+z neighborhood chunks
+ *
+ * With findNN the neighborhood chunks are read from the table NNlist of the grid (filled in the order
+ * +z,-z,+y,-y,+x,-x), otherwise they are searched in the grid. A non existing chunk map to the background chunk
+ *
+ * \tparam findNN true if NNlist is filled
+ * \tparam sizeBlock number of points in a chunk
+ *
+ * \param grid sparse grid
+ * \param cid chunk
+ * \param offset_jump offsets
+ *
+ */
+template<bool findNN, unsigned int sizeBlock, typename SparseGridType>
+inline void load_offset_jump(SparseGridType & grid, size_t cid, long int (& offset_jump)[6])
 {
-	Vc::double_v xm;
-	Vc::double_v xp;
-	Vc::double_v ym;
-	Vc::double_v yp;
-	Vc::double_v zm;
-	Vc::double_v zp;
-};
+	if (findNN == true)
+	{
+		auto & NNlist = grid.private_get_nnlist();
 
-template<>
-struct conv_impl<3>
+		for (int i = 0 ; i < 6 ; i++)
+		{
+			long int r = NNlist.get(cid*NNStar_c<3>::nNN + 5 - i);
+			r = (r == -1)?0:r;
+
+			offset_jump[i] = (r-(long int)cid)*sizeBlock;
+		}
+	}
+	else
+	{
+		for (int i = 0 ; i < 6 ; i++)
+		{
+			grid_key_dx<3> p = grid.getChunkPos(cid);
+			p.set_d(i/2,p.get(i/2) + ((i%2 == 0)?-1:1));
+
+			bool exist;
+			long int r = grid.getChunk(p,exist);
+
+			offset_jump[i] = (r-(long int)cid)*sizeBlock;
+		}
+	}
+}
+
+/*! \brief Return how many chunks a thread of the parallel convolution take at time
+ *
+ * Searching the neighborhood chunks use the cache of the grid, and when the destination is also a source
+ * the result depend on the order of the chunks. In these cases all the chunks go to one thread
+ *
+ * \param findNN true if the neighborhood table is filled
+ * \param in_place true if the destination is also a source
+ * \param n_chunks number of chunks
+ *
+ * \return the number of chunks
+ *
+ */
+inline size_t conv_grain(bool findNN, bool in_place, size_t n_chunks)
 {
-	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	return (findNN == false || in_place == true)?n_chunks:SGRID_CONV_GRAIN;
+}
+
+/*! \brief Vectorized convolutions for sparse grids of any dimension
+ *
+ * The chunk with its border is copied in a buffer (copy_xyz_nd), and the stencil is applied row by row along x.
+ * Only conv and conv2 are implemented, the cross versions exist only in 3D. The chunks are distributed across
+ * the threads of the openfpm thread pool, like the 3D version
+ *
+ */
+template<unsigned int dim>
+struct conv_impl
+{
+	/*! \brief Calculate the position of the row in the block with border and in the chunk
+	 *
+	 * \param row coordinates of the row (the x coordinate is the start of the row)
+	 * \param str_b strides of the block with border
+	 * \param str strides of the chunk
+	 * \param cc position in the block with border
+	 * \param cd position in the chunk
+	 *
+	 */
+	template<unsigned int stencil_size>
+	static inline void row_offsets(const int (& row)[dim], const int (& str_b)[dim], const int (& str)[dim], int & cc, int & cd)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		cc = 0;
+		cd = 0;
 
-		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+		for (int i = 0 ; i < dim ; i++)
+		{
+			cc += row[i]*str_b[i];
+			cd += (row[i]-(int)stencil_size)*str[i];
+		}
+	}
 
-		unsigned char mask[decltype(it)::sizeBlockBord];
-		unsigned char mask_sum[decltype(it)::sizeBlockBord];
-		unsigned char mask_unused[decltype(it)::sizeBlock];
-		__attribute__ ((aligned (32))) prop_type block_bord_src[decltype(it)::sizeBlockBord];
-		__attribute__ ((aligned (32))) prop_type block_bord_dst[decltype(it)::sizeBlock];
+	/*! \brief Move to the next row of the computation block
+	 *
+	 * \param it block iterator
+	 * \param row coordinates of the row
+	 *
+	 * \return false if there are no more rows
+	 *
+	 */
+	template<typename it_type>
+	static inline bool next_row(it_type & it, int (& row)[dim])
+	{
+		for (int i = 1 ; i < dim ; i++)
+		{
+			row[i]++;
 
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
+			if (row[i] < it.stop_b(i))	{return true;}
 
-		while (it.isNext())
+			row[i] = it.start_b(i);
+		}
+
+		return false;
+	}
+
+	/*! \brief Calculate the strides of the block with border and of the chunk, and the offsets of the stencil points
+	 *
+	 * \param str_b strides of the block with border
+	 * \param str strides of the chunk
+	 * \param stencil stencil
+	 * \param st_off offsets of the stencil points in the block with border
+	 *
+	 */
+	template<typename it_type, unsigned int N>
+	static inline void strides(int (& str_b)[dim], int (& str)[dim], int (& stencil)[N][dim], int (& st_off)[N])
+	{
+		str_b[0] = 1;
+		str[0] = 1;
+
+		for (int i = 1 ; i < dim ; i++)
 		{
-			it.template loadBlockBorder<prop_src,NNtype,findNN>(block_bord_src,mask);
+			str_b[i] = str_b[i-1]*it_type::stop_b_::data[i-1];
+			str[i] = str[i-1]*it_type::size::data[i-1];
+		}
 
-			if (it.start_b(2) != stencil_size || it.start_b(1) != stencil_size || it.start_b(0) != stencil_size ||
-			    it.stop_b(2) != sz2::value+stencil_size || it.stop_b(1) != sz1::value+stencil_size || it.stop_b(0) != sz0::value+stencil_size)
-			{
-				auto & header_mask = grid.private_get_header_mask();
-				auto & header_inf = grid.private_get_header_inf();
+		for (int s = 0 ; s < N ; s++)
+		{
+			st_off[s] = 0;
 
-				loadBlock_impl<prop_dst,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst,grid,it.getChunkId(),mask_unused);
-			}
+			for (int i = 0 ; i < dim ; i++)
+			{st_off[s] += stencil[s][i]*str_b[i];}
+		}
+	}
+
+	/*! \brief Return true if the computation block does not cover the full chunk
+	 *
+	 * \param it block iterator
+	 *
+	 */
+	template<unsigned int stencil_size, typename it_type>
+	static inline bool is_partial(it_type & it)
+	{
+		bool partial = false;
 
-			// Sum the mask
-			for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+		for (int i = 0 ; i < dim ; i++)
+		{partial |= (it.start_b(i) != stencil_size || it.stop_b(i) != it_type::size::data[i] + stencil_size);}
+
+		return partial;
+	}
+
+	/*! \brief Sum the mask of the stencil points for all the points of the computation block
+	 *
+	 * \param it block iterator
+	 * \param str_b strides of the block with border
+	 * \param str strides of the chunk
+	 * \param st_off offsets of the stencil points
+	 * \param mask mask of the block with border
+	 * \param mask_sum output
+	 *
+	 */
+	template<unsigned int stencil_size, unsigned int N, typename it_type>
+	static inline void sum_mask(it_type & it, const int (& str_b)[dim], const int (& str)[dim], const int (& st_off)[N],
+			                    unsigned char * mask, unsigned char * mask_sum)
+	{
+		int row[dim];
+
+		for (int i = 0 ; i < dim ; i++)
+		{row[i] = it.start_b(i);}
+
+		do
+		{
+			int cc;
+			int cd;
+
+			row_offsets<stencil_size>(row,str_b,str,cc,cd);
+
+			for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += sizeof(size_t))
 			{
-				for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
-				{
-					int cc = it.LinB(it.start_b(0),j,k);
-					int c[N];
+				size_t cmd = *(size_t *)&mask[cc];
 
+				if (cmd != 0)
+				{
+					size_t sum = 0;
 					for (int s = 0 ; s < N ; s++)
 					{
-						c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+						sum += *(size_t *)&mask[cc+st_off[s]];
 					}
 
-					for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += sizeof(size_t))
-					{
-						size_t cmd = *(size_t *)&mask[cc];
+					*(size_t *)&mask_sum[cc] = sum;
+				}
 
-						if (cmd != 0)
-						{
-							size_t xm[N];
+				cc += sizeof(size_t);
+			}
+		}
+		while (next_row(it,row));
+	}
 
-							for (int s = 0 ; s < N ; s++)
-							{
-								xm[s] = *(size_t *)&mask[c[s]];
-							}
+	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-							size_t sum = 0;
-							for (int s = 0 ; s < N ; s++)
-							{
-								sum += xm[s];
-							}
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_src == prop_dst,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<stencil_size>(start,stop);
 
-							*(size_t *)&mask_sum[cc] = sum;
-						}
+			typedef decltype(it) it_type;
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
 
-						cc += sizeof(size_t);
-						for (int s = 0 ; s < N ; s++)
-						{
-							c[s] += sizeof(size_t);
-						}
-					}
-				}
-			}
+			// the padding cover the last vector (or the last 8 masks) of the last row
+			unsigned char mask[it_type::sizeBlockBord+16];
+			unsigned char mask_sum[it_type::sizeBlockBord+16];
+			unsigned char mask_unused[it_type::sizeBlock];
+			__attribute__ ((aligned (64))) prop_type block_bord_src[it_type::sizeBlockBord+16];
+			__attribute__ ((aligned (64))) prop_type block_bord_dst[it_type::sizeBlock+16];
+
+			int str_b[dim];
+			int str[dim];
+			int st_off[N];
+
+			strides<it_type>(str_b,str,stencil,st_off);
+
+			size_t c_start;
+			size_t c_stop;
 
-			for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+			while (next(c_start,c_stop))
 			{
-				for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
-				{
-					int cc = it.LinB(it.start_b(0),j,k);
-					int c[N];
+				it.setChunkRange(c_start,c_stop);
 
-					int cd = it.LinB_off(it.start_b(0),j,k);
+				while (it.isNext())
+				{
+					it.template loadBlockBorder<prop_src,NNtype,findNN>(block_bord_src,mask);
 
-					for (int s = 0 ; s < N ; s++)
+					if (is_partial<stencil_size>(it) == true)
 					{
-						c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+						loadBlock_impl<prop_dst,0,dim,typename it_type::vector_blocks_exts_type, typename it_type::vector_ext_type>::template loadBlock<it_type::sizeBlock>(block_bord_dst,grid,it.getChunkId(),mask_unused);
 					}
 
-					for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
-					{
-						Vc::Mask<prop_type> cmp;
+					sum_mask<stencil_size>(it,str_b,str,st_off,mask,mask_sum);
 
-						for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
-						{
-							cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
-						}
+					int row[dim];
 
-						// we do only if exist the point
-						if (Vc::none_of(cmp) == false)
-						{
-							Vc::Mask<prop_type> surround;
+					for (int i = 0 ; i < dim ; i++)
+					{row[i] = it.start_b(i);}
 
-							Vc::Vector<prop_type> xs[N+1];
+					do
+					{
+						int cc;
+						int cd;
 
-							xs[0] = Vc::Vector<prop_type>(&block_bord_src[cc],Vc::Unaligned);
+						row_offsets<stencil_size>(row,str_b,str,cc,cd);
 
-							for (int s = 1 ; s < N+1 ; s++)
+						for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
+						{
+							Vc::Mask<prop_type> cmp;
+
+							for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
 							{
-								xs[s] = Vc::Vector<prop_type>(&block_bord_src[c[s-1]],Vc::Unaligned);
+								cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
 							}
 
-							auto res = func(xs, &mask_sum[cc], args ...);
+							// we do only if exist the point
+							if (Vc::none_of(cmp) == false)
+							{
+								Vc::Vector<prop_type> xs[N+1];
 
-							res.store(&block_bord_dst[cd],cmp,Vc::Aligned);
-						}
+								xs[0] = Vc::Vector<prop_type>(&block_bord_src[cc],Vc::Unaligned);
 
-						cc += Vc::Vector<prop_type>::Size;
-						for (int s = 0 ; s < N ; s++)
-						{
-							c[s] += Vc::Vector<prop_type>::Size;
+								for (int s = 1 ; s < N+1 ; s++)
+								{
+									xs[s] = Vc::Vector<prop_type>(&block_bord_src[cc+st_off[s-1]],Vc::Unaligned);
+								}
+
+								auto res = func(xs, &mask_sum[cc], args ...);
+
+								res.store(&block_bord_dst[cd],cmp,Vc::Unaligned);
+							}
+
+							cc += Vc::Vector<prop_type>::Size;
+							cd += Vc::Vector<prop_type>::Size;
 						}
-						cd += Vc::Vector<prop_type>::Size;
 					}
-				}
-			}
+					while (next_row(it,row));
 
-			it.template storeBlock<prop_dst>(block_bord_dst);
+					it.template storeBlock<prop_dst>(block_bord_dst);
 
-			++it;
-		}
+					++it;
+				}
+			}
+		});
 	}
 
 	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	static void conv_cross(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<1>(start,stop);
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross operation not implemented for this dimension, use conv with a cross stencil " << std::endl;
+	}
 
-		auto & datas = grid.private_get_data();
-		auto & headers = grid.private_get_header_mask();
+	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
+			 unsigned int prop_dst1, unsigned int prop_dst2,
+			 unsigned int stencil_size , unsigned int N,
+			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv2(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_dst1 == prop_src1 || prop_dst1 == prop_src2 || prop_dst2 == prop_src1 || prop_dst2 == prop_src2,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<stencil_size>(start,stop);
 
-		typedef typename SparseGridType::chunking_type chunking;
+			typedef decltype(it) it_type;
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
 
-		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+			// the padding cover the last vector (or the last 8 masks) of the last row
+			unsigned char mask[it_type::sizeBlockBord+16];
+			unsigned char mask_sum[it_type::sizeBlockBord+16];
+			unsigned char mask_unused[it_type::sizeBlock];
+			__attribute__ ((aligned (64))) prop_type block_bord_src1[it_type::sizeBlockBord+16];
+			__attribute__ ((aligned (64))) prop_type block_bord_dst1[it_type::sizeBlock+16];
+			__attribute__ ((aligned (64))) prop_type block_bord_src2[it_type::sizeBlockBord+16];
+			__attribute__ ((aligned (64))) prop_type block_bord_dst2[it_type::sizeBlock+16];
 
-		while (it.isNext())
-		{
-			// Load
-			long int offset_jump[6];
+			int str_b[dim];
+			int str[dim];
+			int st_off[N];
 
-			size_t cid = it.getChunkId();
+			strides<it_type>(str_b,str,stencil,st_off);
 
-			auto chunk = datas.get(cid);
-			auto & mask = headers.get(cid);
+			size_t c_start;
+			size_t c_stop;
 
-			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
-			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
+			while (next(c_start,c_stop))
+			{
+				it.setChunkRange(c_start,c_stop);
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
+				while (it.isNext())
+				{
+					it.template loadBlockBorder<prop_src1,NNType,findNN>(block_bord_src1,mask);
+					it.template loadBlockBorder<prop_src2,NNType,findNN>(block_bord_src2,mask);
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
+					if (is_partial<stencil_size>(it) == true)
+					{
+						loadBlock_impl<prop_dst1,0,dim,typename it_type::vector_blocks_exts_type, typename it_type::vector_ext_type>::template loadBlock<it_type::sizeBlock>(block_bord_dst1,grid,it.getChunkId(),mask_unused);
+						loadBlock_impl<prop_dst2,0,dim,typename it_type::vector_blocks_exts_type, typename it_type::vector_ext_type>::template loadBlock<it_type::sizeBlock>(block_bord_dst2,grid,it.getChunkId(),mask_unused);
+					}
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
+					sum_mask<stencil_size>(it,str_b,str,st_off,mask,mask_sum);
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
-			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
+					int row[dim];
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
-			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
+					for (int i = 0 ; i < dim ; i++)
+					{row[i] = it.start_b(i);}
 
-			// Load offset jumps
+					do
+					{
+						int cc;
+						int cd;
 
-			// construct a row mask
+						row_offsets<stencil_size>(row,str_b,str,cc,cd);
 
-			long int s2 = 0;
+						for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
+						{
+							Vc::Mask<prop_type> cmp;
 
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<2>>::type sz;
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<1>>::type sy;
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<0>>::type sx;
+							for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
+							{
+								cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
+							}
+
+							// we do only if exist the point
+							if (Vc::none_of(cmp) == false)
+							{
+								Vc::Vector<prop_type> xs1[N+1];
+								Vc::Vector<prop_type> xs2[N+1];
 
+								xs1[0] = Vc::Vector<prop_type>(&block_bord_src1[cc],Vc::Unaligned);
+								xs2[0] = Vc::Vector<prop_type>(&block_bord_src2[cc],Vc::Unaligned);
 
-			bool mask_row[sx::value];
+								for (int s = 1 ; s < N+1 ; s++)
+								{
+									xs1[s] = Vc::Vector<prop_type>(&block_bord_src1[cc+st_off[s-1]],Vc::Unaligned);
+									xs2[s] = Vc::Vector<prop_type>(&block_bord_src2[cc+st_off[s-1]],Vc::Unaligned);
+								}
 
-			for (int k = 0 ; k < sx::value ; k++)
-			{
-				mask_row[k] = (k >= it.start(0) && k < it.stop(0))?true:false;
+								Vc::Vector<prop_type> vo1;
+								Vc::Vector<prop_type> vo2;
+
+								func(vo1, vo2, xs1, xs2, &mask_sum[cc], args ...);
+
+								vo1.store(&block_bord_dst1[cd],cmp,Vc::Unaligned);
+								vo2.store(&block_bord_dst2[cd],cmp,Vc::Unaligned);
+							}
+
+							cc += Vc::Vector<prop_type>::Size;
+							cd += Vc::Vector<prop_type>::Size;
+						}
+					}
+					while (next_row(it,row));
+
+					it.template storeBlock<prop_dst1>(block_bord_dst1);
+					it.template storeBlock<prop_dst2>(block_bord_dst2);
+
+					++it;
+				}
 			}
+		});
+	}
 
-			for (int v = it.start(2) ; v < it.stop(2) ; v++)
-			{
-				for (int j = it.start(1) ; j < it.stop(1) ; j++)
-				{
-					s2 = it.Lin(0,j,v);
-					for (int k = 0 ; k < sx::value ; k += Vc::Vector<prop_type>::Size)
-					{
-						// we do only id exist the point
-						if (*(int *)&mask.mask[s2] == 0) {s2 += Vc::Vector<prop_type>::Size; continue;}
+	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross2(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 operation not implemented for this dimension, use conv2 with a cross stencil " << std::endl;
+	}
+};
 
-						data_il<Vc::Vector<prop_type>::Size> mxm;
-						data_il<Vc::Vector<prop_type>::Size> mxp;
-						data_il<Vc::Vector<prop_type>::Size> mym;
-						data_il<Vc::Vector<prop_type>::Size> myp;
-						data_il<Vc::Vector<prop_type>::Size> mzm;
-						data_il<Vc::Vector<prop_type>::Size> mzp;
+struct cross_stencil_v
+{
+	Vc::double_v xm;
+	Vc::double_v xp;
+	Vc::double_v ym;
+	Vc::double_v yp;
+	Vc::double_v zm;
+	Vc::double_v zp;
+};
 
-						cross_stencil_v cs;
+/*! \brief Vectorized convolutions for 3D sparse grids
+ *
+ * The chunks are distributed across the threads of the openfpm thread pool (openfpm::set_num_threads).
+ * Every chunk write only its own points, so the result is the same for any number of threads
+ *
+ */
+template<>
+struct conv_impl<3>
+{
+	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-						Vc::Vector<prop_type> cmd(&chunk.template get<prop_src>()[s2]);
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_src == prop_dst,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<stencil_size>(start,stop);
 
-						// Load x-1
-						long int sumxm = s2-1;
-						sumxm += (k==0)?offset_jump[0] + sx::value:0;
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
 
-						// Load x+1
-						long int sumxp = s2+Vc::Vector<prop_type>::Size;
-						sumxp += (k+Vc::Vector<prop_type>::Size == sx::value)?offset_jump[1] - sx::value:0;
-
-						long int sumym = (j == 0)?offset_jump[2] + (sy::value-1)*sx::value:-sx::value;
-						sumym += s2;
-						long int sumyp = (j == sy::value-1)?offset_jump[3] - (sy::value - 1)*sx::value:sx::value;
-						sumyp += s2;
-						long int sumzm = (v == 0)?offset_jump[4] + (sz::value-1)*sx::value*sy::value:-sx::value*sy::value;
-						sumzm += s2;
-						long int sumzp = (v == sz::value-1)?offset_jump[5] - (sz::value - 1)*sx::value*sy::value:sx::value*sy::value;
-						sumzp += s2;
-
-						if (Vc::Vector<prop_type>::Size == 2)
-						{
-							mxm.i = *(short int *)&mask.mask[s2];
-							mxm.i = mxm.i << 8;
-							mxm.i |= (short int)mask.mask[sumxm];
+			unsigned char mask[decltype(it)::sizeBlockBord];
+			unsigned char mask_sum[decltype(it)::sizeBlockBord];
+			unsigned char mask_unused[decltype(it)::sizeBlock];
+			__attribute__ ((aligned (32))) prop_type block_bord_src[decltype(it)::sizeBlockBord];
+			__attribute__ ((aligned (32))) prop_type block_bord_dst[decltype(it)::sizeBlock];
 
-							mxp.i = *(short int *)&mask.mask[s2];
-							mxp.i = mxp.i >> 8;
-							mxp.i |= ((short int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
 
-							mym.i = *(short int *)&mask.mask[sumym];
-							myp.i = *(short int *)&mask.mask[sumyp];
+			size_t c_start;
+			size_t c_stop;
 
-							mzm.i = *(short int *)&mask.mask[sumzm];
-							mzp.i = *(short int *)&mask.mask[sumzp];
-						}
-						else if (Vc::Vector<prop_type>::Size == 4)
-						{
-							mxm.i = *(int *)&mask.mask[s2];
-							mxm.i = mxm.i << 8;
-							mxm.i |= (int)mask.mask[sumxm];
+			while (next(c_start,c_stop))
+			{
+				it.setChunkRange(c_start,c_stop);
+
+				while (it.isNext())
+				{
+					it.template loadBlockBorder<prop_src,NNtype,findNN>(block_bord_src,mask);
 
-							mxp.i = *(int *)&mask.mask[s2];
-							mxp.i = mxp.i >> 8;
-							mxp.i |= ((int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+					if (it.start_b(2) != stencil_size || it.start_b(1) != stencil_size || it.start_b(0) != stencil_size ||
+					    it.stop_b(2) != sz2::value+stencil_size || it.stop_b(1) != sz1::value+stencil_size || it.stop_b(0) != sz0::value+stencil_size)
+					{
+						auto & header_mask = grid.private_get_header_mask();
+						auto & header_inf = grid.private_get_header_inf();
 
-							mym.i = *(int *)&mask.mask[sumym];
-							myp.i = *(int *)&mask.mask[sumyp];
+						loadBlock_impl<prop_dst,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst,grid,it.getChunkId(),mask_unused);
+					}
 
-							mzm.i = *(int *)&mask.mask[sumzm];
-							mzp.i = *(int *)&mask.mask[sumzp];
-						}
-						else
+					// Sum the mask
+					for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+					{
+						for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
 						{
-							std::cout << __FILE__ << ":" << __LINE__ << " UNSUPPORTED" << std::endl;
+							int cc = it.LinB(it.start_b(0),j,k);
+							int c[N];
+
+							for (int s = 0 ; s < N ; s++)
+							{
+								c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+							}
+
+							for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += sizeof(size_t))
+							{
+								size_t cmd = *(size_t *)&mask[cc];
+
+								if (cmd != 0)
+								{
+									size_t xm[N];
+
+									for (int s = 0 ; s < N ; s++)
+									{
+										xm[s] = *(size_t *)&mask[c[s]];
+									}
+
+									size_t sum = 0;
+									for (int s = 0 ; s < N ; s++)
+									{
+										sum += xm[s];
+									}
+
+									*(size_t *)&mask_sum[cc] = sum;
+								}
+
+								cc += sizeof(size_t);
+								for (int s = 0 ; s < N ; s++)
+								{
+									c[s] += sizeof(size_t);
+								}
+							}
 						}
+					}
 
-						cs.xm = cmd;
-						cs.xm = cs.xm.shifted(-1);
-						cs.xm[0] = chunk.template get<prop_src>()[sumxm];
+					for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+					{
+						for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
+						{
+							int cc = it.LinB(it.start_b(0),j,k);
+							int c[N];
 
+							int cd = it.LinB_off(it.start_b(0),j,k);
 
-						cs.xp = cmd;
-						cs.xp = cs.xp.shifted(1);
-						cs.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src>()[sumxp];
+							for (int s = 0 ; s < N ; s++)
+							{
+								c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+							}
 
-						// Load y and z direction
+							for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
+							{
+								Vc::Mask<prop_type> cmp;
 
-						cs.ym.load(&chunk.template get<prop_src>()[sumym],Vc::Aligned);
-						cs.yp.load(&chunk.template get<prop_src>()[sumyp],Vc::Aligned);
-						cs.zm.load(&chunk.template get<prop_src>()[sumzm],Vc::Aligned);
-						cs.zp.load(&chunk.template get<prop_src>()[sumzp],Vc::Aligned);
+								for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
+								{
+									cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
+								}
 
-						// Calculate
+								// we do only if exist the point
+								if (Vc::none_of(cmp) == false)
+								{
+									Vc::Mask<prop_type> surround;
 
-						data_il<Vc::Vector<prop_type>::Size> tot_m;
-						tot_m.i = mxm.i + mxp.i + mym.i + myp.i + mzm.i + mzp.i;
+									Vc::Vector<prop_type> xs[N+1];
 
-						Vc::Vector<prop_type> res = func(cmd,cs,tot_m.uc,args ... );
+									xs[0] = Vc::Vector<prop_type>(&block_bord_src[cc],Vc::Unaligned);
 
-						Vc::Mask<prop_type> m(&mask_row[k]);
+									for (int s = 1 ; s < N+1 ; s++)
+									{
+										xs[s] = Vc::Vector<prop_type>(&block_bord_src[c[s-1]],Vc::Unaligned);
+									}
 
-						res.store(&chunk.template get<prop_dst>()[s2],m,Vc::Aligned);
+									auto res = func(xs, &mask_sum[cc], args ...);
 
-						s2 += Vc::Vector<prop_type>::Size;
+									res.store(&block_bord_dst[cd],cmp,Vc::Aligned);
+								}
+
+								cc += Vc::Vector<prop_type>::Size;
+								for (int s = 0 ; s < N ; s++)
+								{
+									c[s] += Vc::Vector<prop_type>::Size;
+								}
+								cd += Vc::Vector<prop_type>::Size;
+							}
+						}
 					}
+
+					it.template storeBlock<prop_dst>(block_bord_dst);
+
+					++it;
 				}
 			}
-
-			++it;
-		}
+		});
 	}
 
-
-	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
-			 unsigned int prop_dst1, unsigned int prop_dst2,
-			 unsigned int stencil_size , unsigned int N,
-			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_src == prop_dst,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<1>(start,stop);
 
-		unsigned char mask[decltype(it)::sizeBlockBord];
-		unsigned char mask_sum[decltype(it)::sizeBlockBord];
-		__attribute__ ((aligned (64))) prop_type block_bord_src1[decltype(it)::sizeBlockBord];
-		__attribute__ ((aligned (64))) prop_type block_bord_dst1[decltype(it)::sizeBlock+16];
-		__attribute__ ((aligned (64))) prop_type block_bord_src2[decltype(it)::sizeBlockBord];
-		__attribute__ ((aligned (64))) prop_type block_bord_dst2[decltype(it)::sizeBlock+16];
+			auto & datas = grid.private_get_data();
+			auto & headers = grid.private_get_header_mask();
 
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
 
-		while (it.isNext())
-		{
-			it.template loadBlockBorder<prop_src1,NNType,findNN>(block_bord_src1,mask);
-			it.template loadBlockBorder<prop_src2,NNType,findNN>(block_bord_src2,mask);
+			typedef typename SparseGridType::chunking_type chunking;
+
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+
+			size_t c_start;
+			size_t c_stop;
 
-			// Sum the mask
-			for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+			while (next(c_start,c_stop))
 			{
-				for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
+				it.setChunkRange(c_start,c_stop);
+
+				while (it.isNext())
 				{
-					int cc = it.LinB(it.start_b(0),j,k);
-					int c[N];
+					// Load
+					long int offset_jump[6];
 
-					for (int s = 0 ; s < N ; s++)
+					size_t cid = it.getChunkId();
+
+					auto chunk = datas.get(cid);
+					auto & mask = headers.get(cid);
+
+					load_offset_jump<findNN,decltype(it)::sizeBlock>(grid,cid,offset_jump);
+
+					// Load offset jumps
+
+					// construct a row mask
+
+					long int s2 = 0;
+
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<2>>::type sz;
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<1>>::type sy;
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<0>>::type sx;
+
+
+					bool mask_row[sx::value];
+
+					for (int k = 0 ; k < sx::value ; k++)
 					{
-						c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+						mask_row[k] = (k >= it.start(0) && k < it.stop(0))?true:false;
 					}
 
-					for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += sizeof(size_t))
+					for (int v = it.start(2) ; v < it.stop(2) ; v++)
 					{
-						size_t cmd = *(size_t *)&mask[cc];
+						for (int j = it.start(1) ; j < it.stop(1) ; j++)
+						{
+							s2 = it.Lin(0,j,v);
+							for (int k = 0 ; k < sx::value ; k += Vc::Vector<prop_type>::Size)
+							{
+								// we do only id exist the point
+								if (*(int *)&mask.mask[s2] == 0) {s2 += Vc::Vector<prop_type>::Size; continue;}
 
-						if (cmd == 0) {continue;}
+								data_il<Vc::Vector<prop_type>::Size> mxm;
+								data_il<Vc::Vector<prop_type>::Size> mxp;
+								data_il<Vc::Vector<prop_type>::Size> mym;
+								data_il<Vc::Vector<prop_type>::Size> myp;
+								data_il<Vc::Vector<prop_type>::Size> mzm;
+								data_il<Vc::Vector<prop_type>::Size> mzp;
 
+								cross_stencil_v cs;
 
-						size_t xm[N];
+								Vc::Vector<prop_type> cmd(&chunk.template get<prop_src>()[s2]);
 
-						for (int s = 0 ; s < N ; s++)
-						{
-							xm[s] = *(size_t *)&mask[c[s]];
-						}
+								// Load x-1
+								long int sumxm = s2-1;
+								sumxm += (k==0)?offset_jump[0] + sx::value:0;
 
-						size_t sum = 0;
-						for (int s = 0 ; s < N ; s++)
-						{
-							sum += xm[s];
-						}
+								// Load x+1
+								long int sumxp = s2+Vc::Vector<prop_type>::Size;
+								sumxp += (k+Vc::Vector<prop_type>::Size == sx::value)?offset_jump[1] - sx::value:0;
 
-						*(size_t *)&mask_sum[cc] = sum;
+								long int sumym = (j == 0)?offset_jump[2] + (sy::value-1)*sx::value:-sx::value;
+								sumym += s2;
+								long int sumyp = (j == sy::value-1)?offset_jump[3] - (sy::value - 1)*sx::value:sx::value;
+								sumyp += s2;
+								long int sumzm = (v == 0)?offset_jump[4] + (sz::value-1)*sx::value*sy::value:-sx::value*sy::value;
+								sumzm += s2;
+								long int sumzp = (v == sz::value-1)?offset_jump[5] - (sz::value - 1)*sx::value*sy::value:sx::value*sy::value;
+								sumzp += s2;
 
-						cc += sizeof(size_t);
-						for (int s = 0 ; s < N ; s++)
-						{
-							c[s] += sizeof(size_t);
-						}
-					}
-				}
-			}
+								if (Vc::Vector<prop_type>::Size == 2)
+								{
+									mxm.i = *(short int *)&mask.mask[s2];
+									mxm.i = mxm.i << 8;
+									mxm.i |= (short int)mask.mask[sumxm];
 
-			for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
-			{
-				for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
-				{
-					int cc = it.LinB(it.start_b(0),j,k);
-					int c[N];
+									mxp.i = *(short int *)&mask.mask[s2];
+									mxp.i = mxp.i >> 8;
+									mxp.i |= ((short int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
 
-					int cd = it.LinB_off(it.start_b(0),j,k);
+									mym.i = *(short int *)&mask.mask[sumym];
+									myp.i = *(short int *)&mask.mask[sumyp];
 
-					for (int s = 0 ; s < N ; s++)
-					{
-						c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
-					}
+									mzm.i = *(short int *)&mask.mask[sumzm];
+									mzp.i = *(short int *)&mask.mask[sumzp];
+								}
+								else if (Vc::Vector<prop_type>::Size == 4)
+								{
+									mxm.i = *(int *)&mask.mask[s2];
+									mxm.i = mxm.i << 8;
+									mxm.i |= (int)mask.mask[sumxm];
 
-					for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
-					{
-						Vc::Mask<prop_type> cmp;
+									mxp.i = *(int *)&mask.mask[s2];
+									mxp.i = mxp.i >> 8;
+									mxp.i |= ((int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
 
-						for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
-						{
-							cmp[s] = (mask[cc+s] == true);
-						}
+									mym.i = *(int *)&mask.mask[sumym];
+									myp.i = *(int *)&mask.mask[sumyp];
 
-						// we do only id exist the point
-						if (Vc::none_of(cmp) == true) {continue;}
+									mzm.i = *(int *)&mask.mask[sumzm];
+									mzp.i = *(int *)&mask.mask[sumzp];
+								}
+								else
+								{
+									std::cout << __FILE__ << ":" << __LINE__ << " UNSUPPORTED" << std::endl;
+								}
 
-						Vc::Mask<prop_type> surround;
+								cs.xm = cmd;
+								cs.xm = cs.xm.shifted(-1);
+								cs.xm[0] = chunk.template get<prop_src>()[sumxm];
 
-						Vc::Vector<prop_type> xs1[N+1];
-						Vc::Vector<prop_type> xs2[N+1];
 
-						xs1[0] = Vc::Vector<prop_type>(&block_bord_src1[cc],Vc::Unaligned);
-						xs2[0] = Vc::Vector<prop_type>(&block_bord_src2[cc],Vc::Unaligned);
+								cs.xp = cmd;
+								cs.xp = cs.xp.shifted(1);
+								cs.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src>()[sumxp];
 
-						for (int s = 1 ; s < N+1 ; s++)
-						{
-							xs1[s] = Vc::Vector<prop_type>(&block_bord_src1[c[s-1]],Vc::Unaligned);
-							xs2[s] = Vc::Vector<prop_type>(&block_bord_src2[c[s-1]],Vc::Unaligned);
-						}
+								// Load y and z direction
 
-						Vc::Vector<prop_type> vo1;
-						Vc::Vector<prop_type> vo2;
+								cs.ym.load(&chunk.template get<prop_src>()[sumym],Vc::Aligned);
+								cs.yp.load(&chunk.template get<prop_src>()[sumyp],Vc::Aligned);
+								cs.zm.load(&chunk.template get<prop_src>()[sumzm],Vc::Aligned);
+								cs.zp.load(&chunk.template get<prop_src>()[sumzp],Vc::Aligned);
 
-						func(vo1, vo2, xs1, xs2, &mask_sum[cc], args ...);
+								// Calculate
 
-						vo1.store(&block_bord_dst1[cd],cmp,Vc::Unaligned);
-						vo2.store(&block_bord_dst2[cd],cmp,Vc::Unaligned);
+								data_il<Vc::Vector<prop_type>::Size> tot_m;
+								tot_m.i = mxm.i + mxp.i + mym.i + myp.i + mzm.i + mzp.i;
 
-						cc += Vc::Vector<prop_type>::Size;
-						for (int s = 0 ; s < N ; s++)
-						{
-							c[s] += Vc::Vector<prop_type>::Size;
+								Vc::Vector<prop_type> res = func(cmd,cs,tot_m.uc,args ... );
+
+								Vc::Mask<prop_type> m(&mask_row[k]);
+
+								res.store(&chunk.template get<prop_dst>()[s2],m,Vc::Aligned);
+
+								s2 += Vc::Vector<prop_type>::Size;
+							}
 						}
-						cd += Vc::Vector<prop_type>::Size;
 					}
+
+					++it;
 				}
 			}
-
-			it.template storeBlock<prop_dst1>(block_bord_dst1);
-			it.template storeBlock<prop_dst2>(block_bord_dst2);
-
-			++it;
-		}
+		});
 	}
 
-	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
-	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+
+	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
+			 unsigned int prop_dst1, unsigned int prop_dst2,
+			 unsigned int stencil_size , unsigned int N,
+			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv2(int (& stencil)[N][3], grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
 	{
-		auto it = grid.template getBlockIterator<stencil_size>(start,stop);
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-		auto & datas = grid.private_get_data();
-		auto & headers = grid.private_get_header_mask();
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_dst1 == prop_src1 || prop_dst1 == prop_src2 || prop_dst2 == prop_src1 || prop_dst2 == prop_src2,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<stencil_size>(start,stop);
 
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
-		typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
 
-		typedef typename SparseGridType::chunking_type chunking;
+			unsigned char mask[decltype(it)::sizeBlockBord];
+			unsigned char mask_sum[decltype(it)::sizeBlockBord];
+			unsigned char mask_unused[decltype(it)::sizeBlock];
+			__attribute__ ((aligned (64))) prop_type block_bord_src1[decltype(it)::sizeBlockBord];
+			__attribute__ ((aligned (64))) prop_type block_bord_dst1[decltype(it)::sizeBlock+16];
+			__attribute__ ((aligned (64))) prop_type block_bord_src2[decltype(it)::sizeBlockBord];
+			__attribute__ ((aligned (64))) prop_type block_bord_dst2[decltype(it)::sizeBlock+16];
 
-		typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
 
-		while (it.isNext())
-		{
-			// Load
-			long int offset_jump[6];
+			size_t c_start;
+			size_t c_stop;
 
-			size_t cid = it.getChunkId();
+			while (next(c_start,c_stop))
+			{
+				it.setChunkRange(c_start,c_stop);
 
-			auto chunk = datas.get(cid);
-			auto & mask = headers.get(cid);
+				while (it.isNext())
+				{
+					it.template loadBlockBorder<prop_src1,NNType,findNN>(block_bord_src1,mask);
+					it.template loadBlockBorder<prop_src2,NNType,findNN>(block_bord_src2,mask);
 
-			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
-			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
+					if (it.start_b(2) != stencil_size || it.start_b(1) != stencil_size || it.start_b(0) != stencil_size ||
+					    it.stop_b(2) != sz2::value+stencil_size || it.stop_b(1) != sz1::value+stencil_size || it.stop_b(0) != sz0::value+stencil_size)
+					{
+						loadBlock_impl<prop_dst1,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst1,grid,it.getChunkId(),mask_unused);
+						loadBlock_impl<prop_dst2,0,3,typename decltype(it)::vector_blocks_exts_type, typename decltype(it)::vector_ext_type>::template loadBlock<decltype(it)::sizeBlock>(block_bord_dst2,grid,it.getChunkId(),mask_unused);
+					}
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
+					// Sum the mask
+					for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+					{
+						for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
+						{
+							int cc = it.LinB(it.start_b(0),j,k);
+							int c[N];
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
+							for (int s = 0 ; s < N ; s++)
+							{
+								c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+							}
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
+							for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += sizeof(size_t))
+							{
+								size_t cmd = *(size_t *)&mask[cc];
+
+								if (cmd != 0)
+								{
+									size_t xm[N];
+
+									for (int s = 0 ; s < N ; s++)
+									{
+										xm[s] = *(size_t *)&mask[c[s]];
+									}
+
+									size_t sum = 0;
+									for (int s = 0 ; s < N ; s++)
+									{
+										sum += xm[s];
+									}
+
+									*(size_t *)&mask_sum[cc] = sum;
+								}
+
+								cc += sizeof(size_t);
+								for (int s = 0 ; s < N ; s++)
+								{
+									c[s] += sizeof(size_t);
+								}
+							}
+						}
+					}
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
-			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
+					for (int k = it.start_b(2) ; k < it.stop_b(2) ; k++)
+					{
+						for (int j = it.start_b(1) ; j < it.stop_b(1) ; j++)
+						{
+							int cc = it.LinB(it.start_b(0),j,k);
+							int c[N];
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
-			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
+							int cd = it.LinB_off(it.start_b(0),j,k);
 
-			// Load offset jumps
+							for (int s = 0 ; s < N ; s++)
+							{
+								c[s] = it.LinB(it.start_b(0)+stencil[s][0],j+stencil[s][1],k+stencil[s][2]);
+							}
 
-			// construct a row mask
+							for (int i = it.start_b(0) ; i < it.stop_b(0) ; i += Vc::Vector<prop_type>::Size)
+							{
+								Vc::Mask<prop_type> cmp;
 
-			long int s2 = 0;
+								for (int s = 0 ; s < Vc::Vector<prop_type>::Size ; s++)
+								{
+									cmp[s] = (mask[cc+s] == true && i+s < it.stop_b(0));
+								}
 
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<2>>::type sz;
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<1>>::type sy;
-			typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<0>>::type sx;
+								// we do only id exist the point
+								if (Vc::none_of(cmp) == false)
+								{
+									Vc::Mask<prop_type> surround;
 
+									Vc::Vector<prop_type> xs1[N+1];
+									Vc::Vector<prop_type> xs2[N+1];
 
-			bool mask_row[sx::value];
+									xs1[0] = Vc::Vector<prop_type>(&block_bord_src1[cc],Vc::Unaligned);
+									xs2[0] = Vc::Vector<prop_type>(&block_bord_src2[cc],Vc::Unaligned);
 
-			for (int k = 0 ; k < sx::value ; k++)
-			{
-				mask_row[k] = (k >= it.start(0) && k < it.stop(0))?true:false;
-			}
+									for (int s = 1 ; s < N+1 ; s++)
+									{
+										xs1[s] = Vc::Vector<prop_type>(&block_bord_src1[c[s-1]],Vc::Unaligned);
+										xs2[s] = Vc::Vector<prop_type>(&block_bord_src2[c[s-1]],Vc::Unaligned);
+									}
 
-			for (int v = it.start(2) ; v < it.stop(2) ; v++)
-			{
-				for (int j = it.start(1) ; j < it.stop(1) ; j++)
-				{
-					s2 = it.Lin(0,j,v);
-					for (int k = 0 ; k < sx::value ; k += Vc::Vector<prop_type>::Size)
-					{
-						// we do only id exist the point
-						if (*(int *)&mask.mask[s2] == 0) {s2 += Vc::Vector<prop_type>::Size; continue;}
+									Vc::Vector<prop_type> vo1;
+									Vc::Vector<prop_type> vo2;
 
-						data_il<4> mxm;
-						data_il<4> mxp;
-						data_il<4> mym;
-						data_il<4> myp;
-						data_il<4> mzm;
-						data_il<4> mzp;
+									func(vo1, vo2, xs1, xs2, &mask_sum[cc], args ...);
 
-						cross_stencil_v cs1;
-						cross_stencil_v cs2;
+									vo1.store(&block_bord_dst1[cd],cmp,Vc::Unaligned);
+									vo2.store(&block_bord_dst2[cd],cmp,Vc::Unaligned);
+								}
 
-						Vc::Vector<prop_type> cmd1(&chunk.template get<prop_src1>()[s2]);
-						Vc::Vector<prop_type> cmd2(&chunk.template get<prop_src2>()[s2]);
+								cc += Vc::Vector<prop_type>::Size;
+								for (int s = 0 ; s < N ; s++)
+								{
+									c[s] += Vc::Vector<prop_type>::Size;
+								}
+								cd += Vc::Vector<prop_type>::Size;
+							}
+						}
+					}
 
-						// Load x-1
-						long int sumxm = s2-1;
-						sumxm += (k==0)?offset_jump[0] + sx::value:0;
+					it.template storeBlock<prop_dst1>(block_bord_dst1);
+					it.template storeBlock<prop_dst2>(block_bord_dst2);
 
-						// Load x+1
-						long int sumxp = s2+Vc::Vector<prop_type>::Size;
-						sumxp += (k+Vc::Vector<prop_type>::Size == sx::value)?offset_jump[1] - sx::value:0;
-
-						long int sumym = (j == 0)?offset_jump[2] + (sy::value-1)*sx::value:-sx::value;
-						sumym += s2;
-						long int sumyp = (j == sy::value-1)?offset_jump[3] - (sy::value - 1)*sx::value:sx::value;
-						sumyp += s2;
-						long int sumzm = (v == 0)?offset_jump[4] + (sz::value-1)*sx::value*sy::value:-sx::value*sy::value;
-						sumzm += s2;
-						long int sumzp = (v == sz::value-1)?offset_jump[5] - (sz::value - 1)*sx::value*sy::value:sx::value*sy::value;
-						sumzp += s2;
-
-						if (Vc::Vector<prop_type>::Size == 2)
-						{
-							mxm.i = *(short int *)&mask.mask[s2];
-							mxm.i = mxm.i << 8;
-							mxm.i |= (short int)mask.mask[sumxm];
+					++it;
+				}
+			}
+		});
+	}
 
-							mxp.i = *(short int *)&mask.mask[s2];
-							mxp.i = mxp.i >> 8;
-							mxp.i |= ((short int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross2(grid_key_dx<3> & start, grid_key_dx<3> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		size_t n_chunks = grid.private_get_header_inf().size();
 
-							mym.i = *(short int *)&mask.mask[sumym];
-							myp.i = *(short int *)&mask.mask[sumyp];
+		openfpm::parallel_for_dynamic(1,n_chunks,conv_grain(findNN,prop_dst1 == prop_src1 || prop_dst1 == prop_src2 || prop_dst2 == prop_src1 || prop_dst2 == prop_src2,n_chunks),[&](auto & next)
+		{
+			auto it = grid.template getBlockIterator<stencil_size>(start,stop);
 
-							mzm.i = *(short int *)&mask.mask[sumzm];
-							mzp.i = *(short int *)&mask.mask[sumzp];
-						}
-						else if (Vc::Vector<prop_type>::Size == 4)
-						{
-							mxm.i = *(int *)&mask.mask[s2];
-							mxm.i = mxm.i << 8;
-							mxm.i |= (int)mask.mask[sumxm];
+			auto & datas = grid.private_get_data();
+			auto & headers = grid.private_get_header_mask();
 
-							mxp.i = *(int *)&mask.mask[s2];
-							mxp.i = mxp.i >> 8;
-							mxp.i |= ((int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<0>>::type sz0;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<1>>::type sz1;
+			typedef typename boost::mpl::at<typename decltype(it)::stop_border_vmpl,boost::mpl::int_<2>>::type sz2;
 
-							mym.i = *(int *)&mask.mask[sumym];
-							myp.i = *(int *)&mask.mask[sumyp];
+			typedef typename SparseGridType::chunking_type chunking;
 
-							mzm.i = *(int *)&mask.mask[sumzm];
-							mzp.i = *(int *)&mask.mask[sumzp];
-						}
-						else
-						{
-							std::cout << __FILE__ << ":" << __LINE__ << " UNSUPPORTED" << std::endl;
-						}
+			typedef typename boost::mpl::at<typename SparseGridType::value_type::type, boost::mpl::int_<prop_src1>>::type prop_type;
 
-						cs1.xm = cmd1;
-						cs1.xm = cs1.xm.shifted(-1);
-						cs1.xm[0] = chunk.template get<prop_src1>()[sumxm];
+			size_t c_start;
+			size_t c_stop;
 
-						cs2.xm = cmd2;
-						cs2.xm = cs2.xm.shifted(-1);
-						cs2.xm[0] = chunk.template get<prop_src2>()[sumxm];
+			while (next(c_start,c_stop))
+			{
+				it.setChunkRange(c_start,c_stop);
 
-						cs1.xp = cmd1;
-						cs1.xp = cs1.xp.shifted(1);
-						cs1.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src1>()[sumxp];
+				while (it.isNext())
+				{
+					// Load
+					long int offset_jump[6];
 
-						cs2.xp = cmd2;
-						cs2.xp = cs2.xp.shifted(1);
-						cs2.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src2>()[sumxp];
+					size_t cid = it.getChunkId();
 
-						// Load y and z direction
+					auto chunk = datas.get(cid);
+					auto & mask = headers.get(cid);
 
-						cs1.ym.load(&chunk.template get<prop_src1>()[sumym],Vc::Aligned);
-						cs1.yp.load(&chunk.template get<prop_src1>()[sumyp],Vc::Aligned);
-						cs1.zm.load(&chunk.template get<prop_src1>()[sumzm],Vc::Aligned);
-						cs1.zp.load(&chunk.template get<prop_src1>()[sumzp],Vc::Aligned);
+					load_offset_jump<findNN,decltype(it)::sizeBlock>(grid,cid,offset_jump);
 
-						cs2.ym.load(&chunk.template get<prop_src2>()[sumym],Vc::Aligned);
-						cs2.yp.load(&chunk.template get<prop_src2>()[sumyp],Vc::Aligned);
-						cs2.zm.load(&chunk.template get<prop_src2>()[sumzm],Vc::Aligned);
-						cs2.zp.load(&chunk.template get<prop_src2>()[sumzp],Vc::Aligned);
+					// Load offset jumps
 
-						// Calculate
+					// construct a row mask
 
-						data_il<4> tot_m;
-						tot_m.i = mxm.i + mxp.i + mym.i + myp.i + mzm.i + mzp.i;
+					long int s2 = 0;
 
-						Vc::Vector<prop_type> res1;
-						Vc::Vector<prop_type> res2;
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<2>>::type sz;
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<1>>::type sy;
+					typedef typename boost::mpl::at<typename chunking::type,boost::mpl::int_<0>>::type sx;
 
-						func(res1,res2,cmd1,cmd2,cs1,cs2,tot_m.uc,args ... );
 
-						Vc::Mask<prop_type> m(&mask_row[k]);
+					bool mask_row[sx::value];
 
-						res1.store(&chunk.template get<prop_dst1>()[s2],m,Vc::Aligned);
-						res2.store(&chunk.template get<prop_dst2>()[s2],m,Vc::Aligned);
+					for (int k = 0 ; k < sx::value ; k++)
+					{
+						mask_row[k] = (k >= it.start(0) && k < it.stop(0))?true:false;
+					}
 
-						s2 += Vc::Vector<prop_type>::Size;
+					for (int v = it.start(2) ; v < it.stop(2) ; v++)
+					{
+						for (int j = it.start(1) ; j < it.stop(1) ; j++)
+						{
+							s2 = it.Lin(0,j,v);
+							for (int k = 0 ; k < sx::value ; k += Vc::Vector<prop_type>::Size)
+							{
+								// we do only id exist the point
+								if (*(int *)&mask.mask[s2] == 0) {s2 += Vc::Vector<prop_type>::Size; continue;}
+
+								data_il<4> mxm;
+								data_il<4> mxp;
+								data_il<4> mym;
+								data_il<4> myp;
+								data_il<4> mzm;
+								data_il<4> mzp;
+
+								cross_stencil_v cs1;
+								cross_stencil_v cs2;
+
+								Vc::Vector<prop_type> cmd1(&chunk.template get<prop_src1>()[s2]);
+								Vc::Vector<prop_type> cmd2(&chunk.template get<prop_src2>()[s2]);
+
+								// Load x-1
+								long int sumxm = s2-1;
+								sumxm += (k==0)?offset_jump[0] + sx::value:0;
+
+								// Load x+1
+								long int sumxp = s2+Vc::Vector<prop_type>::Size;
+								sumxp += (k+Vc::Vector<prop_type>::Size == sx::value)?offset_jump[1] - sx::value:0;
+
+								long int sumym = (j == 0)?offset_jump[2] + (sy::value-1)*sx::value:-sx::value;
+								sumym += s2;
+								long int sumyp = (j == sy::value-1)?offset_jump[3] - (sy::value - 1)*sx::value:sx::value;
+								sumyp += s2;
+								long int sumzm = (v == 0)?offset_jump[4] + (sz::value-1)*sx::value*sy::value:-sx::value*sy::value;
+								sumzm += s2;
+								long int sumzp = (v == sz::value-1)?offset_jump[5] - (sz::value - 1)*sx::value*sy::value:sx::value*sy::value;
+								sumzp += s2;
+
+								if (Vc::Vector<prop_type>::Size == 2)
+								{
+									mxm.i = *(short int *)&mask.mask[s2];
+									mxm.i = mxm.i << 8;
+									mxm.i |= (short int)mask.mask[sumxm];
+
+									mxp.i = *(short int *)&mask.mask[s2];
+									mxp.i = mxp.i >> 8;
+									mxp.i |= ((short int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+
+									mym.i = *(short int *)&mask.mask[sumym];
+									myp.i = *(short int *)&mask.mask[sumyp];
+
+									mzm.i = *(short int *)&mask.mask[sumzm];
+									mzp.i = *(short int *)&mask.mask[sumzp];
+								}
+								else if (Vc::Vector<prop_type>::Size == 4)
+								{
+									mxm.i = *(int *)&mask.mask[s2];
+									mxm.i = mxm.i << 8;
+									mxm.i |= (int)mask.mask[sumxm];
+
+									mxp.i = *(int *)&mask.mask[s2];
+									mxp.i = mxp.i >> 8;
+									mxp.i |= ((int)mask.mask[sumxp]) << (Vc::Vector<prop_type>::Size - 1)*8;
+
+									mym.i = *(int *)&mask.mask[sumym];
+									myp.i = *(int *)&mask.mask[sumyp];
+
+									mzm.i = *(int *)&mask.mask[sumzm];
+									mzp.i = *(int *)&mask.mask[sumzp];
+								}
+								else
+								{
+									std::cout << __FILE__ << ":" << __LINE__ << " UNSUPPORTED" << std::endl;
+								}
+
+								cs1.xm = cmd1;
+								cs1.xm = cs1.xm.shifted(-1);
+								cs1.xm[0] = chunk.template get<prop_src1>()[sumxm];
+
+								cs2.xm = cmd2;
+								cs2.xm = cs2.xm.shifted(-1);
+								cs2.xm[0] = chunk.template get<prop_src2>()[sumxm];
+
+								cs1.xp = cmd1;
+								cs1.xp = cs1.xp.shifted(1);
+								cs1.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src1>()[sumxp];
+
+								cs2.xp = cmd2;
+								cs2.xp = cs2.xp.shifted(1);
+								cs2.xp[Vc::Vector<prop_type>::Size - 1] = chunk.template get<prop_src2>()[sumxp];
+
+								// Load y and z direction
+
+								cs1.ym.load(&chunk.template get<prop_src1>()[sumym],Vc::Aligned);
+								cs1.yp.load(&chunk.template get<prop_src1>()[sumyp],Vc::Aligned);
+								cs1.zm.load(&chunk.template get<prop_src1>()[sumzm],Vc::Aligned);
+								cs1.zp.load(&chunk.template get<prop_src1>()[sumzp],Vc::Aligned);
+
+								cs2.ym.load(&chunk.template get<prop_src2>()[sumym],Vc::Aligned);
+								cs2.yp.load(&chunk.template get<prop_src2>()[sumyp],Vc::Aligned);
+								cs2.zm.load(&chunk.template get<prop_src2>()[sumzm],Vc::Aligned);
+								cs2.zp.load(&chunk.template get<prop_src2>()[sumzp],Vc::Aligned);
+
+								// Calculate
+
+								data_il<4> tot_m;
+								tot_m.i = mxm.i + mxp.i + mym.i + myp.i + mzm.i + mzp.i;
+
+								Vc::Vector<prop_type> res1;
+								Vc::Vector<prop_type> res2;
+
+								func(res1,res2,cmd1,cmd2,cs1,cs2,tot_m.uc,args ... );
+
+								Vc::Mask<prop_type> m(&mask_row[k]);
+
+								res1.store(&chunk.template get<prop_dst1>()[s2],m,Vc::Aligned);
+								res2.store(&chunk.template get<prop_dst2>()[s2],m,Vc::Aligned);
+
+								s2 += Vc::Vector<prop_type>::Size;
+							}
+						}
 					}
+
+					++it;
 				}
 			}
-
-			++it;
-		}
+		});
 	}
 
 	template<bool findNN, unsigned int stencil_size, typename prop_type, typename SparseGridType, typename lambda_f, typename ... ArgsT >
@@ -882,30 +1281,7 @@ struct conv_impl<3>
 			auto chunk = datas.get(cid);
 			auto & mask = headers.get(cid);
 
-			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
-			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
-
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
-
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
-
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
-			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
-
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
-			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
-
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
-			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
+			load_offset_jump<findNN,decltype(it)::sizeBlock>(grid,cid,offset_jump);
 
 			// Load offset jumps
 
@@ -1017,6 +1393,39 @@ struct conv_impl<3>
 
 };
 
+#else
+
+template<unsigned int dim>
+struct conv_impl
+{
+	template<bool findNN, typename NNtype, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size , unsigned int N, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv is unsupported when compiled on NVCC " << std::endl;
+	}
+
+	template<bool findNN, unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross is unsupported when compiled on NVCC " << std::endl;
+	}
+
+	template<bool findNN, typename NNType, unsigned int prop_src1, unsigned int prop_src2,
+			 unsigned int prop_dst1, unsigned int prop_dst2,
+			 unsigned int stencil_size , unsigned int N,
+			 typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv2(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv2 is unsupported when compiled on NVCC " << std::endl;
+	}
+
+	template<bool findNN, unsigned int prop_src1, unsigned int prop_src2, unsigned int prop_dst1, unsigned int prop_dst2, unsigned int stencil_size, typename SparseGridType, typename lambda_f, typename ... ArgsT >
+	static void conv_cross2(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, SparseGridType & grid , lambda_f func, ArgsT ... args)
+	{
+		std::cout << __FILE__ << ":" << __LINE__ << " error conv_cross2 is unsupported when compiled on NVCC " << std::endl;
+	}
+};
+
 #endif
 
 
@@ -100,42 +100,16 @@ template<unsigned int prop, unsigned int stencil_size, unsigned int dim, typenam
 struct loadBlock_impl
 {
 	template<unsigned int N1, typename T, typename SparseGridType>
-	static void loadBlock(T arr[N1], SparseGridType & sgt, int chunk_id, unsigned char mask[N1])
+	inline static void loadBlock(T arr[N1], SparseGridType & sgt, int chunk_id, unsigned char mask[N1])
 	{
-		get_block_sizes<dim,stencil_size,vector_blocks_exts,vector_ext> gbs;
-
-		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,dim> >(gbs);
-
-		grid_sm<dim,void> g_block(gbs.sz_ext);
-		grid_sm<dim,void> g_in_block(gbs.sz_block);
-		grid_sm<dim,void> g_block_arr(gbs.sz_tot);
-;
-		grid_key_dx_iterator<dim> it_in_block(g_in_block);
-
 		auto & data = sgt.private_get_data();
 		auto & header_mask = sgt.private_get_header_mask();
 
 		auto & h = header_mask.get(chunk_id);
 
-		auto & ref_block = data.template get<prop>(chunk_id);
-
-		while(it_in_block.isNext())
-		{
-			auto p = it_in_block.get();
-
-			grid_key_dx<dim> arr_p;
-
-			for (int i = 0 ; i < dim ; i++)
-			{arr_p.set_d(i,p.get(i)+stencil_size);}
-
-			size_t id = g_block_arr.LinId(arr_p);
-			size_t idi = g_in_block.LinId(p);
-
-			arr[id] = ref_block[idi];
-			mask[id] = exist_sub(h,idi);
+		auto & chunk = data.template get<prop>(chunk_id);
 
-			++it_in_block;
-		}
+		copy_xyz_nd<dim,stencil_size,typename vector_blocks_exts::type>::template copy<N1>(arr,mask,h,chunk);
 	}
 
 	template<unsigned int N1, typename T, typename SparseGridType>
@@ -172,40 +146,23 @@ struct loadBlock_impl
 	}
 
 	template<unsigned int N1, typename T, typename SparseGridType>
-	static void storeBlock(T arr[N1], SparseGridType & sgt, int chunk_id)
+	inline static void storeBlock(T arr[N1], SparseGridType & sgt, int chunk_id)
 	{
-		get_block_sizes<dim,stencil_size,vector_blocks_exts,vector_ext> gbs;
-
-		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,dim> >(gbs);
-
-		grid_sm<dim,void> g_block(gbs.sz_ext);
-		grid_sm<dim,void> g_in_block(gbs.sz_block);
-		grid_sm<dim,void> g_block_arr(gbs.sz_tot);
-
-		grid_key_dx_iterator<dim> it_in_block(g_in_block);
-
 		auto & data = sgt.private_get_data();
-		auto & header_mask = sgt.private_get_header_mask();
-
-		auto & ref_block = data.template get<prop>(chunk_id);
 
-		while(it_in_block.isNext())
-		{
-			auto p = it_in_block.get();
-
-			ref_block[g_in_block.LinId(p)] = arr[g_in_block.LinId(p)];
+		auto & chunk = data.template get<prop>(chunk_id);
 
-			++it_in_block;
-		}
+		copy_xyz_nd<dim,stencil_size,typename vector_blocks_exts::type>::template store<N1>(arr,chunk);
 	}
 
 
 	/*! \brief load the border
 	 *
-	 *
+	 * The neighborhood chunks are searched with findChunk (without passing from the cache of the
+	 * sparse grid), so several iterators can load their borders concurrently
 	 *
 	 */
-	template<unsigned int N1, typename T, typename SparseGridType>
+	template<bool findNN, typename NNType, unsigned int N1, typename T, typename SparseGridType>
 	static void loadBorder(T arr[N1],
 			         SparseGridType & sgt,
 			         size_t chunk_id,
@@ -222,7 +179,6 @@ struct loadBlock_impl
 		auto & header_mask = sgt.private_get_header_mask();
 		auto & header_inf = sgt.private_get_header_inf();
 
-		auto & hm = header_mask.get(chunk_id);
 		auto & hc = header_inf.get(chunk_id);
 
 		maps_blk.resize(block_skin.size());
@@ -234,7 +190,8 @@ struct loadBlock_impl
 			for (int j = 0 ; j < dim ; j++)
 			{p.set_d(j,block_skin.get(i).get(j) + hc.pos.get(j) / size::data[j] - 1);}
 
-			maps_blk.get(i) = sgt.getChunk(p);
+			bool exist;
+			maps_blk.get(i) = sgt.findChunk(p,exist);
 		}
 
 		for (int i = 0 ; i < bord.size(); i++)
@@ -244,10 +201,8 @@ struct loadBlock_impl
 			size_t b = bord.get(i);
 			size_t off = offsets.template get<0>(i);
 
-			auto & h = header_mask.get(ac);
-
-			arr[b] = (ac == data.size()-1)?data.template get<prop>(0)[off]:data.template get<prop>(ac)[off];
-			mask[b] = (ac == data.size()-1)?0:exist_sub(h,off);
+			arr[b] = data.template get<prop>(ac)[off];
+			mask[b] = exist_sub(header_mask.get(ac),off);
 		}
 	}
 };
@@ -469,6 +424,9 @@ class grid_key_sparse_dx_iterator_block_sub
 	//! point to the actual chunk
 	size_t chunk_id;
 
+	//! one past the last chunk to iterate
+	size_t chunk_stop;
+
 	//! Starting point
 	grid_key_dx<dim> start_;
 
@@ -509,7 +467,7 @@ class grid_key_sparse_dx_iterator_block_sub
 		auto & header = spg.private_get_header_inf();
 		auto & header_mask = spg.private_get_header_mask();
 
-		while (chunk_id < header.size())
+		while (chunk_id < chunk_stop)
 		{
 			auto & mask = header_mask.get(chunk_id).mask;
 
@@ -555,7 +513,7 @@ public:
 	grid_key_sparse_dx_iterator_block_sub(SparseGridType & spg,
 								const grid_key_dx<dim> & start,
 								const grid_key_dx<dim> & stop)
-	:spg(spg),chunk_id(1),
+	:spg(spg),chunk_id(1),chunk_stop(spg.private_get_header_inf().size()),
 	 start_(start),stop_(stop)
 	{
 		// Create border coeficents
@@ -566,22 +524,22 @@ public:
 		Box<dim,int> skinb;
 		Box<dim,int> skinbb;
 
-		size_t bc[dim];
+		size_t sz_b[dim];
 		for (int i = 0 ; i < dim ; i ++)
 		{
-			skinb.setLow(i,0);
-			skinb.setHigh(i,gbs.sz_tot[i]-1);
-			skinbb.setLow(i,0);
-			skinbb.setHigh(i,gbs.sz_ext_b[i]-1);
-			bc[i] = NON_PERIODIC;
+			skinb.setLow(i,stencil_size);
+			skinb.setHigh(i,gbs.sz_tot[i]-stencil_size-1);
+			skinbb.setLow(i,1);
+			skinbb.setHigh(i,1);
+			sz_b[i] = 3;
 		}
 
-		grid_sm<dim,void> g_smb(gbs.sz_ext_b);
+		grid_sm<dim,void> g_smb(sz_b);
 
-		// Create block skin index
+		// Create block skin index (all the neighborhood chunks)
 
 		openfpm::vector<unsigned int> b_map;
-		grid_skin_iterator_bc<3> gsi_b(g_smb,skinbb,skinbb,bc);
+		grid_key_dx_iterator<dim> gsi_b(g_smb);
 
 		b_map.resize(g_smb.size());
 
@@ -589,20 +547,31 @@ public:
 		{
 			auto p = gsi_b.get();
 
-			block_skin.add(p);
+			if (skinbb.isInsideKey(p) == false)
+			{
+				block_skin.add(p);
 
-			b_map.get(g_smb.LinId(p)) = block_skin.size() - 1;
+				b_map.get(g_smb.LinId(p)) = block_skin.size() - 1;
+			}
 
 			++gsi_b;
 		}
 
+		// Create the border (all the points of the block with border that are not in the chunk)
+
 		grid_sm<dim,void> g_sm(gbs.sz_tot);
-		grid_skin_iterator_bc<3> gsi(g_sm,skinb,skinb,bc);
+		grid_key_dx_iterator<dim> gsi(g_sm);
 
 		while (gsi.isNext())
 		{
 			auto p = gsi.get();
 
+			if (skinb.isInsideKey(p) == true)
+			{
+				++gsi;
+				continue;
+			}
+
 			grid_key_dx<dim> sh;
 
 			bord.add(g_sm.LinId(p));
@@ -611,11 +580,10 @@ public:
 			int stride = 1;
 			for (int i = 0 ; i < dim ; i++)
 			{
-
 				if (p.get(i) < stencil_size)
-				{offset += (gbs.sz_block[i]-1)*stride;}
-				else if (p.get(i) >= gbs.sz_tot[i] - stencil_size)
-				{offset += 0;}
+				{offset += (p.get(i) - stencil_size + gbs.sz_block[i])*stride;}
+				else if (p.get(i) >= gbs.sz_block[i] + stencil_size)
+				{offset += (p.get(i) - stencil_size - gbs.sz_block[i])*stride;}
 				else
 				{offset += (p.get(i)-stencil_size)*stride;}
 
@@ -652,18 +620,35 @@ public:
 	{
 		spg = g_s_it.spg;
 		chunk_id = g_s_it.chunk_id;
+		chunk_stop = spg.private_get_header_inf().size();
 		start_ = g_s_it.start_;
 		stop_ = g_s_it.stop_;
 		bx = g_s_it.bx;
 	}
 
-	inline grid_key_sparse_dx_iterator_block_sub<dim,stencil_size,SparseGridType,vector_blocks_exts> & operator++()
+	/*! \brief Restrict the iteration to the chunks in [c_start,c_stop)
+	 *
+	 * It is used to split the iteration across threads, each thread iterate its own range of chunks
+	 *
+	 * \param c_start first chunk
+	 * \param c_stop one past the last chunk
+	 *
+	 */
+	inline void setChunkRange(size_t c_start, size_t c_stop)
 	{
 		auto & header = spg.private_get_header_inf();
 
+		chunk_id = c_start;
+		chunk_stop = (c_stop < header.size())?c_stop:header.size();
+
+		SelectValid();
+	}
+
+	inline grid_key_sparse_dx_iterator_block_sub<dim,stencil_size,SparseGridType,vector_blocks_exts> & operator++()
+	{
 		chunk_id++;
 
-		if (chunk_id < header.size())
+		if (chunk_id < chunk_stop)
 		{
 			SelectValid();
 		}
@@ -678,9 +663,7 @@ public:
 	 */
 	bool isNext()
 	{
-		auto & header = spg.private_get_header_inf();
-
-		return chunk_id < header.size();
+		return chunk_id < chunk_stop;
 	}
 
 	/*! \brief Return the starting point for the iteration
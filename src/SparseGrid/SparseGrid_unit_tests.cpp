@@ -11,7 +11,10 @@
 #include <boost/test/unit_test.hpp>
 #include "SparseGrid/SparseGrid.hpp"
 #include "NN/CellList/CellDecomposer.hpp"
+#include "Packer_Unpacker/Packer_container.hpp"
+#include "Packer_Unpacker/Packer_stream.hpp"
 #include <math.h>
+#include <random>
 //#include "util/debug.hpp"
 
 BOOST_AUTO_TEST_SUITE( sparse_grid_test )
@@ -1456,6 +1459,322 @@ BOOST_AUTO_TEST_CASE( sparse_grid_fast_stencil_vectorized_cross_simplified)
 //	print_grid("debug_out",grid);
 }
 
+/*! \brief Fill the grid for the parallel convolution test and run conv, conv_cross, conv2, conv_cross2
+ *
+ * \param grid sparse grid
+ * \param n_threads number of threads
+ *
+ */
+template<typename grid_type>
+void sparse_grid_conv_parallel_run(grid_type & grid, size_t n_threads)
+{
+	size_t sz_cell[3] = {200,200,200};
+
+	CellDecomposer_sm<3, float, shift<3,float>> cdsm;
+
+	Box<3,float> domain({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	cdsm.setDimensions(domain, sz_cell, 0);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid.getBackgroundValue().template get<1>() = 0.0;
+
+	fill_sphere(grid,cdsm);
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		grid.template insert<1>(p) = p.get(0) - 0.5*p.get(1) + 0.25*p.get(2);
+
+		grid.template insert<2>(p) = -1.0;
+		grid.template insert<3>(p) = -1.0;
+		grid.template insert<4>(p) = -1.0;
+		grid.template insert<5>(p) = -1.0;
+		grid.template insert<6>(p) = -1.0;
+		grid.template insert<7>(p) = -1.0;
+
+		++it;
+	}
+
+	// the sub-domain cut the chunks
+
+	grid_key_dx<3> start({3,5,7});
+	grid_key_dx<3> stop({180,170,161});
+
+	int stencil[6][3] = {{1,0,0},{-1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+	openfpm::set_num_threads(n_threads);
+
+	grid.template conv<0,2,1>(stencil,start,stop,[](Vc::double_v (& xs)[7], unsigned char * mask_sum){
+		Vc::double_v Lap = xs[1] + xs[2] + xs[3] + xs[4] + xs[5] + xs[6] - 6.0*xs[0];
+
+		auto surround = load_mask<Vc::double_v>(mask_sum);
+
+		return Vc::iif(surround == 6.0,Lap,Vc::double_v(1.0));
+	});
+
+	grid.template conv_cross<0,3,1>(start,stop,[](Vc::double_v & cmd, cross_stencil_v & s, unsigned char * mask_sum){
+		Vc::double_v Lap = s.xm + 2.0*s.xp + 3.0*s.ym + s.yp + s.zm + s.zp - 6.0*cmd;
+
+		Vc::Mask<double> surround;
+
+		for (int i = 0 ; i < Vc::double_v::Size ; i++)
+		{surround[i] = (mask_sum[i] == 6);}
+
+		return Vc::iif(surround,Lap,Vc::double_v(1.0));
+	});
+
+	// the value of the points that does not exist is undefined, the result is used only when all the neighborhood exist
+
+	grid.template conv2<0,1,4,5,1>(stencil,start,stop,[](Vc::double_v & vo1, Vc::double_v & vo2,
+			                                           Vc::double_v (& xs1)[7], Vc::double_v (& xs2)[7], unsigned char * mask_sum){
+		auto surround = load_mask<Vc::double_v>(mask_sum);
+
+		vo1 = Vc::iif(surround == 6.0,xs1[1] - xs2[2] + xs1[3]*xs2[4] - xs1[0],Vc::double_v(1.0));
+		vo2 = Vc::iif(surround == 6.0,xs2[5] + xs1[6] - 2.0*xs2[0],Vc::double_v(1.0));
+	});
+
+	grid.template conv_cross2<0,1,6,7,1>(start,stop,[](Vc::double_v & vo1, Vc::double_v & vo2, Vc::double_v & c1, Vc::double_v & c2,
+			                                          cross_stencil_v & s1, cross_stencil_v & s2, unsigned char * mask_sum){
+		Vc::Mask<double> surround;
+
+		for (int i = 0 ; i < Vc::double_v::Size ; i++)
+		{surround[i] = (mask_sum[i] == 6);}
+
+		vo1 = Vc::iif(surround,s1.xm + s2.xp + s1.ym + s2.yp + s1.zm + s2.zp - 6.0*c1,Vc::double_v(1.0));
+		vo2 = Vc::iif(surround,s2.xm*s1.zp - c2,Vc::double_v(1.0));
+	});
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_fast_stencil_vectorized_parallel)
+{
+	size_t sz[3] = {201,201,201};
+
+	size_t n_threads = openfpm::get_num_threads();
+
+	sgrid_soa<3,aggregate<double,double,double,double,double,double,double,double>,HeapMemory> grid1(sz);
+	sgrid_soa<3,aggregate<double,double,double,double,double,double,double,double>,HeapMemory> grid4(sz);
+
+	sparse_grid_conv_parallel_run(grid1,1);
+	sparse_grid_conv_parallel_run(grid4,4);
+
+	openfpm::set_num_threads(n_threads);
+
+	size_t cnt = 0;
+	bool match = true;
+
+	auto it = grid1.getIterator();
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid4.existPoint(p);
+
+		match &= grid1.template get<2>(p) == grid4.template get<2>(p);
+		match &= grid1.template get<3>(p) == grid4.template get<3>(p);
+		match &= grid1.template get<4>(p) == grid4.template get<4>(p);
+		match &= grid1.template get<5>(p) == grid4.template get<5>(p);
+		match &= grid1.template get<6>(p) == grid4.template get<6>(p);
+		match &= grid1.template get<7>(p) == grid4.template get<7>(p);
+
+		match &= grid1.template get<2>(p) != -1.0 || p.get(0) < 3 || p.get(0) > 180 ||
+				                                     p.get(1) < 5 || p.get(1) > 170 ||
+				                                     p.get(2) < 7 || p.get(2) > 161;
+
+		cnt++;
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(cnt != 0);
+}
+
+/*! \brief Fill a shell of the grid and run conv and conv2 with a star stencil in dim dimensions
+ *
+ * \param grid sparse grid
+ * \param n_threads number of threads
+ * \param r1 internal radius of the shell
+ * \param r2 external radius of the shell
+ * \param start start point of the convolution
+ * \param stop stop point of the convolution
+ *
+ */
+template<unsigned int dim, typename grid_type>
+void sparse_grid_conv_nd_run(grid_type & grid, size_t n_threads, double r1, double r2, grid_key_dx<dim> & start, grid_key_dx<dim> & stop)
+{
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid.getBackgroundValue().template get<2>() = 0.0;
+
+	size_t sz[dim];
+	for (size_t i = 0 ; i < dim ; i++)
+	{sz[i] = grid.getGrid().size(i);}
+
+	grid_sm<dim,void> g_sm(sz);
+	grid_key_dx_iterator<dim> it(g_sm);
+
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < dim ; i++)
+		{r += (p.get(i) - (double)g_sm.size(i)/2)*(p.get(i) - (double)g_sm.size(i)/2);}
+		r = sqrt(r);
+
+		if (r >= r1 && r <= r2)
+		{
+			grid.template insert<0>(p) = p.get(0) - 0.5*p.get(1) + 0.25*p.get(dim-1)*p.get(0);
+			grid.template insert<1>(p) = -1.0;
+			grid.template insert<2>(p) = 0.1*p.get(0)*p.get(1) + p.get(dim-1);
+			grid.template insert<3>(p) = -1.0;
+			grid.template insert<4>(p) = -1.0;
+		}
+
+		++it;
+	}
+
+	int stencil[2*dim][dim];
+
+	for (size_t i = 0 ; i < 2*dim ; i++)
+	{
+		for (size_t j = 0 ; j < dim ; j++)
+		{stencil[i][j] = (j == i/2)?((i%2 == 0)?1:-1):0;}
+	}
+
+	openfpm::set_num_threads(n_threads);
+
+	grid.template conv<0,1,1>(stencil,start,stop,[](auto & xs, unsigned char * mask_sum){
+		Vc::double_v Lap = xs[1];
+
+		for (size_t s = 2 ; s < 2*dim+1 ; s++)
+		{Lap += xs[s];}
+
+		Lap -= (2.0*dim)*xs[0];
+
+		auto surround = load_mask<Vc::double_v>(mask_sum);
+
+		return Vc::iif(surround == 2.0*dim,Lap,Vc::double_v(1.0));
+	});
+
+	// the value of the points that does not exist is undefined, the result is used only when all the neighborhood exist
+
+	grid.template conv2<0,2,3,4,1>(stencil,start,stop,[](Vc::double_v & vo1, Vc::double_v & vo2,
+			                                           auto & xs1, auto & xs2, unsigned char * mask_sum){
+		auto surround = load_mask<Vc::double_v>(mask_sum);
+
+		vo1 = Vc::iif(surround == 2.0*dim,xs1[1] - xs2[2],Vc::double_v(1.0));
+		vo2 = Vc::iif(surround == 2.0*dim,xs1[3]*xs2[4] - xs2[0],Vc::double_v(1.0));
+	});
+}
+
+/*! \brief Check the result of sparse_grid_conv_nd_run against a point by point calculation
+ *
+ * \param grid sparse grid
+ * \param start start point of the convolution
+ * \param stop stop point of the convolution
+ *
+ * \return true if the result is correct
+ *
+ */
+template<unsigned int dim, typename grid_type>
+bool sparse_grid_conv_nd_check(grid_type & grid, grid_key_dx<dim> & start, grid_key_dx<dim> & stop)
+{
+	bool match = true;
+
+	auto val = [&](grid_key_dx<dim> q, int prp) {
+
+		if (grid.existPoint(q) == false)	{return 0.0;}
+
+		return (prp == 0)?grid.template get<0>(q):grid.template get<2>(q);
+	};
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		bool inside = true;
+		for (size_t i = 0 ; i < dim ; i++)
+		{inside &= (p.get(i) >= start.get(i) && p.get(i) <= stop.get(i));}
+
+		if (inside == false)
+		{
+			match &= grid.template get<1>(p) == -1.0;
+			match &= grid.template get<3>(p) == -1.0;
+			match &= grid.template get<4>(p) == -1.0;
+
+			++it;
+			continue;
+		}
+
+		bool all = true;
+		double Lap = 0.0;
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			all &= grid.existPoint(p.move(i,1));
+			all &= grid.existPoint(p.move(i,-1));
+
+			Lap += val(p.move(i,1),0) + val(p.move(i,-1),0);
+		}
+		Lap -= 2.0*dim*val(p,0);
+
+		double Lap_ref = (all == true)?Lap:1.0;
+		double vo1 = (all == true)?val(p.move(0,1),0) - val(p.move(0,-1),2):1.0;
+		double vo2 = (all == true)?val(p.move(1,1),0)*val(p.move(1,-1),2) - val(p,2):1.0;
+
+		match &= fabs(grid.template get<1>(p) - Lap_ref) <= 1e-9*(1.0 + fabs(Lap_ref));
+		match &= fabs(grid.template get<3>(p) - vo1) <= 1e-9*(1.0 + fabs(vo1));
+		match &= fabs(grid.template get<4>(p) - vo2) <= 1e-9*(1.0 + fabs(vo2));
+
+		++it;
+	}
+
+	return match;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_fast_stencil_vectorized_nd)
+{
+	size_t n_threads = openfpm::get_num_threads();
+
+	// 2D (the sub-domain cut the chunks)
+
+	size_t sz2[2] = {300,300};
+
+	sgrid_soa<2,aggregate<double,double,double,double,double>,HeapMemory> g2_1(sz2);
+	sgrid_soa<2,aggregate<double,double,double,double,double>,HeapMemory> g2_4(sz2);
+
+	grid_key_dx<2> start2({3,5});
+	grid_key_dx<2> stop2({270,261});
+
+	sparse_grid_conv_nd_run<2>(g2_1,1,60.0,120.0,start2,stop2);
+	sparse_grid_conv_nd_run<2>(g2_4,4,60.0,120.0,start2,stop2);
+
+	BOOST_REQUIRE_EQUAL(sparse_grid_conv_nd_check<2>(g2_1,start2,stop2),true);
+	BOOST_REQUIRE_EQUAL(sparse_grid_conv_nd_check<2>(g2_4,start2,stop2),true);
+
+	// 4D
+
+	size_t sz4[4] = {32,32,32,32};
+
+	sgrid_soa<4,aggregate<double,double,double,double,double>,HeapMemory> g4_1(sz4);
+	sgrid_soa<4,aggregate<double,double,double,double,double>,HeapMemory> g4_4(sz4);
+
+	grid_key_dx<4> start4({1,2,3,1});
+	grid_key_dx<4> stop4({29,30,27,28});
+
+	sparse_grid_conv_nd_run<4>(g4_1,1,6.0,12.0,start4,stop4);
+	sparse_grid_conv_nd_run<4>(g4_4,4,6.0,12.0,start4,stop4);
+
+	BOOST_REQUIRE_EQUAL(sparse_grid_conv_nd_check<4>(g4_1,start4,stop4),true);
+	BOOST_REQUIRE_EQUAL(sparse_grid_conv_nd_check<4>(g4_4,start4,stop4),true);
+
+	openfpm::set_num_threads(n_threads);
+}
+
 constexpr int x = 0;
 constexpr int y = 1;
 constexpr int z = 2;
@@ -2144,6 +2463,237 @@ BOOST_AUTO_TEST_CASE( sparse_grid_remove_area)
 	BOOST_REQUIRE_EQUAL(cnt,bx_create.getVolumeKey() - bx_delete.getVolumeKey());
 }
 
+/*! \brief Insert scattered points with insert and with insert_bulk and compare the two grids
+ *
+ * \param grid_s grid filled with insert
+ * \param grid_b grid filled with insert_bulk
+ *
+ * \return true if the two grids are equal
+ *
+ */
+template<typename grid_type>
+bool sparse_grid_insert_bulk_run(grid_type & grid_s, grid_type & grid_b)
+{
+	// some chunks exist before the bulk insert
+
+	for (size_t i = 0 ; i < 20 ; i++)
+	{
+		grid_key_dx<3> p({(long int)(7*i),(long int)(5*i),(long int)(3*i)});
+
+		grid_s.template insert<0>(p) = -1.0;
+		grid_s.template insert<1>(p) = -1;
+		grid_b.template insert<0>(p) = -1.0;
+		grid_b.template insert<1>(p) = -1;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			grid_s.template insert<2>(p)[j] = -1.0;
+			grid_b.template insert<2>(p)[j] = -1.0;
+		}
+	}
+
+	std::default_random_engine eg(1234);
+	std::uniform_int_distribution<int> ud(0,199);
+
+	openfpm::vector<grid_key_dx<3>> keys;
+	openfpm::vector<aggregate<double,int,double[3]>> data;
+
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		grid_key_dx<3> p({ud(eg),ud(eg),ud(eg)});
+
+		keys.add(p);
+		data.add();
+		data.last().template get<0>() = i;
+		data.last().template get<1>() = ud(eg);
+		data.last().template get<2>()[0] = 0.5*i;
+		data.last().template get<2>()[1] = 1.5*i;
+		data.last().template get<2>()[2] = 2.5*i;
+	}
+
+	// repeated points, the last value win
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		grid_key_dx<3> p = keys.get(3*i);
+
+		keys.add(p);
+		data.add();
+		data.last().template get<0>() = -2.0*i;
+		data.last().template get<1>() = -3*i;
+		data.last().template get<2>()[0] = 1.0;
+		data.last().template get<2>()[1] = 2.0;
+		data.last().template get<2>()[2] = 3.0;
+	}
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{
+		grid_s.template insert<0>(keys.get(i)) = data.template get<0>(i);
+		grid_s.template insert<1>(keys.get(i)) = data.template get<1>(i);
+		grid_s.template insert<2>(keys.get(i))[0] = data.template get<2>(i)[0];
+		grid_s.template insert<2>(keys.get(i))[1] = data.template get<2>(i)[1];
+		grid_s.template insert<2>(keys.get(i))[2] = data.template get<2>(i)[2];
+	}
+
+	grid_b.template insert_bulk<0,1,2>(keys,data);
+
+	bool match = true;
+	size_t cnt_s = 0;
+	size_t cnt_b = 0;
+
+	auto it = grid_s.getIterator();
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid_b.existPoint(p);
+		match &= grid_s.template get<0>(p) == grid_b.template get<0>(p);
+		match &= grid_s.template get<1>(p) == grid_b.template get<1>(p);
+		match &= grid_s.template get<2>(p)[0] == grid_b.template get<2>(p)[0];
+		match &= grid_s.template get<2>(p)[1] == grid_b.template get<2>(p)[1];
+		match &= grid_s.template get<2>(p)[2] == grid_b.template get<2>(p)[2];
+
+		cnt_s++;
+		++it;
+	}
+
+	auto it2 = grid_b.getIterator();
+	while (it2.isNext())
+	{
+		cnt_b++;
+		++it2;
+	}
+
+	match &= cnt_s == cnt_b;
+
+	return match;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_insert_bulk)
+{
+	size_t sz[3] = {200,200,200};
+
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	sgrid_cpu<3,aggregate<double,int,double[3]>,HeapMemory> grid_s(sz);
+	sgrid_cpu<3,aggregate<double,int,double[3]>,HeapMemory> grid_b(sz);
+
+	BOOST_REQUIRE_EQUAL(sparse_grid_insert_bulk_run(grid_s,grid_b),true);
+
+	sgrid_soa<3,aggregate<double,int,double[3]>,HeapMemory> grid_s_soa(sz);
+	sgrid_soa<3,aggregate<double,int,double[3]>,HeapMemory> grid_b_soa(sz);
+
+	BOOST_REQUIRE_EQUAL(sparse_grid_insert_bulk_run(grid_s_soa,grid_b_soa),true);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+/*! \brief Deposit particles on the grid with concurrent insertion
+ *
+ * \param grid sparse grid
+ * \param n_threads number of threads
+ *
+ */
+template<typename grid_type>
+void sparse_grid_insert_concurrent_run(grid_type & grid, size_t n_threads)
+{
+	grid.getBackgroundValue().template get<1>() = 0.0;
+
+	for (long int i = 10 ; i < 40 ; i++)
+	{
+		for (long int j = 10 ; j < 40 ; j++)
+		{
+			grid_key_dx<3> p({i,j,25});
+
+			grid.template insert<0>(p) = 0.0;
+			grid.template insert<1>(p) = 0.01*i + 0.02*j;
+		}
+	}
+
+	openfpm::vector<Point<3,double>> part;
+
+	std::default_random_engine eg(4321);
+	std::uniform_real_distribution<double> ud(0.0,48.0);
+
+	for (size_t i = 0 ; i < 200000 ; i++)
+	{part.add(Point<3,double>({ud(eg),ud(eg),ud(eg)}));}
+
+	// the buffers do not depend on the number of threads
+
+	size_t nb = 8;
+
+	openfpm::set_num_threads(n_threads);
+
+	grid.initConcurrent(nb);
+
+	openfpm::parallel_for_blocks(0,part.size(),nb,[&](size_t b, size_t b_start, size_t b_stop)
+	{
+		for (size_t i = b_start ; i < b_stop ; i++)
+		{
+			grid_key_dx<3> k({(long int)part.template get<0>(i)[0],(long int)part.template get<0>(i)[1],(long int)part.template get<0>(i)[2]});
+
+			double w = 0.5*(1.0 + grid.template getConcurrent<1>(k));
+
+			auto e = grid.insertConcurrent(b,k);
+			e.template get<0>() = w;
+
+			auto e2 = grid.insertConcurrent(b,k.move(0,1));
+			e2.template get<0>() = 1.0 - w;
+		}
+	});
+
+	grid.template flushConcurrent<add_,0>();
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_insert_concurrent)
+{
+	size_t sz[3] = {50,50,50};
+
+	size_t n_threads = openfpm::get_num_threads();
+
+	sgrid_cpu<3,aggregate<double,double>,HeapMemory> grid1(sz);
+	sgrid_cpu<3,aggregate<double,double>,HeapMemory> grid4(sz);
+
+	sparse_grid_insert_concurrent_run(grid1,1);
+	sparse_grid_insert_concurrent_run(grid4,4);
+
+	openfpm::set_num_threads(n_threads);
+
+	// the total deposited is the number of particles
+
+	bool match = true;
+	double tot = 0.0;
+	size_t cnt1 = 0;
+	size_t cnt4 = 0;
+
+	auto it = grid1.getIterator();
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid4.existPointConcurrent(p);
+		match &= grid1.template get<0>(p) == grid4.template get<0>(p);
+		match &= grid1.template get<1>(p) == grid4.template get<1>(p);
+
+		tot += grid1.template get<0>(p);
+
+		cnt1++;
+		++it;
+	}
+
+	auto it4 = grid4.getIterator();
+	while (it4.isNext())
+	{
+		cnt4++;
+		++it4;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt1,cnt4);
+	BOOST_REQUIRE_CLOSE(tot,200000.0,0.0001);
+}
+
 BOOST_AUTO_TEST_CASE( sparse_grid_copy_to)
 {
 	size_t sz[3] = {501,501,501};
@@ -2254,6 +2804,272 @@ BOOST_AUTO_TEST_CASE( sparse_pack_full_noprp )
 	Test_unpack_and_check_full_noprp(grid);
 }
 
+/*! \brief Pack a sub-grid and unpack it shifted on a grid that already contain points
+ *
+ * \param grid grid to pack
+ * \param grid_u grid where to unpack
+ * \param start start of the sub-grid to pack
+ * \param stop stop of the sub-grid to pack
+ * \param shift where to unpack the sub-grid
+ * \param buf packed bytes
+ *
+ * \return true if the points unpacked match the packed one
+ *
+ */
+template<typename grid_type>
+bool sparse_grid_pack_parallel_run(grid_type & grid, grid_type & grid_u,
+								   grid_key_dx<3> & start, grid_key_dx<3> & stop, grid_key_dx<3> & shift,
+								   std::vector<char> & buf)
+{
+	for (size_t i = 0 ; i < 200 ; i += 7)
+	{
+		for (size_t j = 0 ; j < 200 ; j += 7)
+		{
+			grid_key_dx<3> key({(long int)i,(long int)j,(long int)((i+j) % 200)});
+
+			grid_u.template insert<0>(key) = -1.0;
+			grid_u.template insert<1>(key) = -1;
+		}
+	}
+
+	auto sub_it = grid.getIterator(start,stop);
+
+	size_t req = 0;
+	grid.template packRequest<0,1>(sub_it,req);
+
+	HeapMemory pmem;
+	pmem.allocate(req);
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	grid.template pack<0,1>(mem,sub_it,sts);
+
+	buf.resize(mem.size());
+	memcpy(buf.data(),pmem.getPointer(),mem.size());
+
+	grid_key_dx<3> stop_u({199,199,199});
+	auto sub_u = grid_u.getIterator(shift,stop_u);
+
+	Unpack_stat ps;
+	int ctx;
+	grid_u.template unpack<0,1>(mem,sub_u,ps,ctx,rem_copy_opt::NONE_OPT);
+
+	bool match = (ps.getOffset() == req);
+
+	auto it = grid.getIterator(start,stop);
+	while (it.isNext())
+	{
+		auto p = it.get();
+		grid_key_dx<3> pu = p - start + shift;
+
+		match &= grid_u.template get<0>(pu) == grid.template get<0>(p);
+		match &= grid_u.template get<1>(pu) == grid.template get<1>(p);
+
+		++it;
+	}
+
+	mem.decRef();
+	delete &mem;
+
+	return match;
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_pack_parallel )
+{
+	size_t sz[3] = {200,200,200};
+
+	size_t n_threads = openfpm::get_num_threads();
+
+	// no padding in the packed points, so the bytes can be compared
+
+	sgrid_cpu<3,aggregate<double,long int>,HeapMemory> grid(sz);
+
+	for (long int i = 0 ; i < 200 ; i++)
+	{
+		for (long int j = 0 ; j < 200 ; j++)
+		{
+			for (long int k = 0 ; k < 200 ; k++)
+			{
+				long int r2 = (i-100)*(i-100) + (j-100)*(j-100) + (k-100)*(k-100);
+
+				if (r2 > 50*50 && r2 < 60*60 && (i+j) % 5 != 0)
+				{
+					grid_key_dx<3> key({i,j,k});
+
+					grid.template insert<0>(key) = i + 0.5*j + 0.25*k;
+					grid.template insert<1>(key) = i*j - k;
+				}
+			}
+		}
+	}
+
+	// aligned sub-grid and shift (parallel unpack) and not aligned (sequential unpack)
+
+	grid_key_dx<3> start_a({32,48,16});
+	grid_key_dx<3> shift_a({16,0,32});
+	grid_key_dx<3> start_n({31,50,17});
+	grid_key_dx<3> shift_n({3,8,5});
+	grid_key_dx<3> stop({150,160,170});
+
+	std::vector<char> buf1;
+	std::vector<char> buf4;
+
+	for (size_t s = 0 ; s < 2 ; s++)
+	{
+		grid_key_dx<3> & start = (s == 0)?start_a:start_n;
+		grid_key_dx<3> & shift = (s == 0)?shift_a:shift_n;
+
+		sgrid_cpu<3,aggregate<double,long int>,HeapMemory> grid_u1(sz);
+		sgrid_cpu<3,aggregate<double,long int>,HeapMemory> grid_u4(sz);
+
+		openfpm::set_num_threads(1);
+		BOOST_REQUIRE_EQUAL(sparse_grid_pack_parallel_run(grid,grid_u1,start,stop,shift,buf1),true);
+
+		openfpm::set_num_threads(4);
+		BOOST_REQUIRE_EQUAL(sparse_grid_pack_parallel_run(grid,grid_u4,start,stop,shift,buf4),true);
+
+		// same bytes and same grid with any number of threads
+
+		BOOST_REQUIRE(buf1 == buf4);
+		BOOST_REQUIRE_EQUAL(grid_u1.size(),grid_u4.size());
+	}
+
+	openfpm::set_num_threads(n_threads);
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_container_file )
+{
+	size_t sz[3] = {100,100,100};
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid(sz);
+
+	for (long int i = 0 ; i < 100 ; i++)
+	{
+		for (long int j = 0 ; j < 100 ; j++)
+		{
+			for (long int k = 0 ; k < 100 ; k++)
+			{
+				long int r2 = (i-50)*(i-50) + (j-50)*(j-50) + (k-50)*(k-50);
+
+				if (r2 > 30*30 && r2 < 35*35)
+				{
+					grid_key_dx<3> key({i,j,k});
+
+					grid.template insert<0>(key) = i + 0.5*j + 0.25*k;
+					grid.template insert<1>(key)[0] = i;
+					grid.template insert<1>(key)[1] = k;
+				}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(pack_container_write(grid,"container_sgrid.bin"),true);
+
+	// read everything
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid2(sz);
+	BOOST_REQUIRE_EQUAL(pack_container_read(grid2,"container_sgrid.bin"),true);
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size());
+
+	// read the property 1 of the points in a box (float to double)
+
+	Box<3,long int> box({10,20,30},{40,50,60});
+	sgrid_cpu<3,aggregate<int,double[2]>,HeapMemory> grid4;
+	BOOST_REQUIRE_EQUAL((pack_container_read_box<1>(grid4,"container_sgrid.bin",box)),true);
+	BOOST_REQUIRE_EQUAL(grid4.getGrid().size(1),100ul);
+
+	bool match = true;
+	size_t cnt = 0;
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		match &= grid2.template get<0>(key) == grid.template get<0>(key);
+		match &= grid2.template get<1>(key)[0] == grid.template get<1>(key)[0];
+		match &= grid2.template get<1>(key)[1] == grid.template get<1>(key)[1];
+
+		if (box.isInside(key.toPointS()) == true)
+		{
+			match &= grid4.template get<1>(key)[0] == grid.template get<1>(key)[0];
+			match &= grid4.template get<1>(key)[1] == grid.template get<1>(key)[1];
+			cnt++;
+		}
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(grid4.size(),cnt);
+
+	remove("container_sgrid.bin");
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_pack_stream )
+{
+	size_t sz[3] = {100,100,100};
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid(sz);
+
+	for (long int i = 0 ; i < 100 ; i++)
+	{
+		for (long int j = 0 ; j < 100 ; j++)
+		{
+			for (long int k = 0 ; k < 100 ; k++)
+			{
+				long int r2 = (i-50)*(i-50) + (j-50)*(j-50) + (k-50)*(k-50);
+
+				if (r2 > 30*30 && r2 < 35*35)
+				{
+					grid_key_dx<3> key({i,j,k});
+
+					grid.template insert<0>(key) = i + 0.5*j + 0.25*k;
+					grid.template insert<1>(key)[0] = i;
+					grid.template insert<1>(key)[1] = k;
+				}
+			}
+		}
+	}
+
+	sgrid_cpu<3,aggregate<double,float[2]>,HeapMemory> grid2;
+	unpack_stream<decltype(grid2)> us(grid2);
+
+	pack_stream<decltype(grid)> ps(grid,64*1024);
+
+	size_t n_chunks = 0;
+
+	while (ps.next() == true)
+	{
+		BOOST_REQUIRE(ps.size() <= 64*1024);
+		BOOST_REQUIRE_EQUAL(us.unpack(ps.getPointer(),ps.size()),true);
+		n_chunks++;
+	}
+
+	BOOST_REQUIRE(n_chunks > 1);
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size());
+	BOOST_REQUIRE_EQUAL(grid2.getGrid().size(0),100ul);
+
+	bool match = true;
+
+	auto it = grid.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		match &= grid2.template get<0>(key) == grid.template get<0>(key);
+		match &= grid2.template get<1>(key)[0] == grid.template get<1>(key)[0];
+		match &= grid2.template get<1>(key)[1] == grid.template get<1>(key)[1];
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
 BOOST_AUTO_TEST_CASE( sparse_operator_equal )
 {
 	size_t sz[3] = {270,270,270};
@@ -9,6 +9,7 @@
 #define MAP_VECTOR_HPP
 
 #include "util/cuda_launch.hpp"
+#include "util/cuda/cudify_parallel.hpp"
 #include <iostream>
 #include <typeinfo>
 #include "util/common.hpp"
@@ -40,6 +41,7 @@
 #include "util/cuda_util.hpp"
 #include "cuda/map_vector_cuda_ker.cuh"
 #include "map_vector_printers.hpp"
+#include "map_vector_bulk.hpp"
 
 namespace openfpm
 {
@@ -294,7 +296,7 @@ namespace openfpm
 		 *
 		 */
 
-		size_t capacity()
+		size_t capacity() const
 		{
 			return base.size();
 		}
@@ -935,18 +937,30 @@ namespace openfpm
 		void merge_prp_v(const vector<S,M,layout_base2,gp,OPENFPM_NATIVE> & v,
 				         size_t start)
 		{
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
 #ifdef SE_CLASS1
 
-				if (start + i >= v_size)
-					std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << start+i << " but the vector has size " << size() << std::endl;
+			if (start + v.size() > v_size)
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " try to access element " << start+v.size()-1 << " but the vector has size " << size() << std::endl;
 
 #endif
-				// write the object in the last element
-				object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(start+i));
+
+			// A replace is a plain copy, it can be done with streaming copies for each property
+			if (std::is_same<op<int,int>,replace_<int,int>>::value == true &&
+				is_vector_bulk_streamable<layout_base<T>,layout_base2<S>,T,S,args...>::value == true)
+			{
+				vector_bulk_copy_prp<is_vector_bulk_streamable<layout_base<T>,layout_base2<S>,T,S,args...>::value,
+				                     self_type,
+				                     vector<S,M,layout_base2,gp,OPENFPM_NATIVE>,
+				                     args...>::run(*this,v,start);
+
+				return;
 			}
+
+			//! Merge the element of v, every element is merged in a different destination
+			openfpm::parallel_for(0,v.size(),[&](size_t i)
+			{
+				object_s_di_op<op,decltype(v.get(0)),decltype(get(0)),OBJ_ENCAP,args...>(v.get(i),get(start+i));
+			});
 		}
 
 		/*! \brief It add the element of a source vector to this vector
@@ -971,15 +985,19 @@ namespace openfpm
 				  unsigned int ...args>
 		void add_prp(const vector<S,M,layout_base2,gp,impl> & v)
 		{
-			//! Add the element of v
-			for (size_t i = 0 ; i < v.size() ; i++)
-			{
-				// Add a new element
-				add();
+			size_t old_sz = size();
 
-				// write the object in the last element
-				object_s_di<decltype(v.get(i)),decltype(get(size()-1)),OBJ_ENCAP,args...>(v.get(i),get(size()-1));
-			}
+			// Grow the capacity following the grow policy, so repeated add_prp are amortized
+			if (old_sz + v.size() > base.size())
+			{reserve(grow_p::grow(base.size(),old_sz + v.size()));}
+
+			resize(old_sz + v.size());
+
+			//! Copy the element of v at the end
+			vector_bulk_copy_prp<is_vector_bulk_streamable<layout_base<T>,layout_base2<S>,T,S,args...>::value,
+			                     self_type,
+			                     vector<S,M,layout_base2,gp,impl>,
+			                     args...>::run(*this,v,old_sz);
 		}
 
 		/*! \brief It add the element of a source vector to this vector
@@ -1067,6 +1085,20 @@ namespace openfpm
 			if (keys.size() <= start )
 				return;
 
+			// If the properties can be moved as raw memory, move the elements between two keys
+			// with one memory copy for each buffer (in parallel)
+			if (vector_bulk_buffers<self_type,layout_base<T>>::raw == true && is_vector_prp_trivially_copyable<T>::value == true)
+			{
+				std::vector<vector_bulk_buffer> bufs;
+				vector_bulk_buffers<self_type,layout_base<T>>::get(*this,bufs);
+
+				for (size_t i = 0 ; i < bufs.size() ; i++)
+				{vector_bulk_remove(bufs[i].ptr,bufs[i].e_sz,size(),keys,start);}
+
+				v_size -= keys.size() - start;
+				return;
+			}
+
 			size_t a_key = start;
 			size_t d_k = keys.get(a_key);
 			size_t s_k = keys.get(a_key) + 1;
@@ -1095,6 +1127,211 @@ namespace openfpm
 			v_size -= keys.size() - start;
 		}
 
+		/*! \brief Move every element i in map.get(i)
+		 *
+		 * \param map new position of each element (VECTOR_BULK_REMOVED to drop it)
+		 * \param n_out size of the vector after the move
+		 * \param compact true if the map is a stable compaction (every element move backward)
+		 *
+		 */
+		void move_by_map(const openfpm::vector<size_t> & map, size_t n_out, bool compact)
+		{
+			const size_t * mp = (const size_t *)map.getPointer();
+
+			if (vector_bulk_buffers<self_type,layout_base<T>>::raw == true && is_vector_prp_trivially_copyable<T>::value == true)
+			{
+				std::vector<vector_bulk_buffer> bufs;
+				vector_bulk_buffers<self_type,layout_base<T>>::get(*this,bufs);
+
+				for (size_t i = 0 ; i < bufs.size() ; i++)
+				{vector_bulk_scatter(bufs[i].ptr,bufs[i].e_sz,size(),mp,n_out,compact);}
+
+				v_size = n_out;
+				return;
+			}
+
+			// every element has a different destination, they can be copied in parallel
+
+			self_type tmp;
+			tmp.resize(n_out);
+
+			openfpm::parallel_for(0,size(),[&](size_t i)
+			{
+				if (mp[i] != VECTOR_BULK_REMOVED)
+				{tmp.set(mp[i],*this,i);}
+			});
+
+			swap(tmp);
+		}
+
+		/*! \brief Stable partition of the vector
+		 *
+		 * The elements for which pred(i) is true go first, the others after, both keep their order.
+		 * The new positions are calculated with a parallel prefix sum, the elements are moved in parallel
+		 *
+		 * \param pred predicate pred(i) where i is the element id
+		 * \param map for each old element its new position (output)
+		 *
+		 * \return the number of elements for which pred is true
+		 *
+		 */
+		template<typename lambda_f>
+		size_t partition(lambda_f pred, openfpm::vector<size_t> & map)
+		{
+			map.resize(size());
+
+			size_t n_true = vector_bulk_partition_map(size(),pred,(size_t *)map.getPointer(),false);
+
+			move_by_map(map,size(),false);
+
+			return n_true;
+		}
+
+		/*! \brief Remove all the elements for which pred(i) is true, the other elements keep their order
+		 *
+		 * The new positions are calculated with a parallel prefix sum, the elements are moved in parallel.
+		 * It replace the construction of a key list for remove(keys)
+		 *
+		 * \param pred predicate pred(i) where i is the element id
+		 * \param map for each old element its new position, VECTOR_BULK_REMOVED if removed (output),
+		 *        it can be used to patch the structures that store element ids (Cell-list, Verlet-list ...)
+		 *
+		 * \return the number of elements removed
+		 *
+		 */
+		template<typename lambda_f>
+		size_t remove_if(lambda_f pred, openfpm::vector<size_t> & map)
+		{
+			map.resize(size());
+
+			size_t n_keep = vector_bulk_partition_map(size(),[&](size_t i){return !pred(i);},(size_t *)map.getPointer(),true);
+			size_t n_rm = size() - n_keep;
+
+			if (n_rm != 0)
+			{move_by_map(map,n_keep,true);}
+
+			return n_rm;
+		}
+
+		/*! \brief Remove all the elements for which pred(i) is true, the other elements keep their order
+		 *
+		 * \param pred predicate pred(i) where i is the element id
+		 *
+		 * \return the number of elements removed
+		 *
+		 */
+		template<typename lambda_f>
+		size_t remove_if(lambda_f pred)
+		{
+			openfpm::vector<size_t> map;
+
+			return remove_if(pred,map);
+		}
+
+		/*! \brief Remove all the elements with the flag property prp different from zero
+		 *
+		 * \tparam prp flag property
+		 *
+		 * \param map for each old element its new position, VECTOR_BULK_REMOVED if removed (output)
+		 *
+		 * \return the number of elements removed
+		 *
+		 */
+		template<unsigned int prp>
+		size_t remove_if_prp(openfpm::vector<size_t> & map)
+		{
+			return remove_if([&](size_t i){return this->template get<prp>(i) != 0;},map);
+		}
+
+		/*! \brief Reorder the vector, the element i become the old element perm.get(i)
+		 *
+		 * The same permutation is applied to all the properties. For memory_traits_lin and
+		 * memory_traits_inte the elements are gathered in parallel in chunks, every chunk is gathered
+		 * for all the property buffers
+		 *
+		 * \param perm permutation, it must have the size of the vector
+		 *
+		 */
+		void reorder(const openfpm::vector<size_t> & perm)
+		{
+#ifdef SE_CLASS1
+
+			if (perm.size() != size())
+			{
+				std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the permutation has size " << perm.size() << " but the vector has size " << size() << std::endl;
+				return;
+			}
+
+#endif
+
+			const size_t * pr = (const size_t *)perm.getPointer();
+
+			if (vector_bulk_buffers<self_type,layout_base<T>>::raw == true && is_vector_prp_trivially_copyable<T>::value == true)
+			{
+				std::vector<vector_bulk_buffer> bufs;
+				vector_bulk_buffers<self_type,layout_base<T>>::get(*this,bufs);
+
+				vector_bulk_gather(bufs,size(),pr);
+				return;
+			}
+
+			self_type tmp;
+			tmp.resize(size());
+
+			openfpm::parallel_for(0,size(),[&](size_t i)
+			{
+				tmp.set(i,*this,pr[i]);
+			});
+
+			swap(tmp);
+		}
+
+		/*! \brief Stable sort of the vector by the property key_prp
+		 *
+		 * Integer keys are sorted with a parallel radix sort, the permutation is applied to all the
+		 * properties with reorder
+		 *
+		 * \tparam key_prp property used as key
+		 * \tparam comp_t comparator (std::less or std::greater use the radix sort for integer keys)
+		 *
+		 * \param perm the permutation applied, the element i is the old element perm.get(i) (output)
+		 * \param comp comparator
+		 *
+		 */
+		template<unsigned int key_prp, typename comp_t = std::less<typename vector_bulk_prp<T,key_prp>::type>>
+		void sort_by(openfpm::vector<size_t> & perm, comp_t comp = comp_t())
+		{
+			typedef typename vector_bulk_prp<T,key_prp>::type key_type;
+
+			std::vector<key_type> keys(size());
+			perm.resize(size());
+
+			size_t * pr = (size_t *)perm.getPointer();
+
+			openfpm::parallel_for(0,size(),[&](size_t i)
+			{
+				keys[i] = this->template get<key_prp>(i);
+				pr[i] = i;
+			});
+
+			openfpm::sort_cpu(keys.data(),pr,size(),comp);
+
+			reorder(perm);
+		}
+
+		/*! \brief Stable sort of the vector by the property key_prp
+		 *
+		 * \tparam key_prp property used as key
+		 *
+		 */
+		template<unsigned int key_prp>
+		void sort_by()
+		{
+			openfpm::vector<size_t> perm;
+
+			sort_by<key_prp>(perm);
+		}
+
 		/*! \brief Get an element of the vector
 		 *
 		 * Get an element of the vector
@@ -1838,7 +2075,7 @@ namespace openfpm
 		 */
 		template<unsigned int p = 0> const void * getPointer() const
 		{
-			return base.getPointer();
+			return base.template getPointer<p>();
 		}
 
 		/*! \brief This class has pointer inside
@@ -1871,6 +2108,16 @@ namespace openfpm
 			return base;
 		}
 
+		/*! \brief Internal function
+		 *
+		 * \return the internal 1D grid base
+		 *
+		 */
+		grid_base<1,T,Memory,layout_type> & getInternal_base()
+		{
+			return base;
+		}
+
 		/*! \brief Copy the memory from host to device
 		 *
 		 *
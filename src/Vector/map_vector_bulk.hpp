@@ -0,0 +1,604 @@
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BULK_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BULK_HPP_
+
+#include "util/thread_pool.hpp"
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
+#include "memory_ly/memory_conf.hpp"
+#include "util/for_each_ref.hpp"
+#include "util/object_s_di.hpp"
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/at.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <memory>
+
+//! pack of booleans used to check that all the elements of a pack are true
+template<bool ... b>
+struct vector_bulk_bool_pack
+{};
+
+//! value is true if all the b are true
+template<bool ... b>
+struct vector_bulk_all_true
+{
+	static const bool value = std::is_same<vector_bulk_bool_pack<true,b...>,vector_bulk_bool_pack<b...,true>>::value;
+};
+
+//! type of the property p of T
+template<typename T, unsigned int p>
+struct vector_bulk_prp
+{
+	//! property type
+	typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type type;
+
+	//! scalar type of the property (the base type for arrays)
+	typedef typename std::remove_all_extents<type>::type base;
+
+	//! number of scalar components of the property
+	static const size_t n_comp = sizeof(type) / sizeof(base);
+};
+
+//! value is true if the properties of T can be moved with memcpy/memmove
+template<typename T, typename seq = std::make_index_sequence<T::max_prop>>
+struct is_vector_prp_trivially_copyable;
+
+//! value is true if the properties of T can be moved with memcpy/memmove
+template<typename T, size_t ... I>
+struct is_vector_prp_trivially_copyable<T,std::index_sequence<I...>>
+{
+	static const bool value = vector_bulk_all_true<std::is_trivially_copyable<typename vector_bulk_prp<T,I>::type>::value ...>::value;
+};
+
+/*! \brief value is true if the properties I of Ts can be copied with memcpy in the properties args of Td
+ *
+ * The types must be the same and trivially copyable
+ *
+ */
+template<typename Ts, typename Td, typename seq, unsigned int ... args>
+struct is_vector_prp_streamable;
+
+//! value is true if the properties I of Ts can be copied with memcpy in the properties args of Td
+template<typename Ts, typename Td, size_t ... I, unsigned int ... args>
+struct is_vector_prp_streamable<Ts,Td,std::index_sequence<I...>,args...>
+{
+	static const bool value = vector_bulk_all_true<(std::is_same<typename vector_bulk_prp<Ts,I>::type,typename vector_bulk_prp<Td,args>::type>::value &&
+	                                                std::is_trivially_copyable<typename vector_bulk_prp<Ts,I>::type>::value) ...>::value;
+};
+
+//! Raw buffer of a vector with elements of size e_sz
+struct vector_bulk_buffer
+{
+	//! pointer to the first element
+	unsigned char * ptr;
+
+	//! size of one element
+	size_t e_sz;
+};
+
+/*! \brief Collect the buffers of each property for memory_traits_inte
+ *
+ * Array properties are stored with one buffer for each component, each component is
+ * collected as a separate buffer
+ *
+ */
+template<typename vector_type>
+struct vector_bulk_buffers_inte
+{
+	//! vector
+	vector_type & v;
+
+	//! buffers
+	std::vector<vector_bulk_buffer> & bufs;
+
+	/*! \brief constructor
+	 *
+	 * \param v vector
+	 * \param bufs output buffers
+	 *
+	 */
+	vector_bulk_buffers_inte(vector_type & v, std::vector<vector_bulk_buffer> & bufs)
+	:v(v),bufs(bufs)
+	{}
+
+	//! It collect the buffers of the property
+	template<typename T>
+	void operator()(T& t)
+	{
+		typedef vector_bulk_prp<typename vector_type::value_type,T::value> prp;
+
+		unsigned char * ptr = (unsigned char *)v.template getPointer<T::value>();
+
+		for (size_t c = 0 ; c < prp::n_comp ; c++)
+		{bufs.push_back({ptr + c*v.capacity()*sizeof(typename prp::base),sizeof(typename prp::base)});}
+	}
+};
+
+/*! \brief Collect the raw buffers of a vector, one for memory_traits_lin, one for each property
+ *         component for memory_traits_inte
+ *
+ * For the other layouts raw is false and no buffer is returned
+ *
+ */
+template<typename vector_type, typename layout, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value>
+struct vector_bulk_buffers
+{
+	//! the vector cannot be accessed as raw buffers
+	static const bool raw = false;
+
+	/*! \brief Collect the buffers
+	 *
+	 * \param v vector
+	 * \param bufs output buffers
+	 *
+	 */
+	static void get(vector_type & v, std::vector<vector_bulk_buffer> & bufs)
+	{}
+};
+
+//! Collect the raw buffers, memory_traits_lin
+template<typename vector_type, typename layout>
+struct vector_bulk_buffers<vector_type,layout,2>
+{
+	//! the vector can be accessed as raw buffers
+	static const bool raw = true;
+
+	/*! \brief Collect the buffers
+	 *
+	 * \param v vector
+	 * \param bufs output buffers
+	 *
+	 */
+	static void get(vector_type & v, std::vector<vector_bulk_buffer> & bufs)
+	{
+		bufs.push_back({(unsigned char *)v.getPointer(),sizeof(typename vector_type::value_type)});
+	}
+};
+
+//! Collect the raw buffers, memory_traits_inte
+template<typename vector_type, typename layout>
+struct vector_bulk_buffers<vector_type,layout,1>
+{
+	//! the vector can be accessed as raw buffers
+	static const bool raw = true;
+
+	/*! \brief Collect the buffers
+	 *
+	 * \param v vector
+	 * \param bufs output buffers
+	 *
+	 */
+	static void get(vector_type & v, std::vector<vector_bulk_buffer> & bufs)
+	{
+		vector_bulk_buffers_inte<vector_type> vbi(v,bufs);
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,vector_type::value_type::max_prop>>(vbi);
+	}
+};
+
+/*! \brief Remove the elements listed in keys from a buffer of n elements
+ *
+ * The elements between two keys are moved with a single memory copy. With more than one thread the
+ * elements to move are gathered in parallel in a temporary buffer and copied back in parallel, so no
+ * thread overwrite an element before it has been read
+ *
+ * \param ptr buffer
+ * \param e_sz size of each element
+ * \param n number of elements in the buffer
+ * \param keys sorted unique keys to remove
+ * \param start first key to consider
+ *
+ */
+template<typename key_vector>
+void vector_bulk_remove(unsigned char * ptr, size_t e_sz, size_t n, const key_vector & keys, size_t start)
+{
+	size_t n_keys = keys.size();
+	size_t first = keys.get(start);
+	size_t n_mv = n - first - (n_keys - start);
+
+	if (n_mv == 0)	{return;}
+
+	size_t grain = (OFP_PARALLEL_GRAIN_BYTES + e_sz - 1) / e_sz;
+	size_t nb = openfpm::parallel_n_blocks(0,n_mv,grain);
+
+	if (nb <= 1)
+	{
+		for (size_t j = start ; j < n_keys ; j++)
+		{
+			size_t s_start = keys.get(j) + 1;
+			size_t s_stop = (j + 1 < n_keys)?keys.get(j+1):n;
+
+			if (s_start < s_stop)
+			{memmove(ptr + (keys.get(j) - (j - start))*e_sz,ptr + s_start*e_sz,(s_stop - s_start)*e_sz);}
+		}
+
+		return;
+	}
+
+	std::unique_ptr<unsigned char[]> tmp(new unsigned char[n_mv*e_sz]);
+
+	openfpm::parallel_for_blocks(0,n_mv,nb,[&](size_t b, size_t b_start, size_t b_stop)
+	{
+		// The elements after the key j are moved back by j - start + 1. Search the last key whose
+		// elements are moved at or before the first element of the block
+
+		size_t d = first + b_start;
+		size_t lo = start;
+		size_t hi = n_keys;
+
+		while (hi - lo > 1)
+		{
+			size_t mid = (lo + hi) / 2;
+
+			if (keys.get(mid) - (mid - start) <= d)
+			{lo = mid;}
+			else
+			{hi = mid;}
+		}
+
+		size_t j = lo;
+		size_t i = b_start;
+
+		while (i < b_stop)
+		{
+			size_t src = first + i + (j - start + 1);
+			size_t s_stop = (j + 1 < n_keys)?keys.get(j+1):n;
+			size_t cnt = (s_stop - src < b_stop - i)?s_stop - src:b_stop - i;
+
+			memcpy(tmp.get() + i*e_sz,ptr + src*e_sz,cnt*e_sz);
+
+			i += cnt;
+			j++;
+		}
+	});
+
+	openfpm::parallel_memcpy(ptr + first*e_sz,tmp.get(),n_mv*e_sz);
+}
+
+/*! \brief Copy the properties of a vector into the properties args of another one with one memory copy
+ *         for each property component, both vectors must have memory_traits_inte layout
+ *
+ * \tparam vector_dst destination vector type
+ * \tparam vector_src source vector type
+ * \tparam args destination property for each source property
+ *
+ */
+template<typename vector_dst, typename vector_src, unsigned int ... args>
+struct vector_bulk_stream_prp
+{
+	/*! \brief Copy the property I of the source into the property p of the destination
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	template<unsigned int I, unsigned int p>
+	static void copy(vector_dst & dst, const vector_src & src, size_t offset)
+	{
+		typedef vector_bulk_prp<typename vector_dst::value_type,p> prp;
+
+		unsigned char * d = (unsigned char *)dst.template getPointer<p>();
+		const unsigned char * s = (const unsigned char *)src.template getPointer<I>();
+
+		for (size_t c = 0 ; c < prp::n_comp ; c++)
+		{
+			openfpm::parallel_memcpy(d + (c*dst.capacity() + offset)*sizeof(typename prp::base),
+			                         s + c*src.capacity()*sizeof(typename prp::base),
+			                         src.size()*sizeof(typename prp::base));
+		}
+	}
+
+	/*! \brief Copy all the properties
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	template<size_t ... I>
+	static void run(vector_dst & dst, const vector_src & src, size_t offset, std::index_sequence<I...>)
+	{
+		int dummy[] = {0, (copy<I,args>(dst,src,offset),0)...};
+		(void)dummy;
+	}
+
+	/*! \brief Copy all the properties
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	static void run(vector_dst & dst, const vector_src & src, size_t offset)
+	{
+		run(dst,src,offset,std::make_index_sequence<sizeof...(args)>());
+	}
+};
+
+//! false if one of the two vectors does not use memory_traits_inte
+template<bool both_inte, typename Td, typename Ts, unsigned int ... args>
+struct is_vector_bulk_streamable_impl
+{
+	static const bool value = false;
+};
+
+//! Both vectors use memory_traits_inte, check the properties
+template<typename Td, typename Ts, unsigned int ... args>
+struct is_vector_bulk_streamable_impl<true,Td,Ts,args...>
+{
+	static const bool value = is_vector_prp_streamable<Ts,Td,std::make_index_sequence<sizeof...(args)>,args...>::value;
+};
+
+/*! \brief value is true if the properties of the source vector can be streamed into the properties
+ *         args of the destination vector with vector_bulk_stream_prp
+ *
+ * \tparam layout_dst layout of the destination vector
+ * \tparam layout_src layout of the source vector
+ * \tparam Td object stored in the destination vector
+ * \tparam Ts object stored in the source vector
+ * \tparam args destination property for each source property
+ *
+ */
+template<typename layout_dst, typename layout_src, typename Td, typename Ts, unsigned int ... args>
+struct is_vector_bulk_streamable
+{
+	static const bool value = is_vector_bulk_streamable_impl<is_layout_inte<layout_dst>::value && is_layout_inte<layout_src>::value,Td,Ts,args...>::value;
+};
+
+//! Copy the properties element by element (generic case)
+template<bool is_stream, typename vector_dst, typename vector_src, unsigned int ... args>
+struct vector_bulk_copy_prp_impl
+{
+	/*! \brief Copy the source vector in the destination from offset
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	static void run(vector_dst & dst, const vector_src & src, size_t offset)
+	{
+		openfpm::parallel_for(0,src.size(),[&](size_t i)
+		{
+			object_s_di<decltype(src.get(i)),decltype(dst.get(offset+i)),OBJ_ENCAP,args...>(src.get(i),dst.get(offset+i));
+		});
+	}
+};
+
+//! Copy the properties with one memory copy for each property component
+template<typename vector_dst, typename vector_src, unsigned int ... args>
+struct vector_bulk_copy_prp_impl<true,vector_dst,vector_src,args...>
+{
+	/*! \brief Copy the source vector in the destination from offset
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	static void run(vector_dst & dst, const vector_src & src, size_t offset)
+	{
+		vector_bulk_stream_prp<vector_dst,vector_src,args...>::run(dst,src,offset);
+	}
+};
+
+/*! \brief Copy the properties of the source vector into the properties args of the destination
+ *         vector starting from offset
+ *
+ * The copy is done in parallel, if is_stream is true (see is_vector_bulk_streamable) each property
+ * component is copied with a single streaming memory copy
+ *
+ * \tparam is_stream both vectors use memory_traits_inte and the properties are trivially copyable
+ * \tparam vector_dst destination vector type
+ * \tparam vector_src source vector type
+ * \tparam args destination property for each source property
+ *
+ */
+template<bool is_stream, typename vector_dst, typename vector_src, unsigned int ... args>
+struct vector_bulk_copy_prp
+{
+	/*! \brief Copy the source vector in the destination from offset
+	 *
+	 * \param dst destination vector
+	 * \param src source vector
+	 * \param offset first destination element
+	 *
+	 */
+	static void run(vector_dst & dst, const vector_src & src, size_t offset)
+	{
+		vector_bulk_copy_prp_impl<is_stream,vector_dst,vector_src,args...>::run(dst,src,offset);
+	}
+};
+
+//! value of the index map for an element that has been removed
+#define VECTOR_BULK_REMOVED ((size_t)-1)
+
+/*! \brief Stable partition of n elements, it compute the new position of every element
+ *
+ * The elements for which pred(i) is true keep their order and go first, the others follow
+ * in order. The new positions are calculated with a parallel prefix sum over contiguous blocks
+ *
+ * \param n number of elements
+ * \param pred predicate pred(i)
+ * \param map for each element its new position (output, n elements)
+ * \param drop if true the elements with pred false are marked as VECTOR_BULK_REMOVED
+ *
+ * \return the number of elements for which pred is true
+ *
+ */
+template<typename lambda_f>
+size_t vector_bulk_partition_map(size_t n, lambda_f pred, size_t * map, bool drop)
+{
+	size_t nb = openfpm::parallel_n_blocks(0,n);
+	std::vector<size_t> cnt(nb+1,0);
+
+	// evaluate the predicate only once, store it in the map and count for each block
+
+	openfpm::parallel_for_blocks(0,n,nb,[&](size_t b, size_t b_start, size_t b_stop)
+	{
+		size_t c = 0;
+
+		for (size_t i = b_start ; i < b_stop ; i++)
+		{
+			map[i] = (pred(i) == true);
+			c += map[i];
+		}
+
+		cnt[b+1] = c;
+	});
+
+	// exclusive scan on the blocks
+
+	for (size_t b = 0 ; b < nb ; b++)
+	{cnt[b+1] += cnt[b];}
+
+	size_t n_true = cnt[nb];
+
+	openfpm::parallel_for_blocks(0,n,nb,[&](size_t b, size_t b_start, size_t b_stop)
+	{
+		size_t p_true = cnt[b];
+		size_t p_false = n_true + b_start - cnt[b];
+
+		for (size_t i = b_start ; i < b_stop ; i++)
+		{
+			if (map[i] == 1)
+			{map[i] = p_true++;}
+			else
+			{map[i] = (drop == true)?VECTOR_BULK_REMOVED:p_false++;}
+		}
+	});
+
+	return n_true;
+}
+
+/*! \brief Move every element i of a buffer in map[i]
+ *
+ * Consecutive elements that stay consecutive are moved with one memory copy. The elements are
+ * scattered in parallel in a temporary buffer and copied back in parallel. With one thread and
+ * a compaction (map[i] <= i) the elements are moved in place
+ *
+ * \param ptr buffer
+ * \param e_sz size of each element
+ * \param n number of elements in the buffer
+ * \param map new position of each element (VECTOR_BULK_REMOVED to drop it)
+ * \param n_out number of elements after the move
+ * \param compact true if the map is a stable compaction (every element move backward)
+ *
+ */
+static inline void vector_bulk_scatter(unsigned char * ptr, size_t e_sz, size_t n, const size_t * map, size_t n_out, bool compact)
+{
+	if (n_out == 0)	{return;}
+
+	// move the runs of consecutive elements from b_start to b_stop in out
+	auto move_runs = [&](unsigned char * out, size_t b_start, size_t b_stop)
+	{
+		size_t i = b_start;
+
+		while (i < b_stop)
+		{
+			if (map[i] == VECTOR_BULK_REMOVED)
+			{
+				i++;
+				continue;
+			}
+
+			size_t j = i + 1;
+			while (j < b_stop && map[j] == map[j-1] + 1)
+			{j++;}
+
+			if (out + map[i]*e_sz != ptr + i*e_sz)
+			{memmove(out + map[i]*e_sz,ptr + i*e_sz,(j - i)*e_sz);}
+
+			i = j;
+		}
+	};
+
+	size_t nb = openfpm::parallel_n_blocks(0,n);
+
+	if (nb <= 1 && compact == true)
+	{
+		move_runs(ptr,0,n);
+		return;
+	}
+
+	std::unique_ptr<unsigned char[]> tmp(new unsigned char[n_out*e_sz]);
+
+	openfpm::parallel_for_blocks(0,n,nb,[&](size_t b, size_t b_start, size_t b_stop)
+	{
+		move_runs(tmp.get(),b_start,b_stop);
+	});
+
+	openfpm::parallel_memcpy(ptr,tmp.get(),n_out*e_sz);
+}
+
+//! number of destination elements gathered for all the buffers before moving to the next chunk
+#define VECTOR_BULK_GATHER_CHUNK 4096
+
+/*! \brief Gather the elements [i_start,i_stop) of src in dst following perm, dst[i] = src[perm[i]]
+ *
+ * \tparam e_sz size of the element (known at compile time the copy become a single move)
+ *
+ * \param dst destination buffer
+ * \param src source buffer
+ * \param perm permutation
+ * \param i_start first element
+ * \param i_stop one past the last element
+ *
+ */
+template<size_t e_sz>
+inline void vector_bulk_gather_chunk(unsigned char * dst, const unsigned char * src, const size_t * perm, size_t i_start, size_t i_stop)
+{
+	for (size_t i = i_start ; i < i_stop ; i++)
+	{memcpy(dst + i*e_sz,src + perm[i]*e_sz,e_sz);}
+}
+
+/*! \brief Apply the permutation perm to a set of buffers, element i become the element perm[i]
+ *
+ * The destination is split in chunks of VECTOR_BULK_GATHER_CHUNK elements distributed across the
+ * threads, each chunk is gathered for all the buffers while its part of perm is still in cache
+ *
+ * \param bufs buffers
+ * \param n number of elements
+ * \param perm permutation (n elements)
+ *
+ */
+static inline void vector_bulk_gather(std::vector<vector_bulk_buffer> & bufs, size_t n, const size_t * perm)
+{
+	if (n == 0)	{return;}
+
+	std::vector<std::unique_ptr<unsigned char[]>> tmp(bufs.size());
+
+	for (size_t k = 0 ; k < bufs.size() ; k++)
+	{tmp[k].reset(new unsigned char[n*bufs[k].e_sz]);}
+
+	size_t n_chunk = (n + VECTOR_BULK_GATHER_CHUNK - 1) / VECTOR_BULK_GATHER_CHUNK;
+
+	openfpm::parallel_for_blocks(0,n_chunk,openfpm::parallel_n_blocks(0,n_chunk,1),[&](size_t b, size_t c_start, size_t c_stop)
+	{
+		for (size_t c = c_start ; c < c_stop ; c++)
+		{
+			size_t i_start = c*VECTOR_BULK_GATHER_CHUNK;
+			size_t i_stop = (i_start + VECTOR_BULK_GATHER_CHUNK < n)?i_start + VECTOR_BULK_GATHER_CHUNK:n;
+
+			for (size_t k = 0 ; k < bufs.size() ; k++)
+			{
+				size_t e_sz = bufs[k].e_sz;
+
+				if (e_sz == 4)
+				{vector_bulk_gather_chunk<4>(tmp[k].get(),bufs[k].ptr,perm,i_start,i_stop);}
+				else if (e_sz == 8)
+				{vector_bulk_gather_chunk<8>(tmp[k].get(),bufs[k].ptr,perm,i_start,i_stop);}
+				else
+				{
+					for (size_t i = i_start ; i < i_stop ; i++)
+					{memcpy(tmp[k].get() + i*e_sz,bufs[k].ptr + perm[i]*e_sz,e_sz);}
+				}
+			}
+		}
+	});
+
+	for (size_t k = 0 ; k < bufs.size() ; k++)
+	{openfpm::parallel_memcpy(bufs[k].ptr,tmp[k].get(),n*bufs[k].e_sz);}
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BULK_HPP_ */
@@ -0,0 +1,206 @@
+#ifndef OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_BULK_PERFORMANCE_TEST_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_BULK_PERFORMANCE_TEST_HPP_
+
+#include <random>
+#include <algorithm>
+
+#define NELE_BULK 8*1024*1024
+
+// Property tree
+struct report_vector_bulk_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_vector_bulk_tests report_vector_bulk;
+
+BOOST_AUTO_TEST_SUITE( vector_bulk_performance )
+
+/*! \brief Add a measure to the report
+ *
+ * \param id measure id
+ * \param name name of the measure
+ * \param times measured times
+ *
+ */
+void vector_bulk_report(size_t id, const std::string & name, std::vector<double> & times)
+{
+	double mean;
+	double dev;
+	standard_deviation(times,mean,dev);
+
+	std::string base = "performance.vector_bulk(" + std::to_string(id) + ")";
+
+	report_vector_bulk.graphs.put(base + ".funcs.nele",NELE_BULK);
+	report_vector_bulk.graphs.put(base + ".funcs.name",name);
+	report_vector_bulk.graphs.put(base + ".y.data.mean",mean);
+	report_vector_bulk.graphs.put(base + ".y.data.dev",dev);
+}
+
+/*! \brief Measure remove, add_prp, merge_prp_v, fill, remove_if and reorder with n_threads threads
+ *
+ * \tparam layout_base memory layout
+ *
+ * \param id first measure id
+ * \param name name of the layout
+ * \param n_threads number of threads
+ *
+ */
+template<template<typename> class layout_base>
+void vector_bulk_benchmark(size_t id, const std::string & name, size_t n_threads)
+{
+	typedef aggregate<float,float[3],float[3]> part;
+
+	openfpm::set_num_threads(n_threads);
+
+	openfpm::vector<part,HeapMemory,layout_base> v;
+	v.resize(NELE_BULK);
+
+	for (size_t k = 0 ; k < v.size() ; k++)
+	{
+		v.template get<0>(k) = k;
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v.template get<1>(k)[j] = k;
+			v.template get<2>(k)[j] = j;
+		}
+	}
+
+	// remove 1% of the particles
+	openfpm::vector<size_t> keys;
+	for (size_t k = 0 ; k < v.size() ; k += 100)
+	{keys.add(k);}
+
+	std::string suffix = name + "_" + std::to_string(n_threads) + "_threads";
+
+	std::vector<double> times_r(N_STAT + 1);
+	std::vector<double> times_a(N_STAT + 1);
+	std::vector<double> times_m(N_STAT + 1);
+	std::vector<double> times_f(N_STAT + 1);
+	std::vector<double> times_ri(N_STAT + 1);
+	std::vector<double> times_o(N_STAT + 1);
+
+	// random permutation for reorder
+	openfpm::vector<size_t> perm;
+	perm.resize(v.size());
+	for (size_t k = 0 ; k < perm.size() ; k++)
+	{perm.get(k) = k;}
+	std::shuffle(&perm.get(0),&perm.get(0) + perm.size(),std::default_random_engine(0));
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		// copy so the pages are already touched when remove is measured
+		openfpm::vector<part,HeapMemory,layout_base> v2;
+		v2 = v;
+
+		timer t;
+		t.start();
+
+		v2.remove(keys);
+
+		t.stop();
+		times_r[i] = t.getwct();
+
+		// the same particles removed with a predicate
+
+		v2 = v;
+
+		t.reset();
+		t.start();
+
+		v2.remove_if([](size_t k){return k % 100 == 0;});
+
+		t.stop();
+		times_ri[i] = t.getwct();
+
+		v2 = v;
+
+		t.reset();
+		t.start();
+
+		v2.reorder(perm);
+
+		t.stop();
+		times_o[i] = t.getwct();
+
+		openfpm::vector<part,HeapMemory,layout_base> v3;
+
+		t.reset();
+		t.start();
+
+		v3.template add_prp<part,HeapMemory,typename openfpm::grow_policy_double,OPENFPM_NATIVE,layout_base,0,1,2>(v);
+
+		t.stop();
+		times_a[i] = t.getwct();
+
+		t.reset();
+		t.start();
+
+		v3.template merge_prp_v<replace_,part,HeapMemory,typename openfpm::grow_policy_double,layout_base,0,1,2>(v,0);
+
+		t.stop();
+		times_m[i] = t.getwct();
+
+		t.reset();
+		t.start();
+
+		v3.template fill<0>(0);
+
+		t.stop();
+		times_f[i] = t.getwct();
+	}
+
+	vector_bulk_report(id,"remove_" + suffix,times_r);
+	vector_bulk_report(id+1,"add_prp_" + suffix,times_a);
+	vector_bulk_report(id+2,"merge_prp_v_" + suffix,times_m);
+	vector_bulk_report(id+3,"fill_" + suffix,times_f);
+	vector_bulk_report(id+4,"remove_if_" + suffix,times_ri);
+	vector_bulk_report(id+5,"reorder_" + suffix,times_o);
+}
+
+BOOST_AUTO_TEST_CASE(vector_bulk_performance)
+{
+	size_t n_threads = std::thread::hardware_concurrency();
+	if (n_threads == 0)	{n_threads = 1;}
+
+	size_t n_threads_old = openfpm::get_num_threads();
+
+	vector_bulk_benchmark<memory_traits_lin>(0,"lin",1);
+	vector_bulk_benchmark<memory_traits_lin>(6,"lin",n_threads);
+	vector_bulk_benchmark<memory_traits_inte>(12,"inte",1);
+	vector_bulk_benchmark<memory_traits_inte>(18,"inte",n_threads);
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
+BOOST_AUTO_TEST_CASE(vector_bulk_performance_write_report)
+{
+	// Create a graphs
+
+	report_vector_bulk.graphs.put("graphs.graph(0).type","line");
+	report_vector_bulk.graphs.add("graphs.graph(0).title","Vector bulk operations");
+	report_vector_bulk.graphs.add("graphs.graph(0).x.title","Tests");
+	report_vector_bulk.graphs.add("graphs.graph(0).y.title","Time seconds");
+	report_vector_bulk.graphs.add("graphs.graph(0).y.data(0).source","performance.vector_bulk(#).y.data.mean");
+	report_vector_bulk.graphs.add("graphs.graph(0).x.data(0).source","performance.vector_bulk(#).funcs.name");
+	report_vector_bulk.graphs.add("graphs.graph(0).y.data(0).title","Actual");
+	report_vector_bulk.graphs.add("graphs.graph(0).interpolation","lines");
+
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("vector_bulk_performance_funcs.xml", report_vector_bulk.graphs,std::locale(),settings);
+
+	GoogleChart cg;
+
+	std::string file_xml_ref(test_dir);
+	file_xml_ref += std::string("/openfpm_data/vector_bulk_performance_funcs_ref.xml");
+
+	StandardXMLPerformanceGraph("vector_bulk_performance_funcs.xml",file_xml_ref,cg);
+
+	addUpdtateTime(cg,1);
+
+	cg.write("vector_bulk_performance_funcs.html");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_BULK_PERFORMANCE_TEST_HPP_ */
@@ -0,0 +1,171 @@
+#ifndef OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_LAYOUT_PERFORMANCE_TEST_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_LAYOUT_PERFORMANCE_TEST_HPP_
+
+#define NELE_LAYOUT 4*1024*1024
+
+// Property tree
+struct report_vector_layout_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_vector_layout_tests report_vector_layout;
+
+BOOST_AUTO_TEST_SUITE( vector_layout_performance )
+
+/*! \brief Add a measure to the report
+ *
+ * \param id measure id
+ * \param name name of the measure
+ * \param times measured times
+ *
+ */
+void vector_layout_report(size_t id, const std::string & name, std::vector<double> & times)
+{
+	double mean;
+	double dev;
+	standard_deviation(times,mean,dev);
+
+	std::string base = "performance.vector_layout(" + std::to_string(id) + ")";
+
+	report_vector_layout.graphs.put(base + ".funcs.nele",NELE_LAYOUT);
+	report_vector_layout.graphs.put(base + ".funcs.name",name);
+	report_vector_layout.graphs.put(base + ".y.data.mean",mean);
+	report_vector_layout.graphs.put(base + ".y.data.dev",dev);
+}
+
+/*! \brief Measure element by element access on a vector with the selected layout
+ *
+ * x = x + dt*v on a vector of aggregate<float,float[3],float[3]> (mass, position, velocity)
+ *
+ * \tparam layout_base memory layout
+ *
+ * \param id first measure id
+ * \param name name of the layout
+ *
+ */
+template<template<typename> class layout_base>
+void vector_layout_benchmark(size_t id, const std::string & name)
+{
+	openfpm::vector<aggregate<float,float[3],float[3]>,HeapMemory,layout_base> v;
+	v.resize(NELE_LAYOUT);
+
+	std::vector<double> times_w(N_STAT + 1);
+	std::vector<double> times_u(N_STAT + 1);
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		for (size_t k = 0 ; k < v.size() ; k++)
+		{
+			v.template get<0>(k) = 1.0;
+			v.template get<1>(k)[0] = k;
+			v.template get<1>(k)[1] = k;
+			v.template get<1>(k)[2] = k;
+			v.template get<2>(k)[0] = 1.0;
+			v.template get<2>(k)[1] = 2.0;
+			v.template get<2>(k)[2] = 3.0;
+		}
+
+		t.stop();
+		times_w[i] = t.getwct();
+
+		timer t2;
+		t2.start();
+
+		for (size_t k = 0 ; k < v.size() ; k++)
+		{
+			v.template get<1>(k)[0] += 0.1f*v.template get<2>(k)[0];
+			v.template get<1>(k)[1] += 0.1f*v.template get<2>(k)[1];
+			v.template get<1>(k)[2] += 0.1f*v.template get<2>(k)[2];
+		}
+
+		t2.stop();
+		times_u[i] = t2.getwct();
+	}
+
+	vector_layout_report(id,"write_" + name,times_w);
+	vector_layout_report(id+1,"update_" + name,times_u);
+}
+
+BOOST_AUTO_TEST_CASE(vector_layout_performance)
+{
+	vector_layout_benchmark<memory_traits_lin>(0,"lin");
+	vector_layout_benchmark<memory_traits_inte>(2,"inte");
+	vector_layout_benchmark<memory_traits_aosoa>(4,"aosoa");
+
+	// The same update with the AoSoA layout, but processing one tile at time
+
+	openfpm::vector<aggregate<float,float[3],float[3]>,HeapMemory,memory_traits_aosoa> v;
+	v.resize(NELE_LAYOUT);
+
+	for (size_t k = 0 ; k < v.size() ; k++)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v.get<1>(k)[j] = k;
+			v.get<2>(k)[j] = j;
+		}
+	}
+
+	auto & base = v.getInternal_base();
+
+	std::vector<double> times(N_STAT + 1);
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		timer t;
+		t.start();
+
+		for (size_t tl = 0 ; tl < v.size() / AOSOA_TILE_SIZE ; tl++)
+		{
+			float (& x)[3][AOSOA_TILE_SIZE] = base.getTile<1>(tl);
+			float (& vel)[3][AOSOA_TILE_SIZE] = base.getTile<2>(tl);
+
+			for (size_t j = 0 ; j < 3 ; j++)
+			{
+				for (size_t l = 0 ; l < AOSOA_TILE_SIZE ; l++)
+				{x[j][l] += 0.1f*vel[j][l];}
+			}
+		}
+
+		t.stop();
+		times[i] = t.getwct();
+	}
+
+	vector_layout_report(6,"update_aosoa_tile",times);
+}
+
+BOOST_AUTO_TEST_CASE(vector_layout_performance_write_report)
+{
+	// Create a graphs
+
+	report_vector_layout.graphs.put("graphs.graph(0).type","line");
+	report_vector_layout.graphs.add("graphs.graph(0).title","Vector memory layouts");
+	report_vector_layout.graphs.add("graphs.graph(0).x.title","Tests");
+	report_vector_layout.graphs.add("graphs.graph(0).y.title","Time seconds");
+	report_vector_layout.graphs.add("graphs.graph(0).y.data(0).source","performance.vector_layout(#).y.data.mean");
+	report_vector_layout.graphs.add("graphs.graph(0).x.data(0).source","performance.vector_layout(#).funcs.name");
+	report_vector_layout.graphs.add("graphs.graph(0).y.data(0).title","Actual");
+	report_vector_layout.graphs.add("graphs.graph(0).interpolation","lines");
+
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("vector_layout_performance_funcs.xml", report_vector_layout.graphs,std::locale(),settings);
+
+	GoogleChart cg;
+
+	std::string file_xml_ref(test_dir);
+	file_xml_ref += std::string("/openfpm_data/vector_layout_performance_funcs_ref.xml");
+
+	StandardXMLPerformanceGraph("vector_layout_performance_funcs.xml",file_xml_ref,cg);
+
+	addUpdtateTime(cg,1);
+
+	cg.write("vector_layout_performance_funcs.html");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_PERFORMANCE_VECTOR_LAYOUT_PERFORMANCE_TEST_HPP_ */
@@ -8,6 +8,8 @@
 #ifndef OPENFPM_DATA_SRC_VECTOR_VECTOR_MAP_ITERATOR_HPP_
 #define OPENFPM_DATA_SRC_VECTOR_VECTOR_MAP_ITERATOR_HPP_
 
+#include "util/thread_pool.hpp"
+
 namespace openfpm
 {
 	/*! \brief Vector iterator
@@ -97,6 +99,27 @@ namespace openfpm
 		{
 			return gk;
 		}
+
+		/*! \brief Split the remaining elements in n balanced parts and return the part i
+		 *
+		 * \param i part
+		 * \param n number of parts
+		 *
+		 * \return an iterator over the part i
+		 *
+		 */
+		vector_key_iterator split(size_t i, size_t n) const
+		{
+			size_t b_start;
+			size_t b_stop;
+
+			if (gk >= end)
+			{return vector_key_iterator(end,end);}
+
+			parallel_block_range(gk,end,n,i,b_start,b_stop);
+
+			return vector_key_iterator(b_stop,b_start);
+		}
 	};
 
 	/*! \brief Vector iterator
@@ -832,6 +832,415 @@ BOOST_AUTO_TEST_CASE( vector_cuda_to_kernel_recursive )
 	BOOST_REQUIRE_EQUAL(test,true);
 }
 
+/*! \brief Check the bulk remove, add_prp and merge_prp_v against an element by element reference
+ *
+ * \tparam layout_base memory layout
+ *
+ */
+template<template<typename> class layout_base>
+void vector_bulk_test()
+{
+	typedef aggregate<float,float[3],int> part;
+
+	openfpm::vector<part,HeapMemory,layout_base> v;
+	openfpm::vector<part,HeapMemory,layout_base> v2;
+
+	v.resize(100000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i;
+		v.template get<1>(i)[1] = i + 1;
+		v.template get<1>(i)[2] = i + 2;
+		v.template get<2>(i) = i;
+	}
+
+	// remove one element every 3 plus a contiguous range
+
+	openfpm::vector<size_t> keys;
+
+	for (size_t i = 0 ; i < 50000 ; i += 3)
+	{keys.add(i);}
+
+	for (size_t i = 60000 ; i < 70000 ; i++)
+	{keys.add(i);}
+
+	size_t n_keys = keys.size();
+	v.remove(keys);
+
+	BOOST_REQUIRE_EQUAL(v.size(),100000 - n_keys);
+
+	bool match = true;
+	size_t k = 0;
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		if ((i < 50000 && i % 3 == 0) || (i >= 60000 && i < 70000))
+		{continue;}
+
+		match &= v.template get<0>(k) == i;
+		match &= v.template get<1>(k)[0] == i;
+		match &= v.template get<1>(k)[1] == i + 1;
+		match &= v.template get<1>(k)[2] == i + 2;
+		match &= v.template get<2>(k) == (int)i;
+		k++;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// add the vector twice, the first time with all the properties, the second time only
+	// property 2 taken from a vector with one property
+
+	openfpm::vector<aggregate<int>,HeapMemory,layout_base> vi;
+	vi.resize(v.size());
+
+	for (size_t i = 0 ; i < vi.size() ; i++)
+	{vi.template get<0>(i) = 3*i;}
+
+	v2.template add_prp<part,HeapMemory,typename openfpm::grow_policy_double,OPENFPM_NATIVE,layout_base,0,1,2>(v);
+	v2.template add_prp<aggregate<int>,HeapMemory,typename openfpm::grow_policy_double,OPENFPM_NATIVE,layout_base,2>(vi);
+
+	BOOST_REQUIRE_EQUAL(v2.size(),2*v.size());
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(i);
+		match &= v2.template get<1>(i)[0] == v.template get<1>(i)[0];
+		match &= v2.template get<1>(i)[1] == v.template get<1>(i)[1];
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(i) == v.template get<2>(i);
+		match &= v2.template get<2>(v.size() + i) == (int)(3*i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// replace the properties 0 and 1 of the second half, add to the property 2
+
+	v2.template merge_prp_v<replace_,part,HeapMemory,typename openfpm::grow_policy_double,layout_base,0,1>(v,v.size());
+	v2.template merge_prp_v<add_,aggregate<int>,HeapMemory,typename openfpm::grow_policy_double,layout_base,2>(vi,v.size());
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(v.size() + i) == v.template get<0>(i);
+		match &= v2.template get<1>(v.size() + i)[2] == v.template get<1>(i)[2];
+		match &= v2.template get<2>(v.size() + i) == (int)(6*i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// fill with a byte
+
+	v2.template fill<0>(0);
+
+	for (size_t i = 0 ; i < v2.size() ; i++)
+	{match &= v2.template get<0>(i) == 0;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( vector_bulk_parallel )
+{
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	vector_bulk_test<memory_traits_lin>();
+	vector_bulk_test<memory_traits_inte>();
+
+	openfpm::set_num_threads(1);
+
+	vector_bulk_test<memory_traits_lin>();
+	vector_bulk_test<memory_traits_inte>();
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
+/*! \brief Check remove_if, remove_if_prp and partition against the expected order and index map
+ *
+ * \tparam layout_base memory layout
+ *
+ */
+template<template<typename> class layout_base>
+void vector_remove_if_test()
+{
+	typedef aggregate<float,float[3],int> part;
+
+	openfpm::vector<part,HeapMemory,layout_base> v;
+
+	v.resize(100000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = i;
+		v.template get<1>(i)[1] = i + 1;
+		v.template get<1>(i)[2] = i + 2;
+		v.template get<2>(i) = (i % 7 == 0 || (i >= 30000 && i < 40000));
+	}
+
+	openfpm::vector<part,HeapMemory,layout_base> v2;
+	v2 = v;
+
+	// remove with the flag property
+
+	openfpm::vector<size_t> map;
+	size_t n_rm = v.template remove_if_prp<2>(map);
+
+	BOOST_REQUIRE_EQUAL(map.size(),100000ul);
+	BOOST_REQUIRE_EQUAL(v.size(),100000ul - n_rm);
+
+	bool match = true;
+	size_t k = 0;
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		if (i % 7 == 0 || (i >= 30000 && i < 40000))
+		{
+			match &= map.get(i) == VECTOR_BULK_REMOVED;
+			continue;
+		}
+
+		match &= map.get(i) == k;
+		match &= v.template get<0>(k) == i;
+		match &= v.template get<1>(k)[0] == i;
+		match &= v.template get<1>(k)[1] == i + 1;
+		match &= v.template get<1>(k)[2] == i + 2;
+		match &= v.template get<2>(k) == 0;
+		k++;
+	}
+
+	BOOST_REQUIRE_EQUAL(k,v.size());
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// partition, the even elements go first
+
+	size_t n_true = v2.partition([&](size_t i){return v2.template get<0>(i) < 50000.0 && ((size_t)v2.template get<0>(i)) % 2 == 0;},map);
+
+	BOOST_REQUIRE_EQUAL(n_true,25000ul);
+	BOOST_REQUIRE_EQUAL(v2.size(),100000ul);
+
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		size_t ex = (i < 50000 && i % 2 == 0)?i/2:((i < 50000)?25000+i/2:i);
+
+		match &= map.get(i) == ex;
+		match &= v2.template get<0>(ex) == i;
+		match &= v2.template get<1>(ex)[2] == i + 2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// remove everything
+
+	n_rm = v2.remove_if([](size_t i){return true;});
+
+	BOOST_REQUIRE_EQUAL(n_rm,100000ul);
+	BOOST_REQUIRE_EQUAL(v2.size(),0ul);
+}
+
+BOOST_AUTO_TEST_CASE( vector_remove_if_partition )
+{
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	vector_remove_if_test<memory_traits_lin>();
+	vector_remove_if_test<memory_traits_inte>();
+
+	openfpm::set_num_threads(1);
+
+	vector_remove_if_test<memory_traits_lin>();
+	vector_remove_if_test<memory_traits_inte>();
+
+	// properties that cannot be moved as raw memory
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> vv;
+	vv.resize(20000);
+
+	for (size_t i = 0 ; i < vv.size() ; i++)
+	{
+		vv.template get<0>(i) = i;
+		vv.template get<1>(i).add(i);
+	}
+
+	openfpm::vector<size_t> map;
+	vv.remove_if([&](size_t i){return i % 2 == 1;},map);
+
+	BOOST_REQUIRE_EQUAL(vv.size(),10000ul);
+
+	bool match = true;
+	for (size_t i = 0 ; i < vv.size() ; i++)
+	{
+		match &= vv.template get<0>(i) == (int)(2*i);
+		match &= vv.template get<1>(i).size() == 1;
+		match &= vv.template get<1>(i).get(0) == (int)(2*i);
+		match &= map.get(2*i) == i;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
+/*! \brief Check sort_by and reorder
+ *
+ * \tparam layout_base memory layout
+ *
+ */
+template<template<typename> class layout_base>
+void vector_sort_by_test()
+{
+	typedef aggregate<unsigned int,float[3],float> part;
+
+	openfpm::vector<part,HeapMemory,layout_base> v;
+
+	v.resize(100000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = (i * 7919) % 1000;
+		v.template get<1>(i)[0] = i;
+		v.template get<1>(i)[1] = i + 1;
+		v.template get<1>(i)[2] = i + 2;
+		v.template get<2>(i) = -(float)((i * 7919) % 1000);
+	}
+
+	openfpm::vector<part,HeapMemory,layout_base> v2;
+	v2 = v;
+
+	openfpm::vector<size_t> perm;
+	v.template sort_by<0>(perm);
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		size_t o = perm.get(i);
+
+		match &= v.template get<0>(i) == (o * 7919) % 1000;
+		match &= v.template get<1>(i)[0] == o;
+		match &= v.template get<1>(i)[1] == o + 1;
+		match &= v.template get<1>(i)[2] == o + 2;
+
+		if (i != 0)
+		{
+			// sorted and stable
+			match &= v.template get<0>(i-1) <= v.template get<0>(i);
+			match &= v.template get<0>(i-1) != v.template get<0>(i) || perm.get(i-1) < perm.get(i);
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// floating point key (comparison sort), it must produce the same order
+
+	openfpm::vector<size_t> perm2;
+	v2.template sort_by<2>(perm2,std::greater<float>());
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= perm2.get(i) == perm.get(i);
+		match &= v2.template get<1>(i)[2] == v.template get<1>(i)[2];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// reverse with reorder
+
+	for (size_t i = 0 ; i < perm.size() ; i++)
+	{perm.get(i) = perm.size() - 1 - i;}
+
+	v2.reorder(perm);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == v.template get<0>(v.size() - 1 - i);
+		match &= v2.template get<1>(i)[1] == v.template get<1>(v.size() - 1 - i)[1];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( vector_sort_by_reorder )
+{
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	vector_sort_by_test<memory_traits_lin>();
+	vector_sort_by_test<memory_traits_inte>();
+
+	// properties that cannot be moved as raw memory
+
+	openfpm::vector<aggregate<int,openfpm::vector<int>>> vv;
+	vv.resize(20000);
+
+	for (size_t i = 0 ; i < vv.size() ; i++)
+	{
+		vv.template get<0>(i) = vv.size() - i;
+		vv.template get<1>(i).add(i);
+	}
+
+	vv.sort_by<0>();
+
+	bool match = true;
+	for (size_t i = 0 ; i < vv.size() ; i++)
+	{
+		match &= vv.template get<0>(i) == (int)(i + 1);
+		match &= vv.template get<1>(i).get(0) == (int)(vv.size() - 1 - i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
+BOOST_AUTO_TEST_CASE( vector_iterator_split )
+{
+	size_t n_threads_old = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	openfpm::vector<aggregate<size_t>> v;
+	v.resize(10007);
+
+	// parts cover the remaining elements once and are balanced
+	auto it = v.getIteratorFrom(7);
+
+	size_t n_parts[] = {1,3,4,64,20000};
+
+	for (size_t j = 0 ; j < sizeof(n_parts)/sizeof(size_t) ; j++)
+	{
+		size_t cnt = 0;
+		size_t next = 7;
+		bool match = true;
+
+		for (size_t i = 0 ; i < n_parts[j] ; i++)
+		{
+			auto it_p = it.split(i,n_parts[j]);
+
+			while (it_p.isNext())
+			{
+				match &= it_p.get() == next;
+				next++;
+				cnt++;
+
+				++it_p;
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+		BOOST_REQUIRE_EQUAL(cnt,10000ul);
+	}
+
+	openfpm::parallel_for_each(v.getIterator(),[&](size_t i)
+	{
+		v.template get<0>(i) = 2*i;
+	});
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{match &= v.template get<0>(i) == 2*i;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
@@ -900,6 +900,194 @@ public:
 	}
 };
 
+/*! \brief this structure encapsulate an object of a grid with AoSoA layout
+ *
+ * It store the tile that contain the object and the position of the object inside the tile
+ *
+ * \see memory_traits_aosoa
+ *
+ *	\param dim Dimensionality of the grid
+ *	\param T type of object the grid store
+ *	\param W number of elements in a tile
+ *
+ */
+template<unsigned int dim,typename T, unsigned int W>
+class encapc<dim,T,memory_aosoa<T,W>>
+{
+	//! type of layout
+	typedef memory_aosoa<T,W> Mem;
+
+	//! layout of the encapsulated object
+	typedef typename memory_traits_lin<T>::type Mem2;
+
+	//! tile type
+	typedef typename memory_aosoa<T,W>::tile_type tile_type;
+
+	//! reference to the encapsulated object
+	aosoa_ref<tile_type> ref;
+
+#ifdef SE_CLASS1
+	bool init = false;
+#endif
+
+#ifdef SE_CLASS1
+	__device__ __host__ void check_init() const
+	{
+		if (init == false)
+		{
+			#ifdef CUDA_ON_CPU
+			std::cout << __FILE__ << ":" << __LINE__ << " Error using unallocated pointer" << std::endl;
+			#else
+			assert(init == true);
+			#endif
+		}
+	}
+#endif
+
+public:
+
+	//! Original list if types
+	typedef typename T::type type;
+
+	//! indicate it is an encapsulated object
+	typedef int yes_i_am_encap;
+
+	//! original object type
+	typedef T T_type;
+
+	//! number of properties
+	static const int max_prop = T::max_prop;
+
+#ifdef SE_CLASS1
+	__device__ __host__ ~encapc()
+	{init = false;}
+#endif
+
+	//! constructor from a reference to the element
+	__device__ __host__ encapc(const aosoa_ref<tile_type> & ref)
+	:ref(ref)
+	{
+#ifdef SE_CLASS1
+		init = true;
+#endif
+	}
+
+    __device__ __host__ encapc(const encapc<dim,T,Mem> & ec) : ref(ec.ref)
+    {
+#ifdef SE_CLASS1
+		init = true;
+#endif
+    }
+
+	/*! \brief Access the data
+	 *
+	 * \tparam p property selected
+	 *
+	 * \return The reference of the data
+	 *
+	 */
+	template <unsigned int p>
+	__device__ __host__ auto get() -> decltype(ref.template get<p>())
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return ref.template get<p>();
+	}
+
+	/*! \brief Access the data
+	 *
+	 * \tparam p property selected
+	 *
+	 * \return The reference of the data
+	 *
+	 */
+	template <unsigned int p> __device__ __host__ auto get() const -> decltype(ref.template get<p>())
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		return ref.template get<p>();
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param ec encapsulator
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const encapc<dim,T,Mem> & ec)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_cpu_encap_single<encapc<dim,T,Mem>> cp(ec,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param ec encapsulator
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const encapc<dim,T,Mem2> & ec)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_cpu_encap_encap_general<encapc<dim,T,Mem2>,encapc<dim,T,Mem>> cp(ec,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	/*! \brief Assignment
+	 *
+	 * \param obj object to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline encapc<dim,T,Mem> & operator=(const T & obj)
+	{
+#ifdef SE_CLASS1
+		check_init();
+#endif
+		copy_fusion_vector_encap<typename T::type,decltype(*this)> cp(obj.data,*this);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
+
+		return *this;
+	}
+
+	/*! \brief Position of the object inside its tile
+	 *
+	 * \return the position inside the tile
+	 *
+	 */
+	__device__ __host__ inline unsigned int private_get_off() const
+	{
+		return ref.off;
+	}
+
+	/*! \brief Tile that contain the object
+	 *
+	 * \return the tile
+	 *
+	 */
+	__device__ __host__ inline tile_type & private_get_tile()
+	{
+		return *ref.tile;
+	}
+};
+
 #include "util/common.hpp"
 
 template<typename T, typename Sfinae = void>
@@ -0,0 +1,877 @@
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_FILEMEMORY_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_FILEMEMORY_HPP_
+
+#include "memory/memory.hpp"
+#include "memory_ly/memory_conf.hpp"
+#include "util/for_each_ref.hpp"
+#include <boost/mpl/range_c.hpp>
+#include <boost/mpl/at.hpp>
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//! Map the file for reading and writing, modifications are written to the file
+#define FILE_MEMORY_RW 0
+//! Map the file copy-on-write, modifications are not written to the file
+#define FILE_MEMORY_READ 1
+
+//! The buffers are in memory_traits_lin layout
+#define FILE_MEMORY_LAYOUT_LIN 0
+//! The buffers are in memory_traits_inte layout (one buffer for each property)
+#define FILE_MEMORY_LAYOUT_INTE 1
+
+//! Version of the file format
+#define FILE_MEMORY_VERSION 1
+
+//! Maximum dimensionality of a grid stored in a file
+#define FILE_MEMORY_MAX_DIM 8
+
+//! Maximum number of properties of an object stored in a file
+#define FILE_MEMORY_MAX_PROP 64
+
+//! Size of the header and alignment of the buffers (it must be a multiple of the page size)
+#define FILE_MEMORY_ALIGN (64*1024)
+
+/*! \brief Memory that map a region of a file
+ *
+ * It can be used as Memory argument of openfpm::vector and as S argument of grid_base/grid_cpu.
+ * A FileMemory not bound to a file (default constructed) behave like an HeapMemory allocated with
+ * mmap. A bound FileMemory map the region [offset,offset + size) of the file, allocate and
+ * resize extend the file if needed and the content of the region is retained. The pages are
+ * loaded lazily by the kernel when they are accessed, and written back to the file without
+ * any explicit copy
+ *
+ * In general it is not used directly, vector_file_create/vector_file_open and
+ * grid_file_create/grid_file_open create a container with a layout header
+ *
+ * It implement the memory interface and the members of HeapMemory used by the containers, so
+ * the buffer passed to setMemory is accessed only through this class
+ *
+ */
+class FileMemory : public memory
+{
+	//! Size of the memory
+	size_t sz;
+
+	//! Pointer to the memory
+	void * mem;
+
+	//! File descriptor (-1 if not bound to a file)
+	int fd;
+
+	//! Offset of the region in the file
+	size_t offset;
+
+	//! FILE_MEMORY_RW or FILE_MEMORY_READ
+	int mode;
+
+	//! Reference counter
+	long int ref_cnt;
+
+	/*! \brief Map sz bytes
+	 *
+	 * \param sz size of the mapping
+	 *
+	 * \return the pointer, NULL if the mapping failed
+	 *
+	 */
+	void * map(size_t sz)
+	{
+		void * ptr;
+
+		if (fd == -1)
+		{ptr = mmap(NULL,sz,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);}
+		else
+		{
+			if (mode == FILE_MEMORY_RW)
+			{
+				struct stat st;
+				if (fstat(fd,&st) != 0)
+				{return NULL;}
+
+				if ((size_t)st.st_size < offset + sz && ftruncate(fd,offset + sz) != 0)
+				{
+					std::cerr << __FILE__ << ":" << __LINE__ << " error extending the file to " << offset + sz << " bytes" << std::endl;
+					return NULL;
+				}
+			}
+
+			int flags = (mode == FILE_MEMORY_RW)?MAP_SHARED:MAP_PRIVATE;
+			ptr = mmap(NULL,sz,PROT_READ | PROT_WRITE,flags,fd,offset);
+		}
+
+		if (ptr == MAP_FAILED)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error mmap failed mapping " << sz << " bytes" << std::endl;
+			return NULL;
+		}
+
+		return ptr;
+	}
+
+	//! Unmap the memory
+	void unmap()
+	{
+		if (mem != NULL)
+		{munmap(mem,sz);}
+
+		mem = NULL;
+		sz = 0;
+	}
+
+public:
+
+	/*! \brief Bind the memory to the region of a file starting at offset
+	 *
+	 * It must be called before allocate
+	 *
+	 * \param file file name
+	 * \param offset offset of the region (it must be a multiple of the page size)
+	 * \param mode FILE_MEMORY_RW to create or modify the file, FILE_MEMORY_READ to map it copy-on-write
+	 *
+	 * \return true if the file has been opened
+	 *
+	 */
+	bool open(const std::string & file, size_t offset, int mode = FILE_MEMORY_RW)
+	{
+		if (mem != NULL || fd != -1)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the memory is already allocated or bound to a file" << std::endl;
+			return false;
+		}
+
+		if (offset % getpagesize() != 0)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the offset " << offset << " is not a multiple of the page size" << std::endl;
+			return false;
+		}
+
+		fd = ::open(file.c_str(),(mode == FILE_MEMORY_RW)?(O_RDWR | O_CREAT):O_RDONLY,0644);
+
+		if (fd == -1)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error opening the file " << file << std::endl;
+			return false;
+		}
+
+		this->offset = offset;
+		this->mode = mode;
+
+		return true;
+	}
+
+	/*! \brief Write the modified pages back to the file
+	 *
+	 * \return true if the synchronization succeed
+	 *
+	 */
+	bool sync()
+	{
+		if (fd == -1 || mem == NULL || mode != FILE_MEMORY_RW)
+		{return true;}
+
+		return msync(mem,sz,MS_SYNC) == 0;
+	}
+
+	/*! \brief Allocate the memory
+	 *
+	 * \param sz size of the memory
+	 *
+	 * \return true if the allocation succeed
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		if (mem != NULL)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error memory already allocated" << std::endl;
+			return false;
+		}
+
+		if (sz == 0)
+		{return true;}
+
+		mem = map(sz);
+
+		if (mem == NULL)
+		{return false;}
+
+		this->sz = sz;
+		return true;
+	}
+
+	//! Destroy the memory (the file is not removed)
+	virtual void destroy()
+	{
+		unmap();
+
+		if (fd != -1)
+		{close(fd);}
+
+		fd = -1;
+	}
+
+	/*! \brief Copy the memory from another device
+	 *
+	 * \param m memory from where to copy
+	 *
+	 * \return true if the copy succeed
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error source memory is bigger than the destination" << std::endl;
+			return false;
+		}
+
+		memcpy(mem,m.getPointer(),m.size());
+		return true;
+	}
+
+	/*! \brief Get the size of the memory
+	 *
+	 * \return the size of the memory
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief Resize the memory retaining the content
+	 *
+	 * If the memory is bound to a file the region is simply mapped again, the content is in the file
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if the resize succeed
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)
+		{return true;}
+
+		if (fd != -1 && mode == FILE_MEMORY_RW)
+		{
+			// Shared mapping, the content is already in the file
+			unmap();
+			return allocate(sz);
+		}
+
+		void * ptr = map(sz);
+
+		if (ptr == NULL)
+		{return false;}
+
+		if (mem != NULL)
+		{memcpy(ptr,mem,this->sz);}
+
+		unmap();
+
+		mem = ptr;
+		this->sz = sz;
+
+		return true;
+	}
+
+	/*! \brief Return a readable pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return mem;
+	}
+
+	/*! \brief Return a readable pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return mem;
+	}
+
+	/*! \brief Return the device pointer (host and device are the same)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return mem;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getPointerBase()
+	{
+		return mem;
+	}
+
+	//! Do nothing (host and device are the same)
+	virtual void hostToDevice()
+	{}
+
+	//! Do nothing (host and device are the same)
+	virtual void deviceToHost()
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param start unused
+	 * \param stop unused
+	 *
+	 */
+	virtual void hostToDevice(size_t start, size_t stop)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param start unused
+	 * \param stop unused
+	 *
+	 */
+	virtual void deviceToHost(size_t start, size_t stop)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param m unused
+	 *
+	 */
+	virtual void hostToDevice(memory & m)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param m unused
+	 *
+	 */
+	virtual void deviceToHost(memory & m)
+	{}
+
+	/*! \brief Host and device memory are the same
+	 *
+	 * \return true
+	 *
+	 */
+	static constexpr bool isDeviceHostSame()
+	{
+		return true;
+	}
+
+	/*! \brief Fill the memory with a byte
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		memset(mem,c,sz);
+	}
+
+	//! Increment the reference counter
+	virtual void incRef()
+	{ref_cnt++;}
+
+	//! Decrement the reference counter
+	virtual void decRef()
+	{ref_cnt--;}
+
+	/*! \brief Return the reference counter
+	 *
+	 * \return the reference counter
+	 *
+	 */
+	virtual long int ref()
+	{
+		return ref_cnt;
+	}
+
+	/*! \brief Memory bound to a file is initialized with the content of the file
+	 *
+	 * This avoid that the containers construct (and so touch) every element when the file is opened
+	 *
+	 * \return true if the memory is bound to a file
+	 *
+	 */
+	virtual bool isInitialized()
+	{
+		return fd != -1;
+	}
+
+	/*! \brief Return true if the memory is bound to a file
+	 *
+	 * \return true if bound to a file
+	 *
+	 */
+	bool isFile() const
+	{
+		return fd != -1;
+	}
+
+	/*! \brief Swap the memory
+	 *
+	 * \param m memory to swap with
+	 *
+	 */
+	void swap(FileMemory & m)
+	{
+		std::swap(sz,m.sz);
+		std::swap(mem,m.mem);
+		std::swap(fd,m.fd);
+		std::swap(offset,m.offset);
+		std::swap(mode,m.mode);
+		std::swap(ref_cnt,m.ref_cnt);
+	}
+
+	//! Constructor
+	FileMemory()
+	:sz(0),mem(NULL),fd(-1),offset(0),mode(FILE_MEMORY_RW),ref_cnt(0)
+	{}
+
+	//! Copy constructor (the copy is never bound to the file)
+	FileMemory(const FileMemory & m)
+	:sz(0),mem(NULL),fd(-1),offset(0),mode(FILE_MEMORY_RW),ref_cnt(0)
+	{
+		if (m.mem != NULL)
+		{
+			allocate(m.sz);
+			copy(m);
+		}
+	}
+
+	//! Move constructor
+	FileMemory(FileMemory && m)
+	:sz(0),mem(NULL),fd(-1),offset(0),mode(FILE_MEMORY_RW),ref_cnt(0)
+	{
+		swap(m);
+	}
+
+	//! Destructor
+	~FileMemory()
+	{
+		if (ref_cnt == 0)
+		{destroy();}
+		else
+		{std::cerr << __FILE__ << ":" << __LINE__ << " error destroying a live object" << std::endl;}
+	}
+};
+
+/*! \brief Header at the beginning of a file created by vector_file_create or grid_file_create
+ *
+ * It describe the layout of the buffers, so the file can be mapped again without any unpacking
+ *
+ */
+struct file_memory_header
+{
+	//! Identify the file "OFPMFILE"
+	char magic[8];
+
+	//! version of the format
+	unsigned int version;
+
+	//! FILE_MEMORY_LAYOUT_LIN or FILE_MEMORY_LAYOUT_INTE
+	unsigned int layout;
+
+	//! dimensionality (1 for a vector)
+	unsigned int dim;
+
+	//! number of properties
+	unsigned int n_prop;
+
+	//! size of the stored object
+	size_t size_elem;
+
+	//! number of elements
+	size_t n_ele;
+
+	//! size of the grid in each dimension (n_ele for a vector)
+	size_t sz[FILE_MEMORY_MAX_DIM];
+
+	//! number of buffers
+	size_t n_buf;
+
+	//! size of each property
+	size_t prp_size[FILE_MEMORY_MAX_PROP];
+
+	//! offset of each buffer in the file
+	size_t offset[FILE_MEMORY_MAX_PROP];
+};
+
+/*! \brief Fill the size of each property in the header
+ *
+ * \tparam T aggregate stored
+ *
+ */
+template<typename T>
+struct file_memory_prp_size
+{
+	//! header
+	file_memory_header & hd;
+
+	/*! \brief constructor
+	 *
+	 * \param hd header to fill
+	 *
+	 */
+	file_memory_prp_size(file_memory_header & hd)
+	:hd(hd)
+	{}
+
+	//! It fill the size of the property
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		hd.prp_size[t_prp::value] = sizeof(typename boost::mpl::at<typename T::type,t_prp>::type);
+	}
+};
+
+/*! \brief Bind the buffer of each property to its region of the file
+ *
+ * \tparam container_type vector or grid
+ *
+ */
+template<typename container_type>
+struct file_memory_set_prp
+{
+	//! container
+	container_type & c;
+
+	//! header
+	const file_memory_header & hd;
+
+	//! file name
+	const std::string & file;
+
+	//! mode
+	int mode;
+
+	//! false if the binding of one buffer failed
+	bool ok;
+
+	/*! \brief constructor
+	 *
+	 * \param c container
+	 * \param hd header of the file
+	 * \param file file name
+	 * \param mode FILE_MEMORY_RW or FILE_MEMORY_READ
+	 *
+	 */
+	file_memory_set_prp(container_type & c, const file_memory_header & hd, const std::string & file, int mode)
+	:c(c),hd(hd),file(file),mode(mode),ok(true)
+	{}
+
+	//! It bind the buffer
+	template<typename t_prp>
+	void operator()(t_prp & t)
+	{
+		if (t_prp::value >= hd.n_buf)	{return;}
+
+		FileMemory * mem = new FileMemory();
+		ok &= mem->open(file,hd.offset[t_prp::value],mode);
+
+		c.template setMemory<t_prp::value>(*mem);
+	}
+};
+
+/*! \brief Create the header of a file for a container of objects T
+ *
+ * \tparam T object stored
+ * \tparam layout memory layout
+ *
+ * \param hd header to fill
+ * \param dim dimensionality
+ * \param sz size in each dimension
+ *
+ * \return the size of the file
+ *
+ */
+template<typename T, typename layout>
+size_t file_memory_make_header(file_memory_header & hd, unsigned int dim, const size_t * sz)
+{
+	static_assert(is_layout_mlin<layout>::value || is_layout_inte<layout>::value,"file storage support only memory_traits_lin and memory_traits_inte");
+	static_assert(T::max_prop <= FILE_MEMORY_MAX_PROP,"too many properties, increase FILE_MEMORY_MAX_PROP");
+
+	memset(&hd,0,sizeof(file_memory_header));
+	memcpy(hd.magic,"OFPMFILE",8);
+
+	hd.version = FILE_MEMORY_VERSION;
+	hd.layout = (is_layout_inte<layout>::value)?FILE_MEMORY_LAYOUT_INTE:FILE_MEMORY_LAYOUT_LIN;
+	hd.dim = dim;
+	hd.n_prop = T::max_prop;
+	hd.size_elem = sizeof(T);
+
+	hd.n_ele = 1;
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		hd.sz[i] = sz[i];
+		hd.n_ele *= sz[i];
+	}
+
+	file_memory_prp_size<T> fps(hd);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fps);
+
+	hd.n_buf = (hd.layout == FILE_MEMORY_LAYOUT_INTE)?hd.n_prop:1;
+
+	size_t off = FILE_MEMORY_ALIGN;
+	for (size_t i = 0 ; i < hd.n_buf ; i++)
+	{
+		size_t sz_buf = (hd.layout == FILE_MEMORY_LAYOUT_INTE)?hd.n_ele*hd.prp_size[i]:hd.n_ele*hd.size_elem;
+
+		hd.offset[i] = off;
+		off += (sz_buf + FILE_MEMORY_ALIGN - 1) / FILE_MEMORY_ALIGN * FILE_MEMORY_ALIGN;
+	}
+
+	return off;
+}
+
+/*! \brief Write the header and set the size of the file
+ *
+ * \param file file name
+ * \param hd header
+ * \param sz_file size of the file
+ *
+ * \return true if succeed
+ *
+ */
+static inline bool file_memory_write_header(const std::string & file, const file_memory_header & hd, size_t sz_file)
+{
+	int fd = ::open(file.c_str(),O_RDWR | O_CREAT | O_TRUNC,0644);
+
+	if (fd == -1)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error creating the file " << file << std::endl;
+		return false;
+	}
+
+	bool ok = pwrite(fd,&hd,sizeof(file_memory_header),0) == sizeof(file_memory_header);
+	ok &= ftruncate(fd,sz_file) == 0;
+
+	close(fd);
+
+	if (ok == false)
+	{std::cerr << __FILE__ << ":" << __LINE__ << " error writing the file " << file << std::endl;}
+
+	return ok;
+}
+
+/*! \brief Read the header of a file and check that it match the header expected
+ *
+ * \param file file name
+ * \param hd_ex expected header (only type and layout fields are checked)
+ * \param hd header read
+ *
+ * \return true if the file can be mapped with the expected layout
+ *
+ */
+static inline bool file_memory_read_header(const std::string & file, const file_memory_header & hd_ex, file_memory_header & hd)
+{
+	int fd = ::open(file.c_str(),O_RDONLY);
+
+	if (fd == -1)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error opening the file " << file << std::endl;
+		return false;
+	}
+
+	bool ok = pread(fd,&hd,sizeof(file_memory_header),0) == sizeof(file_memory_header);
+	close(fd);
+
+	if (ok == false || memcmp(hd.magic,"OFPMFILE",8) != 0)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " is not a container file" << std::endl;
+		return false;
+	}
+
+	if (hd.version != FILE_MEMORY_VERSION)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " has version " << hd.version << " expected " << FILE_MEMORY_VERSION << std::endl;
+		return false;
+	}
+
+	if (hd.layout != hd_ex.layout)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " is stored with layout " << ((hd.layout == FILE_MEMORY_LAYOUT_LIN)?"memory_traits_lin":"memory_traits_inte") << " but the container use a different layout" << std::endl;
+		return false;
+	}
+
+	if (hd.dim != hd_ex.dim || hd.n_prop != hd_ex.n_prop || hd.size_elem != hd_ex.size_elem || memcmp(hd.prp_size,hd_ex.prp_size,sizeof(hd.prp_size)) != 0)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error " << file << " store a different object type" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/*! \brief Create a vector of n elements stored in a file
+ *
+ * The previous content of the vector is discarded, the elements are zero. The vector must use FileMemory
+ * as Memory, the elements are written in the file as they are modified. The vector cannot grow
+ * beyond n elements
+ *
+ * \param v vector
+ * \param file file name
+ * \param n number of elements
+ *
+ * \return true if succeed
+ *
+ */
+template<typename vector_type>
+bool vector_file_create(vector_type & v, const std::string & file, size_t n)
+{
+	typedef typename vector_type::value_type T;
+
+	file_memory_header hd;
+	size_t sz_file = file_memory_make_header<T,typename vector_type::layout_base_>(hd,1,&n);
+
+	if (file_memory_write_header(file,hd,sz_file) == false)
+	{return false;}
+
+	vector_type v_new;
+
+	file_memory_set_prp<vector_type> fsp(v_new,hd,file,FILE_MEMORY_RW);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fsp);
+
+	if (fsp.ok == false)	{return false;}
+
+	// reserve allocate exactly n elements
+	v_new.reserve(n);
+	v_new.resize(n);
+	v.swap(v_new);
+
+	return true;
+}
+
+/*! \brief Open a vector stored in a file created with vector_file_create
+ *
+ * The elements are not read, the pages are loaded when accessed
+ *
+ * \param v vector
+ * \param file file name
+ * \param mode FILE_MEMORY_RW modifications are written in the file, FILE_MEMORY_READ modifications are discarded
+ *
+ * \return true if succeed
+ *
+ */
+template<typename vector_type>
+bool vector_file_open(vector_type & v, const std::string & file, int mode = FILE_MEMORY_RW)
+{
+	typedef typename vector_type::value_type T;
+
+	size_t n = 0;
+	file_memory_header hd_ex;
+	file_memory_header hd;
+	file_memory_make_header<T,typename vector_type::layout_base_>(hd_ex,1,&n);
+
+	if (file_memory_read_header(file,hd_ex,hd) == false)
+	{return false;}
+
+	vector_type v_new;
+
+	file_memory_set_prp<vector_type> fsp(v_new,hd,file,mode);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fsp);
+
+	if (fsp.ok == false)	{return false;}
+
+	v_new.reserve(hd.n_ele);
+	v_new.resize(hd.n_ele);
+	v.swap(v_new);
+
+	return true;
+}
+
+/*! \brief Create a grid stored in a file
+ *
+ * The previous content of the grid is discarded, the elements are zero. The grid must use FileMemory
+ * as memory
+ *
+ * \snippet memory_conf_unit_tests.cpp grid stored in a file
+ *
+ * \param g grid
+ * \param file file name
+ * \param sz size of the grid
+ *
+ * \return true if succeed
+ *
+ */
+template<typename grid_type>
+bool grid_file_create(grid_type & g, const std::string & file, const size_t (& sz)[grid_type::dims])
+{
+	typedef typename grid_type::value_type T;
+
+	file_memory_header hd;
+	size_t sz_file = file_memory_make_header<T,typename grid_type::layout_base_>(hd,grid_type::dims,sz);
+
+	if (file_memory_write_header(file,hd,sz_file) == false)
+	{return false;}
+
+	grid_type g_new(sz);
+
+	file_memory_set_prp<grid_type> fsp(g_new,hd,file,FILE_MEMORY_RW);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fsp);
+
+	if (fsp.ok == false)	{return false;}
+
+	g.swap(g_new);
+
+	return true;
+}
+
+/*! \brief Open a grid stored in a file created with grid_file_create
+ *
+ * The grid take the size stored in the file. The elements are not read, the pages are loaded when accessed
+ *
+ * \param g grid
+ * \param file file name
+ * \param mode FILE_MEMORY_RW modifications are written in the file, FILE_MEMORY_READ modifications are discarded
+ *
+ * \return true if succeed
+ *
+ */
+template<typename grid_type>
+bool grid_file_open(grid_type & g, const std::string & file, int mode = FILE_MEMORY_RW)
+{
+	typedef typename grid_type::value_type T;
+
+	size_t sz[grid_type::dims];
+	for (size_t i = 0 ; i < grid_type::dims ; i++)
+	{sz[i] = 0;}
+
+	file_memory_header hd_ex;
+	file_memory_header hd;
+	file_memory_make_header<T,typename grid_type::layout_base_>(hd_ex,grid_type::dims,sz);
+
+	if (file_memory_read_header(file,hd_ex,hd) == false)
+	{return false;}
+
+	for (size_t i = 0 ; i < grid_type::dims ; i++)
+	{sz[i] = hd.sz[i];}
+
+	grid_type g_new(sz);
+
+	file_memory_set_prp<grid_type> fsp(g_new,hd,file,mode);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(fsp);
+
+	if (fsp.ok == false)	{return false;}
+
+	g.swap(g_new);
+
+	return true;
+}
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_FILEMEMORY_HPP_ */
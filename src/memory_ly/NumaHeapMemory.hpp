@@ -0,0 +1,580 @@
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_NUMAHEAPMEMORY_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_NUMAHEAPMEMORY_HPP_
+
+#include "memory/memory.hpp"
+#include "util/thread_pool.hpp"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+//! Use the standard pages
+#define NUMA_MEM_PAGE_DEFAULT 0
+//! Ask the kernel for transparent huge pages (madvise MADV_HUGEPAGE)
+#define NUMA_MEM_HUGE_TRANSPARENT 1
+//! Use explicit huge pages (MAP_HUGETLB), fall back to transparent huge pages if none are reserved
+#define NUMA_MEM_HUGE_EXPLICIT 2
+
+//! Pages are placed by whatever thread touch them first
+#define NUMA_MEM_PLACE_DEFAULT 0
+//! Pages are touched in parallel with the same block partition used by openfpm::parallel_for
+#define NUMA_MEM_FIRST_TOUCH 1
+//! Pages are interleaved across all the NUMA nodes allowed to the process
+#define NUMA_MEM_INTERLEAVE 2
+
+//! Allocations smaller than this are served by the standard allocator without page policy
+#ifndef NUMA_MEM_THRESHOLD
+#define NUMA_MEM_THRESHOLD (2*1024*1024)
+#endif
+
+//! Size of the huge pages
+#ifndef NUMA_MEM_HUGE_PAGE_SIZE
+#define NUMA_MEM_HUGE_PAGE_SIZE (2*1024*1024)
+#endif
+
+/*! \brief Host memory with control over the page size and the NUMA placement of the pages
+ *
+ * It can be used everywhere HeapMemory is used, in particular as Memory argument of openfpm::vector
+ * and as S argument of grid_base/grid_cpu
+ *
+ * \snippet memory_conf_unit_tests.cpp numa heap memory usage
+ *
+ * Big buffers are allocated with mmap. With NUMA_MEM_FIRST_TOUCH every new page is touched (and every
+ * copy is done) by openfpm::parallel_for_blocks splitting the buffer in get_num_threads() contiguous
+ * blocks. A parallel_for over the elements of the container split the elements in the same way,
+ * so each thread find its part of the data on its own NUMA node. This work as long as the threads
+ * of the pool are pinned (OMP_PROC_BIND, numactl, taskset ...) and the number of threads is not
+ * changed between allocation and use.
+ *
+ * Requesting huge pages or NUMA placement is only an hint, if the system does not support it the
+ * memory is allocated with the standard pages and the default placement
+ *
+ * It implement the memory interface and the members of HeapMemory used by the containers, all the
+ * accesses (also the ones through a memory pointer) reach the buffer allocated here
+ *
+ * \tparam page_opt NUMA_MEM_PAGE_DEFAULT NUMA_MEM_HUGE_TRANSPARENT NUMA_MEM_HUGE_EXPLICIT
+ * \tparam place_opt NUMA_MEM_PLACE_DEFAULT NUMA_MEM_FIRST_TOUCH NUMA_MEM_INTERLEAVE
+ *
+ */
+template<unsigned int page_opt = NUMA_MEM_HUGE_TRANSPARENT, unsigned int place_opt = NUMA_MEM_FIRST_TOUCH>
+class NumaHeapMemory : public memory
+{
+	//! Size of the memory
+	size_t sz;
+
+	//! Size of the mapping (0 if the memory is not mapped with mmap)
+	size_t sz_map;
+
+	//! Pointer to the memory
+	void * mem;
+
+	//! Reference counter
+	long int ref_cnt;
+
+	/*! \brief Number of blocks used to split a buffer of the given mapping size
+	 *
+	 * \param len_map size of the mapping (0 if not mapped)
+	 *
+	 * \return the number of blocks
+	 *
+	 */
+	static size_t n_blocks(size_t len_map)
+	{
+		return (len_map != 0 && place_opt == NUMA_MEM_FIRST_TOUCH)?openfpm::get_num_threads():1;
+	}
+
+	/*! \brief Place the pages of the buffer touching them with the block partition of [0,len)
+	 *
+	 * The bytes in [0,src_sz) are copied from src, the pages after touch_from are touched
+	 *
+	 * \param ptr buffer
+	 * \param len size of the buffer
+	 * \param len_map size of the mapping
+	 * \param touch_from bytes before this are not touched (they are already placed)
+	 * \param src if not NULL the bytes are copied from src
+	 * \param src_sz number of bytes to copy from src
+	 *
+	 */
+	static void place(void * ptr, size_t len, size_t len_map, size_t touch_from, const void * src, size_t src_sz)
+	{
+		openfpm::parallel_for_blocks(0,len,n_blocks(len_map),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			size_t c_stop = (b_stop < src_sz)?b_stop:src_sz;
+
+			if (src != NULL && b_start < c_stop)
+			{memcpy((char *)ptr + b_start,(const char *)src + b_start,c_stop - b_start);}
+
+			size_t t_start = (b_start < touch_from)?touch_from:b_start;
+			t_start = (t_start < c_stop)?c_stop:t_start;
+
+			// pages from mmap are already zero, writing one byte for each page is enough
+			// to place them
+			for (size_t i = t_start ; i < b_stop ; i += getpagesize())
+			{((volatile char *)ptr)[i] = 0;}
+		});
+	}
+
+	/*! \brief Interleave the pages of the buffer across the allowed NUMA nodes
+	 *
+	 * \param ptr buffer
+	 * \param len size of the buffer
+	 *
+	 */
+	static void interleave(void * ptr, size_t len)
+	{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+
+		// values from linux/mempolicy.h
+		const int mpol_interleave = 3;
+		const unsigned long mpol_f_mems_allowed = 1 << 2;
+
+		unsigned long nodes[16];
+		const unsigned long max_node = sizeof(nodes)*8;
+
+		if (syscall(SYS_get_mempolicy,NULL,nodes,max_node,NULL,mpol_f_mems_allowed) != 0)
+		{return;}
+
+		syscall(SYS_mbind,ptr,len,mpol_interleave,nodes,max_node,0);
+
+#endif
+	}
+
+	/*! \brief Map a buffer of at least len bytes with the page option
+	 *
+	 * \param len requested size
+	 * \param len_map size of the mapping
+	 *
+	 * \return the pointer to the buffer, NULL if the allocation failed
+	 *
+	 */
+	static void * map(size_t len, size_t & len_map)
+	{
+		void * ptr = MAP_FAILED;
+
+		if (page_opt == NUMA_MEM_PAGE_DEFAULT)
+		{
+			len_map = (len + getpagesize() - 1) / getpagesize() * getpagesize();
+			ptr = mmap(NULL,len_map,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+		}
+		else
+		{
+			len_map = (len + NUMA_MEM_HUGE_PAGE_SIZE - 1) / NUMA_MEM_HUGE_PAGE_SIZE * NUMA_MEM_HUGE_PAGE_SIZE;
+
+#ifdef MAP_HUGETLB
+			if (page_opt == NUMA_MEM_HUGE_EXPLICIT)
+			{ptr = mmap(NULL,len_map,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,-1,0);}
+#endif
+
+			if (ptr == MAP_FAILED)
+			{
+				// Over-allocate to align the buffer to the huge page size, the kernel
+				// can use huge pages only on aligned regions
+
+				size_t len_al = len_map + NUMA_MEM_HUGE_PAGE_SIZE;
+				char * ptr_al = (char *)mmap(NULL,len_al,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+
+				if ((void *)ptr_al == MAP_FAILED)
+				{return NULL;}
+
+				size_t head = (NUMA_MEM_HUGE_PAGE_SIZE - (size_t)ptr_al % NUMA_MEM_HUGE_PAGE_SIZE) % NUMA_MEM_HUGE_PAGE_SIZE;
+
+				if (head != 0)
+				{munmap(ptr_al,head);}
+				if (len_al - head - len_map != 0)
+				{munmap(ptr_al + head + len_map,len_al - head - len_map);}
+
+				ptr = ptr_al + head;
+
+#ifdef MADV_HUGEPAGE
+				madvise(ptr,len_map,MADV_HUGEPAGE);
+#endif
+			}
+		}
+
+		if (ptr == MAP_FAILED)
+		{return NULL;}
+
+		if (place_opt == NUMA_MEM_INTERLEAVE)
+		{interleave(ptr,len_map);}
+
+		return ptr;
+	}
+
+	/*! \brief Allocate a new buffer of size len, copying the first src_sz bytes from src
+	 *
+	 * \param len size of the new buffer
+	 * \param src source of the copy (can be NULL)
+	 * \param src_sz bytes to copy
+	 *
+	 * \return true if the allocation succeed
+	 *
+	 */
+	bool alloc_copy(size_t len, const void * src, size_t src_sz)
+	{
+		size_t len_map = 0;
+		void * ptr;
+
+		if (len < NUMA_MEM_THRESHOLD)
+		{
+			if (posix_memalign(&ptr,64,(len == 0)?64:len) != 0)
+			{return false;}
+
+			if (src != NULL)
+			{memcpy(ptr,src,src_sz);}
+		}
+		else
+		{
+			ptr = map(len,len_map);
+
+			if (ptr == NULL)
+			{
+				std::cerr << __FILE__ << ":" << __LINE__ << " error mmap failed allocating " << len << " bytes" << std::endl;
+				return false;
+			}
+
+			place(ptr,len,len_map,0,src,src_sz);
+		}
+
+		release();
+
+		mem = ptr;
+		sz = len;
+		sz_map = len_map;
+
+		return true;
+	}
+
+	//! Release the buffer
+	void release()
+	{
+		if (mem == NULL)	{return;}
+
+		if (sz_map != 0)
+		{munmap(mem,sz_map);}
+		else
+		{free(mem);}
+
+		mem = NULL;
+		sz = 0;
+		sz_map = 0;
+	}
+
+public:
+
+	/*! \brief Allocate memory
+	 *
+	 * \param sz size of the memory
+	 *
+	 * \return true if the allocation succeed
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		if (mem != NULL)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error memory already allocated" << std::endl;
+			return false;
+		}
+
+		return alloc_copy(sz,NULL,0);
+	}
+
+	//! Destroy the memory
+	virtual void destroy()
+	{
+		release();
+	}
+
+	/*! \brief Copy the memory from another device
+	 *
+	 * \param m memory from where to copy
+	 *
+	 * \return true if the copy succeed
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error source memory is bigger than the destination" << std::endl;
+			return false;
+		}
+
+		const void * src = m.getPointer();
+		size_t src_sz = m.size();
+
+		openfpm::parallel_for_blocks(0,sz,n_blocks(sz_map),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			b_stop = (b_stop < src_sz)?b_stop:src_sz;
+
+			if (b_start < b_stop)
+			{memcpy((char *)mem + b_start,(const char *)src + b_start,b_stop - b_start);}
+		});
+
+		return true;
+	}
+
+	/*! \brief Get the size of the memory
+	 *
+	 * \return the size of the memory
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief Resize the memory preserving the content
+	 *
+	 * A reallocation copy the old content with the same partition used to place the pages
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if the resize succeed
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)
+		{return true;}
+
+		if (sz_map != 0 && sz <= sz_map)
+		{
+			// the mapping is big enough, only the new part must be placed
+			place(mem,sz,sz_map,this->sz,NULL,0);
+			this->sz = sz;
+			return true;
+		}
+
+		return alloc_copy(sz,mem,this->sz);
+	}
+
+	/*! \brief Return a readable pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return mem;
+	}
+
+	/*! \brief Return a readable pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return mem;
+	}
+
+	/*! \brief Return the device pointer (host and device are the same)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return mem;
+	}
+
+	/*! \brief Return the pointer to the memory
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getPointerBase()
+	{
+		return mem;
+	}
+
+	//! Do nothing (host and device are the same)
+	virtual void hostToDevice()
+	{}
+
+	//! Do nothing (host and device are the same)
+	virtual void deviceToHost()
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param start unused
+	 * \param stop unused
+	 *
+	 */
+	virtual void hostToDevice(size_t start, size_t stop)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param start unused
+	 * \param stop unused
+	 *
+	 */
+	virtual void deviceToHost(size_t start, size_t stop)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param m unused
+	 *
+	 */
+	virtual void hostToDevice(memory & m)
+	{}
+
+	/*! \brief Do nothing (host and device are the same)
+	 *
+	 * \param m unused
+	 *
+	 */
+	virtual void deviceToHost(memory & m)
+	{}
+
+	/*! \brief Host and device memory are the same
+	 *
+	 * \return true
+	 *
+	 */
+	static constexpr bool isDeviceHostSame()
+	{
+		return true;
+	}
+
+	/*! \brief Fill the memory with a byte
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		openfpm::parallel_for_blocks(0,sz,n_blocks(sz_map),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			memset((char *)mem + b_start,c,b_stop - b_start);
+		});
+	}
+
+	//! Increment the reference counter
+	virtual void incRef()
+	{ref_cnt++;}
+
+	//! Decrement the reference counter
+	virtual void decRef()
+	{ref_cnt--;}
+
+	/*! \brief Return the reference counter
+	 *
+	 * \return the reference counter
+	 *
+	 */
+	virtual long int ref()
+	{
+		return ref_cnt;
+	}
+
+	/*! \brief Allocated memory is not initialized
+	 *
+	 * \return false
+	 *
+	 */
+	virtual bool isInitialized()
+	{
+		return false;
+	}
+
+	/*! \brief Return true if the buffer has been allocated with the page and placement policy
+	 *
+	 * Small buffers (less than NUMA_MEM_THRESHOLD) are allocated with the standard allocator
+	 *
+	 * \return true if the buffer is mapped
+	 *
+	 */
+	bool isMapped() const
+	{
+		return sz_map != 0;
+	}
+
+	/*! \brief Swap the memory
+	 *
+	 * \param m memory to swap with
+	 *
+	 */
+	void swap(NumaHeapMemory & m)
+	{
+		size_t sz_tmp = sz;
+		sz = m.sz;
+		m.sz = sz_tmp;
+
+		size_t sz_map_tmp = sz_map;
+		sz_map = m.sz_map;
+		m.sz_map = sz_map_tmp;
+
+		void * mem_tmp = mem;
+		mem = m.mem;
+		m.mem = mem_tmp;
+
+		long int ref_tmp = ref_cnt;
+		ref_cnt = m.ref_cnt;
+		m.ref_cnt = ref_tmp;
+	}
+
+	//! Copy operator
+	NumaHeapMemory & operator=(const NumaHeapMemory & m)
+	{
+		if (this == &m)	{return *this;}
+
+		release();
+
+		if (m.mem != NULL)
+		{alloc_copy(m.sz,m.mem,m.sz);}
+
+		return *this;
+	}
+
+	//! Move operator
+	NumaHeapMemory & operator=(NumaHeapMemory && m)
+	{
+		release();
+		swap(m);
+
+		return *this;
+	}
+
+	//! Constructor
+	NumaHeapMemory()
+	:sz(0),sz_map(0),mem(NULL),ref_cnt(0)
+	{}
+
+	//! Copy constructor
+	NumaHeapMemory(const NumaHeapMemory & m)
+	:sz(0),sz_map(0),mem(NULL),ref_cnt(0)
+	{
+		if (m.mem != NULL)
+		{alloc_copy(m.sz,m.mem,m.sz);}
+	}
+
+	//! Move constructor
+	NumaHeapMemory(NumaHeapMemory && m)
+	:sz(0),sz_map(0),mem(NULL),ref_cnt(0)
+	{
+		swap(m);
+	}
+
+	//! Destructor
+	~NumaHeapMemory()
+	{
+		if (ref_cnt == 0)
+		{release();}
+		else
+		{std::cerr << __FILE__ << ":" << __LINE__ << " error destroying a live object" << std::endl;}
+	}
+};
+
+//! Memory with transparent huge pages interleaved across the NUMA nodes
+typedef NumaHeapMemory<NUMA_MEM_HUGE_TRANSPARENT,NUMA_MEM_INTERLEAVE> InterleavedHeapMemory;
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_NUMAHEAPMEMORY_HPP_ */
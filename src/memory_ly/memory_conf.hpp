@@ -12,6 +12,7 @@
 #include "t_to_memory_c.hpp"
 #include "Vector/vect_isel.hpp"
 #include "Vector/util.hpp"
+#include "memory_traits_aosoa.hpp"
 
 constexpr int SOA_layout_IA = 2;
 constexpr int SOA_layout = 1;
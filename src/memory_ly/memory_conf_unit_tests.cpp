@@ -2,6 +2,9 @@
 #include <boost/test/unit_test.hpp>
 #include "memory_ly/memory_conf.hpp"
 #include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+#include "memory_ly/NumaHeapMemory.hpp"
+#include "memory_ly/FileMemory.hpp"
 
 BOOST_AUTO_TEST_SUITE( memory_conf_test )
 
@@ -25,4 +28,513 @@ BOOST_AUTO_TEST_CASE( memory_conf_use )
 	BOOST_REQUIRE_EQUAL(test,true);
 }
 
+/*! \brief Fill an element of the test vectors
+ *
+ * \param v vector
+ * \param i element
+ *
+ */
+template<typename vector_type>
+void aosoa_fill_element(vector_type & v, size_t i)
+{
+	v.template get<0>(i) = i;
+	v.template get<1>(i)[0] = 2.0*i;
+	v.template get<1>(i)[1] = 2.0*i+1.0;
+	v.template get<1>(i)[2] = 2.0*i+2.0;
+	v.template get<2>(i)[0][0] = 4*i;
+	v.template get<2>(i)[0][1] = 4*i+1;
+	v.template get<2>(i)[1][0] = 4*i+2;
+	v.template get<2>(i)[1][1] = 4*i+3;
+}
+
+/*! \brief Check that two vectors store the same elements
+ *
+ * \param v1 first vector
+ * \param v2 second vector
+ *
+ * \return true if they match
+ *
+ */
+template<typename vector_type1, typename vector_type2>
+bool aosoa_compare(const vector_type1 & v1, const vector_type2 & v2)
+{
+	if (v1.size() != v2.size())
+	{return false;}
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{
+		match &= v1.template get<0>(i) == v2.template get<0>(i);
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{match &= v1.template get<1>(i)[j] == v2.template get<1>(i)[j];}
+
+		for (size_t j = 0 ; j < 2 ; j++)
+		{
+			for (size_t k = 0 ; k < 2 ; k++)
+			{match &= v1.template get<2>(i)[j][k] == v2.template get<2>(i)[j][k];}
+		}
+	}
+
+	return match;
+}
+
+template<template<typename> class layout_aosoa>
+void memory_conf_aosoa_vector_test()
+{
+	typedef aggregate<float,double[3],int[2][2]> part;
+
+	openfpm::vector<part> v_lin;
+	openfpm::vector<part,HeapMemory,layout_aosoa> v;
+
+	// the vector size is not a multiple of the tile width
+
+	for (size_t i = 0 ; i < 1003 ; i++)
+	{
+		v.add();
+		v_lin.add();
+
+		aosoa_fill_element(v,v.size()-1);
+		aosoa_fill_element(v_lin,v_lin.size()-1);
+	}
+
+	BOOST_REQUIRE_EQUAL(aosoa_compare(v,v_lin),true);
+
+	// remove and copy of objects
+
+	v.remove(17);
+	v_lin.remove(17);
+
+	v.get(5) = v.get(900);
+	v_lin.get(5) = v_lin.get(900);
+
+	v.set(6,v.get(901));
+	v_lin.set(6,v_lin.get(901));
+
+	v.get(7) = v_lin.get(902);
+	v_lin.get(7) = v_lin.get(902);
+
+	BOOST_REQUIRE_EQUAL(aosoa_compare(v,v_lin),true);
+
+	// add from an object
+
+	part p;
+	p.template get<0>() = -1.0;
+	p.template get<1>()[0] = -2.0;
+	p.template get<1>()[1] = -3.0;
+	p.template get<1>()[2] = -4.0;
+	p.template get<2>()[0][0] = -5;
+	p.template get<2>()[0][1] = -6;
+	p.template get<2>()[1][0] = -7;
+	p.template get<2>()[1][1] = -8;
+
+	v.add(p);
+	v_lin.add(p);
+
+	BOOST_REQUIRE_EQUAL(aosoa_compare(v,v_lin),true);
+
+	// copy and resize
+
+	openfpm::vector<part,HeapMemory,layout_aosoa> v2 = v;
+	v2.resize(500);
+	v_lin.resize(500);
+
+	BOOST_REQUIRE_EQUAL(aosoa_compare(v2,v_lin),true);
+
+	// access by tile
+
+	const unsigned int W = layout_aosoa<part>::tile_size;
+	auto & base = v2.getInternal_base();
+
+	// the internal grid has the capacity of the vector
+	BOOST_REQUIRE(base.size_tiles() >= (v2.size() + W - 1) / W);
+
+	bool match = true;
+	for (size_t t = 0 ; t < (v2.size() + W - 1) / W ; t++)
+	{
+		for (size_t j = 0 ; j < W && t*W + j < v2.size() ; j++)
+		{
+			match &= base.template getTile<0>(t)[j] == v2.template get<0>(t*W + j);
+			match &= base.template getTile<1>(t)[2][j] == v2.template get<1>(t*W + j)[2];
+			match &= base.template getTile<2>(t)[1][0][j] == v2.template get<2>(t*W + j)[1][0];
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( memory_conf_aosoa_vector )
+{
+	memory_conf_aosoa_vector_test<memory_traits_aosoa>();
+	memory_conf_aosoa_vector_test<memory_traits_aosoa_tile<4>::layout>();
+	memory_conf_aosoa_vector_test<memory_traits_aosoa_tile<16>::layout>();
+
+	//! [Vector with AoSoA layout]
+
+	openfpm::vector<aggregate<float,float[3]>,HeapMemory,memory_traits_aosoa> v;
+	v.resize(1024);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.get<0>(i) = 1.0;
+		v.get<1>(i)[0] = i;
+		v.get<1>(i)[1] = 2*i;
+		v.get<1>(i)[2] = 3*i;
+	}
+
+	// each tile store AOSOA_TILE_SIZE contiguous values for each component
+	auto & base = v.getInternal_base();
+
+	for (size_t t = 0 ; t < v.size() / AOSOA_TILE_SIZE ; t++)
+	{
+		float (& s)[AOSOA_TILE_SIZE] = base.getTile<0>(t);
+		float (& x)[3][AOSOA_TILE_SIZE] = base.getTile<1>(t);
+
+		for (size_t j = 0 ; j < AOSOA_TILE_SIZE ; j++)
+		{s[j] = x[0][j] + x[1][j] + x[2][j];}
+	}
+
+	//! [Vector with AoSoA layout]
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{match &= v.get<0>(i) == 6*i;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( memory_conf_aosoa_grid )
+{
+	typedef aggregate<float,float[3]> part;
+
+	//! [Grid with AoSoA layout]
+
+	size_t sz[3] = {13,17,11};
+
+	grid_base<3,part,HeapMemory,memory_traits_aosoa<part>::type> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 100*key.get(1) + 10000*key.get(2);
+		g.template get<1>(key)[0] = key.get(0);
+		g.template get<1>(key)[1] = key.get(1);
+		g.template get<1>(key)[2] = key.get(2);
+
+		++it;
+	}
+
+	//! [Grid with AoSoA layout]
+
+	size_t sz2[3] = {20,15,14};
+	g.resize(sz2);
+
+	bool match = true;
+
+	grid_sm<3,void> g_sm(sz);
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		if (key.get(0) < 13 && key.get(1) < 15 && key.get(2) < 11)
+		{
+			match &= g.template get<0>(key) == key.get(0) + 100*key.get(1) + 10000*key.get(2);
+			match &= g.template get<1>(key)[0] == key.get(0);
+			match &= g.template get<1>(key)[1] == key.get(1);
+			match &= g.template get<1>(key)[2] == key.get(2);
+		}
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the same layout on a grid with a different tile width
+
+	grid_base<3,part,HeapMemory,memory_traits_aosoa_tile<32>::layout<part>::type> g2(sz2);
+	g2.setMemory();
+
+	auto it3 = g.getIterator();
+
+	while (it3.isNext())
+	{
+		auto key = it3.get();
+
+		g2.template get<0>(key) = g.template get<0>(key);
+		g2.template get<1>(key) = g.template get<1>(key);
+
+		++it3;
+	}
+
+	match = true;
+	for (size_t i = 0 ; i < g.getGrid().size() ; i++)
+	{
+		match &= g.template get<0>(i) == g2.template get<0>(i);
+		match &= g.template get<1>(i)[1] == g2.template get<1>(i)[1];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Test a vector and a grid allocated with NumaHeapMemory
+ *
+ * \tparam Mem NumaHeapMemory with the page and placement options to test
+ *
+ */
+template<typename Mem>
+void numa_heap_memory_test()
+{
+	// The memory alone
+
+	Mem m;
+	m.allocate(1024);
+
+	BOOST_REQUIRE_EQUAL(m.isMapped(),false);
+
+	m.fill(7);
+	m.resize(3*NUMA_MEM_THRESHOLD + 100);
+
+	BOOST_REQUIRE_EQUAL(m.isMapped(),true);
+	BOOST_REQUIRE_EQUAL(m.size(),3*NUMA_MEM_THRESHOLD + 100);
+
+	bool match = true;
+	for (size_t i = 0 ; i < 1024 ; i++)
+	{match &= ((unsigned char *)m.getPointer())[i] == 7;}
+	for (size_t i = 1024 ; i < m.size() ; i++)
+	{match &= ((unsigned char *)m.getPointer())[i] == 0;}
+
+	Mem m2;
+	m2.allocate(m.size());
+	((unsigned char *)m.getPointer())[m.size()-1] = 9;
+	m2.copy(m);
+
+	match &= ((unsigned char *)m2.getPointer())[0] == 7;
+	match &= ((unsigned char *)m2.getPointer())[m.size()-1] == 9;
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// A vector that grow from the standard allocator to the mapped memory
+
+	openfpm::vector<aggregate<float,float[3]>,Mem> v;
+
+	for (size_t i = 0 ; i < 300000 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = 2.0*i;
+		v.template get<1>(i)[1] = 3.0*i;
+		v.template get<1>(i)[2] = 4.0*i;
+	}
+
+	openfpm::vector<aggregate<float,float[3]>,Mem> v2 = v.duplicate();
+	v.clear();
+	v.swap(v2);
+
+	match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v.template get<0>(i) == (float)i;
+		match &= v.template get<1>(i)[0] == (float)(2.0*i);
+		match &= v.template get<1>(i)[2] == (float)(4.0*i);
+	}
+
+	BOOST_REQUIRE_EQUAL(v.size(),300000ul);
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// A grid
+
+	size_t sz[3] = {64,64,64};
+	grid_cpu<3,aggregate<float,float[3]>,grid_sm<3,void>,Mem> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 100*key.get(1) + 10000*key.get(2);
+
+		++it;
+	}
+
+	size_t sz2[3] = {70,64,64};
+	g.resize(sz2);
+
+	match = true;
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		if (key.get(0) < 64)
+		{match &= g.template get<0>(key) == key.get(0) + 100*key.get(1) + 10000*key.get(2);}
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE( numa_heap_memory_use )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	numa_heap_memory_test<NumaHeapMemory<>>();
+	numa_heap_memory_test<NumaHeapMemory<NUMA_MEM_PAGE_DEFAULT,NUMA_MEM_FIRST_TOUCH>>();
+	numa_heap_memory_test<NumaHeapMemory<NUMA_MEM_HUGE_EXPLICIT,NUMA_MEM_PLACE_DEFAULT>>();
+	numa_heap_memory_test<InterleavedHeapMemory>();
+
+	//! [numa heap memory usage]
+
+	// transparent huge pages, pages touched in parallel by the threads that will use them
+	openfpm::vector<aggregate<double,double[3]>,NumaHeapMemory<NUMA_MEM_HUGE_TRANSPARENT,NUMA_MEM_FIRST_TOUCH>> v;
+	v.resize(1024*1024);
+
+	openfpm::parallel_for(0,v.size(),[&](size_t i)
+	{
+		v.template get<0>(i) = i;
+	});
+
+	//! [numa heap memory usage]
+
+	BOOST_REQUIRE_EQUAL(v.template get<0>(v.size()-1),1024*1024-1);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+/*! \brief Test a vector stored in a file with the selected layout
+ *
+ * \tparam layout_base memory layout
+ *
+ */
+template<template<typename> class layout_base>
+void file_memory_vector_test()
+{
+	typedef openfpm::vector<aggregate<float,double[3],int>,FileMemory,layout_base> vector_type;
+
+	{
+	vector_type v;
+	v.add();
+
+	bool ret = vector_file_create(v,"file_memory_vector.bin",100000);
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(v.size(),100000ul);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[0] = 2.0*i;
+		v.template get<1>(i)[1] = 3.0*i;
+		v.template get<1>(i)[2] = 4.0*i;
+		v.template get<2>(i) = -(int)i;
+	}
+	}
+
+	// reopen without any copy
+
+	vector_type v2;
+	bool ret = vector_file_open(v2,"file_memory_vector.bin");
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(v2.size(),100000ul);
+
+	bool match = true;
+	for (size_t i = 0 ; i < v2.size() ; i++)
+	{
+		match &= v2.template get<0>(i) == (float)i;
+		match &= v2.template get<1>(i)[0] == 2.0*i;
+		match &= v2.template get<1>(i)[2] == 4.0*i;
+		match &= v2.template get<2>(i) == -(int)i;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// modifications with FILE_MEMORY_READ are not written
+
+	{
+	vector_type v3;
+	ret = vector_file_open(v3,"file_memory_vector.bin",FILE_MEMORY_READ);
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	v3.template get<0>(10) = -1.0;
+	}
+
+	BOOST_REQUIRE_EQUAL(v2.template get<0>(10),10.0);
+}
+
+BOOST_AUTO_TEST_CASE( file_memory_use )
+{
+	file_memory_vector_test<memory_traits_lin>();
+	file_memory_vector_test<memory_traits_inte>();
+
+	// a file written with a layout cannot be opened with the other
+
+	openfpm::vector<aggregate<float,double[3],int>,FileMemory,memory_traits_lin> v_lin;
+	bool ret = vector_file_open(v_lin,"file_memory_vector.bin");
+	BOOST_REQUIRE_EQUAL(ret,false);
+
+	// or as a different type
+
+	openfpm::vector<aggregate<float,double[3]>,FileMemory,memory_traits_inte> v_type;
+	ret = vector_file_open(v_type,"file_memory_vector.bin");
+	BOOST_REQUIRE_EQUAL(ret,false);
+
+	//! [grid stored in a file]
+
+	size_t sz[3] = {32,16,8};
+
+	{
+	grid_cpu<3,aggregate<float,float[3]>,grid_sm<3,void>,FileMemory> g;
+	grid_file_create(g,"file_memory_grid.bin",sz);
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 100*key.get(1) + 10000*key.get(2);
+		g.template get<1>(key)[2] = key.get(2);
+
+		++it;
+	}
+	}
+
+	// The size and the layout are read from the file
+	grid_cpu<3,aggregate<float,float[3]>,grid_sm<3,void>,FileMemory> g2;
+	grid_file_open(g2,"file_memory_grid.bin");
+
+	//! [grid stored in a file]
+
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(0),32ul);
+	BOOST_REQUIRE_EQUAL(g2.getGrid().size(2),8ul);
+
+	bool match = true;
+	auto it2 = g2.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g2.template get<0>(key) == key.get(0) + 100*key.get(1) + 10000*key.get(2);
+		match &= g2.template get<1>(key)[2] == key.get(2);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	remove("file_memory_vector.bin");
+	remove("file_memory_grid.bin");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,796 @@
+#ifndef OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_TRAITS_AOSOA_HPP_
+#define OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_TRAITS_AOSOA_HPP_
+
+#include <type_traits>
+#include <boost/mpl/int.hpp>
+#include <boost/fusion/include/at_c.hpp>
+#include "util/variadic_to_vmpl.hpp"
+#include "memory/memory.hpp"
+#include "util/cuda_util.hpp"
+
+//! Default number of elements in a tile of the memory_traits_aosoa layout
+#ifndef AOSOA_TILE_SIZE
+#define AOSOA_TILE_SIZE 8
+#endif
+
+constexpr int AOSOA_layout = 3;
+
+/*! \brief Representation of one property inside a tile of W elements
+ *
+ * float -> float[W]
+ *
+ * \tparam T property type
+ * \tparam W number of elements in the tile
+ *
+ */
+template<typename T, unsigned int W>
+struct aosoa_tile_prp_impl
+{
+	typedef T type[W];
+};
+
+//! Property of type T[N1] -> T[N1][W] (the W elements of each component are contiguous)
+template<typename T, unsigned int W, unsigned int N1>
+struct aosoa_tile_prp_impl<T[N1],W>
+{
+	typedef T type[N1][W];
+};
+
+//! Property of type T[N1][N2] -> T[N1][N2][W]
+template<typename T, unsigned int W, unsigned int N1, unsigned int N2>
+struct aosoa_tile_prp_impl<T[N1][N2],W>
+{
+	typedef T type[N1][N2][W];
+};
+
+//! transform T=aggregate<float,double[3]> into boost::fusion::vector<float[n_ele],double[3][n_ele]>
+template <typename n_ele, typename T>
+struct aosoa_tile_prp
+{
+	typedef aosoa_tile_prp_impl<typename std::remove_const<typename std::remove_reference<T>::type>::type,n_ele::value> type;
+};
+
+/*! \brief Reference to the property T[N1] of one element inside a tile
+ *
+ * \tparam T base type of the property
+ * \tparam N1 number of components
+ * \tparam W number of elements in the tile
+ *
+ */
+template<typename T, unsigned int N1, unsigned int W>
+class aosoa_array_ref
+{
+	//! components of the property inside the tile
+	T (* ptr)[W];
+
+	//! position of the element inside the tile
+	unsigned int off;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param ptr property inside the tile
+	 * \param off position of the element inside the tile
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref(T (* ptr)[W], unsigned int off)
+	:ptr(ptr),off(off)
+	{}
+
+	//! Copy constructor (it copy the reference)
+	aosoa_array_ref(const aosoa_array_ref<T,N1,W> & ref) = default;
+
+	/*! \brief Access one component
+	 *
+	 * \param i component
+	 *
+	 * \return a reference to the component
+	 *
+	 */
+	__device__ __host__ inline T & operator[](size_t i) const
+	{
+		return ptr[i][off];
+	}
+
+	/*! \brief Copy the components of another element
+	 *
+	 * \param src element to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	template<typename Tsrc, unsigned int W2>
+	__device__ __host__ inline aosoa_array_ref<T,N1,W> & operator=(const aosoa_array_ref<Tsrc,N1,W2> & src)
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{ptr[i][off] = src[i];}
+
+		return *this;
+	}
+
+	/*! \brief Copy the components of another element
+	 *
+	 * \param src element to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref<T,N1,W> & operator=(const aosoa_array_ref<T,N1,W> & src)
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{ptr[i][off] = src[i];}
+
+		return *this;
+	}
+
+	/*! \brief Copy an array
+	 *
+	 * \param src array to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref<T,N1,W> & operator=(const typename std::remove_const<T>::type (& src)[N1])
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{ptr[i][off] = src[i];}
+
+		return *this;
+	}
+};
+
+/*! \brief Reference to the property T[N1][N2] of one element inside a tile
+ *
+ * \tparam T base type of the property
+ * \tparam N1 number of rows
+ * \tparam N2 number of columns
+ * \tparam W number of elements in the tile
+ *
+ */
+template<typename T, unsigned int N1, unsigned int N2, unsigned int W>
+class aosoa_array_ref2
+{
+	//! components of the property inside the tile
+	T (* ptr)[N2][W];
+
+	//! position of the element inside the tile
+	unsigned int off;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param ptr property inside the tile
+	 * \param off position of the element inside the tile
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref2(T (* ptr)[N2][W], unsigned int off)
+	:ptr(ptr),off(off)
+	{}
+
+	//! Copy constructor (it copy the reference)
+	aosoa_array_ref2(const aosoa_array_ref2<T,N1,N2,W> & ref) = default;
+
+	/*! \brief Access one row
+	 *
+	 * \param i row
+	 *
+	 * \return a reference to the row
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref<T,N2,W> operator[](size_t i) const
+	{
+		return aosoa_array_ref<T,N2,W>(ptr[i],off);
+	}
+
+	/*! \brief Copy the components of another element
+	 *
+	 * \param src element to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	template<typename Tsrc, unsigned int W2>
+	__device__ __host__ inline aosoa_array_ref2<T,N1,N2,W> & operator=(const aosoa_array_ref2<Tsrc,N1,N2,W2> & src)
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{
+			for (size_t j = 0 ; j < N2 ; j++)
+			{ptr[i][j][off] = src[i][j];}
+		}
+
+		return *this;
+	}
+
+	/*! \brief Copy the components of another element
+	 *
+	 * \param src element to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref2<T,N1,N2,W> & operator=(const aosoa_array_ref2<T,N1,N2,W> & src)
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{
+			for (size_t j = 0 ; j < N2 ; j++)
+			{ptr[i][j][off] = src[i][j];}
+		}
+
+		return *this;
+	}
+
+	/*! \brief Copy an array
+	 *
+	 * \param src array to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	__device__ __host__ inline aosoa_array_ref2<T,N1,N2,W> & operator=(const typename std::remove_const<T>::type (& src)[N1][N2])
+	{
+		for (size_t i = 0 ; i < N1 ; i++)
+		{
+			for (size_t j = 0 ; j < N2 ; j++)
+			{ptr[i][j][off] = src[i][j];}
+		}
+
+		return *this;
+	}
+};
+
+/*! \brief Given the type of a property inside the tile, it return the reference to the property of one element
+ *
+ * \tparam Tp type of the property in the tile (T[W], T[N1][W], T[N1][N2][W])
+ *
+ */
+template<typename Tp>
+struct aosoa_prp_ref
+{
+};
+
+//! Scalar property, the reference is a normal reference
+template<typename T, unsigned int W>
+struct aosoa_prp_ref<T[W]>
+{
+	//! reference type
+	typedef T & type;
+
+	/*! \brief Return the reference to the property of the element off
+	 *
+	 * \param t property in the tile
+	 * \param off element in the tile
+	 *
+	 */
+	__device__ __host__ static inline type get(T (& t)[W], unsigned int off)
+	{
+		return t[off];
+	}
+};
+
+//! Property T[N1]
+template<typename T, unsigned int N1, unsigned int W>
+struct aosoa_prp_ref<T[N1][W]>
+{
+	//! reference type
+	typedef aosoa_array_ref<T,N1,W> type;
+
+	/*! \brief Return the reference to the property of the element off
+	 *
+	 * \param t property in the tile
+	 * \param off element in the tile
+	 *
+	 */
+	__device__ __host__ static inline type get(T (& t)[N1][W], unsigned int off)
+	{
+		return type(t,off);
+	}
+};
+
+//! Property T[N1][N2]
+template<typename T, unsigned int N1, unsigned int N2, unsigned int W>
+struct aosoa_prp_ref<T[N1][N2][W]>
+{
+	//! reference type
+	typedef aosoa_array_ref2<T,N1,N2,W> type;
+
+	/*! \brief Return the reference to the property of the element off
+	 *
+	 * \param t property in the tile
+	 * \param off element in the tile
+	 *
+	 */
+	__device__ __host__ static inline type get(T (& t)[N1][N2][W], unsigned int off)
+	{
+		return type(t,off);
+	}
+};
+
+/*! \brief Reference to one element of an AoSoA array (tile + position inside the tile)
+ *
+ * \tparam tile_type tile type (it can be const)
+ *
+ */
+template<typename tile_type>
+struct aosoa_ref
+{
+	//! tile that contain the element
+	tile_type * tile;
+
+	//! position inside the tile
+	unsigned int off;
+
+	/*! \brief Constructor
+	 *
+	 * \param tile tile
+	 * \param off position in the tile
+	 *
+	 */
+	__device__ __host__ inline aosoa_ref(tile_type * tile, unsigned int off)
+	:tile(tile),off(off)
+	{}
+
+	/*! \brief Return the property p of the element
+	 *
+	 * \tparam p property
+	 *
+	 * \return a reference to the property
+	 *
+	 */
+	template<unsigned int p>
+	__device__ __host__ inline typename aosoa_prp_ref<typename std::remove_reference<decltype(boost::fusion::at_c<p>(*tile))>::type>::type get() const
+	{
+		typedef typename std::remove_reference<decltype(boost::fusion::at_c<p>(*tile))>::type prp_type;
+
+		return aosoa_prp_ref<prp_type>::get(boost::fusion::at_c<p>(*tile),off);
+	}
+};
+
+/*! \brief It give a representation to a chunk of memory as an array of tiles
+ *
+ * Element i is in the tile i / W at position i % W
+ *
+ * \tparam tile_type tile type
+ * \tparam W number of elements in a tile
+ *
+ */
+template<typename tile_type, unsigned int W>
+class aosoa_array
+{
+	//! Internal pointer
+	tile_type * ptr;
+
+	//! number of elements
+	size_t sz;
+
+public:
+
+	//! type of the tile
+	typedef tile_type value_type;
+
+	/*! \brief Return the number of tiles required to store sz elements
+	 *
+	 * \param sz number of elements
+	 *
+	 * \return the number of tiles
+	 *
+	 */
+	__device__ __host__ static inline size_t n_tiles(size_t sz)
+	{
+		return (sz + W - 1) / W;
+	}
+
+	/*! \brief Initialize the memory array
+	 *
+	 * \param ptr pointer
+	 * \param sz number of elements in the array
+	 * \param init indicate if the memory is already initialized
+	 *
+	 */
+	void initialize(void * ptr, size_t sz, bool init)
+	{
+		this->ptr = static_cast<tile_type *>(ptr);
+
+		// Initialize the constructors
+
+		if (init == false)
+			new (ptr)tile_type[n_tiles(sz)];
+
+		this->sz = sz;
+	}
+
+	//! return the number of elements
+	size_t size() const
+	{
+		return sz;
+	}
+
+	//! return the number of tiles
+	size_t size_tiles() const
+	{
+		return n_tiles(sz);
+	}
+
+	/*! \brief Set the internal pointer to the indicated chunk of memory
+	 *
+	 * \param ptr_ pointer
+	 *
+	 */
+	void set_pointer(void * ptr_)
+	{
+		ptr = static_cast<tile_type *>(ptr_);
+	}
+
+	//! Return the pointer
+	__device__ __host__ void * get_pointer() const
+	{
+		return ptr;
+	}
+
+	/*! \brief Access an element
+	 *
+	 * \param i element
+	 *
+	 * \return a reference to the element
+	 *
+	 */
+	__device__ __host__ inline aosoa_ref<tile_type> operator[](size_t i)
+	{
+		return aosoa_ref<tile_type>(&ptr[i / W],i % W);
+	}
+
+	/*! \brief Access an element
+	 *
+	 * \param i element
+	 *
+	 * \return a reference to the element
+	 *
+	 */
+	__device__ __host__ inline aosoa_ref<const tile_type> operator[](size_t i) const
+	{
+		return aosoa_ref<const tile_type>(&ptr[i / W],i % W);
+	}
+
+	/*! \brief Access the property p of an element
+	 *
+	 * \tparam p property
+	 *
+	 * \param i element
+	 *
+	 * \return a reference to the property
+	 *
+	 */
+	template<unsigned int p>
+	__device__ __host__ inline auto get(size_t i) -> decltype(aosoa_ref<tile_type>(ptr,0).template get<p>())
+	{
+		return aosoa_ref<tile_type>(&ptr[i / W],i % W).template get<p>();
+	}
+
+	/*! \brief Access the property p of an element
+	 *
+	 * \tparam p property
+	 *
+	 * \param i element
+	 *
+	 * \return a constant reference to the property
+	 *
+	 */
+	template<unsigned int p>
+	__device__ __host__ inline auto get(size_t i) const -> decltype(aosoa_ref<const tile_type>(ptr,0).template get<p>())
+	{
+		return aosoa_ref<const tile_type>(&ptr[i / W],i % W).template get<p>();
+	}
+
+	/*! \brief Access a tile
+	 *
+	 * \param t tile
+	 *
+	 * \return the tile
+	 *
+	 */
+	__device__ __host__ inline tile_type & getTile(size_t t)
+	{
+		return ptr[t];
+	}
+
+	/*! \brief Access a tile
+	 *
+	 * \param t tile
+	 *
+	 * \return the tile
+	 *
+	 */
+	__device__ __host__ inline const tile_type & getTile(size_t t) const
+	{
+		return ptr[t];
+	}
+
+	/*! \brief swap the two objects memory
+	 *
+	 * \param obj memory to swap with
+	 *
+	 */
+	void swap(aosoa_array<tile_type,W> & obj)
+	{
+		size_t sz_tmp = sz;
+		sz = obj.sz;
+		obj.sz = sz_tmp;
+
+		tile_type * ptr_tmp = ptr;
+		ptr = obj.ptr;
+		obj.ptr = ptr_tmp;
+	}
+
+	//! Call the destructor of every tile
+	void deinit()
+	{
+		for (size_t i = 0 ; i < n_tiles(sz) ; i++)
+		{
+			(&ptr[i])->~tile_type();
+		}
+	}
+
+	//! Default constructor
+	aosoa_array()
+	:ptr(NULL),sz(0)
+	{};
+};
+
+/*! \brief Container for the AoSoA memory layout
+ *
+ * Like memory_c it store the object used to allocate memory and a representation of
+ * this memory, here an array of tiles. Each tile store W elements, property by
+ * property, so the same property of W consecutive elements is contiguous in memory
+ *
+ * \see memory_traits_aosoa
+ *
+ * \tparam T aggregate type
+ * \tparam W number of elements in a tile
+ *
+ */
+template<typename T, unsigned int W>
+class memory_aosoa
+{
+public:
+
+	//! tile (for each property a W array)
+	typedef typename v_transform_two_v2<aosoa_tile_prp,boost::mpl::int_<W>,typename T::type>::type tile_type;
+
+	//! define the type
+	typedef memory_aosoa<T,W> type;
+
+	//! number of elements in a tile
+	static const unsigned int tile_size = W;
+
+	//! object that allocate memory like HeapMemory or CudaMemory
+	memory * mem;
+
+	//! object that represent the memory as an array of tiles
+	aosoa_array<tile_type,W> mem_r;
+
+	/*! \brief This function set the object that allocate memory
+	 *
+	 * \param mem the memory object
+	 *
+	 */
+	void setMemory(memory & mem)
+	{
+		if (this->mem != NULL)
+		{
+			this->mem->decRef();
+
+			if (this->mem->ref() == 0 && &mem != this->mem)
+				delete(this->mem);
+		}
+
+		mem.incRef();
+		this->mem = &mem;
+	}
+
+	/*! \brief This function bind the memory_aosoa to this memory_aosoa as reference
+	 *
+	 * \param ref the object to reference
+	 *
+	 */
+	bool bind_ref(const memory_aosoa<T,W> & ref)
+	{
+	    mem = ref.mem;
+	    mem->incRef();
+
+	    mem_r = ref.mem_r;
+
+	    return true;
+	}
+
+	/*! \brief This function get the object that allocate memory
+	 *
+	 * \return memory object to allocate memory
+	 *
+	 */
+	memory& getMemory()
+	{
+		return *this->mem;
+	}
+
+	/*! \brief This function get the object that allocate memory
+	 *
+	 * \return memory object to allocate memory
+	 *
+	 */
+	const memory& getMemory() const
+	{
+		return *this->mem;
+	}
+
+	//! Switch the pointer to device pointer
+	void switchToDevicePtr()
+	{
+		mem_r.set_pointer(mem->getDevicePointer());
+	}
+
+	/*! \brief This function allocate memory for sz elements (rounded up to full tiles)
+	 *
+	 * \param sz number of elements
+	 * \param skip_initialization skip the call of the tile constructors
+	 *
+	 */
+	bool allocate(const size_t sz, bool skip_initialization = false)
+	{
+		memory * mem = this->mem;
+
+		//! We create a chunk of memory
+	    mem->resize( aosoa_array<tile_type,W>::n_tiles(sz)*sizeof(tile_type) );
+
+	    //! we create the representation for this buffer
+	    mem_r.initialize(mem->getPointer(),sz,mem->isInitialized() | skip_initialization);
+
+	    return true;
+	}
+
+	//! constructor
+	memory_aosoa():mem(NULL){}
+
+	//! destructor
+	~memory_aosoa()
+	{
+		mem_r.deinit();
+		if (mem != NULL)
+		{
+			mem->decRef();
+
+			if (mem->ref() == 0)
+				delete(mem);
+		}
+	}
+
+	/*! \brief swap the memory
+	 *
+	 * \param mem_obj object to swap with
+	 *
+	 */
+	void swap(memory_aosoa<T,W> & mem_obj)
+	{
+		memory * mem_tmp = mem;
+		mem = mem_obj.mem;
+		mem_obj.mem = mem_tmp;
+
+		mem_obj.mem_r.swap(mem_r);
+	}
+
+	/*! \brief swap the memory content but not the memory objects
+	 *
+	 * \param mem_obj object to swap with
+	 *
+	 */
+	template<typename Mem_type>
+	__host__ void swap_nomode(memory_aosoa<T,W> & mem_obj)
+	{
+		Mem_type * mem_tmp = static_cast<Mem_type*>(mem);
+		mem_tmp->swap(*static_cast<Mem_type*>(mem_obj.mem));
+
+		mem_obj.mem_r.swap(mem_r);
+	}
+};
+
+/*! \brief Array of Structures of Arrays memory layout
+ *
+ * The elements are grouped in tiles of W elements. Inside a tile every property is
+ * stored as an array of W values, so a property of W consecutive elements can be
+ * loaded with vector instructions (like with memory_traits_inte) while all the properties
+ * of one element stay close in memory (like with memory_traits_lin)
+ *
+ * memory_traits_aosoa_tile<W>::layout is a layout with tile width W, memory_traits_aosoa
+ * use AOSOA_TILE_SIZE
+ *
+ * ### Vector with AoSoA layout
+ * \snippet memory_conf_unit_tests.cpp Vector with AoSoA layout
+ *
+ * \tparam W number of elements in a tile
+ *
+ */
+template<unsigned int W>
+struct memory_traits_aosoa_tile
+{
+	/*! \brief AoSoA layout for the aggregate T
+	 *
+	 * \tparam T aggregate type
+	 *
+	 */
+	template<typename T>
+	struct layout
+	{
+		//! container type
+		typedef memory_aosoa<T,W> type;
+
+		typedef boost::mpl::int_<AOSOA_layout> type_value;
+
+		//! number of elements in a tile
+		static const unsigned int tile_size = W;
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param v1 element id
+		 *
+		 * \return a reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type, typename key_type>
+		__host__ __device__ static inline auto get(data_type & data_, const g1_type & g1, const key_type & v1) -> decltype(data_.mem_r.template get<p>(g1.LinId(v1)))
+		{
+			return data_.mem_r.template get<p>(g1.LinId(v1));
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param lin_id element id
+		 *
+		 * \return a reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type>
+		__host__ __device__ static inline auto get_lin(data_type & data_, const g1_type & g1, const size_t lin_id) -> decltype(data_.mem_r.template get<p>(lin_id))
+		{
+			return data_.mem_r.template get<p>(lin_id);
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param v1 element id
+		 *
+		 * \return a const reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type, typename key_type>
+		__host__ __device__ static inline auto get_c(const data_type & data_, const g1_type & g1, const key_type & v1) -> decltype(data_.mem_r.template get<p>(g1.LinId(v1)))
+		{
+			return data_.mem_r.template get<p>(g1.LinId(v1));
+		}
+
+		/*! \brief Return a reference to the selected element
+		 *
+		 * \param data object from where to take the element
+		 * \param g1 grid information
+		 * \param lin_id element id
+		 *
+		 * \return a const reference to the object selected
+		 *
+		 */
+		template<unsigned int p, typename data_type, typename g1_type>
+		__host__ __device__ static inline auto get_lin_c(const data_type & data_, const g1_type & g1, const size_t lin_id) -> decltype(data_.mem_r.template get<p>(lin_id))
+		{
+			return data_.mem_r.template get<p>(lin_id);
+		}
+	};
+};
+
+//! AoSoA layout with the default tile width AOSOA_TILE_SIZE
+template<typename T> using memory_traits_aosoa = typename memory_traits_aosoa_tile<AOSOA_TILE_SIZE>::template layout<T>;
+
+#endif /* OPENFPM_DATA_SRC_MEMORY_LY_MEMORY_TRAITS_AOSOA_HPP_ */
@@ -35,6 +35,10 @@ BOOST_AUTO_TEST_SUITE( performance )
 
 #include "Grid/performance/grid_performance_tests.hpp"
 #include "Vector/performance/vector_performance_test.hpp"
+#include "Vector/performance/vector_layout_performance_test.hpp"
+#include "Vector/performance/vector_bulk_performance_test.hpp"
+#include "NN/CellList/performance/cell_list_performance_test.hpp"
+#include "util/performance/scan_sort_reduce_cpu_performance_test.hpp"
 
 BOOST_AUTO_TEST_SUITE_END()
 
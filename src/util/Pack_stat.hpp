@@ -81,6 +81,16 @@ public:
 		un_ele++;
 	}
 
+	/*! \brief Increment the request pointer by n
+	 *
+	 * \param n number of requests
+	 *
+	 */
+	inline void incReq(size_t n)
+	{
+		un_ele += n;
+	}
+
 	/*! \brief return the actual request for packing
 	 *
 	 * \return the actual request for packing
@@ -0,0 +1,403 @@
+#ifndef OPENFPM_DATA_SRC_UTIL_CUDA_CUDIFY_PARALLEL_HPP_
+#define OPENFPM_DATA_SRC_UTIL_CUDA_CUDIFY_PARALLEL_HPP_
+
+#include "config.h"
+
+#if defined(HAVE_BOOST_CONTEXT) && (!defined(__NVCC__) || defined(CUDA_ON_CPU))
+
+#ifdef CUDA_ON_CPU
+#include "util/cuda_launch.hpp"
+#include "util/cudify/cudify.hpp"
+#endif
+
+#include "util/thread_pool.hpp"
+#include <boost/context/fiber.hpp>
+#include <boost/context/stack_context.hpp>
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include <iostream>
+
+//! Stack size of each GPU thread when the kernel use __syncthreads
+#ifndef CUDIFY_FIBER_STACK_SIZE
+#define CUDIFY_FIBER_STACK_SIZE 64*1024
+#endif
+
+namespace openfpm
+{
+	namespace cudify
+	{
+		//! three dimensional index (like CUDA uint3/dim3)
+		struct idx3
+		{
+			//! x component
+			unsigned int x;
+
+			//! y component
+			unsigned int y;
+
+			//! z component
+			unsigned int z;
+		};
+
+		/*! \brief Execution context of the GPU thread running on the calling host thread
+		 *
+		 * Every host thread of the pool execute one block at time, the context is thread local
+		 *
+		 */
+		struct kernel_ctx
+		{
+			//! thread index inside the block
+			idx3 thread_id;
+
+			//! block index
+			idx3 block_id;
+
+			//! block size
+			idx3 block_dim;
+
+			//! grid size
+			idx3 grid_dim;
+
+			//! continuation of the block scheduler (NULL if the kernel is launched without synchronization)
+			boost::context::fiber * sched;
+		};
+
+		/*! \brief Return the execution context of the calling host thread
+		 *
+		 * \return the execution context
+		 *
+		 */
+		inline kernel_ctx & get_ctx()
+		{
+			static thread_local kernel_ctx ctx = {{0,0,0},{0,0,0},{1,1,1},{1,1,1},NULL};
+
+			return ctx;
+		}
+
+		/*! \brief Stack allocator for the GPU thread fibers
+		 *
+		 * The stacks are kept in a thread local free list and reused across blocks and launches
+		 *
+		 */
+		struct reuse_stack_allocator
+		{
+			/*! \brief Return the free list of stacks of the calling host thread
+			 *
+			 * \return the free list
+			 *
+			 */
+			static std::vector<char *> & free_list()
+			{
+				struct stacks
+				{
+					std::vector<char *> fl;
+
+					~stacks()
+					{
+						for (size_t i = 0 ; i < fl.size() ; i++)
+						{delete [] fl[i];}
+					}
+				};
+
+				static thread_local stacks s;
+
+				return s.fl;
+			}
+
+			/*! \brief Allocate a stack
+			 *
+			 * \return the stack context
+			 *
+			 */
+			boost::context::stack_context allocate()
+			{
+				std::vector<char *> & fl = free_list();
+
+				char * base;
+
+				if (fl.size() != 0)
+				{
+					base = fl.back();
+					fl.pop_back();
+				}
+				else
+				{base = new char [CUDIFY_FIBER_STACK_SIZE];}
+
+				boost::context::stack_context sctx;
+				sctx.size = CUDIFY_FIBER_STACK_SIZE;
+				sctx.sp = base + CUDIFY_FIBER_STACK_SIZE;
+
+				return sctx;
+			}
+
+			/*! \brief Release a stack
+			 *
+			 * \param sctx stack context
+			 *
+			 */
+			void deallocate(boost::context::stack_context & sctx)
+			{
+				free_list().push_back(static_cast<char *>(sctx.sp) - CUDIFY_FIBER_STACK_SIZE);
+			}
+		};
+
+		/*! \brief Barrier for all the threads of a block
+		 *
+		 * The GPU thread suspend itself and the block scheduler run the other threads of the
+		 * block until they reach the barrier (or terminate)
+		 *
+		 */
+		inline void syncthreads()
+		{
+			kernel_ctx & ctx = get_ctx();
+
+			if (ctx.sched == NULL)
+			{
+				if (ctx.block_dim.x * ctx.block_dim.y * ctx.block_dim.z != 1)
+				{std::cerr << __FILE__ << ":" << __LINE__ << " error: __syncthreads() called in a kernel launched without synchronization support" << std::endl;}
+
+				return;
+			}
+
+			boost::context::fiber & sched = *ctx.sched;
+			sched = std::move(sched).resume();
+
+			// other fibers of the block have been running in the meanwhile
+			get_ctx().sched = &sched;
+		}
+
+		/*! \brief Convert the linear thread id into a 3D index
+		 *
+		 * \param t linear index
+		 * \param sz size
+		 *
+		 * \return the 3D index
+		 *
+		 */
+		inline idx3 lin_to_idx3(size_t t, const idx3 & sz)
+		{
+			idx3 id;
+
+			id.x = t % sz.x;
+			id.y = (t / sz.x) % sz.y;
+			id.z = t / (sz.x * sz.y);
+
+			return id;
+		}
+
+		/*! \brief Convert a launch size (dim3 like structure) into idx3
+		 *
+		 * \tparam T type of the launch size
+		 * \tparam is_int true if the launch size is an integer
+		 *
+		 */
+		template<typename T, bool is_int = std::is_integral<T>::value>
+		struct to_idx3
+		{
+			/*! \brief Convert
+			 *
+			 * \param d launch size
+			 *
+			 * \return the launch size as idx3
+			 *
+			 */
+			static idx3 get(const T & d)
+			{
+				idx3 id = {(unsigned int)d.x,(unsigned int)d.y,(unsigned int)d.z};
+
+				return id;
+			}
+		};
+
+		/*! \brief Convert a launch size (integer) into idx3
+		 *
+		 * \tparam T type of the launch size
+		 *
+		 */
+		template<typename T>
+		struct to_idx3<T,true>
+		{
+			/*! \brief Convert
+			 *
+			 * \param d launch size
+			 *
+			 * \return the launch size as idx3
+			 *
+			 */
+			static idx3 get(const T & d)
+			{
+				idx3 id = {(unsigned int)d,1,1};
+
+				return id;
+			}
+		};
+
+		/*! \brief Run one block, every GPU thread is a fiber
+		 *
+		 * The fibers are resumed round robin. Each one run until it reach a barrier or it terminate,
+		 * so a round move all the threads of the block past the same barrier
+		 *
+		 * \param f kernel
+		 * \param n_thr number of threads in the block
+		 *
+		 */
+		template<typename lambda_f>
+		void run_block_sync(lambda_f & f, size_t n_thr)
+		{
+			kernel_ctx & ctx = get_ctx();
+
+			std::vector<boost::context::fiber> thr(n_thr);
+			size_t alive = n_thr;
+
+			for (size_t t = 0 ; t < n_thr ; t++)
+			{
+				thr[t] = boost::context::fiber(std::allocator_arg,reuse_stack_allocator(),[&f](boost::context::fiber && sched)
+				{
+					get_ctx().sched = &sched;
+
+					f();
+
+					return std::move(sched);
+				});
+			}
+
+			while (alive != 0)
+			{
+				for (size_t t = 0 ; t < n_thr ; t++)
+				{
+					if (!thr[t])	{continue;}
+
+					ctx.thread_id = lin_to_idx3(t,ctx.block_dim);
+					thr[t] = std::move(thr[t]).resume();
+
+					if (!thr[t])	{alive--;}
+				}
+			}
+
+			ctx.sched = NULL;
+		}
+
+		/*! \brief Launch a kernel distributing the blocks across the threads of the thread pool
+		 *
+		 * The blocks are executed independently (in any order and concurrently). If sync is true every
+		 * GPU thread run in a fiber and syncthreads() implement the __syncthreads semantic inside the block,
+		 * otherwise the threads of a block are executed in sequence and syncthreads() cannot be used.
+		 * The number of host threads is the one of the thread pool (openfpm::set_num_threads or the
+		 * environment variable OPENFPM_NUM_THREADS)
+		 *
+		 * \warning block shared memory must be thread local, two blocks can run at the same time
+		 *
+		 * \param f kernel (it read the indexes from the built-in variables or get_ctx())
+		 * \param grid number of blocks (dim3 like structure or integer)
+		 * \param block number of threads for each block (dim3 like structure or integer)
+		 * \param sync true if the kernel use syncthreads()
+		 *
+		 */
+		template<typename lambda_f, typename grid_type, typename block_type>
+		void exe_kernel(lambda_f f, const grid_type & grid, const block_type & block, bool sync = true)
+		{
+			idx3 gd = to_idx3<grid_type>::get(grid);
+			idx3 bd = to_idx3<block_type>::get(block);
+
+			size_t n_blk = (size_t)gd.x * gd.y * gd.z;
+			size_t n_thr = (size_t)bd.x * bd.y * bd.z;
+
+			if (n_blk == 0 || n_thr == 0)	{return;}
+
+			openfpm::parallel_for(0,n_blk,[&](size_t b)
+			{
+				kernel_ctx & ctx = get_ctx();
+				kernel_ctx old = ctx;
+
+				ctx.grid_dim = gd;
+				ctx.block_dim = bd;
+				ctx.block_id = lin_to_idx3(b,gd);
+				ctx.sched = NULL;
+
+				if (sync == true && n_thr > 1)
+				{run_block_sync(f,n_thr);}
+				else
+				{
+					for (size_t t = 0 ; t < n_thr ; t++)
+					{
+						ctx.thread_id = lin_to_idx3(t,bd);
+						f();
+					}
+				}
+
+				ctx = old;
+			},1);
+		}
+	}
+}
+
+namespace openfpm
+{
+	namespace cudify
+	{
+		/*! \brief CUDA built-in variables for the kernels launched with exe_kernel
+		 *
+		 * They are references to the execution context of the calling host thread. With CUDA_ON_CPU the
+		 * global built-in are redirected here, otherwise a kernel can use them with a using directive
+		 *
+		 */
+		namespace builtin
+		{
+			//! thread index of the calling GPU thread
+			static thread_local const idx3 & threadIdx = get_ctx().thread_id;
+
+			//! block index of the calling GPU thread
+			static thread_local const idx3 & blockIdx = get_ctx().block_id;
+
+			//! block size of the running kernel
+			static thread_local const idx3 & blockDim = get_ctx().block_dim;
+
+			//! grid size of the running kernel
+			static thread_local const idx3 & gridDim = get_ctx().grid_dim;
+
+			//! Barrier for all the threads of a block (see openfpm::cudify::syncthreads)
+			inline void __syncthreads()
+			{
+				syncthreads();
+			}
+		}
+	}
+}
+
+#ifdef CUDA_ON_CPU
+
+/*
+ * The kernels launched with CUDA_LAUNCH and CUDA_LAUNCH_DIM3 run with exe_kernel, the blocks are
+ * distributed across the threads of the thread pool. The built-in read the execution context of
+ * exe_kernel and the shared memory is thread local, because more blocks run at the same time
+ *
+ */
+
+#undef threadIdx
+#undef blockIdx
+#undef blockDim
+#undef gridDim
+#undef __syncthreads
+#undef __shared__
+#undef CUDA_LAUNCH
+#undef CUDA_LAUNCH_DIM3
+
+#define threadIdx openfpm::cudify::builtin::threadIdx
+#define blockIdx openfpm::cudify::builtin::blockIdx
+#define blockDim openfpm::cudify::builtin::blockDim
+#define gridDim openfpm::cudify::builtin::gridDim
+#define __syncthreads openfpm::cudify::builtin::__syncthreads
+#define __shared__ static thread_local
+
+#define CUDA_LAUNCH(cuda_call,ite, ...) \
+		openfpm::cudify::exe_kernel([&]() {cuda_call(__VA_ARGS__);},(ite).wthr,(ite).thr)
+
+#define CUDA_LAUNCH_DIM3(cuda_call,wthr_,thr_, ...) \
+		openfpm::cudify::exe_kernel([&]() {cuda_call(__VA_ARGS__);},wthr_,thr_)
+
+#endif
+
+#endif
+
+#endif /* OPENFPM_DATA_SRC_UTIL_CUDA_CUDIFY_PARALLEL_HPP_ */
@@ -27,6 +27,7 @@
 #endif
 
 #include "util/cuda/ofp_context.hxx"
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
 
 namespace openfpm
 {
@@ -35,11 +36,7 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	output[0] = 0;
-	for (int i = 0 ; i < count ; i++)
-	{
-		output[0] = op(output[0],input[i]);
-	}
+	openfpm::reduce_cpu(input,count,output,op);
 
 #else
 	#ifdef REDUCE_WITH_CUB
@@ -26,6 +26,7 @@
 	#include "util/cuda/moderngpu/kernel_scan.hxx"
 #endif
 #include "util/cuda/ofp_context.hxx"
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
 
 namespace openfpm
 {
@@ -34,16 +35,7 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	if (count == 0)	{return;}
-
-	auto prec = input[0];
-	output[0] = 0;
-	for (int i = 1 ; i < count ; i++)
-	{
-		auto next = prec + output[i-1];
-		prec = input[i];
-		output[i] = next;
-	}
+	openfpm::scan_cpu(input,count,output);
 
 #else
 	#ifdef SCAN_WITH_CUB
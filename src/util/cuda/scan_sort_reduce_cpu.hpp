@@ -0,0 +1,347 @@
+#ifndef OPENFPM_DATA_SRC_UTIL_CUDA_SCAN_SORT_REDUCE_CPU_HPP_
+#define OPENFPM_DATA_SRC_UTIL_CUDA_SCAN_SORT_REDUCE_CPU_HPP_
+
+#include "util/thread_pool.hpp"
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <vector>
+#include <limits>
+
+//! number of bits sorted in each pass of the radix sort
+#define OFP_RADIX_BITS 8
+
+namespace mgpu
+{
+	template<typename type_t> struct less_t;
+	template<typename type_t> struct greater_t;
+}
+
+namespace openfpm
+{
+	/*! \brief Order produced by a comparator, 1 ascending, -1 descending, 0 unknown
+	 *
+	 * For unknown comparators the sort fall back to a comparison sort
+	 *
+	 */
+	template<typename comp_t>
+	struct radix_sort_order
+	{
+		enum
+		{
+			value = 0
+		};
+	};
+
+	template<typename key_t>
+	struct radix_sort_order<mgpu::less_t<key_t>>
+	{
+		enum
+		{
+			value = 1
+		};
+	};
+
+	template<typename key_t>
+	struct radix_sort_order<std::less<key_t>>
+	{
+		enum
+		{
+			value = 1
+		};
+	};
+
+	template<typename key_t>
+	struct radix_sort_order<mgpu::greater_t<key_t>>
+	{
+		enum
+		{
+			value = -1
+		};
+	};
+
+	template<typename key_t>
+	struct radix_sort_order<std::greater<key_t>>
+	{
+		enum
+		{
+			value = -1
+		};
+	};
+
+	/*! \brief Exclusive prefix sum on host using the thread pool
+	 *
+	 * Each thread sum a contiguous block, the blocks are scanned with the offset of the previous
+	 * blocks. input and output can be the same array
+	 *
+	 * \param input input array
+	 * \param count number of elements
+	 * \param output output array
+	 *
+	 */
+	template<typename input_it, typename output_it>
+	void scan_cpu(input_it input, int count, output_it output)
+	{
+		typedef typename std::remove_const<typename std::remove_reference<decltype(output[0])>::type>::type val_t;
+
+		if (count <= 0)	{return;}
+
+		size_t nb = parallel_n_blocks(0,count);
+
+		std::vector<val_t> sums(nb+1);
+
+		if (nb > 1)
+		{
+			parallel_for_blocks(0,count,nb,[&](size_t b, size_t start, size_t stop)
+			{
+				val_t acc = 0;
+
+				for (size_t i = start ; i < stop ; i++)
+				{acc += input[i];}
+
+				sums[b+1] = acc;
+			});
+
+			for (size_t b = 0 ; b < nb ; b++)
+			{sums[b+1] += sums[b];}
+		}
+
+		parallel_for_blocks(0,count,nb,[&](size_t b, size_t start, size_t stop)
+		{
+			val_t acc = sums[b];
+
+			for (size_t i = start ; i < stop ; i++)
+			{
+				val_t prec = input[i];
+				output[i] = acc;
+				acc += prec;
+			}
+		});
+	}
+
+	/*! \brief Reduction on host using the thread pool
+	 *
+	 * The result is op(...op(op(0,input[0]),input[1])...,input[count-1]) calculated in blocks,
+	 * op must be associative
+	 *
+	 * \param input input array
+	 * \param count number of elements
+	 * \param output where to store the result (output[0])
+	 * \param op reduction operation
+	 *
+	 */
+	template<typename input_it, typename output_it, typename reduce_op>
+	void reduce_cpu(input_it input, int count, output_it output, reduce_op op)
+	{
+		typedef typename std::remove_const<typename std::remove_reference<decltype(output[0])>::type>::type val_t;
+
+		size_t nb = parallel_n_blocks(0,(count < 0)?0:count);
+
+		std::vector<val_t> red_b(nb);
+
+		parallel_for_blocks(0,count,nb,[&](size_t b, size_t start, size_t stop)
+		{
+			val_t acc = input[start];
+
+			for (size_t i = start + 1 ; i < stop ; i++)
+			{acc = op(acc,input[i]);}
+
+			red_b[b] = acc;
+		});
+
+		val_t acc = 0;
+
+		for (size_t b = 0 ; b < nb ; b++)
+		{acc = op(acc,red_b[b]);}
+
+		output[0] = acc;
+	}
+
+	/*! \brief Convert a key into an unsigned integer with the same order
+	 *
+	 * \param k key
+	 *
+	 * \return the unsigned key
+	 *
+	 */
+	template<typename key_t, int order>
+	inline typename std::make_unsigned<key_t>::type radix_key(key_t k)
+	{
+		typedef typename std::make_unsigned<key_t>::type ukey_t;
+
+		ukey_t uk = (ukey_t)k;
+
+		if (std::is_signed<key_t>::value == true)
+		{uk ^= (ukey_t)1 << (sizeof(key_t)*8 - 1);}
+
+		return (order == 1)?uk:(ukey_t)~uk;
+	}
+
+	/*! \brief Stable LSD radix sort of key-value pairs on host using the thread pool
+	 *
+	 * Each pass sort OFP_RADIX_BITS bits, every block of elements create its histogram, the
+	 * histograms are scanned in (digit,block) order and each block scatter its elements. Passes
+	 * where all the keys have the same digit are skipped
+	 *
+	 * \tparam order 1 ascending -1 descending
+	 *
+	 * \param keys keys
+	 * \param vals values
+	 * \param count number of elements
+	 *
+	 */
+	template<int order, typename key_t, typename val_t>
+	void radix_sort_cpu(key_t * keys, val_t * vals, size_t count)
+	{
+		const size_t n_bin = 1 << OFP_RADIX_BITS;
+		const size_t n_pass = (sizeof(key_t)*8 + OFP_RADIX_BITS - 1) / OFP_RADIX_BITS;
+
+		size_t nb = parallel_n_blocks(0,count);
+
+		std::vector<key_t> keys_tmp(count);
+		std::vector<val_t> vals_tmp(count);
+
+		key_t * k_src = keys;
+		val_t * v_src = vals;
+		key_t * k_dst = keys_tmp.data();
+		val_t * v_dst = vals_tmp.data();
+
+		std::vector<size_t> hist(nb*n_bin);
+
+		for (size_t p = 0 ; p < n_pass ; p++)
+		{
+			size_t shift = p*OFP_RADIX_BITS;
+
+			std::fill(hist.begin(),hist.end(),0);
+
+			parallel_for_blocks(0,count,nb,[&](size_t b, size_t start, size_t stop)
+			{
+				size_t * h = &hist[b*n_bin];
+
+				for (size_t i = start ; i < stop ; i++)
+				{h[(radix_key<key_t,order>(k_src[i]) >> shift) & (n_bin - 1)]++;}
+			});
+
+			// all the keys have the same digit (summed over the blocks)
+			bool skip = false;
+
+			for (size_t d = 0 ; d < n_bin ; d++)
+			{
+				size_t n = 0;
+
+				for (size_t b = 0 ; b < nb ; b++)
+				{n += hist[b*n_bin + d];}
+
+				if (n != 0)
+				{
+					skip = (n == count);
+					break;
+				}
+			}
+
+			if (skip == true)
+			{continue;}
+
+			// offsets, digit major, block minor
+			size_t off = 0;
+
+			for (size_t d = 0 ; d < n_bin ; d++)
+			{
+				for (size_t b = 0 ; b < nb ; b++)
+				{
+					size_t n = hist[b*n_bin + d];
+					hist[b*n_bin + d] = off;
+					off += n;
+				}
+			}
+
+			parallel_for_blocks(0,count,nb,[&](size_t b, size_t start, size_t stop)
+			{
+				size_t * h = &hist[b*n_bin];
+
+				for (size_t i = start ; i < stop ; i++)
+				{
+					size_t pos = h[(radix_key<key_t,order>(k_src[i]) >> shift) & (n_bin - 1)]++;
+					k_dst[pos] = k_src[i];
+					v_dst[pos] = v_src[i];
+				}
+			});
+
+			std::swap(k_src,k_dst);
+			std::swap(v_src,v_dst);
+		}
+
+		if (k_src != keys)
+		{
+			parallel_for(0,count,[&](size_t i)
+			{
+				keys[i] = k_src[i];
+				vals[i] = v_src[i];
+			});
+		}
+	}
+
+	/*! \brief Select radix sort or comparison sort
+	 *
+	 * Comparison sort case
+	 *
+	 */
+	template<bool is_radix, int order>
+	struct sort_cpu_impl
+	{
+		template<typename key_t, typename val_t, typename comp_t>
+		static void sort(key_t * keys, val_t * vals, size_t count, comp_t comp)
+		{
+			std::vector<size_t> id(count);
+			std::vector<key_t> keys_tmp(keys,keys+count);
+			std::vector<val_t> vals_tmp(vals,vals+count);
+
+			for (size_t i = 0 ; i < count ; i++)
+			{id[i] = i;}
+
+			std::stable_sort(id.begin(),id.end(),[&](size_t a, size_t b){return comp(keys_tmp[a],keys_tmp[b]);});
+
+			parallel_for(0,count,[&](size_t i)
+			{
+				keys[i] = keys_tmp[id[i]];
+				vals[i] = vals_tmp[id[i]];
+			});
+		}
+	};
+
+	/*! \brief Select radix sort or comparison sort
+	 *
+	 * Radix sort case
+	 *
+	 */
+	template<int order>
+	struct sort_cpu_impl<true,order>
+	{
+		template<typename key_t, typename val_t, typename comp_t>
+		static void sort(key_t * keys, val_t * vals, size_t count, comp_t comp)
+		{
+			radix_sort_cpu<order>(keys,vals,count);
+		}
+	};
+
+	/*! \brief Stable sort of key-value pairs on host using the thread pool
+	 *
+	 * Integer keys with less or greater comparators are sorted with a parallel radix sort,
+	 * any other key type or comparator use a stable comparison sort
+	 *
+	 * \param keys keys
+	 * \param vals values
+	 * \param count number of elements
+	 * \param comp comparator
+	 *
+	 */
+	template<typename key_t, typename val_t, typename comp_t>
+	void sort_cpu(key_t * keys, val_t * vals, int count, comp_t comp)
+	{
+		if (count <= 1)	{return;}
+
+		sort_cpu_impl<std::is_integral<key_t>::value && std::is_same<key_t,bool>::value == false && radix_sort_order<comp_t>::value != 0,radix_sort_order<comp_t>::value>::sort(keys,vals,count,comp);
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_UTIL_CUDA_SCAN_SORT_REDUCE_CPU_HPP_ */
@@ -28,6 +28,7 @@
 #endif
 
 #include "util/cuda/ofp_context.hxx"
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
 
 template<typename key_t, typename val_t>
 struct key_val_ref;
@@ -240,9 +241,7 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	key_val_it<key_t,val_t> kv(keys_input,vals_input);
-
-	std::sort(kv,kv+count,comp);
+	openfpm::sort_cpu(keys_input,vals_input,count,comp);
 
 #else
 
@@ -0,0 +1,167 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "util/cuda/cudify_parallel.hpp"
+
+#ifdef HAVE_BOOST_CONTEXT
+
+//! dim3 like structure to define the launch
+struct test_dim3
+{
+	unsigned int x;
+	unsigned int y;
+	unsigned int z;
+};
+
+BOOST_AUTO_TEST_SUITE( cudify_parallel_test )
+
+/*! \brief Kernel that reduce in shared memory the elements of each block
+ *
+ * It is written like a CUDA kernel, the built-in variables are the ones of the execution context
+ *
+ * \param in input
+ * \param out one result for each block
+ *
+ */
+void block_reduce_kernel(const int * in, int * out)
+{
+	// with CUDA_ON_CPU the global built-in are already the ones of the execution context
+	using namespace openfpm::cudify::builtin;
+
+	// shared memory must be thread local (one block running on each host thread)
+	static thread_local int sh[256];
+
+	unsigned int tid = threadIdx.x;
+	unsigned int bid = blockIdx.x + blockIdx.y * gridDim.x;
+
+	sh[tid] = in[bid * blockDim.x + tid];
+
+	__syncthreads();
+
+	for (unsigned int s = blockDim.x / 2 ; s > 0 ; s >>= 1)
+	{
+		if (tid < s)
+		{sh[tid] += sh[tid + s];}
+
+		__syncthreads();
+	}
+
+	if (tid == 0)
+	{out[bid] = sh[0];}
+}
+
+/*! \brief Check the result of block_reduce_kernel
+ *
+ * \param in input
+ * \param out one result for each block
+ *
+ * \return true if every block has the correct sum
+ *
+ */
+bool check_block_reduce(const std::vector<int> & in, const std::vector<int> & out)
+{
+	bool match = true;
+
+	for (size_t b = 0 ; b < out.size() ; b++)
+	{
+		int sum = 0;
+
+		for (size_t t = 0 ; t < 256 ; t++)
+		{sum += in[b*256 + t];}
+
+		match &= sum == out[b];
+	}
+
+	return match;
+}
+
+BOOST_AUTO_TEST_CASE( cudify_parallel_syncthreads )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	test_dim3 grid = {16,8,1};
+	test_dim3 block = {256,1,1};
+
+	std::vector<int> in(16*8*256);
+	std::vector<int> out(16*8,0);
+
+	for (size_t i = 0 ; i < in.size() ; i++)
+	{in[i] = rand() % 100;}
+
+	openfpm::cudify::exe_kernel([&](){block_reduce_kernel(in.data(),out.data());},grid,block);
+
+	BOOST_REQUIRE_EQUAL(check_block_reduce(in,out),true);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+#ifdef CUDA_ON_CPU
+
+BOOST_AUTO_TEST_CASE( cudify_parallel_cuda_launch )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	struct
+	{
+		test_dim3 wthr;
+		test_dim3 thr;
+	} ite = {{16,8,1},{256,1,1}};
+
+	std::vector<int> in(16*8*256);
+	std::vector<int> out(16*8,0);
+
+	for (size_t i = 0 ; i < in.size() ; i++)
+	{in[i] = rand() % 100;}
+
+	CUDA_LAUNCH(block_reduce_kernel,ite,in.data(),out.data());
+
+	BOOST_REQUIRE_EQUAL(check_block_reduce(in,out),true);
+
+	std::fill(out.begin(),out.end(),0);
+
+	CUDA_LAUNCH_DIM3(block_reduce_kernel,ite.wthr,256,in.data(),out.data());
+
+	BOOST_REQUIRE_EQUAL(check_block_reduce(in,out),true);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE( cudify_parallel_index )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	test_dim3 grid = {5,3,2};
+	test_dim3 block = {4,2,3};
+
+	std::vector<int> cnt(5*3*2*4*2*3,0);
+
+	auto kernel = [&]()
+	{
+		openfpm::cudify::kernel_ctx & ctx = openfpm::cudify::get_ctx();
+
+		size_t bid = ctx.block_id.x + ctx.grid_dim.x*(ctx.block_id.y + ctx.grid_dim.y*ctx.block_id.z);
+		size_t tid = ctx.thread_id.x + ctx.block_dim.x*(ctx.thread_id.y + ctx.block_dim.y*ctx.thread_id.z);
+
+		cnt[bid*ctx.block_dim.x*ctx.block_dim.y*ctx.block_dim.z + tid]++;
+	};
+
+	openfpm::cudify::exe_kernel(kernel,grid,block,false);
+	openfpm::cudify::exe_kernel(kernel,grid,block,true);
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < cnt.size() ; i++)
+	{match &= cnt[i] == 2;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,130 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
+
+BOOST_AUTO_TEST_SUITE( scan_sort_reduce_cpu_test )
+
+/*! \brief Sort with the given comparator and check the result is a stable sort
+ *
+ * \param keys_in keys to sort
+ * \param comp comparator
+ *
+ */
+template<typename key_t, typename comp_t>
+void test_sort_cpu(const std::vector<key_t> & keys_in, comp_t comp)
+{
+	std::vector<key_t> keys = keys_in;
+	std::vector<unsigned int> vals(keys.size());
+
+	for (size_t i = 0 ; i < vals.size() ; i++)
+	{vals[i] = i;}
+
+	openfpm::sort_cpu(keys.data(),vals.data(),keys.size(),comp);
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{match &= keys_in[vals[i]] == keys[i];}
+
+	for (size_t i = 1 ; i < keys.size() ; i++)
+	{
+		match &= !comp(keys[i],keys[i-1]);
+
+		if (!comp(keys[i],keys[i-1]) && !comp(keys[i-1],keys[i]))
+		{match &= vals[i-1] < vals[i];}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Test scan, sort and reduce with n elements
+ *
+ * \param n number of elements
+ *
+ */
+void test_scan_sort_reduce_cpu(size_t n)
+{
+	std::vector<unsigned int> in(n);
+	std::vector<unsigned int> out(n);
+	std::vector<int> keys(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		in[i] = rand() % 10;
+		keys[i] = rand() % 2000 - 1000;
+	}
+
+	// scan
+
+	openfpm::scan_cpu(in.data(),n,out.data());
+
+	bool match = true;
+	unsigned int cnt = 0;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		match &= out[i] == cnt;
+		cnt += in[i];
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// in-place scan
+
+	openfpm::scan_cpu(in.data(),n,in.data());
+
+	for (size_t i = 0 ; i < n ; i++)
+	{match &= in[i] == out[i];}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// reduce
+
+	int red;
+	int red_max;
+
+	openfpm::reduce_cpu(keys.data(),n,&red,std::plus<int>());
+	openfpm::reduce_cpu(keys.data(),n,&red_max,[](int a, int b){return (a > b)?a:b;});
+
+	int red_s = 0;
+	int red_max_s = 0;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		red_s += keys[i];
+		red_max_s = (red_max_s > keys[i])?red_max_s:keys[i];
+	}
+
+	BOOST_REQUIRE_EQUAL(red,red_s);
+	BOOST_REQUIRE_EQUAL(red_max,red_max_s);
+
+	// sort radix and comparison
+
+	test_sort_cpu(keys,std::less<int>());
+	test_sort_cpu(keys,std::greater<int>());
+	test_sort_cpu(keys,[](int a, int b){return (a/10) < (b/10);});
+
+	std::vector<unsigned int> ukeys(out);
+	test_sort_cpu(ukeys,std::greater<unsigned int>());
+}
+
+BOOST_AUTO_TEST_CASE( scan_sort_reduce_cpu_use )
+{
+	size_t n_threads = openfpm::get_num_threads();
+
+	openfpm::set_num_threads(1);
+
+	test_scan_sort_reduce_cpu(0);
+	test_scan_sort_reduce_cpu(7);
+	test_scan_sort_reduce_cpu(100000);
+
+	openfpm::set_num_threads(4);
+
+	test_scan_sort_reduce_cpu(7);
+	test_scan_sort_reduce_cpu(100000);
+	test_scan_sort_reduce_cpu(1000003);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#ifndef OPENFPM_DATA_SRC_UTIL_PERFORMANCE_SCAN_SORT_REDUCE_CPU_PERFORMANCE_TEST_HPP_
+#define OPENFPM_DATA_SRC_UTIL_PERFORMANCE_SCAN_SORT_REDUCE_CPU_PERFORMANCE_TEST_HPP_
+
+#include "util/cuda/scan_sort_reduce_cpu.hpp"
+
+#define NELE_SSR 16*1024*1024
+
+// Property tree
+struct report_ssr_cpu_func_tests
+{
+	boost::property_tree::ptree graphs;
+};
+
+report_ssr_cpu_func_tests report_ssr_cpu_funcs;
+
+BOOST_AUTO_TEST_SUITE( scan_sort_reduce_cpu_performance )
+
+/*! \brief Measure the time of a function
+ *
+ * \param prepare function called before each measure (not timed)
+ * \param f function to measure
+ * \param mean average time
+ * \param dev standard deviation
+ *
+ */
+template<typename lambda_p, typename lambda_f>
+void ssr_measure(lambda_p prepare, lambda_f f, double & mean, double & dev)
+{
+	std::vector<double> times(N_STAT + 1);
+
+	for (size_t i = 0 ; i < N_STAT+1 ; i++)
+	{
+		prepare();
+
+		timer t;
+		t.start();
+
+		f();
+
+		t.stop();
+		times[i] = t.getwct();
+	}
+
+	standard_deviation(times,mean,dev);
+}
+
+/*! \brief Add a measure to the report
+ *
+ * \param id measure id
+ * \param name name of the measure
+ * \param mean average time
+ * \param dev standard deviation
+ *
+ */
+void ssr_report(size_t id, const std::string & name, double mean, double dev)
+{
+	std::string base = "performance.ssr_cpu(" + std::to_string(id) + ")";
+
+	report_ssr_cpu_funcs.graphs.put(base + ".funcs.nele",NELE_SSR);
+	report_ssr_cpu_funcs.graphs.put(base + ".funcs.name",name);
+	report_ssr_cpu_funcs.graphs.put(base + ".y.data.mean",mean);
+	report_ssr_cpu_funcs.graphs.put(base + ".y.data.dev",dev);
+}
+
+BOOST_AUTO_TEST_CASE(scan_sort_reduce_cpu_performance)
+{
+	std::vector<unsigned int> keys(NELE_SSR);
+	std::vector<unsigned int> vals(NELE_SSR);
+	std::vector<unsigned int> keys_in(NELE_SSR);
+	std::vector<unsigned int> out(NELE_SSR);
+
+	for (size_t i = 0 ; i < keys_in.size() ; i++)
+	{keys_in[i] = rand();}
+
+	size_t n_threads = std::thread::hardware_concurrency();
+	if (n_threads == 0)	{n_threads = 1;}
+
+	size_t n_threads_old = openfpm::get_num_threads();
+
+	auto reset = [&]()
+	{
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{
+			keys[i] = keys_in[i];
+			vals[i] = i;
+		}
+	};
+
+	double mean;
+	double dev;
+
+	// serial scan (the previous CUDA_ON_CPU implementation)
+
+	ssr_measure([](){},[&]()
+	{
+		out[0] = 0;
+		for (size_t i = 1 ; i < keys_in.size() ; i++)
+		{out[i] = out[i-1] + keys_in[i-1];}
+	},mean,dev);
+	ssr_report(0,"scan_serial",mean,dev);
+
+	openfpm::set_num_threads(n_threads);
+
+	ssr_measure([](){},[&](){openfpm::scan_cpu(keys_in.data(),keys_in.size(),out.data());},mean,dev);
+	ssr_report(1,"scan_" + std::to_string(n_threads) + "_threads",mean,dev);
+
+	// serial reduce
+
+	ssr_measure([](){},[&]()
+	{
+		out[0] = 0;
+		for (size_t i = 0 ; i < keys_in.size() ; i++)
+		{out[0] = out[0] + keys_in[i];}
+	},mean,dev);
+	ssr_report(2,"reduce_serial",mean,dev);
+
+	ssr_measure([](){},[&](){openfpm::reduce_cpu(keys_in.data(),keys_in.size(),out.data(),std::plus<unsigned int>());},mean,dev);
+	ssr_report(3,"reduce_" + std::to_string(n_threads) + "_threads",mean,dev);
+
+	// serial sort (comparison sort of key-value pairs)
+
+	std::vector<std::pair<unsigned int,unsigned int>> kv(NELE_SSR);
+
+	ssr_measure([&]()
+	{
+		for (size_t i = 0 ; i < kv.size() ; i++)
+		{kv[i] = std::make_pair(keys_in[i],(unsigned int)i);}
+	},
+	[&]()
+	{
+		std::sort(kv.begin(),kv.end(),[](const std::pair<unsigned int,unsigned int> & a, const std::pair<unsigned int,unsigned int> & b){return a.first < b.first;});
+	},mean,dev);
+	ssr_report(4,"sort_serial",mean,dev);
+
+	openfpm::set_num_threads(1);
+
+	ssr_measure(reset,[&](){openfpm::sort_cpu(keys.data(),vals.data(),keys.size(),std::less<unsigned int>());},mean,dev);
+	ssr_report(5,"sort_radix_1_thread",mean,dev);
+
+	openfpm::set_num_threads(n_threads);
+
+	ssr_measure(reset,[&](){openfpm::sort_cpu(keys.data(),vals.data(),keys.size(),std::less<unsigned int>());},mean,dev);
+	ssr_report(6,"sort_radix_" + std::to_string(n_threads) + "_threads",mean,dev);
+
+	openfpm::set_num_threads(n_threads_old);
+}
+
+/////// THIS IS NOT A TEST IT WRITE THE PERFORMANCE RESULT ///////
+
+BOOST_AUTO_TEST_CASE(scan_sort_reduce_cpu_performance_write_report)
+{
+	// Create a graphs
+
+	report_ssr_cpu_funcs.graphs.put("graphs.graph(0).type","line");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).title","Host scan sort reduce");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).x.title","Tests");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).y.title","Time seconds");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).y.data(0).source","performance.ssr_cpu(#).y.data.mean");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).x.data(0).source","performance.ssr_cpu(#).funcs.name");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).y.data(0).title","Actual");
+	report_ssr_cpu_funcs.graphs.add("graphs.graph(0).interpolation","lines");
+
+	boost::property_tree::xml_writer_settings<std::string> settings(' ', 4);
+	boost::property_tree::write_xml("scan_sort_reduce_cpu_performance_funcs.xml", report_ssr_cpu_funcs.graphs,std::locale(),settings);
+
+	GoogleChart cg;
+
+	std::string file_xml_ref(test_dir);
+	file_xml_ref += std::string("/openfpm_data/scan_sort_reduce_cpu_performance_funcs_ref.xml");
+
+	StandardXMLPerformanceGraph("scan_sort_reduce_cpu_performance_funcs.xml",file_xml_ref,cg);
+
+	addUpdtateTime(cg,1);
+
+	cg.write("scan_sort_reduce_cpu_performance_funcs.html");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* OPENFPM_DATA_SRC_UTIL_PERFORMANCE_SCAN_SORT_REDUCE_CPU_PERFORMANCE_TEST_HPP_ */
@@ -0,0 +1,91 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "util/thread_pool.hpp"
+#include <atomic>
+
+BOOST_AUTO_TEST_SUITE( thread_pool_test )
+
+BOOST_AUTO_TEST_CASE( thread_pool_parallel_for )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	BOOST_REQUIRE_EQUAL(openfpm::get_num_threads(),4ul);
+
+	std::vector<int> v(100000,0);
+
+	for (size_t r = 0 ; r < 16 ; r++)
+	{openfpm::parallel_for(0,v.size(),[&](size_t i){v[i] += 1;});}
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{match &= v[i] == 16;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// more blocks than threads and nested parallel loops
+
+	std::atomic<size_t> cnt(0);
+
+	openfpm::parallel_for_blocks(0,1000,7,[&](size_t b, size_t start, size_t stop)
+	{
+		openfpm::parallel_for(start,stop,[&](size_t i){cnt++;},1);
+	});
+
+	BOOST_REQUIRE_EQUAL(cnt.load(),1000ul);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_block_range )
+{
+	size_t b_start;
+	size_t b_stop;
+	size_t prev_stop = 10;
+
+	for (size_t b = 0 ; b < 7 ; b++)
+	{
+		openfpm::parallel_block_range(10,110,7,b,b_start,b_stop);
+
+		BOOST_REQUIRE_EQUAL(b_start,prev_stop);
+		BOOST_REQUIRE(b_stop - b_start == 14 || b_stop - b_start == 15);
+
+		prev_stop = b_stop;
+	}
+
+	BOOST_REQUIRE_EQUAL(prev_stop,110ul);
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_dynamic )
+{
+	size_t n_threads = openfpm::get_num_threads();
+	openfpm::set_num_threads(4);
+
+	std::vector<int> v(1003,0);
+	std::atomic<size_t> n_ranges(0);
+
+	openfpm::parallel_for_dynamic(3,1003,10,[&](auto & next)
+	{
+		size_t start;
+		size_t stop;
+
+		while (next(start,stop))
+		{
+			n_ranges++;
+
+			for (size_t i = start ; i < stop ; i++)
+			{v[i]++;}
+		}
+	});
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{match &= v[i] == ((i < 3)?0:1);}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(n_ranges.load(),100ul);
+
+	openfpm::set_num_threads(n_threads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
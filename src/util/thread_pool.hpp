@@ -0,0 +1,534 @@
+#ifndef OPENFPM_DATA_SRC_UTIL_THREAD_POOL_HPP_
+#define OPENFPM_DATA_SRC_UTIL_THREAD_POOL_HPP_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+//! Minimum number of iterations each thread must get before a loop is split
+#define OFP_PARALLEL_GRAIN 4096
+
+//! Minimum number of bytes each thread must get before a memory copy is split
+#define OFP_PARALLEL_GRAIN_BYTES (256*1024)
+
+namespace openfpm
+{
+	/*! \brief Pool of host threads used by the multi-threaded host algorithms
+	 *
+	 * The pool run jobs in the form f(tid) with tid in [0,n_threads). The thread
+	 * that submit the job participate as tid 0. A job submitted from inside a running
+	 * job (or while another thread is using the pool) is executed sequentially by
+	 * the calling thread, calling f(tid) for every tid in order. Because of this a job must
+	 * not assume that its tids run concurrently (no barrier inside a job)
+	 *
+	 */
+	class thread_pool
+	{
+		//! worker threads (tid 1 ... n_threads-1)
+		std::vector<std::thread> workers;
+
+		//! mutex that protect the job state
+		std::mutex mtx;
+
+		//! mutex acquired for the full duration of a job
+		std::mutex run_mtx;
+
+		//! condition variable to wake-up the workers
+		std::condition_variable cv_start;
+
+		//! condition variable to signal the end of a job
+		std::condition_variable cv_done;
+
+		//! current job
+		const std::function<void(size_t)> * job = NULL;
+
+		//! job counter, every new job increment it
+		size_t generation = 0;
+
+		//! number of threads participating to the current job
+		size_t n_job = 0;
+
+		//! number of tids of the current job
+		size_t n_job_tot = 0;
+
+		//! number of workers still running the current job
+		size_t n_running = 0;
+
+		//! first exception raised by a worker in the current job
+		std::exception_ptr eptr;
+
+		//! signal the workers to terminate
+		bool stop = false;
+
+		/*! \brief Return true if the calling thread is executing a job
+		 *
+		 * \return a reference to the thread local flag
+		 *
+		 */
+		static bool & in_job()
+		{
+			static thread_local bool ij = false;
+			return ij;
+		}
+
+		/*! \brief Main loop of a worker
+		 *
+		 * \param tid thread id
+		 * \param seen last job seen by the worker
+		 *
+		 */
+		void worker_loop(size_t tid, size_t seen)
+		{
+			in_job() = true;
+
+			std::unique_lock<std::mutex> lk(mtx);
+
+			while (true)
+			{
+				cv_start.wait(lk,[&]{return stop == true || generation != seen;});
+
+				if (stop == true)
+				{return;}
+
+				seen = generation;
+
+				if (tid >= n_job)
+				{continue;}
+
+				const std::function<void(size_t)> & f = *job;
+				size_t n_tot = n_job_tot;
+				size_t stride = n_job;
+				lk.unlock();
+
+				try
+				{
+					for (size_t i = tid ; i < n_tot ; i += stride)
+					{f(i);}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lke(mtx);
+					if (!eptr)	{eptr = std::current_exception();}
+				}
+
+				lk.lock();
+				n_running--;
+				if (n_running == 0)
+				{cv_done.notify_one();}
+			}
+		}
+
+		//! terminate all the workers
+		void join()
+		{
+			{
+			std::lock_guard<std::mutex> lk(mtx);
+			stop = true;
+			}
+
+			cv_start.notify_all();
+
+			for (size_t i = 0 ; i < workers.size() ; i++)
+			{workers[i].join();}
+
+			workers.clear();
+			stop = false;
+		}
+
+	public:
+
+		/*! \brief Constructor
+		 *
+		 * \param n_threads number of threads (including the thread submitting the jobs)
+		 *
+		 */
+		thread_pool(size_t n_threads = 1)
+		{
+			resize(n_threads);
+		}
+
+		//! Destructor
+		~thread_pool()
+		{
+			join();
+		}
+
+		/*! \brief Change the number of threads of the pool
+		 *
+		 * \param n_threads number of threads (including the thread submitting the jobs)
+		 *
+		 */
+		void resize(size_t n_threads)
+		{
+			std::lock_guard<std::mutex> lkr(run_mtx);
+
+			if (n_threads == 0)
+			{n_threads = 1;}
+
+			if (n_threads == workers.size() + 1)
+			{return;}
+
+			join();
+
+			for (size_t i = 1 ; i < n_threads ; i++)
+			{workers.push_back(std::thread(&thread_pool::worker_loop,this,i,generation));}
+		}
+
+		/*! \brief Return the number of threads of the pool
+		 *
+		 * \return the number of threads
+		 *
+		 */
+		size_t size() const
+		{
+			return workers.size() + 1;
+		}
+
+		/*! \brief Execute f(tid) for tid in [0,n)
+		 *
+		 * If n is bigger than the size of the pool each thread execute more tids
+		 *
+		 * \param n number of tids
+		 * \param f job to execute
+		 *
+		 */
+		void run(size_t n, const std::function<void(size_t)> & f)
+		{
+			if (n == 0)	{return;}
+
+			std::unique_lock<std::mutex> lkr(run_mtx,std::try_to_lock);
+
+			if (n == 1 || workers.size() == 0 || in_job() == true || lkr.owns_lock() == false)
+			{
+				// sequential execution
+				for (size_t i = 0 ; i < n ; i++)
+				{f(i);}
+				return;
+			}
+
+			size_t nt = (n > size())?size():n;
+
+			{
+			std::lock_guard<std::mutex> lk(mtx);
+			job = &f;
+			n_job = nt;
+			n_job_tot = n;
+			n_running = nt - 1;
+			eptr = nullptr;
+			generation++;
+			}
+
+			cv_start.notify_all();
+
+			std::exception_ptr eptr_0;
+
+			in_job() = true;
+			try
+			{
+				for (size_t i = 0 ; i < n ; i += nt)
+				{f(i);}
+			}
+			catch (...)
+			{eptr_0 = std::current_exception();}
+			in_job() = false;
+
+			std::unique_lock<std::mutex> lk(mtx);
+			cv_done.wait(lk,[&]{return n_running == 0;});
+			job = NULL;
+
+			if (eptr_0)	{std::rethrow_exception(eptr_0);}
+			if (eptr)	{std::rethrow_exception(eptr);}
+		}
+	};
+
+	/*! \brief Return the number of threads requested at start-up
+	 *
+	 * It is the value of the environment variable OPENFPM_NUM_THREADS, 1 if not set. The default
+	 * is one thread because in general we run one MPI process for each core
+	 *
+	 * \return the number of threads
+	 *
+	 */
+	static inline size_t get_env_num_threads()
+	{
+		const char * nt = getenv("OPENFPM_NUM_THREADS");
+
+		if (nt == NULL)	{return 1;}
+
+		long int n = atol(nt);
+
+		return (n <= 0)?1:n;
+	}
+
+	/*! \brief Return the global thread pool used by the host parallel algorithms
+	 *
+	 * \return the thread pool
+	 *
+	 */
+	inline thread_pool & get_thread_pool()
+	{
+		static thread_pool tp(get_env_num_threads());
+
+		return tp;
+	}
+
+	/*! \brief Return the number of threads used by the host parallel algorithms
+	 *
+	 * \return the number of threads
+	 *
+	 */
+	static inline size_t get_num_threads()
+	{
+		return get_thread_pool().size();
+	}
+
+	/*! \brief Set the number of threads used by the host parallel algorithms
+	 *
+	 * \param n_threads number of threads
+	 *
+	 */
+	static inline void set_num_threads(size_t n_threads)
+	{
+		get_thread_pool().resize(n_threads);
+	}
+
+	/*! \brief Calculate in how many blocks split the range [start,stop)
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param grain minimum number of elements for each block
+	 *
+	 * \return the number of blocks
+	 *
+	 */
+	static inline size_t parallel_n_blocks(size_t start, size_t stop, size_t grain = OFP_PARALLEL_GRAIN)
+	{
+		if (stop <= start)	{return 0;}
+
+		size_t nb = (stop - start + grain - 1) / grain;
+		size_t nt = get_num_threads();
+
+		return (nb < nt)?nb:nt;
+	}
+
+	/*! \brief Split the range [start,stop) in nb contiguous blocks and return block b
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param nb number of blocks
+	 * \param b block id
+	 * \param b_start first element of the block
+	 * \param b_stop one past the last element of the block
+	 *
+	 */
+	static inline void parallel_block_range(size_t start, size_t stop, size_t nb, size_t b, size_t & b_start, size_t & b_stop)
+	{
+		size_t n = stop - start;
+
+		b_start = start + (n / nb) * b + ((b < n % nb)?b:n % nb);
+		b_stop = b_start + n / nb + ((b < n % nb)?1:0);
+	}
+
+	/*! \brief Run f(b,b_start,b_stop) over nb contiguous blocks covering [start,stop)
+	 *
+	 * The splitting is deterministic, it depend only on (start,stop,nb)
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param nb number of blocks (one for each thread)
+	 * \param f function to execute on each block
+	 *
+	 */
+	template<typename lambda_f>
+	void parallel_for_blocks(size_t start, size_t stop, size_t nb, lambda_f f)
+	{
+		if (nb == 0)	{return;}
+
+		if (nb == 1)
+		{
+			f((size_t)0,start,stop);
+			return;
+		}
+
+		std::function<void(size_t)> job = [&](size_t b)
+		{
+			size_t b_start;
+			size_t b_stop;
+
+			parallel_block_range(start,stop,nb,b,b_start,b_stop);
+
+			f(b,b_start,b_stop);
+		};
+
+		get_thread_pool().run(nb,job);
+	}
+
+	/*! \brief Reduce f(i) for every i in [start,stop) using the thread pool
+	 *
+	 * Each thread reduce a contiguous block, the partial results are reduced in order,
+	 * so the result is deterministic for a given number of threads
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param init neutral element of the reduction
+	 * \param f function that return the value for the element i
+	 * \param red reduction operation red(a,b)
+	 * \param grain minimum number of iterations for each thread
+	 *
+	 * \return the reduced value
+	 *
+	 */
+	template<typename T, typename lambda_f, typename lambda_r>
+	T parallel_reduce(size_t start, size_t stop, T init, lambda_f f, lambda_r red, size_t grain = OFP_PARALLEL_GRAIN)
+	{
+		size_t nb = parallel_n_blocks(start,stop,grain);
+		std::vector<T> red_b(nb,init);
+
+		parallel_for_blocks(start,stop,nb,[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			T acc = init;
+
+			for (size_t i = b_start ; i < b_stop ; i++)
+			{acc = red(acc,f(i));}
+
+			red_b[b] = acc;
+		});
+
+		T acc = init;
+
+		for (size_t b = 0 ; b < nb ; b++)
+		{acc = red(acc,red_b[b]);}
+
+		return acc;
+	}
+
+	/*! \brief Run f(i) for every i in [start,stop) using the thread pool
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param f function to execute
+	 * \param grain minimum number of iterations for each thread
+	 *
+	 */
+	template<typename lambda_f>
+	void parallel_for(size_t start, size_t stop, lambda_f f, size_t grain = OFP_PARALLEL_GRAIN)
+	{
+		parallel_for_blocks(start,stop,parallel_n_blocks(start,stop,grain),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			for (size_t i = b_start ; i < b_stop ; i++)
+			{f(i);}
+		});
+	}
+
+	/*! \brief Run f(key) for every key of a splittable iterator using the thread pool
+	 *
+	 * The iterator must implement split(i,n) (grid_key_dx_iterator, grid_key_dx_iterator_sub,
+	 * grid_key_dx_iterator_sub_tiled, openfpm::vector_key_iterator), every thread iterate one part
+	 *
+	 * \code
+	 *
+	 * openfpm::parallel_for_each(g.getIterator(),[&](const grid_key_dx<3> & key)
+	 * {
+	 * 	g.template get<0>(key) = 1.0;
+	 * });
+	 *
+	 * \endcode
+	 *
+	 * \param it iterator
+	 * \param f function to execute for each key
+	 *
+	 */
+	template<typename it_type, typename lambda_f>
+	void parallel_for_each(const it_type & it, lambda_f f)
+	{
+		size_t nt = get_num_threads();
+
+		parallel_for_blocks(0,nt,nt,[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			auto it_b = it.split(b,nt);
+
+			while (it_b.isNext())
+			{
+				f(it_b.get());
+
+				++it_b;
+			}
+		});
+	}
+
+	/*! \brief memcpy split in contiguous blocks across the threads of the pool
+	 *
+	 * \param dst destination
+	 * \param src source (it must not overlap dst)
+	 * \param n number of bytes
+	 *
+	 */
+	static inline void parallel_memcpy(void * dst, const void * src, size_t n)
+	{
+		parallel_for_blocks(0,n,parallel_n_blocks(0,n,OFP_PARALLEL_GRAIN_BYTES),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			memcpy((unsigned char *)dst + b_start,(const unsigned char *)src + b_start,b_stop - b_start);
+		});
+	}
+
+	/*! \brief memset split in contiguous blocks across the threads of the pool
+	 *
+	 * \param dst destination
+	 * \param c byte
+	 * \param n number of bytes
+	 *
+	 */
+	static inline void parallel_memset(void * dst, int c, size_t n)
+	{
+		parallel_for_blocks(0,n,parallel_n_blocks(0,n,OFP_PARALLEL_GRAIN_BYTES),[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			memset((unsigned char *)dst + b_start,c,b_stop - b_start);
+		});
+	}
+
+	/*! \brief Dynamic scheduling of the range [start,stop) across the threads of the pool
+	 *
+	 * Every thread run f(next) once. next(b_start,b_stop) give to the calling thread the next range of at
+	 * most grain elements not processed yet and return false when the range is exhausted. Threads that
+	 * finish early take more ranges, so the work is balanced even when the cost of the elements is
+	 * irregular. Per-thread state can be created inside f before calling next
+	 *
+	 * \param start first element
+	 * \param stop one past the last element
+	 * \param grain number of elements taken at time
+	 * \param f function to execute on each thread
+	 *
+	 */
+	template<typename lambda_f>
+	void parallel_for_dynamic(size_t start, size_t stop, size_t grain, lambda_f f)
+	{
+		if (stop <= start)	{return;}
+
+		std::atomic<size_t> cnt(start);
+
+		auto next = [&](size_t & b_start, size_t & b_stop) -> bool
+		{
+			b_start = cnt.fetch_add(grain);
+
+			if (b_start >= stop)	{return false;}
+
+			b_stop = (b_start + grain < stop)?b_start + grain:stop;
+			return true;
+		};
+
+		size_t nt = parallel_n_blocks(start,stop,grain);
+
+		parallel_for_blocks(0,nt,nt,[&](size_t b, size_t b_start, size_t b_stop)
+		{
+			f(next);
+		});
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_UTIL_THREAD_POOL_HPP_ */
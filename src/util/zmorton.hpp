@@ -127,4 +127,69 @@ inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<3,T> & key)
 	key.set_d(2,z);
 }
 
+template<typename T>
+inline __device__ __host__  size_t lin_zid(const grid_key_dx<4,T> & key)
+{
+	size_t x = key.get(0);
+	size_t y = key.get(1);
+	size_t z = key.get(2);
+	size_t w = key.get(3);
+
+	x = (x | (x << 24)) & 0x000000FF000000FF;
+	x = (x | (x << 12)) & 0x000F000F000F000F;
+	x = (x | (x << 6)) & 0x0303030303030303;
+	x = (x | (x << 3)) & 0x1111111111111111;
+
+	y = (y | (y << 24)) & 0x000000FF000000FF;
+	y = (y | (y << 12)) & 0x000F000F000F000F;
+	y = (y | (y << 6)) & 0x0303030303030303;
+	y = (y | (y << 3)) & 0x1111111111111111;
+
+	z = (z | (z << 24)) & 0x000000FF000000FF;
+	z = (z | (z << 12)) & 0x000F000F000F000F;
+	z = (z | (z << 6)) & 0x0303030303030303;
+	z = (z | (z << 3)) & 0x1111111111111111;
+
+	w = (w | (w << 24)) & 0x000000FF000000FF;
+	w = (w | (w << 12)) & 0x000F000F000F000F;
+	w = (w | (w << 6)) & 0x0303030303030303;
+	w = (w | (w << 3)) & 0x1111111111111111;
+
+	return x | (y << 1) | (z << 2) | (w << 3);
+}
+
+template<typename T>
+inline __device__ __host__  void invlin_zid(size_t lin, grid_key_dx<4,T> & key)
+{
+	size_t x = lin & 0x1111111111111111;
+	size_t y = (lin >> 1) & 0x1111111111111111;
+	size_t z = (lin >> 2) & 0x1111111111111111;
+	size_t w = (lin >> 3) & 0x1111111111111111;
+
+	x = (x | (x >> 3)) & 0x0303030303030303;
+	x = (x | (x >> 6)) & 0x000F000F000F000F;
+	x = (x | (x >> 12)) & 0x000000FF000000FF;
+	x = (x | (x >> 24)) & 0x000000000000FFFF;
+
+	y = (y | (y >> 3)) & 0x0303030303030303;
+	y = (y | (y >> 6)) & 0x000F000F000F000F;
+	y = (y | (y >> 12)) & 0x000000FF000000FF;
+	y = (y | (y >> 24)) & 0x000000000000FFFF;
+
+	z = (z | (z >> 3)) & 0x0303030303030303;
+	z = (z | (z >> 6)) & 0x000F000F000F000F;
+	z = (z | (z >> 12)) & 0x000000FF000000FF;
+	z = (z | (z >> 24)) & 0x000000000000FFFF;
+
+	w = (w | (w >> 3)) & 0x0303030303030303;
+	w = (w | (w >> 6)) & 0x000F000F000F000F;
+	w = (w | (w >> 12)) & 0x000000FF000000FF;
+	w = (w | (w >> 24)) & 0x000000000000FFFF;
+
+	key.set_d(0,x);
+	key.set_d(1,y);
+	key.set_d(2,z);
+	key.set_d(3,w);
+}
+
 #endif /* ZMORTON_HPP_ */